@@ -0,0 +1,206 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: cli/cli.hpp
+ * @Description: Command-line front end: sessions, argument parsing and output
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__CLI_HPP__
+#define __MINECRAFT_ENGINE__CLI_HPP__
+
+#include <minecraft/cntconfig.hpp>
+#include <minecraft/java.hpp>
+#include <minecraft/index.hpp>
+#include <minecraft/lib/config.hpp>
+#include <minecraft/lib/result.hpp>
+
+#include <vector>
+#include <memory>
+#include <iosfwd>
+#include <cstdint>
+#include <optional>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace cli
+        {
+            // Options that apply to every command, on the command line or per batch line
+            struct CliOptions
+            {
+                // Root of the index commands work on
+                fs::path index = ".";
+
+                // One JSON object per command on stdout instead of text
+                bool json = false;
+
+                // Concurrent workers for commands that fan out, 0 uses every CPU worker
+                unsigned int jobs = 0;
+            };
+
+            // Options and operands of one command
+            class CliArguments
+            {
+            private:
+                std::vector<String> _operands;
+                std::unordered_map<String, std::vector<String>> _values;
+
+                friend class CliSession;
+
+            public:
+                const std::vector<String> &operands() const { return _operands; }
+
+                bool has(const String &name) const { return _values.count(name) != 0; }
+
+                // Last value of an option, fallback if it was not given
+                String value(const String &name, const String &fallback = "") const;
+
+                // Every value of an option that may be repeated
+                const std::vector<String> &values(const String &name) const;
+
+                // Value of a numeric option, an error if it is not a number
+                Result<long long> number(const String &name, long long fallback) const;
+            };
+
+            class CliSession;
+
+            // The result of a command: data rendered as JSON or text, and whether it succeeded
+            struct CliReply
+            {
+                ConfigObject data;
+
+                // A command may report findings (e.g. missing files) and still fail
+                bool ok = true;
+
+                CliReply() = default;
+                CliReply(ConfigObject _data, bool _ok = true) : data(std::move(_data)), ok(_ok) {}
+            };
+
+            using CliHandler = std::function<Result<CliReply>(CliSession &, const CliArguments &)>;
+
+            struct CliCommand
+            {
+                const char *name;
+                const char *usage;
+                const char *summary;
+
+                // Options taking a value ("--name value" or "--name=value"), the others are flags
+                std::vector<String> valueOptions;
+                std::vector<String> flags;
+
+                std::size_t minOperands = 0;
+                std::size_t maxOperands = SIZE_MAX;
+
+                CliHandler handler;
+
+                // Human readable output, the generic layout is used when empty
+                std::function<void(const ConfigObject &, String &)> text;
+            };
+
+            // Every command of the front end
+            const std::vector<CliCommand> &Commands();
+
+            /**
+             * State shared by the commands of one invocation
+             * In batch mode every line runs in the same session, so the Java
+             * registry, the compiled profiles and the classpaths are warmed once.
+             */
+            class CliSession
+            {
+            private:
+                CliOptions _options;
+                std::ostream &_out;
+                std::ostream &_err;
+
+                std::optional<JavaList> _java;
+                bool _javaDeep = false;
+
+                std::unique_ptr<Index> _index;
+
+                int _run(const CliCommand &command, const CliArguments &arguments);
+                void _print(const CliCommand *command, const Result<CliReply> &reply);
+
+            public:
+                CliSession(CliOptions options, std::ostream &out, std::ostream &err)
+                    : _options(std::move(options)), _out(out), _err(err) {}
+
+                const CliOptions &options() const { return _options; }
+
+                std::ostream &err() { return _err; }
+
+                // Open the index, creating it if it does not exist yet
+                Index &index();
+
+                /**
+                 * Java installations, searched on first use and kept for the session
+                 * @param deep Search with SearchJava$Deep; a deep search replaces a quick one
+                 * @param refresh Search again even if installations are known
+                 */
+                const JavaList &java(bool deep = false, bool refresh = false);
+
+                /**
+                 * Apply global options that are not followed by a command (--batch)
+                 * @return An error naming the first argument that is not a global option
+                 */
+                Result<void> configure(const std::vector<String> &argv);
+
+                /**
+                 * Run one command line
+                 * Global options (--index, --json, --jobs) may appear anywhere and only
+                 * apply to this command.
+                 * @param argv Command name followed by its options and operands
+                 * @return Exit status: 0 on success, 1 if the command failed, 2 on a usage error
+                 */
+                int run(const std::vector<String> &argv);
+
+                /**
+                 * Run one command per line until the end of input
+                 * Blank lines and lines starting with # are skipped, a failing command
+                 * does not stop the batch.
+                 * @return 0 if every command succeeded, otherwise the highest exit status
+                 */
+                int batch(std::istream &input);
+
+                void usage(std::ostream &out) const;
+            };
+
+            namespace internal
+            {
+                // Split a line into words: whitespace separated, with '...', "..." and \ escapes
+                Result<std::vector<String>> splitCommandLine(std::string_view line);
+
+                // Append a value as JSON: None is null, characters are one-character strings
+                void writeJson(String &out, const ConfigObject &value);
+
+                // Append a value as indented "key: value" lines
+                void writeText(String &out, const ConfigObject &value, int indent = 0);
+
+                // Lowercase name of an error code ("not_found", ...)
+                const char *errcName(Errc code);
+            }
+        } // namespace cli
+    } // namespace minecraft
+
+} // namespace cnt
+
+#endif // !__MINECRAFT_ENGINE__CLI_HPP__
@@ -0,0 +1,54 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: cli/main.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <cli/cli.hpp>
+
+#include <iostream>
+#include <algorithm>
+
+int main(int argc, char **argv)
+{
+    using namespace cnt::minecraft::cli;
+
+    std::vector<String> arguments(argv + 1, argv + argc);
+    CliSession session(CliOptions{}, std::cout, std::cerr);
+    if (arguments.empty())
+    {
+        session.usage(std::cerr);
+        return 2;
+    }
+
+    auto batch = std::find(arguments.begin(), arguments.end(), "--batch");
+    if (batch == arguments.end())
+        return session.run(arguments);
+
+    // Options around --batch are the defaults of every line
+    arguments.erase(batch);
+    cnt::Result<void> configured = session.configure(arguments);
+    if (!configured)
+    {
+        std::cerr << "error: " << configured.error().message() << std::endl;
+        return 2;
+    }
+    return session.batch(std::cin);
+}
@@ -0,0 +1,590 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: cli/source/cli.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <cli/cli.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+#include <stdexcept>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace cli
+        {
+            namespace internal
+            {
+                Result<std::vector<String>> splitCommandLine(std::string_view line)
+                {
+                    std::vector<String> words;
+                    String word;
+                    bool inWord = false;
+                    char quote = 0;
+                    for (std::size_t i = 0; i < line.size(); i++)
+                    {
+                        char c = line[i];
+                        if (quote == '\'')
+                        {
+                            if (c == '\'')
+                                quote = 0;
+                            else
+                                word += c;
+                            continue;
+                        }
+                        if (c == '\\' && quote != '\'')
+                        {
+                            if (++i == line.size())
+                                return Error(Errc::PARSE, "Trailing backslash");
+                            // Inside double quotes only the quote and the backslash are escaped
+                            if (quote == '"' && line[i] != '"' && line[i] != '\\')
+                                word += '\\';
+                            word += line[i];
+                            inWord = true;
+                            continue;
+                        }
+                        if (quote == '"')
+                        {
+                            if (c == '"')
+                                quote = 0;
+                            else
+                                word += c;
+                            continue;
+                        }
+                        if (c == '\'' || c == '"')
+                        {
+                            quote = c;
+                            inWord = true;
+                        }
+                        else if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+                        {
+                            if (inWord)
+                                words.push_back(std::move(word));
+                            word.clear();
+                            inWord = false;
+                        }
+                        else
+                        {
+                            word += c;
+                            inWord = true;
+                        }
+                    }
+                    if (quote)
+                        return Error(Errc::PARSE, "Unterminated quote");
+                    if (inWord)
+                        words.push_back(std::move(word));
+                    return words;
+                }
+
+                static void writeJsonString(String &out, std::string_view text)
+                {
+                    out += '"';
+                    for (char ch : text)
+                    {
+                        unsigned char c = static_cast<unsigned char>(ch);
+                        if (c == '"' || c == '\\')
+                        {
+                            out += '\\';
+                            out += ch;
+                        }
+                        else if (c == '\n')
+                            out += "\\n";
+                        else if (c == '\t')
+                            out += "\\t";
+                        else if (c < 0x20)
+                        {
+                            char code[8];
+                            std::snprintf(code, sizeof(code), "\\u%04x", c);
+                            out += code;
+                        }
+                        else
+                            out += ch;
+                    }
+                    out += '"';
+                }
+
+                void writeJson(String &out, const ConfigObject &value)
+                {
+                    switch (value.get_type())
+                    {
+                    case ConfigType::NONE:
+                        out += "null";
+                        break;
+                    case ConfigType::NUMBER:
+                        out += std::to_string(*value.as_number());
+                        break;
+                    case ConfigType::FLOAT:
+                    {
+                        double number = *value.as_float();
+                        if (!std::isfinite(number))
+                        {
+                            out += "null";
+                            break;
+                        }
+                        char text[32];
+                        std::snprintf(text, sizeof(text), "%.15g", number);
+                        out += text;
+                        break;
+                    }
+                    case ConfigType::BOOLEAN:
+                        out += *value.as_boolean() ? "true" : "false";
+                        break;
+                    case ConfigType::STRING:
+                        writeJsonString(out, *value.as_string());
+                        break;
+                    case ConfigType::CHARACTER:
+                    {
+                        char c = *value.as_character();
+                        writeJsonString(out, std::string_view(&c, 1));
+                        break;
+                    }
+                    case ConfigType::OBJECT:
+                    {
+                        out += '{';
+                        bool first = true;
+                        for (const auto &key : value.keys())
+                        {
+                            if (!first)
+                                out += ',';
+                            first = false;
+                            writeJsonString(out, key);
+                            out += ':';
+                            writeJson(out, value.at(key));
+                        }
+                        out += '}';
+                        break;
+                    }
+                    case ConfigType::ARRAY:
+                        out += '[';
+                        for (std::size_t i = 0; i < value.size(); i++)
+                        {
+                            if (i > 0)
+                                out += ',';
+                            writeJson(out, value.at(i));
+                        }
+                        out += ']';
+                        break;
+                    }
+                }
+
+                static String scalarText(const ConfigObject &value)
+                {
+                    switch (value.get_type())
+                    {
+                    case ConfigType::NONE:
+                        return "-";
+                    case ConfigType::STRING:
+                        return *value.as_string();
+                    case ConfigType::CHARACTER:
+                        return String(1, *value.as_character());
+                    case ConfigType::FLOAT:
+                    {
+                        char text[32];
+                        std::snprintf(text, sizeof(text), "%.6g", *value.as_float());
+                        return text;
+                    }
+                    default:
+                        return value.to_string();
+                    }
+                }
+
+                static bool isNested(const ConfigObject &value)
+                {
+                    return (value.is_object() || value.is_array()) && value.size() > 0;
+                }
+
+                void writeText(String &out, const ConfigObject &value, int indent)
+                {
+                    const String pad(static_cast<std::size_t>(indent), ' ');
+                    if (value.is_object())
+                    {
+                        for (const auto &key : value.keys())
+                        {
+                            const ConfigObject &field = value.at(key);
+                            if (isNested(field))
+                            {
+                                out += pad + key + ":\n";
+                                writeText(out, field, indent + 2);
+                            }
+                            else
+                                out += pad + key + ": " + (field.is_array() || field.is_object() ? String("-") : scalarText(field)) + "\n";
+                        }
+                        return;
+                    }
+                    if (value.is_array())
+                    {
+                        for (std::size_t i = 0; i < value.size(); i++)
+                        {
+                            const ConfigObject &item = value.at(i);
+                            if (!isNested(item))
+                            {
+                                out += pad + "- " + scalarText(item) + "\n";
+                                continue;
+                            }
+                            // The first line of a nested item carries the dash
+                            String nested;
+                            writeText(nested, item, indent + 2);
+                            nested.replace(0, static_cast<std::size_t>(indent) + 2, pad + "- ");
+                            out += nested;
+                        }
+                        return;
+                    }
+                    out += pad + scalarText(value) + "\n";
+                }
+
+                const char *errcName(Errc code)
+                {
+                    switch (code)
+                    {
+                    case Errc::NOT_FOUND:
+                        return "not_found";
+                    case Errc::PERMISSION_DENIED:
+                        return "permission_denied";
+                    case Errc::IO:
+                        return "io";
+                    case Errc::PARSE:
+                        return "parse";
+                    case Errc::INVALID:
+                        return "invalid";
+                    case Errc::OUT_OF_RANGE:
+                        return "out_of_range";
+                    }
+                    return "unknown";
+                }
+
+                static const CliCommand *findCommand(std::string_view name)
+                {
+                    for (const auto &command : Commands())
+                    {
+                        if (name == command.name)
+                            return &command;
+                    }
+                    return nullptr;
+                }
+
+                static Result<unsigned int> parseJobs(const String &text)
+                {
+                    char *end = nullptr;
+                    unsigned long jobs = std::strtoul(text.c_str(), &end, 10);
+                    if (text.empty() || *end != '\0' || text[0] == '-' || jobs > 1024)
+                        return Error(Errc::INVALID, "--jobs takes a number from 0 to 1024");
+                    return static_cast<unsigned int>(jobs);
+                }
+            }
+
+            String CliArguments::value(const String &name, const String &fallback) const
+            {
+                auto it = _values.find(name);
+                if (it == _values.end() || it->second.empty())
+                    return fallback;
+                return it->second.back();
+            }
+
+            const std::vector<String> &CliArguments::values(const String &name) const
+            {
+                static const std::vector<String> none;
+                auto it = _values.find(name);
+                return it == _values.end() ? none : it->second;
+            }
+
+            Result<long long> CliArguments::number(const String &name, long long fallback) const
+            {
+                if (!has(name))
+                    return fallback;
+                String text = value(name);
+                char *end = nullptr;
+                long long number = std::strtoll(text.c_str(), &end, 10);
+                if (text.empty() || *end != '\0')
+                    return Error(Errc::INVALID, "--" + name + " takes a number, got \"" + text + "\"");
+                return number;
+            }
+
+            Index &CliSession::index()
+            {
+                if (!_index || _index->getPath() != _options.index)
+                    _index = std::make_unique<Index>(_options.index);
+                return *_index;
+            }
+
+            const JavaList &CliSession::java(bool deep, bool refresh)
+            {
+                if (!_java || refresh || (deep && !_javaDeep))
+                {
+                    _java = deep ? SearchJava$Deep() : SearchJava$Quick();
+                    _javaDeep = deep;
+                }
+                return *_java;
+            }
+
+            void CliSession::usage(std::ostream &out) const
+            {
+                out << "Usage: minecraft-engine [--index <dir>] [--json] [--jobs <n>] <command> [options]\n"
+                       "       minecraft-engine [--index <dir>] [--json] [--jobs <n>] --batch < commands\n\n"
+                       "Commands:\n";
+                for (const auto &command : Commands())
+                {
+                    String line = String("  ") + command.usage;
+                    if (line.size() < 44)
+                        line.resize(44, ' ');
+                    else
+                        line += "\n" + String(44, ' ');
+                    out << line << command.summary << "\n";
+                }
+                out << "\nGlobal options:\n"
+                       "  --index <dir>   Index to work on (default: current directory)\n"
+                       "  --json          Print one JSON object per command\n"
+                       "  --jobs <n>      Parallel workers, 0 uses every core (default)\n"
+                       "  --batch         Read one command per line from stdin, sharing warm caches\n";
+            }
+
+            Result<void> CliSession::configure(const std::vector<String> &argv)
+            {
+                for (std::size_t i = 0; i < argv.size(); i++)
+                {
+                    String name = argv[i].compare(0, 2, "--") == 0 ? argv[i].substr(2) : String();
+                    std::optional<String> value;
+                    std::size_t equals = name.find('=');
+                    if (equals != String::npos)
+                    {
+                        value = name.substr(equals + 1);
+                        name.resize(equals);
+                    }
+                    if (name == "json" && !value)
+                    {
+                        _options.json = true;
+                        continue;
+                    }
+                    if (name != "index" && name != "jobs")
+                        return Error(Errc::INVALID, "Unexpected argument: " + argv[i]);
+                    if (!value && i + 1 < argv.size())
+                        value = argv[++i];
+                    if (!value)
+                        return Error(Errc::INVALID, "--" + name + " needs a value");
+                    if (name == "index")
+                    {
+                        _options.index = *value;
+                        continue;
+                    }
+                    Result<unsigned int> jobs = internal::parseJobs(*value);
+                    if (!jobs)
+                        return jobs.error();
+                    _options.jobs = *jobs;
+                }
+                return {};
+            }
+
+            void CliSession::_print(const CliCommand *command, const Result<CliReply> &reply)
+            {
+                if (_options.json)
+                {
+                    String out = "{\"command\":";
+                    internal::writeJson(out, command ? ConfigObject(command->name) : ConfigObject());
+                    if (reply)
+                    {
+                        out += reply->ok ? ",\"ok\":true,\"result\":" : ",\"ok\":false,\"result\":";
+                        internal::writeJson(out, reply->data);
+                    }
+                    else
+                    {
+                        out += ",\"ok\":false,\"error\":{\"code\":\"";
+                        out += internal::errcName(reply.error().code);
+                        out += "\",\"message\":";
+                        internal::writeJson(out, ConfigObject(reply.error().message()));
+                        out += '}';
+                    }
+                    out += "}\n";
+                    _out << out << std::flush;
+                    return;
+                }
+
+                if (!reply)
+                {
+                    _err << "error: " << reply.error().message() << std::endl;
+                    return;
+                }
+                String out;
+                if (command && command->text)
+                    command->text(reply->data, out);
+                else
+                    internal::writeText(out, reply->data);
+                _out << out << std::flush;
+            }
+
+            int CliSession::_run(const CliCommand &command, const CliArguments &arguments)
+            {
+                Result<CliReply> reply = Error(Errc::INVALID, "Command did not run");
+                try
+                {
+                    reply = command.handler(*this, arguments);
+                }
+                catch (const std::exception &e)
+                {
+                    reply = Error(Errc::IO, e.what());
+                }
+                _print(&command, reply);
+                return reply && reply->ok ? 0 : 1;
+            }
+
+            int CliSession::run(const std::vector<String> &argv)
+            {
+                // Global options given on this line only apply to it
+                const CliOptions saved = _options;
+                struct Restore
+                {
+                    CliOptions &options;
+                    const CliOptions &saved;
+                    ~Restore() { options = saved; }
+                } restore{_options, saved};
+
+                const CliCommand *command = nullptr;
+                CliArguments arguments;
+                bool operandsOnly = false;
+                auto usageError = [&](const String &message)
+                {
+                    _print(command, Result<CliReply>(Error(Errc::INVALID, message)));
+                    if (!_options.json)
+                        _err << "Run 'minecraft-engine help' for usage" << std::endl;
+                    return 2;
+                };
+
+                for (std::size_t i = 0; i < argv.size(); i++)
+                {
+                    const String &word = argv[i];
+                    if (operandsOnly || word.size() < 3 || word.compare(0, 2, "--") != 0)
+                    {
+                        if (word == "--" && !operandsOnly)
+                        {
+                            operandsOnly = true;
+                            continue;
+                        }
+                        if (command)
+                        {
+                            arguments._operands.push_back(word);
+                            continue;
+                        }
+                        if (word == "help" || word == "-h")
+                        {
+                            usage(_out);
+                            return 0;
+                        }
+                        command = internal::findCommand(word);
+                        if (!command)
+                            return usageError("Unknown command: " + word);
+                        continue;
+                    }
+
+                    String name = word.substr(2);
+                    std::optional<String> value;
+                    std::size_t equals = name.find('=');
+                    if (equals != String::npos)
+                    {
+                        value = name.substr(equals + 1);
+                        name.resize(equals);
+                    }
+                    auto takeValue = [&]()
+                    {
+                        if (!value && i + 1 < argv.size())
+                            value = argv[++i];
+                        return value.has_value();
+                    };
+
+                    if (name == "help")
+                    {
+                        usage(_out);
+                        return 0;
+                    }
+                    if (name == "json" && !value)
+                    {
+                        _options.json = true;
+                        continue;
+                    }
+                    if (name == "index")
+                    {
+                        if (!takeValue())
+                            return usageError("--index needs a directory");
+                        _options.index = *value;
+                        continue;
+                    }
+                    if (name == "jobs")
+                    {
+                        if (!takeValue())
+                            return usageError("--jobs needs a number");
+                        Result<unsigned int> jobs = internal::parseJobs(*value);
+                        if (!jobs)
+                            return usageError(jobs.error().detail);
+                        _options.jobs = *jobs;
+                        continue;
+                    }
+
+                    if (!command)
+                        return usageError("Unknown option: --" + name);
+                    if (std::find(command->valueOptions.begin(), command->valueOptions.end(), name) != command->valueOptions.end())
+                    {
+                        if (!takeValue())
+                            return usageError("--" + name + " needs a value");
+                        arguments._values[name].push_back(std::move(*value));
+                    }
+                    else if (std::find(command->flags.begin(), command->flags.end(), name) != command->flags.end() && !value)
+                        arguments._values[name];
+                    else
+                        return usageError(String("Unknown option for ") + command->name + ": --" + name);
+                }
+
+                if (!command)
+                    return usageError("No command given");
+                if (arguments._operands.size() < command->minOperands || arguments._operands.size() > command->maxOperands)
+                    return usageError(String("Usage: minecraft-engine ") + command->usage);
+                return _run(*command, arguments);
+            }
+
+            int CliSession::batch(std::istream &input)
+            {
+                int status = 0;
+                String line;
+                while (std::getline(input, line))
+                {
+                    std::size_t start = line.find_first_not_of(" \t\r");
+                    if (start == String::npos || line[start] == '#')
+                        continue;
+
+                    Result<std::vector<String>> words = internal::splitCommandLine(line);
+                    int result;
+                    if (!words)
+                    {
+                        _print(nullptr, Result<CliReply>(words.error()));
+                        result = 2;
+                    }
+                    else
+                        result = run(*words);
+                    status = std::max(status, result);
+                }
+                return status;
+            }
+        } // namespace cli
+    } // namespace minecraft
+
+} // namespace cnt
@@ -0,0 +1,790 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: cli/source/commands.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <cli/cli.hpp>
+#include <minecraft/instance.hpp>
+#include <minecraft/daemon.hpp>
+#include <minecraft/parallel.hpp>
+#include <minecraft/cache.hpp>
+#include <minecraft/lib/memory.hpp>
+#include <minecraft/lib/sha1.hpp>
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <cstdio>
+#include <climits>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <unordered_map>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace cli
+        {
+            namespace internal
+            {
+                // A file a version needs at launch
+                struct VersionFile
+                {
+                    fs::path path;
+                    String sha1; // empty if the profile does not say
+                    const char *kind;
+                };
+
+                static ConfigObject javaObject(const JavaInfo &java)
+                {
+                    ConfigObject object;
+                    object["name"] = java.name;
+                    object["publisher"] = java.publisher;
+                    object["structure"] = java.structure;
+                    object["path"] = java.path.string();
+                    object["version"] = java.version;
+                    object["major"] = java.majorVersion();
+                    return object;
+                }
+
+                static ConfigObject stringList(const std::vector<String> &values)
+                {
+                    ConfigArray array;
+                    array.reserve(values.size());
+                    for (const auto &value : values)
+                        array.emplace_back(value);
+                    return ConfigObject(std::move(array));
+                }
+
+                static bool hasVersion(const fs::path &indexPath, const String &id)
+                {
+                    std::error_code ec;
+                    return !id.empty() && id.find('/') == String::npos &&
+                           fs::is_regular_file(indexPath / "versions" / id / (id + ".json"), ec);
+                }
+
+                static Result<void> checkVersion(const fs::path &indexPath, const String &id)
+                {
+                    if (!hasVersion(indexPath, id))
+                        return Error(Errc::NOT_FOUND, "Unknown version: " + id, indexPath.string());
+                    return {};
+                }
+
+                // Versions of an index: directories of versions/ holding <id>.json
+                static std::vector<String> listVersions(const fs::path &indexPath)
+                {
+                    std::vector<String> versions;
+                    std::error_code ec;
+                    for (fs::directory_iterator it(indexPath / "versions", ec), end; !ec && it != end; it.increment(ec))
+                    {
+                        String id = it->path().filename().string();
+                        if (hasVersion(indexPath, id))
+                            versions.push_back(std::move(id));
+                    }
+                    std::sort(versions.begin(), versions.end());
+                    return versions;
+                }
+
+                static String relativeTo(const fs::path &path, const fs::path &root)
+                {
+                    fs::path relative = path.lexically_relative(root);
+                    return relative.empty() ? path.string() : relative.string();
+                }
+
+                // Profiles, classpath, natives and assets of a version, with the hashes the profiles publish
+                static std::vector<VersionFile> versionFiles(const fs::path &indexPath, const String &id)
+                {
+                    const fs::path versionsDir = indexPath / "versions";
+                    const fs::path librariesDir = indexPath / "libraries";
+                    const fs::path assetsDir = indexPath / "assets";
+                    auto chain = minecraft::internal::loadProfileChain(versionsDir, id);
+                    auto ids = minecraft::internal::profileChainIds(chain, id);
+
+                    std::vector<VersionFile> files;
+                    std::unordered_map<String, String> hashes;
+                    String clientSha1;
+                    ConfigObject assetIndex;
+                    for (std::size_t p = 0; p < chain.size(); p++)
+                    {
+                        files.push_back({versionsDir / ids[p] / (ids[p] + ".json"), "", "profile"});
+
+                        ConfigObject libraries = chain[p]->get("libraries");
+                        for (std::size_t i = 0; i < libraries.size(); i++)
+                        {
+                            const ConfigObject &library = libraries.at(i);
+                            if (!library.has_key("downloads") || !library.at("downloads").has_key("artifact"))
+                                continue;
+                            const ConfigObject &artifact = library.at("downloads").at("artifact");
+                            if (artifact.has_key("path") && artifact.has_key("sha1"))
+                                hashes[(librariesDir / artifact.at("path").as_string().value_or("")).string()] = artifact.at("sha1").as_string().value_or("");
+                        }
+
+                        // The launched profile wins, like for every other key of the chain
+                        ConfigObject downloads = chain[p]->get("downloads");
+                        if (downloads.has_key("client") && downloads.at("client").has_key("sha1"))
+                            clientSha1 = downloads.at("client").at("sha1").as_string().value_or("");
+                        ConfigObject index = chain[p]->get("assetIndex");
+                        if (index.has_key("id"))
+                            assetIndex = index;
+                    }
+
+                    Classpath classpath = minecraft::internal::resolveClasspath(chain, indexPath, id);
+                    for (std::size_t i = 0; i < classpath.entries.size(); i++)
+                    {
+                        const fs::path &entry = classpath.entries[i];
+                        if (i + 1 == classpath.entries.size())
+                        {
+                            files.push_back({entry, clientSha1, "client"});
+                            continue;
+                        }
+                        auto it = hashes.find(entry.string());
+                        files.push_back({entry, it == hashes.end() ? String() : it->second, "library"});
+                    }
+
+                    for (auto &native : minecraft::internal::resolveNatives(chain, indexPath))
+                        files.push_back({std::move(native.jar), std::move(native.sha1), "natives"});
+
+                    if (assetIndex.has_key("id"))
+                    {
+                        const String assetId = assetIndex.at("id").as_string().value_or("");
+                        const fs::path indexFile = assetsDir / "indexes" / (assetId + ".json");
+                        files.push_back({indexFile, assetIndex.has_key("sha1") ? assetIndex.at("sha1").as_string().value_or("") : String(), "asset-index"});
+
+                        // Objects are only known once the asset index is there
+                        Config assets;
+                        if (assets.try_open(indexFile))
+                        {
+                            ConfigObject objects = assets.get("objects");
+                            if (objects.is_object())
+                            {
+                                for (const auto &name : objects.keys())
+                                {
+                                    String hash = objects.at(name).has_key("hash") ? objects.at(name).at("hash").as_string().value_or("") : String();
+                                    if (hash.size() < 2)
+                                        continue;
+                                    files.push_back({assetsDir / "objects" / hash.substr(0, 2) / hash, hash, "asset"});
+                                }
+                            }
+                        }
+                    }
+                    return files;
+                }
+
+                // SHA-1 of a file, shared with the natives cache through the cache store
+                static String hashFile(const fs::path &file)
+                {
+                    const String cacheKey = minecraft::internal::fileCacheKey(file);
+                    if (std::optional<String> stored = CacheStore::shared().get("sha1", cacheKey))
+                        return *stored;
+                    String sha1 = cnt::Sha1::hash_file(file);
+                    CacheStore::shared().put("sha1", cacheKey, sha1);
+                    return sha1;
+                }
+
+                static Result<JavaInfo> javaForVersion(CliSession &session, const String &id, const String &home)
+                {
+                    if (!home.empty())
+                    {
+                        fs::path path(home);
+                        JavaInfo java(path.filename().string(), minecraft::internal::getJavaPublisher(path),
+                                      minecraft::internal::getJavaStructure(path), path, "");
+                        if (!minecraft::internal::isValidJavaExecutable(java.executable()))
+                            return Error(Errc::NOT_FOUND, "No java executable in " + home);
+                        java.version = minecraft::internal::getJavaVersionInfo(java.executable());
+                        return java;
+                    }
+
+                    // Profiles older than javaVersion all run on Java 8
+                    int major = LaunchTemplateCache::shared().get(session.index().getPath() / "versions", id, LaunchFeatures{})->javaMajor();
+                    if (major == 0)
+                        major = 8;
+                    const JavaInfo *java = minecraft::internal::selectJava(session.java(), major);
+                    if (!java)
+                        return Error(Errc::NOT_FOUND, "No Java " + std::to_string(major) + " runtime found, pass --java", id);
+                    return *java;
+                }
+
+                static Result<void> parseVariables(const CliArguments &arguments, LaunchOptions &options)
+                {
+                    for (const auto &assignment : arguments.values("var"))
+                    {
+                        std::size_t equals = assignment.find('=');
+                        if (equals == String::npos)
+                            return Error(Errc::INVALID, "--var takes name=value, got \"" + assignment + "\"");
+                        LaunchSlot slot = minecraft::internal::lookupLaunchSlot(std::string_view(assignment).substr(0, equals));
+                        if (slot == LaunchSlot::Count)
+                            return Error(Errc::INVALID, "Unknown launch variable: " + assignment.substr(0, equals));
+                        options.variables.set(slot, assignment.substr(equals + 1));
+                    }
+                    options.jvmArgs = arguments.values("jvm-arg");
+                    return {};
+                }
+
+                static String formatDuration(double ns)
+                {
+                    char text[32];
+                    if (ns < 1e3)
+                        std::snprintf(text, sizeof(text), "%.0f ns", ns);
+                    else if (ns < 1e6)
+                        std::snprintf(text, sizeof(text), "%.2f us", ns / 1e3);
+                    else if (ns < 1e9)
+                        std::snprintf(text, sizeof(text), "%.2f ms", ns / 1e6);
+                    else
+                        std::snprintf(text, sizeof(text), "%.2f s", ns / 1e9);
+                    return text;
+                }
+
+                static void padTo(String &line, std::size_t width)
+                {
+                    if (line.size() < width)
+                        line.resize(width, ' ');
+                    else
+                        line += ' ';
+                }
+
+                // Time fn per call after one warm-up call
+                template <typename Fn>
+                static ConfigObject measure(const char *name, long long iterations, Fn &&fn)
+                {
+                    static volatile std::size_t sink;
+                    sink = sink + fn();
+
+                    std::vector<std::uint64_t> samples;
+                    samples.reserve(static_cast<std::size_t>(iterations));
+                    AllocationCounter counter;
+                    for (long long i = 0; i < iterations; i++)
+                    {
+                        auto start = std::chrono::steady_clock::now();
+                        sink = sink + fn();
+                        auto elapsed = std::chrono::steady_clock::now() - start;
+                        samples.push_back(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+                    }
+                    std::uint64_t allocations = counter.allocations();
+
+                    std::sort(samples.begin(), samples.end());
+                    double total = 0;
+                    for (std::uint64_t sample : samples)
+                        total += static_cast<double>(sample);
+                    auto percentile = [&](double p)
+                    {
+                        std::size_t index = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1));
+                        return static_cast<long long>(samples[index]);
+                    };
+
+                    ConfigObject result;
+                    result["name"] = name;
+                    result["iterations"] = iterations;
+                    result["mean_ns"] = total / static_cast<double>(samples.size());
+                    result["min_ns"] = static_cast<long long>(samples.front());
+                    result["p50_ns"] = percentile(0.5);
+                    result["p99_ns"] = percentile(0.99);
+                    // Tagged allocations per call, every operator new with CNT_COUNT_ALL_ALLOCATIONS;
+                    // nothing is counted without CNT_ALLOCATION_COUNTER (see AllocationCounter)
+                    if (AllocationCounter::available)
+                        result["allocations"] = static_cast<double>(allocations) / static_cast<double>(iterations);
+                    return result;
+                }
+            }
+
+            static Result<CliReply> javaCommand(CliSession &session, const CliArguments &arguments)
+            {
+                ConfigArray installations;
+                for (const auto &java : session.java(arguments.has("deep"), arguments.has("refresh")))
+                    installations.push_back(internal::javaObject(java));
+                return CliReply(ConfigObject(std::move(installations)));
+            }
+
+            static void javaText(const ConfigObject &data, String &out)
+            {
+                if (data.size() == 0)
+                {
+                    out += "No Java installations found\n";
+                    return;
+                }
+                for (std::size_t i = 0; i < data.size(); i++)
+                {
+                    const ConfigObject &java = data.at(i);
+                    String line = std::to_string(java.at("major").as_number().value_or(0));
+                    internal::padTo(line, 5);
+                    line += java.at("version").as_string().value_or("");
+                    internal::padTo(line, 20);
+                    line += java.at("publisher").as_string().value_or("");
+                    internal::padTo(line, 34);
+                    line += java.at("structure").as_string().value_or("");
+                    internal::padTo(line, 40);
+                    out += line + java.at("path").as_string().value_or("") + "\n";
+                }
+            }
+
+            static Result<CliReply> configCommand(CliSession &session, const CliArguments &arguments)
+            {
+                const std::vector<String> &files = arguments.operands();
+                std::vector<ConfigObject> results(files.size());
+                minecraft::internal::parallelFor(files.size(), [&](std::size_t index)
+                                                 {
+                    const fs::path path(files[index]);
+                    ConfigObject &result = results[index];
+                    result["file"] = files[index];
+
+                    Config config;
+                    Result<void> opened = config.try_open(path);
+                    std::vector<String> problems;
+                    if (!opened)
+                        problems.push_back(opened.error().detail);
+                    else if (path.filename() == "meic.cco")
+                    {
+                        // The index config written by Index, see Index::_create_meic
+                        if (!config.get("name").is_string())
+                            problems.push_back("\"name\" must be a string");
+                        if (!config.get("config").is_object())
+                            problems.push_back("\"config\" must be an object");
+                    }
+                    result["ok"] = problems.empty();
+                    if (!problems.empty())
+                        result["problems"] = internal::stringList(problems); }, session.options().jobs);
+
+                bool ok = true;
+                ConfigArray array;
+                for (auto &result : results)
+                {
+                    ok = ok && result.at("ok").as_boolean().value_or(false);
+                    array.push_back(std::move(result));
+                }
+                return CliReply(ConfigObject(std::move(array)), ok);
+            }
+
+            static void configText(const ConfigObject &data, String &out)
+            {
+                for (std::size_t i = 0; i < data.size(); i++)
+                {
+                    const ConfigObject &result = data.at(i);
+                    const String file = result.at("file").as_string().value_or("");
+                    if (result.at("ok").as_boolean().value_or(false))
+                    {
+                        out += "ok    " + file + "\n";
+                        continue;
+                    }
+                    const ConfigObject &problems = result.at("problems");
+                    for (std::size_t p = 0; p < problems.size(); p++)
+                        out += "FAIL  " + file + ": " + problems.at(p).as_string().value_or("") + "\n";
+                }
+            }
+
+            static Result<CliReply> installCommand(CliSession &session, const CliArguments &arguments)
+            {
+                const String id = arguments.operands()[0];
+                const fs::path source(arguments.value("from"));
+                if (source.empty())
+                    return Error(Errc::INVALID, "install needs --from <index> (versions are copied from another index)");
+                Result<void> known = internal::checkVersion(source, id);
+                if (!known)
+                    return known.error();
+
+                const fs::path target = session.index().getPath();
+                std::error_code ec;
+                if (fs::equivalent(source, target, ec))
+                    return Error(Errc::INVALID, "Cannot install a version into the index it comes from");
+                const bool force = arguments.has("force");
+
+                // Profiles first: the version directories with their client jars
+                ConfigArray profiles;
+                auto chain = minecraft::internal::loadProfileChain(source / "versions", id);
+                for (const auto &profile : minecraft::internal::profileChainIds(chain, id))
+                {
+                    ConfigObject entry;
+                    entry["id"] = profile;
+                    if (internal::hasVersion(target, profile) && !force)
+                        entry["action"] = "kept";
+                    else
+                    {
+                        CloneOptions options;
+                        options.immutableDirs = {profile + ".jar"};
+                        options.overwrite = true;
+                        options.threads = session.options().jobs;
+                        CloneTree(source / "versions" / profile, target / "versions" / profile, options);
+                        entry["action"] = "installed";
+                    }
+                    profiles.push_back(std::move(entry));
+                }
+
+                // Then the shared content, hardlinked where the indexes share a filesystem
+                std::vector<internal::VersionFile> files;
+                for (auto &file : internal::versionFiles(source, id))
+                {
+                    String relative = internal::relativeTo(file.path, source);
+                    if (relative.compare(0, 10, "libraries/") == 0 || relative.compare(0, 7, "assets/") == 0)
+                        files.push_back(std::move(file));
+                }
+
+                std::mutex mutex;
+                std::vector<String> missing;
+                std::size_t present = 0, linked = 0, copied = 0;
+                std::uint64_t bytes = 0;
+                minecraft::internal::parallelFor(files.size(), [&](std::size_t index)
+                                                 {
+                    const fs::path &from = files[index].path;
+                    const String relative = internal::relativeTo(from, source);
+                    const fs::path to = target / relative;
+                    std::error_code fileError;
+                    std::uintmax_t size = fs::file_size(from, fileError);
+                    if (fileError)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        missing.push_back(relative);
+                        return;
+                    }
+                    if (!force && fs::exists(to, fileError))
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        present++;
+                        return;
+                    }
+                    fs::create_directories(to.parent_path(), fileError);
+                    CloneMethod method = minecraft::internal::cloneFile(from, to, true, force);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    (method == CloneMethod::Hardlink ? linked : copied)++;
+                    bytes += size; }, session.options().jobs);
+
+                std::sort(missing.begin(), missing.end());
+                ConfigObject result;
+                result["version"] = id;
+                result["from"] = source.string();
+                result["profiles"] = ConfigObject(std::move(profiles));
+                result["files"] = static_cast<long long>(files.size());
+                result["present"] = static_cast<long long>(present);
+                result["linked"] = static_cast<long long>(linked);
+                result["copied"] = static_cast<long long>(copied);
+                result["bytes"] = static_cast<long long>(bytes);
+                result["missing"] = internal::stringList(missing);
+                return CliReply(result, missing.empty());
+            }
+
+            static Result<CliReply> verifyCommand(CliSession &session, const CliArguments &arguments)
+            {
+                const fs::path indexPath = session.index().getPath();
+                std::vector<String> ids = arguments.operands();
+                if (ids.empty())
+                    ids = internal::listVersions(indexPath);
+                const bool hash = arguments.has("hash");
+
+                struct Check
+                {
+                    String sha1;
+                    int state = 0; // 0 ok, 1 missing, 2 corrupt
+                };
+                std::vector<std::vector<internal::VersionFile>> perVersion(ids.size());
+                std::vector<String> errors(ids.size());
+                std::unordered_map<String, Check> checks;
+                std::vector<String> paths;
+
+                for (std::size_t v = 0; v < ids.size(); v++)
+                {
+                    Result<void> known = internal::checkVersion(indexPath, ids[v]);
+                    if (!known)
+                    {
+                        errors[v] = known.error().detail;
+                        continue;
+                    }
+                    try
+                    {
+                        perVersion[v] = internal::versionFiles(indexPath, ids[v]);
+                    }
+                    catch (const std::exception &e)
+                    {
+                        errors[v] = e.what();
+                        continue;
+                    }
+                    for (const auto &file : perVersion[v])
+                    {
+                        auto inserted = checks.emplace(file.path.string(), Check{file.sha1});
+                        if (inserted.second)
+                            paths.push_back(file.path.string());
+                        else if (inserted.first->second.sha1.empty())
+                            inserted.first->second.sha1 = file.sha1;
+                    }
+                }
+
+                // Every file once, however many versions share it
+                std::atomic<std::size_t> hashed{0};
+                minecraft::internal::parallelFor(paths.size(), [&](std::size_t index)
+                                                 {
+                    Check &check = checks.find(paths[index])->second;
+                    std::error_code ec;
+                    if (!fs::is_regular_file(paths[index], ec))
+                    {
+                        check.state = 1;
+                        return;
+                    }
+                    if (!hash || check.sha1.empty())
+                        return;
+                    String actual = internal::hashFile(paths[index]);
+                    hashed.fetch_add(1, std::memory_order_relaxed);
+                    String expected = check.sha1;
+                    std::transform(expected.begin(), expected.end(), expected.begin(), [](unsigned char c)
+                                   { return static_cast<char>(std::tolower(c)); });
+                    if (actual != expected)
+                        check.state = 2; }, session.options().jobs);
+
+                bool ok = true;
+                ConfigArray versions;
+                for (std::size_t v = 0; v < ids.size(); v++)
+                {
+                    ConfigObject version;
+                    version["id"] = ids[v];
+                    if (!errors[v].empty())
+                    {
+                        version["ok"] = false;
+                        version["error"] = errors[v];
+                        versions.push_back(std::move(version));
+                        ok = false;
+                        continue;
+                    }
+
+                    std::vector<String> missing, corrupt;
+                    for (const auto &file : perVersion[v])
+                    {
+                        int state = checks.find(file.path.string())->second.state;
+                        if (state == 1)
+                            missing.push_back(internal::relativeTo(file.path, indexPath));
+                        else if (state == 2)
+                            corrupt.push_back(internal::relativeTo(file.path, indexPath));
+                    }
+                    version["ok"] = missing.empty() && corrupt.empty();
+                    version["files"] = static_cast<long long>(perVersion[v].size());
+                    version["missing"] = internal::stringList(missing);
+                    version["corrupt"] = internal::stringList(corrupt);
+                    ok = ok && missing.empty() && corrupt.empty();
+                    versions.push_back(std::move(version));
+                }
+
+                ConfigObject result;
+                result["index"] = indexPath.string();
+                result["checked"] = static_cast<long long>(paths.size());
+                result["hashed"] = static_cast<long long>(hashed.load());
+                result["versions"] = ConfigObject(std::move(versions));
+                return CliReply(result, ok);
+            }
+
+            static void verifyText(const ConfigObject &data, String &out)
+            {
+                const ConfigObject &versions = data.at("versions");
+                for (std::size_t i = 0; i < versions.size(); i++)
+                {
+                    const ConfigObject &version = versions.at(i);
+                    const String id = version.at("id").as_string().value_or("");
+                    if (version.has_key("error"))
+                    {
+                        out += "FAIL  " + id + ": " + version.at("error").as_string().value_or("") + "\n";
+                        continue;
+                    }
+                    out += (version.at("ok").as_boolean().value_or(false) ? "ok    " : "FAIL  ") + id + " (" +
+                           std::to_string(version.at("files").as_number().value_or(0)) + " files)\n";
+                    for (const char *kind : {"missing", "corrupt"})
+                    {
+                        const ConfigObject &list = version.at(kind);
+                        for (std::size_t f = 0; f < list.size(); f++)
+                            out += String("      ") + kind + " " + list.at(f).as_string().value_or("") + "\n";
+                    }
+                }
+                out += std::to_string(data.at("checked").as_number().value_or(0)) + " files checked, " +
+                       std::to_string(data.at("hashed").as_number().value_or(0)) + " hashed\n";
+            }
+
+            static Result<CliReply> launchCommand(CliSession &session, const CliArguments &arguments)
+            {
+                const String id = arguments.operands()[0];
+                Result<void> known = internal::checkVersion(session.index().getPath(), id);
+                if (!known)
+                    return known.error();
+
+                LaunchOptions options;
+                Result<void> parsed = internal::parseVariables(arguments, options);
+                if (!parsed)
+                    return parsed.error();
+                Result<JavaInfo> java = internal::javaForVersion(session, id, arguments.value("java"));
+                if (!java)
+                    return java.error();
+
+                Instance instance(session.index(), id);
+                ConfigObject result;
+                result["version"] = id;
+                result["java"] = internal::javaObject(*java);
+
+                if (arguments.has("dry-run"))
+                {
+                    // Whoever runs the command would not commit a CDS dump
+                    options.classDataSharing = false;
+                    instance.prepareNatives();
+                    LaunchCommand command;
+                    instance.buildLaunchCommand(*java, options, command);
+                    result["argv"] = internal::stringList(command.toVector());
+                    return CliReply(result);
+                }
+
+                // Game output goes to stderr in JSON mode, stdout is for results
+                const bool json = session.options().json;
+                auto process = instance.launch(*java, options, [json](ProcessStream stream, std::string_view data)
+                                               {
+                    if (data.empty())
+                        return;
+                    std::FILE *file = json || stream == ProcessStream::Stderr ? stderr : stdout;
+                    std::fwrite(data.data(), 1, data.size(), file);
+                    std::fflush(file); });
+                result["pid"] = process->pid();
+                int status = process->wait();
+                result["exit"] = status;
+                return CliReply(result, status == 0);
+            }
+
+            static Result<CliReply> benchCommand(CliSession &session, const CliArguments &arguments)
+            {
+                const fs::path indexPath = session.index().getPath();
+                const fs::path versionsDir = indexPath / "versions";
+                String id = arguments.operands().empty() ? String() : arguments.operands()[0];
+                if (id.empty())
+                {
+                    std::vector<String> versions = internal::listVersions(indexPath);
+                    if (versions.empty())
+                        return Error(Errc::NOT_FOUND, "No version to benchmark", indexPath.string());
+                    id = versions.front();
+                }
+                Result<void> known = internal::checkVersion(indexPath, id);
+                if (!known)
+                    return known.error();
+                Result<long long> iterations = arguments.number("iterations", 200);
+                if (!iterations)
+                    return iterations.error();
+                if (*iterations < 1)
+                    return Error(Errc::OUT_OF_RANGE, "--iterations must be at least 1");
+
+                std::ifstream file(versionsDir / id / (id + ".json"), std::ios::binary);
+                const String content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                const LaunchFeatures features;
+                const auto chain = minecraft::internal::loadProfileChain(versionsDir, id);
+
+                ConfigArray results;
+                results.push_back(internal::measure("config.parse", *iterations, [&]()
+                                                    {
+                    Config config;
+                    config.try_parse(content).value();
+                    return config.get("id").size(); }));
+                results.push_back(internal::measure("profile.load", *iterations, [&]()
+                                                    { return minecraft::internal::loadProfileChain(versionsDir, id).size(); }));
+                results.push_back(internal::measure("template.compile", *iterations, [&]()
+                                                    { return LaunchTemplate::compile(chain, features)->mainClass().size(); }));
+                results.push_back(internal::measure("template.cached", *iterations, [&]()
+                                                    { return LaunchTemplateCache::shared().get(versionsDir, id, features)->mainClass().size(); }));
+                results.push_back(internal::measure("classpath.resolve", *iterations, [&]()
+                                                    { return minecraft::internal::resolveClasspath(chain, indexPath, id).entries.size(); }));
+                results.push_back(internal::measure("classpath.cached", *iterations, [&]()
+                                                    { return ClasspathCache::shared().get(indexPath, id)->entries.size(); }));
+
+                // Filling reuses the buffers of the command, like repeated launches do
+                auto launchTemplate = LaunchTemplateCache::shared().get(versionsDir, id, features);
+                LaunchVariables variables;
+                variables.set(LaunchSlot::Classpath, ClasspathCache::shared().get(indexPath, id)->value);
+                variables.set(LaunchSlot::AuthPlayerName, "Player");
+                LaunchCommand command;
+                results.push_back(internal::measure("command.fill", *iterations, [&]()
+                                                    {
+                    launchTemplate->fill("java", variables, {}, command);
+                    return command.size(); }));
+
+                if (arguments.has("java"))
+                {
+                    // A search spawns java -version per candidate, a few rounds are plenty
+                    results.push_back(internal::measure("java.search", std::min<long long>(*iterations, 5), []()
+                                                        { return SearchJava$Quick().size(); }));
+                }
+
+                ConfigObject result;
+                result["version"] = id;
+                result["benchmarks"] = ConfigObject(std::move(results));
+                return CliReply(result);
+            }
+
+            static void benchText(const ConfigObject &data, String &out)
+            {
+                out += "version " + data.at("version").as_string().value_or("") + "\n";
+                String header = "benchmark";
+                internal::padTo(header, 20);
+                header += "mean";
+                internal::padTo(header, 32);
+                header += "p50";
+                internal::padTo(header, 44);
+                header += "p99";
+                internal::padTo(header, 56);
+                header += "min";
+                internal::padTo(header, 68);
+                out += header + "allocs\n";
+
+                const ConfigObject &benchmarks = data.at("benchmarks");
+                for (std::size_t i = 0; i < benchmarks.size(); i++)
+                {
+                    const ConfigObject &bench = benchmarks.at(i);
+                    String line = bench.at("name").as_string().value_or("");
+                    internal::padTo(line, 20);
+                    line += internal::formatDuration(bench.at("mean_ns").as_float().value_or(0));
+                    internal::padTo(line, 32);
+                    line += internal::formatDuration(static_cast<double>(bench.at("p50_ns").as_number().value_or(0)));
+                    internal::padTo(line, 44);
+                    line += internal::formatDuration(static_cast<double>(bench.at("p99_ns").as_number().value_or(0)));
+                    internal::padTo(line, 56);
+                    line += internal::formatDuration(static_cast<double>(bench.at("min_ns").as_number().value_or(0)));
+                    internal::padTo(line, 68);
+                    if (bench.has_key("allocations"))
+                    {
+                        char allocations[32];
+                        std::snprintf(allocations, sizeof(allocations), "%.1f", bench.at("allocations").as_float().value_or(0));
+                        line += allocations;
+                    }
+                    else
+                        line += "-";
+                    out += line + "\n";
+                }
+            }
+
+            const std::vector<CliCommand> &Commands()
+            {
+                static const std::vector<CliCommand> commands = {
+                    {"java", "java [--deep] [--refresh]", "List Java installations",
+                     {}, {"deep", "refresh"}, 0, 0, javaCommand, javaText},
+                    {"config", "config <file.cco>...", "Parse and validate config files",
+                     {}, {}, 1, SIZE_MAX, configCommand, configText},
+                    {"install", "install <version> --from <index> [--force]", "Copy a version and its files from another index",
+                     {"from"}, {"force"}, 1, 1, installCommand, nullptr},
+                    {"verify", "verify [<version>...] [--hash]", "Check that versions have every file they launch with",
+                     {}, {"hash"}, 0, SIZE_MAX, verifyCommand, verifyText},
+                    {"launch", "launch <version> [--java <home>] [--var name=value]... [--jvm-arg <arg>]... [--dry-run]",
+                     "Launch a version and wait for it to exit",
+                     {"java", "var", "jvm-arg"}, {"dry-run"}, 1, 1, launchCommand, nullptr},
+                    {"bench", "bench [<version>] [--iterations <n>] [--java]", "Time the launch pipeline of a version",
+                     {"iterations"}, {"java"}, 0, 1, benchCommand, benchText},
+                };
+                return commands;
+            }
+        } // namespace cli
+    } // namespace minecraft
+
+} // namespace cnt
@@ -0,0 +1,143 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/backup.hpp
+ * @Description: Incremental deduplicating backups of instance directories
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__BACKUP_HPP__
+#define __MINECRAFT_ENGINE__BACKUP_HPP__
+
+#include <minecraft/cntconfig.hpp>
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        struct BackupOptions
+        {
+            // Relative paths (files or directories) left out of the backup
+            std::vector<String> exclude = {"logs", "crash-reports", ".fabric", "natives"};
+
+            // Deflate chunks that shrink, stored as is otherwise
+            bool compress = true;
+
+            // Worker threads for hashing and compression, 0 means hardware_concurrency
+            unsigned int threads = 0;
+        };
+
+        struct BackupStats
+        {
+            String snapshot;
+            std::size_t files = 0;
+            std::size_t unchangedFiles = 0; // reused from the previous snapshot without reading
+            std::size_t chunks = 0;
+            std::size_t newChunks = 0;
+            std::uint64_t totalBytes = 0;   // size of all files
+            std::uint64_t readBytes = 0;    // read from changed files
+            std::uint64_t writtenBytes = 0; // written to the chunk store
+        };
+
+        struct BackupFile
+        {
+            String path; // relative, with '/' separators
+            std::uint64_t size = 0;
+            std::int64_t mtime = 0; // nanoseconds
+            std::uint64_t inode = 0;
+            std::uint32_t mode = 0;
+            std::vector<std::array<std::uint8_t, 20>> chunks;
+        };
+
+        /**
+         * Content addressed store of backups
+         * Files are cut into chunks with content-defined (FastCDC) boundaries,
+         * so an edit only changes the chunks around it, and every chunk is
+         * stored once by its SHA-1. A snapshot is a manifest of files and their
+         * chunks; files whose size, mtime and inode match the previous snapshot
+         * of the same name are taken from it without being read.
+         *
+         * <root>/chunks/<2 hex>/<40 hex>        1 byte method (0 stored, 8 deflate) + data
+         * <root>/snapshots/<name>/<time>.manifest
+         */
+        class BackupStore
+        {
+        private:
+            fs::path _root;
+
+            fs::path _chunkPath(const std::array<std::uint8_t, 20> &hash) const;
+
+        public:
+            explicit BackupStore(fs::path root);
+
+            const fs::path &root() const { return _root; }
+
+            /**
+             * Back up a directory as a new snapshot of name
+             * @param source Directory to back up, e.g. an instance
+             * @param name Snapshot series, e.g. the instance name
+             * @return Snapshot id ("<name>/<time>") and what was written
+             */
+            BackupStats backup(const fs::path &source, const String &name, const BackupOptions &options = {});
+
+            // Snapshot ids of a series, oldest first
+            std::vector<String> snapshots(const String &name) const;
+
+            // Files of a snapshot
+            std::vector<BackupFile> files(const String &snapshot) const;
+
+            /**
+             * Restore a snapshot into a directory, overwriting files with the same path
+             * @param threads Worker threads, 0 means hardware_concurrency
+             */
+            void restore(const String &snapshot, const fs::path &target, unsigned int threads = 0) const;
+
+            // Delete snapshots of a series except the newest keep
+            void prune(const String &name, std::size_t keep);
+
+            // Delete chunks no snapshot refers to
+            std::size_t collectGarbage();
+        };
+
+        namespace internal
+        {
+            /**
+             * Length of the next content-defined chunk (FastCDC with normalized chunking)
+             * @return Between the minimum and maximum chunk size, or size if smaller
+             */
+            std::size_t nextChunkBoundary(const std::uint8_t *data, std::size_t size);
+
+            // Parse and write the manifest format
+            std::vector<BackupFile> parseBackupManifest(const String &text);
+            String formatBackupManifest(const std::vector<BackupFile> &files);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/backup.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__BACKUP_HPP__
@@ -0,0 +1,139 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/cache.hpp
+ * @Description: Persistent key-value cache store in a single memory-mapped file
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__CACHE_HPP__
+#define __MINECRAFT_ENGINE__CACHE_HPP__
+
+#include <minecraft/cntconfig.hpp>
+#include <minecraft/lib/result.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        struct CacheStoreStats
+        {
+            std::uint64_t fileBytes = 0;   // Bytes of the log in use
+            std::uint64_t liveBytes = 0;   // Bytes of the latest record of every key
+            std::uint64_t liveRecords = 0; // Keys with a value, expired ones included until compaction
+        };
+
+        /**
+         * Embedded key-value store shared by the caches of the engine
+         * Records are appended to one log file and checked with a CRC-32, so a
+         * crash leaves at most a torn tail that is cut on the next write. The file
+         * is mapped for reads and each handle keeps a hash index of the latest
+         * record of every key, caught up lazily when other processes append.
+         * Writers of every process are serialized by a lock on <path>.lock; once
+         * the log is mostly dead records it is compacted into a new file, which
+         * readers notice through a flag in the old one.
+         * Keys live in namespaces, each with its own time to live.
+         * A handle is thread safe.
+         */
+        class CacheStore
+        {
+        private:
+            fs::path _path;
+            int _fd = -1;
+            int _lockFd = -1;
+            std::uint8_t *_data = nullptr;
+            std::size_t _mapped = 0;
+
+            mutable std::shared_mutex _mutex;
+            std::unordered_map<String, std::uint64_t> _index; // namespace '\0' key -> record offset
+            std::unordered_map<String, std::chrono::seconds> _ttl;
+            std::uint64_t _indexed = 0;
+            std::uint64_t _liveBytes = 0;
+
+            Result<void> _openFile();
+            void _closeFile();
+            bool _current() const;
+            Result<void> _sync(bool writer);
+            std::uint64_t _scan(std::uint64_t end);
+            Result<void> _append(std::string_view ns, std::string_view key, std::string_view value, bool erase);
+            Result<void> _compact();
+
+        public:
+            CacheStore() = default;
+            ~CacheStore();
+            CacheStore(const CacheStore &) = delete;
+            CacheStore &operator=(const CacheStore &) = delete;
+
+            /**
+             * Store shared by the engine caches, in $XDG_CACHE_HOME/minecraft-engine/store.kv
+             * (or the platform equivalent). If it cannot be opened every lookup
+             * misses and writes are dropped.
+             */
+            static CacheStore &shared();
+
+            /**
+             * Open or create a store file
+             * @param path Log file, <path>.lock is created next to it
+             */
+            Result<void> open(const fs::path &path);
+
+            bool isOpen() const;
+
+            // Time to live of records written to a namespace from now on, zero keeps them forever
+            void setTtl(std::string_view ns, std::chrono::seconds ttl);
+
+            // Latest value of a key, nothing if it is missing or expired
+            std::optional<String> get(std::string_view ns, std::string_view key);
+
+            Result<void> put(std::string_view ns, std::string_view key, std::string_view value);
+            Result<void> erase(std::string_view ns, std::string_view key);
+
+            // Rewrite the log with only live records, done automatically when it is mostly dead
+            Result<void> compact();
+
+            // Flush appended records to disk; without it a crash may lose the latest writes
+            Result<void> flush();
+
+            CacheStoreStats stats();
+        };
+
+        namespace internal
+        {
+            // Default location of the shared cache store
+            fs::path defaultCacheStorePath();
+
+            // Cache key of a file's contents: path, size and modification time
+            String fileCacheKey(const fs::path &file);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/cache.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__CACHE_HPP__
@@ -0,0 +1,86 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/cds.hpp
+ * @Description: Dynamic class data sharing (AppCDS) archives per runtime and classpath
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__CDS_HPP__
+#define __MINECRAFT_ENGINE__CDS_HPP__
+
+#include <minecraft/cntconfig.hpp>
+#include <minecraft/java.hpp>
+#include <minecraft/classpath.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        struct CdsPlan
+        {
+            // JVM arguments to add, empty when the runtime cannot use dynamic archives
+            std::vector<String> arguments;
+
+            // Final location of the archive
+            fs::path archive;
+
+            // Where the JVM dumps a new archive on exit, empty when reusing one
+            fs::path pending;
+
+            bool dumping() const { return !pending.empty(); }
+        };
+
+        /**
+         * Plan class data sharing for a launch
+         * Archives are keyed by the Java runtime (path, version, runtime image)
+         * and the classpath (entries, their sizes and mtimes), so changing either
+         * starts a new archive. The first launch dumps the loaded classes at exit
+         * (-XX:ArchiveClassesAtExit, Java 13+), later launches map the archive
+         * (-XX:SharedArchiveFile).
+         * @param java Runtime of the launch
+         * @param classpath Resolved classpath of the launch
+         * @param directory Directory holding the archives
+         */
+        CdsPlan PlanCdsArchive(const JavaInfo &java, const Classpath &classpath, const fs::path &directory);
+
+        /**
+         * Publish the archive dumped by a launch, call once the process exited
+         * The archive only replaces the pending one after a clean exit, a crashed
+         * JVM may leave a partial file behind which is removed.
+         */
+        void CommitCdsArchive(const CdsPlan &plan, int exitCode);
+
+        namespace internal
+        {
+            // Cache key of a runtime and classpath pair
+            std::uint64_t cdsArchiveKey(const JavaInfo &java, const Classpath &classpath);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/cds.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__CDS_HPP__
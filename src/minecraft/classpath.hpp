@@ -0,0 +1,120 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/classpath.hpp
+ * @Description: Resolves, dedupes and caches the classpath of a profile
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__CLASSPATH_HPP__
+#define __MINECRAFT_ENGINE__CLASSPATH_HPP__
+
+#include <minecraft/cntconfig.hpp>
+#include <minecraft/lib/config.hpp>
+#include <minecraft/launch.hpp>
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        struct Classpath
+        {
+            // Joined classpath, entries separated by the platform separator
+            String value;
+
+            // Resolved entries in classpath order, the client jar is last
+            std::vector<fs::path> entries;
+
+            // Hash of the resolved entries, stable across runs
+            std::uint64_t hash = 0;
+        };
+
+        // Resolved classpaths keyed by profile
+        class ClasspathCache
+        {
+        private:
+            internal::ProfileCache<Classpath> _cache{"classpath"};
+
+        public:
+            static ClasspathCache &shared();
+
+            /**
+             * Get the resolved classpath of a profile, resolving it again only if
+             * the profile (or a profile it inherits from) changed on disk
+             * @param indexPath Root of the index
+             * @param id Profile id
+             */
+            std::shared_ptr<const Classpath> get(const fs::path &indexPath, const String &id);
+
+            void clear();
+        };
+
+        namespace internal
+        {
+            // Maven coordinate "group:artifact:version[:classifier][@extension]"
+            struct MavenName
+            {
+                String group;
+                String artifact;
+                String version;
+                String classifier;
+                String extension = "jar";
+
+                // group:artifact[:classifier], the identity used for deduplication
+                String key() const;
+
+                // Repository-relative path of the artifact
+                fs::path path() const;
+            };
+
+            MavenName parseMavenName(const String &name);
+
+            // Compare Maven versions segment by segment, numeric segments numerically
+            int compareMavenVersions(std::string_view a, std::string_view b);
+
+            // 64-bit FNV-1a
+            std::uint64_t fnv1a64(std::string_view data, std::uint64_t seed = 14695981039346656037ull);
+
+            // Resolve the classpath of a loaded profile chain (root first)
+            Classpath resolveClasspath(const std::vector<std::unique_ptr<Config>> &chain, const fs::path &indexPath, const String &id);
+        }
+
+        /**
+         * Write a Java 9+ argument file holding "-cp <classpath>"
+         * The file is named after the classpath hash and only written once.
+         * @param classpath Resolved classpath
+         * @param directory Directory to store argument files in
+         * @return Path of the argument file, pass it as "@<path>"
+         */
+        fs::path WriteClasspathArgFile(const Classpath &classpath, const fs::path &directory);
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/classpath.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__CLASSPATH_HPP__
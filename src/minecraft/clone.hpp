@@ -0,0 +1,102 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/clone.hpp
+ * @Description: Fast directory tree cloning (reflink, hardlink, copy_file_range)
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__CLONE_HPP__
+#define __MINECRAFT_ENGINE__CLONE_HPP__
+
+#include <minecraft/cntconfig.hpp>
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <functional>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        // How a single file ended up in the destination tree
+        enum class CloneMethod
+        {
+            Reflink,   // ioctl(FICLONE), shares extents on CoW filesystems
+            Hardlink,  // link(), only used for immutable content
+            CopyRange, // copy_file_range(), in-kernel copy
+            Copy       // plain read/write fallback
+        };
+
+        struct CloneOptions
+        {
+            // Top-level entries whose files never change once written
+            // (libraries, assets); these are hardlinked instead of copied
+            std::vector<String> immutableDirs = {"libraries", "assets"};
+
+            // Concurrent walkers on the IO pool of the shared Scheduler including the caller, 0 means every IO worker
+            unsigned int threads = 0;
+
+            // Replace files that already exist in the destination
+            bool overwrite = false;
+
+            // Optional filter, return false to skip an entry (path is relative to the source root)
+            std::function<bool(const fs::path &)> filter;
+
+            // Optional rename hook for files (path is relative to the source root)
+            std::function<fs::path(const fs::path &)> rename;
+        };
+
+        struct CloneStats
+        {
+            std::size_t directories = 0;
+            std::size_t files = 0;
+            std::size_t symlinks = 0;
+            std::size_t reflinked = 0;
+            std::size_t hardlinked = 0;
+            std::size_t copied = 0;
+            std::uint64_t bytes = 0;
+        };
+
+        namespace internal
+        {
+            // Clone a single regular file, trying the cheapest method first
+            CloneMethod cloneFile(const fs::path &from, const fs::path &to, bool immutable, bool overwrite);
+        }
+
+        /**
+         * Clone a directory tree using the cheapest method available per file
+         * Immutable content is hardlinked, everything else is reflinked on CoW
+         * filesystems and copied with copy_file_range otherwise. Directories are
+         * traversed in parallel.
+         * @param from Source directory
+         * @param to Destination directory, created if missing
+         * @param options Clone options
+         * @return Statistics about the clone
+         */
+        CloneStats CloneTree(const fs::path &from, const fs::path &to, const CloneOptions &options = CloneOptions());
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/clone.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__CLONE_HPP__
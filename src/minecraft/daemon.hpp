@@ -0,0 +1,259 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/daemon.hpp
+ * @Description: Long-running engine daemon serving warm launches over a Unix socket
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__DAEMON_HPP__
+#define __MINECRAFT_ENGINE__DAEMON_HPP__
+
+#include <minecraft/cntconfig.hpp>
+#include <minecraft/instance.hpp>
+#include <minecraft/lib/result.hpp>
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <utility>
+#include <string_view>
+#include <shared_mutex>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        /**
+         * Wire protocol
+         * Every message is a frame: a little-endian u32 body length, then the body.
+         * A request body starts with its DaemonOp, a response body with a status
+         * byte, 0 for success or 1 + Errc followed by the error message.
+         * Strings are a u32 length and the bytes, lists a u32 count and the items.
+         */
+        enum class DaemonOp : std::uint8_t
+        {
+            Ping,            // -> u32 protocol version
+            ListVersions,    // -> list of version ids
+            ResolveJava,     // instance, u32 minimum major (0 from the profile) -> JavaInfo
+            PrepareInstance, // instance, java path (empty resolves), variables -> argv
+            Launch,          // instance, java path (empty resolves), variables -> u32 pid
+            Refresh,         // u8 deep Java search -> u32 Java installations
+            Shutdown         // -> nothing, the daemon stops after answering
+        };
+
+        constexpr std::uint32_t DaemonProtocolVersion = 1;
+
+        // ${name} launch variables sent with PrepareInstance and Launch
+        using DaemonVariables = std::vector<std::pair<String, String>>;
+
+        struct DaemonOptions
+        {
+            // Path of the Unix socket, a stale socket left by a dead daemon is replaced.
+            // It is created with mode 0600 and connections from other users are refused
+            fs::path socket;
+
+            // Root of the index whose versions are served
+            fs::path index;
+
+            // Search Java with SearchJava$Deep instead of SearchJava$Quick
+            bool deepJavaSearch = false;
+
+            // Compile the launch template and classpath of every version at startup
+            bool warmProfiles = true;
+
+            // Connections served at once, further ones are closed right away
+            unsigned int maxClients = 32;
+        };
+
+        /**
+         * Keeps the Java registry, the version list and the compiled profiles of an
+         * index in memory and serves them over a Unix socket, so a launcher front
+         * end pays the discovery and parsing cost once instead of per invocation.
+         * Each connection is served by its own thread; requests on one connection
+         * are answered in order.
+         */
+        class EngineDaemon
+        {
+        private:
+            struct Client
+            {
+                int fd = -1;
+                std::thread thread;
+                std::atomic<bool> done{false};
+            };
+
+            DaemonOptions _options;
+            Index _index;
+            fs::path _versionsDir;
+            int _listen = -1;
+            int _wakeup = -1;
+            std::atomic<bool> _stopping{false};
+
+            mutable std::shared_mutex _javaMutex;
+            JavaList _java;
+
+            std::mutex _versionsMutex;
+            std::vector<String> _versions;
+            fs::file_time_type _versionsStamp;
+
+            std::mutex _clientsMutex;
+            std::vector<std::unique_ptr<Client>> _clients;
+
+            void _serveClient(Client &client);
+            String _handle(std::string_view request);
+            void _refreshJava(bool deep);
+            void _warm();
+            std::vector<String> _listVersions();
+            Result<JavaInfo> _resolveJava(const String &instance, int major);
+            Result<Instance> _instance(const String &name);
+
+        public:
+            /**
+             * Bind the socket and load the Java registry and version list
+             * @param options Socket path, index and warm-up options
+             */
+            explicit EngineDaemon(DaemonOptions options);
+
+            // Stops serving, closes every connection and removes the socket
+            ~EngineDaemon();
+
+            EngineDaemon(const EngineDaemon &) = delete;
+            EngineDaemon &operator=(const EngineDaemon &) = delete;
+
+            // Accept and serve connections until stop() or a Shutdown request
+            void serve();
+
+            // Make serve() return, safe to call from any thread
+            void stop();
+        };
+
+        /**
+         * Connection to an EngineDaemon
+         * Calls block until the daemon answers; failures of the daemon are
+         * returned as errors, only a broken connection throws.
+         */
+        class DaemonClient
+        {
+        private:
+            int _fd = -1;
+
+            Result<String> _call(const String &request);
+
+        public:
+            // Connect to the daemon listening on socket
+            explicit DaemonClient(const fs::path &socket);
+            ~DaemonClient();
+
+            DaemonClient(const DaemonClient &) = delete;
+            DaemonClient &operator=(const DaemonClient &) = delete;
+
+            // Protocol version of the daemon
+            Result<std::uint32_t> ping();
+
+            Result<std::vector<String>> listVersions();
+
+            /**
+             * Java runtime for an instance
+             * @param instance Version id
+             * @param major Minimum major version, 0 takes it from the profile (javaVersion.majorVersion)
+             */
+            Result<JavaInfo> resolveJava(const String &instance, int major = 0);
+
+            /**
+             * Prepare natives and build the launch command of an instance
+             * @param java Java home, empty lets the daemon resolve one
+             * @return The argv of the game process
+             */
+            Result<std::vector<String>> prepare(const String &instance, const fs::path &java = {}, const DaemonVariables &variables = {});
+
+            /**
+             * Launch an instance from the daemon, its process is supervised there
+             * @return Pid of the game process
+             */
+            Result<int> launch(const String &instance, const fs::path &java = {}, const DaemonVariables &variables = {});
+
+            // Search Java again and drop cached profiles, returns the Java installations found
+            Result<std::uint32_t> refresh(bool deep = false);
+
+            Result<void> shutdown();
+        };
+
+        namespace internal
+        {
+            // Builds a frame: the length prefix is patched in by finish()
+            class DaemonWriter
+            {
+            private:
+                String _buffer;
+
+            public:
+                DaemonWriter() : _buffer(4, '\0') {}
+
+                void u8(std::uint8_t value) { _buffer.push_back(static_cast<char>(value)); }
+                void u32(std::uint32_t value);
+                void string(std::string_view value);
+                void strings(const std::vector<String> &values);
+
+                String &finish();
+            };
+
+            // Reads a frame body; past the end every read returns zero and ok() turns false
+            class DaemonReader
+            {
+            private:
+                std::string_view _data;
+                bool _ok = true;
+
+            public:
+                explicit DaemonReader(std::string_view data) : _data(data) {}
+
+                std::uint8_t u8();
+                std::uint32_t u32();
+                std::string_view string();
+                std::vector<String> strings();
+
+                bool ok() const { return _ok; }
+                bool done() const { return _data.empty(); }
+            };
+
+            // Largest frame either side accepts
+            constexpr std::uint32_t DaemonMaxFrame = 1u << 20;
+
+            // Send a finished frame, false if the connection is gone
+            bool sendDaemonFrame(int fd, const String &frame);
+
+            // Receive the body of the next frame, false on end of stream or a bad length
+            bool receiveDaemonFrame(int fd, String &body);
+
+            // Best installation for a major version: an exact match, else the closest newer one
+            const JavaInfo *selectJava(const JavaList &java, int major);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/daemon.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__DAEMON_HPP__
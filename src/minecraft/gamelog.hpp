@@ -0,0 +1,121 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/gamelog.hpp
+ * @Description: Streams game output into log records (Log4j2 XML events and plain lines)
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__GAMELOG_HPP__
+#define __MINECRAFT_ENGINE__GAMELOG_HPP__
+
+#include <minecraft/cntconfig.hpp>
+#include <minecraft/process.hpp>
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        enum class GameLogLevel : std::uint8_t
+        {
+            Unknown,
+            Trace,
+            Debug,
+            Info,
+            Warn,
+            Error,
+            Fatal
+        };
+
+        // A parsed record, views point into the stream buffer and are only valid
+        // during the subscriber call
+        struct GameLogRecord
+        {
+            ProcessStream stream = ProcessStream::Stdout;
+            GameLogLevel level = GameLogLevel::Unknown;
+            bool structured = false;      // Parsed from a <log4j:Event>
+            std::int64_t timestamp = 0;   // Milliseconds since epoch, 0 for plain lines
+            std::string_view thread;
+            std::string_view logger;
+            std::string_view message;     // Raw text, XML entities outside CDATA are not decoded
+            std::string_view throwable;
+        };
+
+        using GameLogSubscriber = std::function<void(const GameLogRecord *records, std::size_t count)>;
+
+        class GameLogStream
+        {
+        private:
+            // Fixed capacity buffer per stream, consumed bytes are reclaimed by
+            // moving the unparsed tail to the front before new data is appended
+            struct Channel
+            {
+                std::unique_ptr<char[]> data;
+                std::size_t begin = 0;
+                std::size_t end = 0;
+            };
+
+            std::size_t _capacity;
+            std::size_t _batchSize;
+            std::array<Channel, 2> _channels;
+            std::vector<GameLogRecord> _batch;
+            std::vector<GameLogSubscriber> _subscribers;
+
+            void _parse(ProcessStream stream, bool final);
+            void _deliver();
+
+        public:
+            /**
+             * @param capacity Buffer size per stream, the longest record that is kept whole
+             * @param batchSize Records delivered to subscribers per call at most
+             */
+            explicit GameLogStream(std::size_t capacity = 1 << 20, std::size_t batchSize = 256);
+
+            // Register a subscriber, must happen before data is fed
+            void subscribe(GameLogSubscriber subscriber);
+
+            // Feed a chunk of process output, an empty chunk marks the end of the stream
+            void feed(ProcessStream stream, std::string_view data);
+
+            // Output handler feeding a shared stream, for Instance::launch
+            static ProcessOutputHandler bind(std::shared_ptr<GameLogStream> stream);
+        };
+
+        namespace internal
+        {
+            GameLogLevel parseGameLogLevel(std::string_view name);
+
+            // Value of attribute name="..." inside an XML start tag
+            std::string_view findXmlAttribute(std::string_view tag, std::string_view name);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/gamelog.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__GAMELOG_HPP__
@@ -0,0 +1,114 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/host.hpp
+ * @Description: Host memory and CPU resources, including cgroup limits
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__HOST_HPP__
+#define __MINECRAFT_ENGINE__HOST_HPP__
+
+#include <minecraft/cntconfig.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        struct HostResources
+        {
+            // Physical memory and what the kernel reports as available, in bytes
+            std::uint64_t totalMemory = 0;
+            std::uint64_t availableMemory = 0;
+
+            // Memory limit of our cgroup (v1 or v2), 0 if unlimited
+            std::uint64_t memoryLimit = 0;
+
+            // Online CPUs usable by this process (affinity mask applied)
+            unsigned int cpus = 1;
+
+            // CPU quota of our cgroup in cores, 0 if unlimited
+            double cpuQuota = 0;
+
+            // Explicit huge pages (hugetlbfs) that are free, and their size
+            std::uint64_t hugePagesFree = 0;
+            std::uint64_t hugePageSize = 0;
+
+            // Transparent huge pages are set to "always" or "madvise"
+            bool transparentHugePages = false;
+
+            // Memory this process may use: the tighter of physical memory and the cgroup limit
+            std::uint64_t effectiveMemory() const;
+
+            // CPUs this process may use: the tighter of the CPU count and the cgroup quota
+            unsigned int effectiveCpus() const;
+
+            /**
+             * Read the resources of this host from /proc, /sys and the cgroup
+             * filesystem (or the platform equivalents)
+             */
+            static HostResources detect();
+        };
+
+        // Live load signals, sampled on demand
+        struct HostLoad
+        {
+            // Pressure stall information ("some" avg10, percent of time stalled),
+            // all zero when the kernel has no PSI
+            bool hasPressure = false;
+            double cpuPressure = 0;
+            double ioPressure = 0;
+            double memoryPressure = 0;
+
+            // Runnable tasks right now, and averaged over one minute
+            unsigned int runQueue = 0;
+            double loadAverage = 0;
+
+            static HostLoad sample();
+        };
+
+        namespace internal
+        {
+            // "some avg10" of a /proc/pressure file, negative if missing
+            double parsePressureSome(std::string_view text);
+
+            // Value of a "Key:   1234 kB" line of /proc/meminfo in bytes (or a plain count), 0 if missing
+            std::uint64_t parseMeminfoValue(std::string_view meminfo, std::string_view key);
+
+            // cgroup v2 "cpu.max" ("max 100000" or "<quota> <period>") in cores, 0 if unlimited
+            double parseCgroupCpuMax(std::string_view text);
+
+            // cgroup memory limit file ("max" or bytes), 0 if unlimited
+            std::uint64_t parseCgroupMemoryLimit(std::string_view text);
+
+            // Contents of a small pseudo file, empty if it cannot be read
+            String readSmallFile(const fs::path &path);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/host.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__HOST_HPP__
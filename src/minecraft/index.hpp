@@ -26,6 +26,7 @@
 
 #include <minecraft/cntconfig.hpp>
 #include <minecraft/lib/config.hpp>
+#include <minecraft/clone.hpp>
 
 namespace cnt
 {
@@ -39,10 +40,22 @@ namespace cnt
             cnt::Config _meic_config;
         public:
             Index(fs::path _) : path(_) { _init(); }
+
+            const fs::path &getPath() const { return path; }
+
+            /**
+             * Populate this index from another one (e.g. a template)
+             * Libraries and assets are hardlinked, everything else is reflinked
+             * where the filesystem supports it. meic.cco of this index is kept.
+             * @param other Source index
+             * @return Statistics about the clone
+             */
+            CloneStats cloneFrom(const Index &other);
         
         private:
             void _init();
             void _create_meic();
+            void _migrate_meic();
         };
     } // namespace minecraft
     
@@ -26,6 +26,15 @@
 
 #include <minecraft/cntconfig.hpp>
 #include <minecraft/index.hpp>
+#include <minecraft/java.hpp>
+#include <minecraft/launch.hpp>
+#include <minecraft/classpath.hpp>
+#include <minecraft/process.hpp>
+#include <minecraft/natives.hpp>
+#include <minecraft/mods.hpp>
+#include <minecraft/tuning.hpp>
+#include <minecraft/cds.hpp>
+#include <minecraft/region.hpp>
 
 namespace cnt
 {
@@ -35,17 +44,99 @@ namespace cnt
         private:
             String name;
             String description;
-            Index _father_path;
+            fs::path _father_path;
+            fs::path path;
             
         public:
-            Instance(String _name) : name(_name) { _init(); }
+            Instance(const Index &index, String _name) : name(_name), _father_path(index.getPath()) { _init(); }
+
+            const String &getName() const { return name; }
+            const fs::path &getPath() const { return path; }
+            const fs::path &getIndexPath() const { return _father_path; }
+
+            /**
+             * Clone this instance under a new name in the same index
+             * Files named after the instance (<name>.json, <name>.jar) are renamed.
+             * @param newName Name of the new instance
+             * @return The new instance
+             */
+            Instance cloneTo(const String &newName) const;
+
+            /**
+             * Clone this instance into another index
+             * @param index Target index
+             * @param newName Name of the new instance
+             * @return The new instance
+             */
+            Instance cloneTo(const Index &index, const String &newName) const;
+
+            /**
+             * Build the command line used to start this instance
+             * The compiled template of the profile is cached, slots that are not
+             * set in options are filled with defaults derived from the instance.
+             * @param java Java runtime to launch with
+             * @param options Launch options
+             * @param out Output command, its buffers are reused between calls
+             * @param cds Receives the class data sharing plan of the command, if any
+             */
+            void buildLaunchCommand(const JavaInfo &java, const LaunchOptions &options, LaunchCommand &out, CdsPlan *cds = nullptr) const;
+
+            /**
+             * Make the native libraries of this instance available in <instance>/natives
+             * Jars are extracted once into the shared store of the index, warm calls
+             * only compare cache keys.
+             * @return Natives directory
+             */
+            fs::path prepareNatives() const;
+
+            /**
+             * Metadata of the mods installed in <instance>/mods
+             * Results are cached per jar, see ModScanner.
+             */
+            std::vector<std::shared_ptr<const ModInfo>> mods() const;
+
+            /**
+             * Plan JVM options for this instance on this host
+             * Whether the instance is modded, and how heavily, is taken from its
+             * mods directory; pass the result's arguments as LaunchOptions::jvmArgs.
+             * @param java Java runtime to launch with
+             * @param options Planner options, server and concurrency are up to the caller
+             */
+            JvmPlan planJvm(const JavaInfo &java, JvmPlanOptions options = {}) const;
+
+            /**
+             * Compact the region files of every world of this instance
+             * Covers saves/ of clients and the world directories of servers.
+             * The instance must not be running.
+             */
+            RegionCompactStats compactWorlds(const RegionCompactOptions &options = {}) const;
+
+            /**
+             * Launch this instance
+             * Natives are prepared unless options set the natives directory.
+             * The process runs in the instance directory and is supervised by the
+             * shared process reactor, its output is passed to the handler.
+             * @param java Java runtime to launch with
+             * @param options Launch options
+             * @param output Output handler, called on the reactor thread
+             * @return Handle of the running game process
+             */
+            std::shared_ptr<GameProcess> launch(const JavaInfo &java, const LaunchOptions &options, ProcessOutputHandler output = nullptr) const;
 
         private:
+            Instance(const fs::path &indexPath, String _name) : name(_name), _father_path(indexPath) { _init(); }
+
+            Instance _clone(const fs::path &indexPath, const String &newName) const;
+
             void _init();
         };
     } // namespace minecraft
     
 } // namespace cnt
 
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/instance.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
 
 #endif // !__MINECRAFT_ENGINE__INSTANCE_HPP__
\ No newline at end of file
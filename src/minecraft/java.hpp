@@ -25,6 +25,8 @@
 #define __MINECRAFT_ENGINE__JAVA_HPP__
 
 #include <minecraft/cntconfig.hpp>
+#include <minecraft/lib/result.hpp>
+#include <minecraft/lib/memory.hpp>
 
 #include <vector>
 #include <string>
@@ -63,6 +65,12 @@ namespace cnt {
             JavaInfo(String _$name, String _$publisher, String _$structure, fs::path _$path);
             JavaInfo(String _$name, String _$publisher, String _$structure, fs::path _$path, std::string _$version);
             
+            // Path to the java launcher inside the installation
+            fs::path executable() const;
+
+            // Feature release number ("1.8.0_292" -> 8, "17.0.2" -> 17), 0 if unknown
+            int majorVersion() const;
+
             // Operator to compare JavaInfo objects
             bool operator==(const JavaInfo& other) const;
             
@@ -72,7 +80,7 @@ namespace cnt {
             }
         };
 
-        typedef std::vector<JavaInfo> JavaList;
+        typedef std::vector<JavaInfo, TaggedAllocator<JavaInfo, MemoryTag::JAVA>> JavaList;
 
         namespace internal {
             // Helper function to check if a path is a valid Java executable
@@ -89,6 +97,9 @@ namespace cnt {
             
             // Helper function to scan directory for Java installations
             void scanDirectoryForJava(const fs::path& directory, JavaList& result, bool recursive = false);
+
+            // Non-throwing scan; installations found before an error are kept in result
+            Result<void> tryScanDirectoryForJava(const fs::path& directory, JavaList& result, bool recursive = false);
             
             // Helper to convert Windows TCHAR to std::string
             #ifdef _WIN32
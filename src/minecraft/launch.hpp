@@ -0,0 +1,345 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/launch.hpp
+ * @Description: Builds the JVM command line from precompiled argument templates
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__LAUNCH_HPP__
+#define __MINECRAFT_ENGINE__LAUNCH_HPP__
+
+#include <minecraft/cntconfig.hpp>
+#include <minecraft/lib/config.hpp>
+#include <minecraft/lib/memory.hpp>
+#include <minecraft/lib/metrics.hpp>
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        // Variables that may appear as ${...} in version JSON arguments
+        enum class LaunchSlot : std::uint8_t
+        {
+            AuthPlayerName,
+            AuthUuid,
+            AuthAccessToken,
+            AuthSession,
+            AuthXuid,
+            ClientId,
+            UserType,
+            UserProperties,
+            VersionName,
+            VersionType,
+            GameDirectory,
+            AssetsRoot,
+            AssetsIndexName,
+            GameAssets,
+            Classpath,
+            ClasspathSeparator,
+            NativesDirectory,
+            LibraryDirectory,
+            LauncherName,
+            LauncherVersion,
+            ResolutionWidth,
+            ResolutionHeight,
+            QuickPlayPath,
+            QuickPlaySingleplayer,
+            QuickPlayMultiplayer,
+            QuickPlayRealms,
+            LoggingPath, // ${path} of the logging argument
+            Count
+        };
+
+        // Feature flags referenced by argument rules
+        struct LaunchFeatures
+        {
+            bool isDemoUser = false;
+            bool hasCustomResolution = false;
+            bool hasQuickPlaysSupport = false;
+            bool isQuickPlaySingleplayer = false;
+            bool isQuickPlayMultiplayer = false;
+            bool isQuickPlayRealms = false;
+
+            std::uint32_t mask() const;
+        };
+
+        // Values for the template slots of one launch
+        class LaunchVariables
+        {
+        private:
+            std::array<String, static_cast<std::size_t>(LaunchSlot::Count)> _values;
+
+        public:
+            void set(LaunchSlot slot, String value) { _values[static_cast<std::size_t>(slot)] = std::move(value); }
+            const String &get(LaunchSlot slot) const { return _values[static_cast<std::size_t>(slot)]; }
+            bool has(LaunchSlot slot) const { return !get(slot).empty(); }
+        };
+
+        // A filled argv, all arguments live in one buffer
+        class LaunchCommand
+        {
+        private:
+            String _buffer;
+            std::vector<std::uint32_t> _offsets;
+            std::vector<char *> _argv;
+
+            friend class LaunchTemplate;
+
+        public:
+            // Null-terminated argv suitable for exec/posix_spawn
+            char *const *argv() const { return _argv.data(); }
+            std::size_t size() const { return _offsets.size(); }
+            std::string_view operator[](std::size_t index) const { return std::string_view(_argv[index]); }
+            std::vector<String> toVector() const;
+        };
+
+        class LaunchTemplate
+        {
+        private:
+            // A literal segment of _literals, or a variable slot
+            struct Piece
+            {
+                std::uint32_t offset;
+                std::uint32_t length;
+                LaunchSlot slot; // LaunchSlot::Count for literals
+            };
+
+            // One argv entry made of consecutive pieces
+            struct Argument
+            {
+                std::uint32_t first;
+                std::uint32_t count;
+            };
+
+            // Template storage lives as long as the cache, accounted under MemoryTag::MANIFEST
+            using ArgumentList = TaggedVector<Argument, MemoryTag::MANIFEST>;
+
+            TaggedString<MemoryTag::MANIFEST> _literals;
+            TaggedVector<Piece, MemoryTag::MANIFEST> _pieces;
+            ArgumentList _jvm;
+            ArgumentList _game;
+
+            // logging.client.argument, only emitted when LoggingPath is set
+            ArgumentList _logging;
+            String _loggingFile;
+
+            // Position of "-cp" in _jvm when followed by a bare ${classpath}, -1 otherwise
+            std::int32_t _classpathArg = -1;
+
+            String _id;
+            String _mainClass;
+            String _assets;
+            String _type;
+            int _javaMajor = 0;
+
+            void _append(ArgumentList &target, const String &argument);
+            void _appendValue(ArgumentList &target, const ConfigObject &value, const LaunchFeatures &features);
+
+        public:
+            /**
+             * Compile the arguments of a resolved profile into a template
+             * @param chain Version JSONs, root profile first and the launched profile last
+             * @param features Feature flags used to evaluate argument rules
+             * @return The compiled template
+             */
+            static std::shared_ptr<const LaunchTemplate> compile(const std::vector<std::unique_ptr<Config>> &chain, const LaunchFeatures &features);
+
+            /**
+             * Fill the slots into one argv buffer
+             * The layout is: java, jvm arguments, logging argument, extra jvm arguments, main class, game arguments
+             * @param java Java executable
+             * @param variables Slot values
+             * @param extraJvmArgs Additional JVM arguments (memory, GC, ...)
+             * @param out Output command, its buffers are reused between calls
+             * @param classpathArgFile If not empty, "-cp ${classpath}" is replaced by "@<classpathArgFile>"
+             */
+            void fill(const fs::path &java, const LaunchVariables &variables, const std::vector<String> &extraJvmArgs, LaunchCommand &out,
+                      std::string_view classpathArgFile = std::string_view()) const;
+
+            const String &id() const { return _id; }
+            const String &mainClass() const { return _mainClass; }
+            const String &assets() const { return _assets; }
+            const String &type() const { return _type; }
+
+            // javaVersion.majorVersion of the profile, 0 if it does not say
+            int javaMajor() const { return _javaMajor; }
+
+            // Id of the Log4j2 configuration file (logging.client.file.id), may be empty
+            const String &loggingFile() const { return _loggingFile; }
+        };
+
+        namespace internal
+        {
+            // Profile files a cached value was built from, with their times before they were read
+            using ProfileSources = std::vector<std::pair<fs::path, fs::file_time_type>>;
+
+            // Load a version JSON and the profiles it inherits from, root first.
+            // sources, if given, receives each file with its time taken before reading it
+            std::vector<std::unique_ptr<Config>> loadProfileChain(const fs::path &versionsDir, const String &id, ProfileSources *sources = nullptr);
+
+            // Ids of a loaded profile chain, in the same order as the chain
+            std::vector<String> profileChainIds(const std::vector<std::unique_ptr<Config>> &chain, const String &id);
+
+            // Whether no file of sources changed since its time was taken
+            bool profileSourcesFresh(const ProfileSources &sources);
+
+            /**
+             * Values built from a profile chain, rebuilt when a file of the chain changes
+             * The lock is only held to look up and to store an entry, so building one
+             * profile never blocks lookups of the others. If two threads rebuild the
+             * same entry, the first one stored wins and the other result is dropped.
+             */
+            template <typename T>
+            class ProfileCache
+            {
+            private:
+                struct Entry
+                {
+                    ProfileSources sources;
+                    std::shared_ptr<const T> value;
+                };
+
+                std::mutex _mutex;
+                std::unordered_map<String, Entry> _entries;
+                Counter &_hits;
+                Counter &_misses;
+
+            public:
+                // @param name Value of the cache label of the hit and miss counters
+                explicit ProfileCache(const String &name)
+                    : _hits(Metrics::shared().counter("cnt_cache_hits_total", "Lookups served from a cache", "cache=\"" + name + "\"")),
+                      _misses(Metrics::shared().counter("cnt_cache_misses_total", "Lookups that had to rebuild the entry", "cache=\"" + name + "\""))
+                {
+                }
+
+                /**
+                 * Cached value of a profile, built by build(chain) when missing or stale
+                 * @param key Cache key, a profile may be cached under several keys
+                 * @param usable False to rebuild even if the profile did not change
+                 */
+                template <typename Build>
+                std::shared_ptr<const T> get(const String &key, const fs::path &versionsDir, const String &id, Build &&build, bool usable = true)
+                {
+                    // The entry seen here tells whether another thread stored one since
+                    std::shared_ptr<const T> seen;
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        auto it = _entries.find(key);
+                        if (it != _entries.end())
+                        {
+                            if (usable && profileSourcesFresh(it->second.sources))
+                            {
+                                _hits.add();
+                                return it->second.value;
+                            }
+                            seen = it->second.value;
+                        }
+                    }
+                    _misses.add();
+
+                    // A file changing while it is read keeps its old time, so the next lookup rebuilds
+                    Entry entry;
+                    auto chain = loadProfileChain(versionsDir, id, &entry.sources);
+                    entry.value = build(chain);
+
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    Entry &slot = _entries[key];
+                    if (slot.value && slot.value != seen)
+                        return slot.value;
+                    slot = std::move(entry);
+                    return slot.value;
+                }
+
+                void clear()
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _entries.clear();
+                }
+            };
+        }
+
+        // Compiled templates keyed by profile and feature set
+        class LaunchTemplateCache
+        {
+        private:
+            internal::ProfileCache<LaunchTemplate> _cache{"launch_template"};
+
+        public:
+            static LaunchTemplateCache &shared();
+
+            /**
+             * Get the compiled template of a profile, compiling it if the
+             * profile (or a profile it inherits from) changed on disk
+             * @param versionsDir The versions directory of the index
+             * @param id Profile id
+             * @param features Feature flags
+             */
+            std::shared_ptr<const LaunchTemplate> get(const fs::path &versionsDir, const String &id, const LaunchFeatures &features);
+
+            void clear();
+        };
+
+        struct LaunchOptions
+        {
+            LaunchFeatures features;
+            LaunchVariables variables;
+            std::vector<String> jvmArgs;
+
+            // Pass the classpath through an @argfile on Java 9+
+            bool classpathArgFile = false;
+
+            // Pass the Log4j2 configuration of the profile, so stdout carries <log4j:Event> records
+            bool launcherLogging = true;
+
+            // Reuse a class data sharing archive of the runtime and classpath (Java 13+),
+            // dumping one on the first launch
+            bool classDataSharing = true;
+
+            // "KEY=VALUE" entries added to the environment of the game process
+            std::vector<String> environment;
+
+            // cgroup v2 group holding the game process (see CreateCgroup), empty for none
+            fs::path cgroup;
+        };
+
+        namespace internal
+        {
+            // Map a ${name} variable to its slot, LaunchSlot::Count if unknown
+            LaunchSlot lookupLaunchSlot(std::string_view name);
+
+            // Evaluate a "rules" array against the current platform and features
+            bool evaluateRules(const ConfigObject &rules, const LaunchFeatures &features);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/launch.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__LAUNCH_HPP__
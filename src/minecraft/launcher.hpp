@@ -0,0 +1,196 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/launcher.hpp
+ * @Description: Launch queue that staggers instance starts by host load and restarts crashes
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__LAUNCHER_HPP__
+#define __MINECRAFT_ENGINE__LAUNCHER_HPP__
+
+#include <minecraft/cntconfig.hpp>
+#include <minecraft/instance.hpp>
+#include <minecraft/host.hpp>
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <optional>
+#include <functional>
+#include <condition_variable>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        enum class LaunchState
+        {
+            Queued,   // Waiting for its turn
+            Waiting,  // Next in line, held back by host load or the stagger interval
+            Starting, // Running, still counted as a cold start
+            Running,  // Warmed up
+            Backoff,  // Crashed, waiting to be restarted
+            Stopped,  // Exited cleanly or cancelled
+            Failed    // Crashed too often or could not be started
+        };
+
+        struct LaunchRequest
+        {
+            Instance instance;
+            JavaInfo java;
+            LaunchOptions options;
+
+            // Higher priorities start first, equal priorities in submission order
+            int priority = 0;
+
+            // Restart after a non-zero exit, with exponential backoff
+            bool restartOnCrash = true;
+            unsigned int maxRestarts = 5;
+            std::chrono::milliseconds backoff{1000};
+            std::chrono::milliseconds maxBackoff{60000};
+
+            // A start stops counting as cold once ready matches an output chunk
+            // (e.g. a server's "Done (") or after warmup, whichever comes first
+            std::function<bool(std::string_view)> ready;
+            std::chrono::milliseconds warmup{60000};
+
+            ProcessOutputHandler output;
+
+            LaunchRequest(Instance _instance, JavaInfo _java, LaunchOptions _options = {})
+                : instance(std::move(_instance)), java(std::move(_java)), options(std::move(_options)) {}
+        };
+
+        struct LaunchStatus
+        {
+            std::uint64_t id = 0;
+            String instance;
+            LaunchState state = LaunchState::Queued;
+            int priority = 0;
+            unsigned int restarts = 0;
+
+            // Exit status of the last run, see GameProcess::exited
+            std::optional<int> lastExit;
+            String error;
+
+            // Current process while Starting or Running
+            std::shared_ptr<GameProcess> process;
+        };
+
+        // Called from the scheduler thread on every state change
+        using LaunchObserver = std::function<void(const LaunchStatus &)>;
+
+        struct LaunchSchedulerOptions
+        {
+            // Instances allowed in the Starting state at once
+            unsigned int maxColdStarts = 2;
+
+            // Minimum time between two starts
+            std::chrono::milliseconds stagger{2000};
+
+            // Hold starts while PSI "some" avg10 is above these (percent)
+            double maxCpuPressure = 40;
+            double maxIoPressure = 30;
+            double maxMemoryPressure = 10;
+
+            // Hold starts while more tasks than this per CPU are runnable
+            double maxRunQueuePerCpu = 1.5;
+
+            // How often load is sampled and processes are checked
+            std::chrono::milliseconds interval{250};
+
+            // How long Stopped and Failed launches stay visible to status() before they are dropped
+            std::chrono::milliseconds retention{60000};
+        };
+
+        /**
+         * Starts queued instances one after another
+         * At most maxColdStarts instances warm up at the same time, and starts
+         * are spaced by the stagger interval and held back while the host is
+         * under pressure, so a farm of servers does not load all at once.
+         */
+        class LaunchScheduler
+        {
+        private:
+            struct Entry
+            {
+                LaunchRequest request;
+                LaunchStatus status;
+                std::uint64_t order;
+                std::chrono::steady_clock::time_point notBefore;
+                std::chrono::steady_clock::time_point startedAt;
+                std::chrono::steady_clock::time_point finishedAt;
+                std::shared_ptr<std::atomic<bool>> ready;
+                bool cancelled = false;
+
+                Entry(LaunchRequest _request) : request(std::move(_request)) {}
+            };
+
+            LaunchSchedulerOptions _options;
+            unsigned int _cpus;
+
+            mutable std::mutex _mutex;
+            std::condition_variable _wakeup;
+            std::vector<std::unique_ptr<Entry>> _entries;
+            std::vector<LaunchObserver> _observers;
+            std::uint64_t _nextId = 1;
+            std::chrono::steady_clock::time_point _lastStart;
+            bool _stopping = false;
+            std::thread _thread;
+
+            void _run();
+            void _tick(std::unique_lock<std::mutex> &lock, std::vector<LaunchStatus> &changes);
+            bool _loadAllows(const HostLoad &load) const;
+            void _start(Entry &entry, std::unique_lock<std::mutex> &lock, std::vector<LaunchStatus> &changes);
+            void _exited(Entry &entry, std::optional<int> code, std::vector<LaunchStatus> &changes);
+            void _setState(Entry &entry, LaunchState state, std::vector<LaunchStatus> &changes);
+
+        public:
+            explicit LaunchScheduler(LaunchSchedulerOptions options = {});
+
+            // Stops scheduling; processes that are running keep running
+            ~LaunchScheduler();
+
+            LaunchScheduler(const LaunchScheduler &) = delete;
+            LaunchScheduler &operator=(const LaunchScheduler &) = delete;
+
+            // Queue a launch, returns its id
+            std::uint64_t submit(LaunchRequest request);
+
+            // Remove a queued launch or terminate a running one, without restarting it
+            bool cancel(std::uint64_t id);
+
+            std::optional<LaunchStatus> status(std::uint64_t id) const;
+            std::vector<LaunchStatus> statuses() const;
+
+            void subscribe(LaunchObserver observer);
+        };
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/launcher.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__LAUNCHER_HPP__
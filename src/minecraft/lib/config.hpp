@@ -38,6 +38,9 @@
 #include <cctype>
 #include <utility>
 
+#include "result.hpp"
+#include "memory.hpp"
+
 namespace fs = std::filesystem;
 
 namespace cnt {
@@ -45,6 +48,11 @@ namespace cnt {
 // Forward declaration
 class ConfigObject;
 
+// Containers of the config tree, accounted under MemoryTag::CONFIG
+using ConfigMap = std::map<std::string, ConfigObject, std::less<std::string>,
+                           TaggedAllocator<std::pair<const std::string, ConfigObject>, MemoryTag::CONFIG>>;
+using ConfigArray = TaggedVector<ConfigObject, MemoryTag::CONFIG>;
+
 // Alias for internal use
 using ConfigValue = std::variant<
     std::monostate,      // None
@@ -53,8 +61,8 @@ using ConfigValue = std::variant<
     bool,                // Boolean
     std::string,         // String
     char,                // Character
-    std::shared_ptr<std::map<std::string, ConfigObject>>, // Object
-    std::shared_ptr<std::vector<ConfigObject>>           // Array
+    std::shared_ptr<ConfigMap>, // Object
+    std::shared_ptr<ConfigArray>           // Array
 >;
 
 enum class ConfigType {
@@ -73,6 +81,12 @@ private:
     ConfigValue value;
     ConfigType type;
 
+    // Nodes share one allocation with their control block, both accounted
+    template <typename T, typename... Args>
+    static std::shared_ptr<T> make_node(Args&&... args) {
+        return std::allocate_shared<T>(TaggedAllocator<T, MemoryTag::CONFIG>(), std::forward<Args>(args)...);
+    }
+
 public:
     // Constructors for each type
     ConfigObject() : value(std::monostate{}), type(ConfigType::NONE) {}
@@ -86,14 +100,18 @@ public:
     ConfigObject(char val) : value(val), type(ConfigType::CHARACTER) {}
     
     // Object constructor
-    ConfigObject(const std::map<std::string, ConfigObject>& obj) 
-        : value(std::make_shared<std::map<std::string, ConfigObject>>(obj))
+    ConfigObject(ConfigMap obj)
+        : value(make_node<ConfigMap>(std::move(obj)))
         , type(ConfigType::OBJECT) {}
+    ConfigObject(const std::map<std::string, ConfigObject>& obj)
+        : ConfigObject(ConfigMap(obj.begin(), obj.end())) {}
     
     // Array constructor
-    ConfigObject(const std::vector<ConfigObject>& arr)
-        : value(std::make_shared<std::vector<ConfigObject>>(arr))
+    ConfigObject(ConfigArray arr)
+        : value(make_node<ConfigArray>(std::move(arr)))
         , type(ConfigType::ARRAY) {}
+    ConfigObject(const std::vector<ConfigObject>& arr)
+        : ConfigObject(ConfigArray(arr.begin(), arr.end())) {}
 
     // Type checking
     bool is_none() const { return type == ConfigType::NONE; }
@@ -146,18 +164,18 @@ public:
     ConfigObject& operator[](const std::string& key) {
         if (type != ConfigType::OBJECT) {
             type = ConfigType::OBJECT;
-            value = std::make_shared<std::map<std::string, ConfigObject>>();
+            value = make_node<ConfigMap>();
         }
-        auto& obj = *std::get<std::shared_ptr<std::map<std::string, ConfigObject>>>(value);
+        auto& obj = *std::get<std::shared_ptr<ConfigMap>>(value);
         return obj[key];
     }
 
     ConfigObject& operator[](size_t index) {
         if (type != ConfigType::ARRAY) {
             type = ConfigType::ARRAY;
-            value = std::make_shared<std::vector<ConfigObject>>();
+            value = make_node<ConfigArray>();
         }
-        auto& arr = *std::get<std::shared_ptr<std::vector<ConfigObject>>>(value);
+        auto& arr = *std::get<std::shared_ptr<ConfigArray>>(value);
         if (index >= arr.size()) arr.resize(index + 1);
         return arr[index];
     }
@@ -166,7 +184,7 @@ public:
         if (type != ConfigType::OBJECT) {
             throw std::runtime_error("Not an object");
         }
-        const auto& obj = *std::get<std::shared_ptr<std::map<std::string, ConfigObject>>>(value);
+        const auto& obj = *std::get<std::shared_ptr<ConfigMap>>(value);
         return obj.at(key);
     }
 
@@ -174,15 +192,15 @@ public:
         if (type != ConfigType::ARRAY) {
             throw std::runtime_error("Not an array");
         }
-        const auto& arr = *std::get<std::shared_ptr<std::vector<ConfigObject>>>(value);
+        const auto& arr = *std::get<std::shared_ptr<ConfigArray>>(value);
         return arr.at(index);
     }
 
     size_t size() const {
         if (type == ConfigType::ARRAY) {
-            return std::get<std::shared_ptr<std::vector<ConfigObject>>>(value)->size();
+            return std::get<std::shared_ptr<ConfigArray>>(value)->size();
         } else if (type == ConfigType::OBJECT) {
-            return std::get<std::shared_ptr<std::map<std::string, ConfigObject>>>(value)->size();
+            return std::get<std::shared_ptr<ConfigMap>>(value)->size();
         } else if (type == ConfigType::STRING) {
             return std::get<std::string>(value).size();
         }
@@ -191,10 +209,19 @@ public:
 
     bool has_key(const std::string& key) const {
         if (type != ConfigType::OBJECT) return false;
-        const auto& obj = *std::get<std::shared_ptr<std::map<std::string, ConfigObject>>>(value);
+        const auto& obj = *std::get<std::shared_ptr<ConfigMap>>(value);
         return obj.find(key) != obj.end();
     }
 
+    std::vector<std::string> keys() const {
+        std::vector<std::string> result;
+        if (type != ConfigType::OBJECT) return result;
+        const auto& obj = *std::get<std::shared_ptr<ConfigMap>>(value);
+        result.reserve(obj.size());
+        for (const auto& [k, v] : obj) result.push_back(k);
+        return result;
+    }
+
     // String representation
     std::string to_string() const {
         switch (type) {
@@ -205,7 +232,7 @@ public:
             case ConfigType::STRING: return "\"" + std::get<std::string>(value) + "\"";
             case ConfigType::CHARACTER: return "'" + std::string(1, std::get<char>(value)) + "'";
             case ConfigType::OBJECT: {
-                const auto& obj = *std::get<std::shared_ptr<std::map<std::string, ConfigObject>>>(value);
+                const auto& obj = *std::get<std::shared_ptr<ConfigMap>>(value);
                 std::string result = "{";
                 bool first = true;
                 for (const auto& [k, v] : obj) {
@@ -217,7 +244,7 @@ public:
                 return result;
             }
             case ConfigType::ARRAY: {
-                const auto& arr = *std::get<std::shared_ptr<std::vector<ConfigObject>>>(value);
+                const auto& arr = *std::get<std::shared_ptr<ConfigArray>>(value);
                 std::string result = "[";
                 for (size_t i = 0; i < arr.size(); ++i) {
                     if (i > 0) result += ", ";
@@ -233,393 +260,49 @@ public:
 
 class Config {
 private:
-    std::unique_ptr<std::map<std::string, ConfigObject>> data;
+    std::unique_ptr<ConfigMap> data;
     std::optional<fs::path> filepath;
     bool opened = false;
+    std::optional<Error> parse_error; // first error of the parse in progress
 
-    // Parser helpers
-    std::string read_file(const fs::path& path) {
-        std::ifstream file(path);
-        if (!file.is_open()) {
-            throw std::runtime_error("Cannot open file: " + path.string());
-        }
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
-    }
+    // Deepest nesting of arrays and objects parse_value recurses into
+    static constexpr size_t MAX_DEPTH = 512;
 
-    void skip_whitespace(const std::string& content, size_t& pos) {
-        while (pos < content.size() && std::isspace(content[pos])) {
-            pos++;
-        }
-    }
-
-    void skip_comment(const std::string& content, size_t& pos) {
-        if (pos < content.size() && content[pos] == '/') {
-            if (pos + 1 < content.size()) {
-                if (content[pos + 1] == '/') {
-                    // Single line comment
-                    while (pos < content.size() && content[pos] != '\n') {
-                        pos++;
-                    }
-                } else if (content[pos + 1] == '*') {
-                    // Multi-line comment
-                    pos += 2;
-                    while (pos + 1 < content.size() && 
-                           !(content[pos] == '*' && content[pos + 1] == '/')) {
-                        pos++;
-                    }
-                    if (pos + 1 < content.size()) {
-                        pos += 2; // Skip "*/"
-                    }
-                }
-            }
-        }
-    }
-
-    std::string parse_key(const std::string& content, size_t& pos) {
-        skip_whitespace(content, pos);
-        
-        std::string key;
-        if (pos < content.size() && content[pos] == '"') {
-            // Quoted key
-            pos++;
-            while (pos < content.size() && content[pos] != '"') {
-                key += content[pos];
-                pos++;
-            }
-            if (pos < content.size() && content[pos] == '"') {
-                pos++;
-            }
-        } else {
-            // Unquoted identifier
-            while (pos < content.size() && 
-                   (std::isalnum(content[pos]) || content[pos] == '_' || content[pos] == '-')) {
-                key += content[pos];
-                pos++;
-            }
-        }
-        return key;
-    }
-
-    ConfigObject parse_value(const std::string& content, size_t& pos) {
-        skip_whitespace(content, pos);
-        
-        if (pos >= content.size()) return ConfigObject();
-        
-        // Check for None
-        if (content.substr(pos, 4) == "None") {
-            pos += 4;
-            return ConfigObject(nullptr);
-        }
-        
-        // Check for boolean
-        if (content.substr(pos, 4) == "true") {
-            pos += 4;
-            return ConfigObject(true);
-        }
-        if (content.substr(pos, 5) == "false") {
-            pos += 5;
-            return ConfigObject(false);
-        }
-        
-        // Check for string
-        if (content[pos] == '"') {
-            pos++;
-            std::string str;
-            while (pos < content.size() && content[pos] != '"') {
-                if (content[pos] == '\\' && pos + 1 < content.size()) {
-                    // Handle escape sequences
-                    pos++;
-                    switch (content[pos]) {
-                        case 'n': str += '\n'; break;
-                        case 't': str += '\t'; break;
-                        case 'r': str += '\r'; break;
-                        case '\\': str += '\\'; break;
-                        case '"': str += '"'; break;
-                        default: str += content[pos]; break;
-                    }
-                } else {
-                    str += content[pos];
-                }
-                pos++;
-            }
-            if (pos < content.size() && content[pos] == '"') {
-                pos++;
-            }
-            return ConfigObject(str);
-        }
-        
-        // Check for character
-        if (content[pos] == '\'') {
-            pos++;
-            char ch = '\0';
-            if (pos < content.size()) {
-                if (content[pos] == '\\' && pos + 1 < content.size()) {
-                    // Handle escape sequences
-                    pos++;
-                    switch (content[pos]) {
-                        case 'n': ch = '\n'; break;
-                        case 't': ch = '\t'; break;
-                        case 'r': ch = '\r'; break;
-                        case '\\': ch = '\\'; break;
-                        case '\'': ch = '\''; break;
-                        default: ch = content[pos]; break;
-                    }
-                } else {
-                    ch = content[pos];
-                }
-                pos++;
-            }
-            if (pos < content.size() && content[pos] == '\'') {
-                pos++;
-            }
-            return ConfigObject(ch);
-        }
-        
-        // Check for array
-        if (content[pos] == '[') {
-            pos++;
-            std::vector<ConfigObject> array;
-            
-            skip_whitespace(content, pos);
-            while (pos < content.size() && content[pos] != ']') {
-                auto value = parse_value(content, pos);
-                array.push_back(value);
-                
-                skip_whitespace(content, pos);
-                if (pos < content.size() && content[pos] == ',') {
-                    pos++;
-                    skip_whitespace(content, pos);
-                }
-            }
-            if (pos < content.size() && content[pos] == ']') {
-                pos++;
-            }
-            return ConfigObject(array);
-        }
-        
-        // Check for object
-        if (content[pos] == '{') {
-            pos++;
-            std::map<std::string, ConfigObject> object;
-            
-            skip_whitespace(content, pos);
-            while (pos < content.size() && content[pos] != '}') {
-                auto key = parse_key(content, pos);
-                
-                skip_whitespace(content, pos);
-                if (pos < content.size() && content[pos] == ':') {
-                    pos++;
-                }
-                
-                auto value = parse_value(content, pos);
-                object[key] = value;
-                
-                skip_whitespace(content, pos);
-                if (pos < content.size() && content[pos] == ',') {
-                    pos++;
-                    skip_whitespace(content, pos);
-                }
-            }
-            if (pos < content.size() && content[pos] == '}') {
-                pos++;
-            }
-            return ConfigObject(object);
-        }
-        
-        // Check for number
-        if (std::isdigit(content[pos]) || content[pos] == '-' || content[pos] == '+') {
-            std::string num_str;
-            bool has_decimal = false;
-            
-            // Handle sign
-            if (content[pos] == '-' || content[pos] == '+') {
-                num_str += content[pos];
-                pos++;
-            }
-            
-            // Parse number
-            while (pos < content.size() && 
-                   (std::isdigit(content[pos]) || content[pos] == '.' || 
-                    content[pos] == 'e' || content[pos] == 'E' ||
-                    content[pos] == '+' || content[pos] == '-')) {
-                if (content[pos] == '.') has_decimal = true;
-                num_str += content[pos];
-                pos++;
-            }
-            
-            try {
-                if (has_decimal) {
-                    return ConfigObject(std::stod(num_str));
-                } else {
-                    return ConfigObject(std::stoll(num_str));
-                }
-            } catch (...) {
-                throw std::runtime_error("Invalid number: " + num_str);
-            }
-        }
-        
-        return ConfigObject();
-    }
-
-    void parse_content(const std::string& content) {
-        data = std::make_unique<std::map<std::string, ConfigObject>>();
-        size_t pos = 0;
-        
-        while (pos < content.size()) {
-            skip_whitespace(content, pos);
-            
-            // Skip comments
-            while (pos < content.size() && content[pos] == '/') {
-                size_t old_pos = pos;
-                skip_comment(content, pos);
-                if (pos == old_pos) break; // Not a comment
-                skip_whitespace(content, pos);
-            }
-            
-            if (pos >= content.size()) break;
-            
-            // Parse key-value pair
-            std::string key = parse_key(content, pos);
-            
-            skip_whitespace(content, pos);
-            if (pos < content.size() && content[pos] == ':') {
-                pos++;
-            }
-            
-            ConfigObject value = parse_value(content, pos);
-            
-            if (!key.empty()) {
-                (*data)[key] = value;
-            }
-            
-            skip_whitespace(content, pos);
-            if (pos < content.size() && content[pos] == ',') {
-                pos++;
-            }
-        }
-    }
-
-    void write_value(std::ostream& os, const ConfigObject& obj, int indent = 0, bool is_inline = false) {
-        const std::string indent_str(indent * 4, ' ');
-        
-        switch (obj.get_type()) {
-            case ConfigType::NONE:
-                os << "None";
-                break;
-            case ConfigType::NUMBER:
-                os << obj.as_number().value();
-                break;
-            case ConfigType::FLOAT:
-                os << obj.as_float().value();
-                break;
-            case ConfigType::BOOLEAN:
-                os << (obj.as_boolean().value() ? "true" : "false");
-                break;
-            case ConfigType::STRING: {
-                std::string str = obj.as_string().value();
-                // Escape special characters
-                std::string escaped;
-                for (char c : str) {
-                    switch (c) {
-                        case '\n': escaped += "\\n"; break;
-                        case '\t': escaped += "\\t"; break;
-                        case '\r': escaped += "\\r"; break;
-                        case '\\': escaped += "\\\\"; break;
-                        case '"': escaped += "\\\""; break;
-                        default: escaped += c; break;
-                    }
-                }
-                os << "\"" << escaped << "\"";
-                break;
-            }
-            case ConfigType::CHARACTER: {
-                char ch = obj.as_character().value();
-                switch (ch) {
-                    case '\n': os << "'\\n'"; break;
-                    case '\t': os << "'\\t'"; break;
-                    case '\r': os << "'\\r'"; break;
-                    case '\\': os << "'\\\\'"; break;
-                    case '\'': os << "'\\''"; break;
-                    default: os << "'" << ch << "'"; break;
-                }
-                break;
-            }
-            case ConfigType::OBJECT: {
-                const auto obj_ptr = obj.get_as<std::shared_ptr<std::map<std::string, ConfigObject>>>();
-                if (!obj_ptr) break;
-                
-                const auto& map_obj = *obj_ptr.value();
-                if (map_obj.empty()) {
-                    os << "{}";
-                } else if (is_inline) {
-                    os << "{";
-                    bool first = true;
-                    for (const auto& [key, value] : map_obj) {
-                        if (!first) os << ", ";
-                        os << "\"" << key << "\": ";
-                        write_value(os, value, 0, true);
-                        first = false;
-                    }
-                    os << "}";
-                } else {
-                    os << "{\n";
-                    bool first = true;
-                    for (const auto& [key, value] : map_obj) {
-                        if (!first) os << ",\n";
-                        os << indent_str << "    \"" << key << "\": ";
-                        write_value(os, value, indent + 1, false);
-                        first = false;
-                    }
-                    os << "\n" << indent_str << "}";
-                }
-                break;
-            }
-            case ConfigType::ARRAY: {
-                const auto arr_ptr = obj.get_as<std::shared_ptr<std::vector<ConfigObject>>>();
-                if (!arr_ptr) break;
-                
-                const auto& vec = *arr_ptr.value();
-                if (vec.empty()) {
-                    os << "[]";
-                } else if (is_inline || vec.size() <= 3) {
-                    os << "[";
-                    for (size_t i = 0; i < vec.size(); ++i) {
-                        if (i > 0) os << ", ";
-                        write_value(os, vec[i], 0, true);
-                    }
-                    os << "]";
-                } else {
-                    os << "[\n";
-                    for (size_t i = 0; i < vec.size(); ++i) {
-                        if (i > 0) os << ",\n";
-                        os << indent_str << "    ";
-                        write_value(os, vec[i], indent + 1, false);
-                    }
-                    os << "\n" << indent_str << "]";
-                }
-                break;
-            }
-        }
-    }
+    // Parser helpers, defined in source/config.cpp. They report errors through
+    // parse_error instead of throwing so the try_* functions never unwind.
+    Result<std::string> read_file(const fs::path& path);
+    void skip_whitespace(const std::string& content, size_t& pos);
+    void skip_comment(const std::string& content, size_t& pos);
+    void skip_blank(const std::string& content, size_t& pos); // whitespace and comments
+    std::string parse_key(const std::string& content, size_t& pos);
+    ConfigObject parse_value(const std::string& content, size_t& pos, size_t depth = 0);
+    bool parse_unicode_escape(const std::string& content, size_t& pos, std::string& out);
+    Result<void> parse_content(const std::string& content);
+    ConfigObject fail(std::string detail);
+    void write_value(std::ostream& os, const ConfigObject& obj, int indent = 0, bool is_inline = false);
 
 public:
-    Config() : data(std::make_unique<std::map<std::string, ConfigObject>>()) {}
+    Config() : data(std::make_unique<ConfigMap>()) {}
     
     ~Config() = default;
     
+    // Non-throwing variants of open() and parse(); on failure the config keeps
+    // its previous contents
+    Result<void> try_open(const fs::path& path);
+    Result<void> try_parse(const std::string& content);
+
     void open(const fs::path& path) {
-        try {
-            std::string content = read_file(path);
-            parse_content(content);
-            filepath = path;
-            opened = true;
-        } catch (const std::exception& e) {
-            throw std::runtime_error("Failed to open config file: " + std::string(e.what()));
+        Result<void> result = try_open(path);
+        if (!result) {
+            throw std::runtime_error("Failed to open config file: " + result.error().message());
         }
     }
     
+    // Parse content that is already in memory (e.g. read from an archive)
+    void parse(const std::string& content) {
+        try_parse(content).value();
+    }
+    
     bool is_open() const {
         return opened;
     }
@@ -637,18 +320,7 @@ public:
         save(filepath.value());
     }
     
-    void save(const fs::path& path) {
-        std::ofstream file(path);
-        if (!file.is_open()) {
-            throw std::runtime_error("Cannot save to file: " + path.string());
-        }
-        
-        for (const auto& [key, value] : *data) {
-            file << key << ": ";
-            write_value(file, value, 0, false);
-            file << "\n";
-        }
-    }
+    void save(const fs::path& path);
     
     ConfigObject get(const std::string& name) const {
         if (!data) {
@@ -702,6 +374,14 @@ public:
         (*data)[name] = ConfigObject(value);
     }
     
+    void set(const std::string& name, ConfigMap value) {
+        (*data)[name] = ConfigObject(std::move(value));
+    }
+    
+    void set(const std::string& name, ConfigArray value) {
+        (*data)[name] = ConfigObject(std::move(value));
+    }
+    
     // Generic set method using ConfigObject
     void set(const std::string& name, const ConfigObject& value) {
         (*data)[name] = value;
@@ -749,7 +429,7 @@ private:
     void add_impl(const std::string& name, const ConfigObject& value) {
         if (data->find(name) != data->end() && (*data)[name].is_array()) {
             // Get the array and append
-            auto arr_ptr = (*data)[name].get_as<std::shared_ptr<std::vector<ConfigObject>>>();
+            auto arr_ptr = (*data)[name].get_as<std::shared_ptr<ConfigArray>>();
             if (arr_ptr) {
                 arr_ptr.value()->push_back(value);
             }
@@ -780,7 +460,7 @@ public:
         if (obj.is_object() && data->find("_root") != data->end() && 
             (*data)["_root"].is_object()) {
             auto root_obj = (*data)["_root"];
-            auto new_obj = ConfigObject(std::map<std::string, ConfigObject>());
+            auto new_obj = ConfigObject(ConfigMap());
             
             // Merge logic here (simplified)
             return new_obj;
@@ -805,4 +485,8 @@ public:
 
 } // namespace cnt
 
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include "source/config.cpp"
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
 #endif // __CNTLIB_CONFIG_HPP__
\ No newline at end of file
@@ -0,0 +1,170 @@
+/*
+ * CNT Library
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: deflate.hpp
+ * @Description: Raw DEFLATE (RFC 1951) encoder with LZ77 hash chains and fixed Huffman codes
+ * @Ownership: TaimWay <taimway@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __CNTLIB_DEFLATE_HPP__
+#define __CNTLIB_DEFLATE_HPP__
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+
+namespace cnt {
+
+class Deflater {
+private:
+    static constexpr std::size_t WINDOW = 32768;
+    static constexpr int HASH_BITS = 15;
+    static constexpr std::size_t MIN_MATCH = 3;
+    static constexpr std::size_t MAX_MATCH = 258;
+
+    std::vector<std::uint8_t>& out;
+    std::uint64_t bitbuf = 0;
+    int bitcnt = 0;
+
+    explicit Deflater(std::vector<std::uint8_t>& _out) : out(_out) {}
+
+    void put(std::uint32_t value, int count) {
+        bitbuf |= std::uint64_t(value) << bitcnt;
+        bitcnt += count;
+        while (bitcnt >= 8) {
+            out.push_back(static_cast<std::uint8_t>(bitbuf));
+            bitbuf >>= 8;
+            bitcnt -= 8;
+        }
+    }
+
+    // Huffman codes are sent most significant bit first
+    void code(std::uint32_t value, int count) {
+        std::uint32_t reversed = 0;
+        for (int i = 0; i < count; ++i) reversed |= ((value >> i) & 1u) << (count - 1 - i);
+        put(reversed, count);
+    }
+
+    void literal(int symbol) {
+        if (symbol < 144) code(0x30 + symbol, 8);
+        else if (symbol < 256) code(0x190 + symbol - 144, 9);
+        else if (symbol < 280) code(symbol - 256, 7);
+        else code(0xc0 + symbol - 280, 8);
+    }
+
+    void match(std::size_t length, std::size_t distance) {
+        static const std::uint16_t lbase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                                35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static const std::uint8_t lext[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                              3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static const std::uint16_t dbase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                                257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                                8193, 12289, 16385, 24577};
+        static const std::uint8_t dext[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                              7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+        int l = 28;
+        while (lbase[l] > length) --l;
+        literal(257 + l);
+        put(static_cast<std::uint32_t>(length - lbase[l]), lext[l]);
+
+        int d = 29;
+        while (dbase[d] > distance) --d;
+        code(static_cast<std::uint32_t>(d), 5);
+        put(static_cast<std::uint32_t>(distance - dbase[d]), dext[d]);
+    }
+
+    static std::uint32_t hash(const std::uint8_t* p) {
+        std::uint32_t v = p[0] | (std::uint32_t(p[1]) << 8) | (std::uint32_t(p[2]) << 16);
+        return (v * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    void run(const std::uint8_t* src, std::size_t size, int chain) {
+        // One final block with the fixed code, good enough for configs and metadata
+        put(1, 1);
+        put(1, 2);
+
+        std::unique_ptr<std::int32_t[]> head(new std::int32_t[std::size_t(1) << HASH_BITS]);
+        std::unique_ptr<std::int32_t[]> prev(new std::int32_t[WINDOW]);
+        std::fill(head.get(), head.get() + (std::size_t(1) << HASH_BITS), -1);
+
+        auto insert = [&](std::size_t at) {
+            std::uint32_t h = hash(src + at);
+            prev[at & (WINDOW - 1)] = head[h];
+            head[h] = static_cast<std::int32_t>(at);
+        };
+
+        std::size_t pos = 0;
+        while (pos < size) {
+            std::size_t best = 0, distance = 0;
+            if (pos + MIN_MATCH <= size) {
+                std::size_t limit = std::min(MAX_MATCH, size - pos);
+                std::int32_t candidate = head[hash(src + pos)];
+                for (int tries = chain; candidate >= 0 && tries > 0; --tries) {
+                    std::size_t from = static_cast<std::size_t>(candidate);
+                    if (pos - from > WINDOW - 1) break;
+                    if (src[from + best] == src[pos + best]) {
+                        std::size_t len = 0;
+                        while (len < limit && src[from + len] == src[pos + len]) ++len;
+                        if (len > best) {
+                            best = len;
+                            distance = pos - from;
+                            if (len == limit) break;
+                        }
+                    }
+                    std::int32_t next = prev[from & (WINDOW - 1)];
+                    if (next >= candidate) break;
+                    candidate = next;
+                }
+                insert(pos);
+            }
+
+            if (best >= MIN_MATCH) {
+                match(best, distance);
+                std::size_t end = pos + best;
+                for (++pos; pos < end; ++pos) {
+                    if (pos + MIN_MATCH <= size) insert(pos);
+                }
+            } else {
+                literal(src[pos++]);
+            }
+        }
+
+        literal(256);
+        if (bitcnt > 0) put(0, 8 - bitcnt);
+    }
+
+public:
+    /**
+     * Encode data as a raw DEFLATE stream, appending to out
+     * @param chain Match candidates tried per position, higher is slower and smaller
+     * @return Number of bytes appended
+     */
+    static std::size_t deflate(const void* data, std::size_t size, std::vector<std::uint8_t>& out, int chain = 32) {
+        std::size_t start = out.size();
+        Deflater deflater(out);
+        deflater.run(static_cast<const std::uint8_t*>(data), size, chain < 1 ? 1 : chain);
+        return out.size() - start;
+    }
+};
+
+} // namespace cnt
+
+#endif // __CNTLIB_DEFLATE_HPP__
@@ -0,0 +1,281 @@
+/*
+ * CNT Library
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: inflate.hpp
+ * @Description: Raw DEFLATE (RFC 1951) decoder with bounded-memory streaming output
+ * @Ownership: TaimWay <taimway@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef __CNTLIB_INFLATE_HPP__
+#define __CNTLIB_INFLATE_HPP__
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <functional>
+
+namespace cnt {
+
+class Inflater {
+public:
+    // Receives decoded output in order; chunks are only valid during the call
+    using Sink = std::function<void(const std::uint8_t*, std::size_t)>;
+
+private:
+    struct Huffman {
+        std::uint16_t count[16];
+        std::uint16_t symbol[288];
+    };
+
+    static constexpr std::size_t WINDOW = 32768;
+    static constexpr std::size_t FLUSH_AT = 8 * WINDOW;
+
+    const std::uint8_t* src;
+    std::size_t size;
+    std::size_t pos = 0;
+    std::uint64_t bitbuf = 0;
+    int bitcnt = 0;
+
+    std::vector<std::uint8_t>& out;
+    const Sink* sink;
+    std::size_t start;       // out.size() before decoding, appended output follows it
+    std::size_t limit;       // most bytes the stream may decode to
+    std::size_t emitted = 0; // bytes already handed to the sink
+
+    Inflater(const std::uint8_t* _src, std::size_t _size, std::vector<std::uint8_t>& _out, const Sink* _sink, std::size_t _limit)
+        : src(_src), size(_size), out(_out), sink(_sink), start(_out.size()), limit(_limit) {}
+
+    [[noreturn]] static void fail() {
+        throw std::runtime_error("Invalid deflate stream");
+    }
+
+    std::uint32_t bits(int need) {
+        while (bitcnt < need) {
+            if (pos >= size) fail();
+            bitbuf |= std::uint64_t(src[pos++]) << bitcnt;
+            bitcnt += 8;
+        }
+        std::uint32_t value = std::uint32_t(bitbuf & ((1ull << need) - 1));
+        bitbuf >>= need;
+        bitcnt -= need;
+        return value;
+    }
+
+    // With a sink, keep only the last window of output in memory. Output past
+    // the limit is rejected here, before it reaches the sink.
+    void flush(bool final) {
+        if (out.size() - start > limit - emitted) {
+            throw std::runtime_error("Deflate stream is larger than expected");
+        }
+        if (!sink) return;
+        if (final) {
+            if (!out.empty()) (*sink)(out.data(), out.size());
+            emitted += out.size();
+            out.clear();
+        } else if (out.size() >= FLUSH_AT) {
+            std::size_t emit = out.size() - WINDOW;
+            (*sink)(out.data(), emit);
+            emitted += emit;
+            out.erase(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(emit));
+        }
+    }
+
+    static void build(Huffman& h, const std::uint8_t* lengths, int n) {
+        std::memset(h.count, 0, sizeof(h.count));
+        for (int i = 0; i < n; ++i) h.count[lengths[i]]++;
+        if (h.count[0] == n) return;
+
+        int left = 1;
+        for (int len = 1; len < 16; ++len) {
+            left <<= 1;
+            left -= h.count[len];
+            if (left < 0) fail();
+        }
+
+        std::uint16_t offs[16];
+        offs[1] = 0;
+        for (int len = 1; len < 15; ++len) offs[len + 1] = offs[len] + h.count[len];
+        for (int i = 0; i < n; ++i) {
+            if (lengths[i] != 0) h.symbol[offs[lengths[i]]++] = static_cast<std::uint16_t>(i);
+        }
+    }
+
+    int decode(const Huffman& h) {
+        int code = 0, first = 0, index = 0;
+        for (int len = 1; len < 16; ++len) {
+            code |= static_cast<int>(bits(1));
+            int count = h.count[len];
+            if (code - count < first) return h.symbol[index + (code - first)];
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+        }
+        fail();
+    }
+
+    void stored() {
+        bitbuf = 0;
+        bitcnt = 0;
+        if (pos + 4 > size) fail();
+        std::uint32_t len = src[pos] | (std::uint32_t(src[pos + 1]) << 8);
+        std::uint32_t nlen = src[pos + 2] | (std::uint32_t(src[pos + 3]) << 8);
+        if (len != (~nlen & 0xffff)) fail();
+        pos += 4;
+        if (pos + len > size) fail();
+        out.insert(out.end(), src + pos, src + pos + len);
+        pos += len;
+        flush(false);
+    }
+
+    void codes(const Huffman& lencode, const Huffman& distcode) {
+        static const std::uint16_t lbase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                                35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static const std::uint8_t lext[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                              3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static const std::uint16_t dbase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                                257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                                8193, 12289, 16385, 24577};
+        static const std::uint8_t dext[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                              7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+        for (;;) {
+            int symbol = decode(lencode);
+            if (symbol < 256) {
+                out.push_back(static_cast<std::uint8_t>(symbol));
+            } else if (symbol == 256) {
+                break;
+            } else {
+                symbol -= 257;
+                if (symbol >= 29) fail();
+                std::size_t len = lbase[symbol] + bits(lext[symbol]);
+                int dsym = decode(distcode);
+                if (dsym >= 30) fail();
+                std::size_t dist = dbase[dsym] + bits(dext[dsym]);
+                if (dist > out.size()) fail();
+                std::size_t from = out.size() - dist;
+                for (std::size_t i = 0; i < len; ++i) out.push_back(out[from + i]);
+            }
+            flush(false);
+        }
+    }
+
+    void fixed() {
+        static Huffman lencode, distcode;
+        static const bool ready = [] {
+            std::uint8_t lengths[288];
+            int symbol = 0;
+            for (; symbol < 144; ++symbol) lengths[symbol] = 8;
+            for (; symbol < 256; ++symbol) lengths[symbol] = 9;
+            for (; symbol < 280; ++symbol) lengths[symbol] = 7;
+            for (; symbol < 288; ++symbol) lengths[symbol] = 8;
+            build(lencode, lengths, 288);
+            for (symbol = 0; symbol < 30; ++symbol) lengths[symbol] = 5;
+            build(distcode, lengths, 30);
+            return true;
+        }();
+        (void)ready;
+        codes(lencode, distcode);
+    }
+
+    void dynamic() {
+        static const std::uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+        int nlen = static_cast<int>(bits(5)) + 257;
+        int ndist = static_cast<int>(bits(5)) + 1;
+        int ncode = static_cast<int>(bits(4)) + 4;
+        if (nlen > 286 || ndist > 30) fail();
+
+        std::uint8_t lengths[320] = {0};
+        for (int i = 0; i < ncode; ++i) lengths[order[i]] = static_cast<std::uint8_t>(bits(3));
+
+        Huffman lencode, distcode;
+        build(lencode, lengths, 19);
+
+        int index = 0;
+        while (index < nlen + ndist) {
+            int symbol = decode(lencode);
+            if (symbol < 16) {
+                lengths[index++] = static_cast<std::uint8_t>(symbol);
+                continue;
+            }
+            std::uint8_t len = 0;
+            int repeat;
+            if (symbol == 16) {
+                if (index == 0) fail();
+                len = lengths[index - 1];
+                repeat = 3 + static_cast<int>(bits(2));
+            } else if (symbol == 17) {
+                repeat = 3 + static_cast<int>(bits(3));
+            } else {
+                repeat = 11 + static_cast<int>(bits(7));
+            }
+            if (index + repeat > nlen + ndist) fail();
+            while (repeat--) lengths[index++] = len;
+        }
+        if (lengths[256] == 0) fail();
+
+        build(lencode, lengths, nlen);
+        build(distcode, lengths + nlen, ndist);
+        codes(lencode, distcode);
+    }
+
+    std::size_t run() {
+        int last;
+        do {
+            last = static_cast<int>(bits(1));
+            switch (bits(2)) {
+                case 0: stored(); break;
+                case 1: fixed(); break;
+                case 2: dynamic(); break;
+                default: fail();
+            }
+        } while (!last);
+        flush(true);
+        // Whole bytes still sitting in the bit buffer were not consumed
+        return pos - static_cast<std::size_t>(bitcnt / 8);
+    }
+
+public:
+    /**
+     * Decode a raw DEFLATE stream, appending to out
+     * @param limit Most bytes to append, a longer stream throws
+     * @return Number of input bytes consumed
+     */
+    static std::size_t inflate(const void* data, std::size_t size, std::vector<std::uint8_t>& out, std::size_t limit = SIZE_MAX) {
+        Inflater inflater(static_cast<const std::uint8_t*>(data), size, out, nullptr, limit);
+        return inflater.run();
+    }
+
+    /**
+     * Decode a raw DEFLATE stream into a sink, keeping at most a few windows in memory
+     * @param limit Most bytes to pass to the sink, a longer stream throws first
+     * @return Number of input bytes consumed
+     */
+    static std::size_t inflate(const void* data, std::size_t size, const Sink& sink, std::size_t limit = SIZE_MAX) {
+        std::vector<std::uint8_t> window;
+        window.reserve(FLUSH_AT + 258);
+        Inflater inflater(static_cast<const std::uint8_t*>(data), size, window, &sink, limit);
+        return inflater.run();
+    }
+};
+
+} // namespace cnt
+
+#endif // __CNTLIB_INFLATE_HPP__
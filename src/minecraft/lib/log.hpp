@@ -0,0 +1,218 @@
+/*
+ * CNT Library
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: log.hpp
+ * @Description: Asynchronous logging through per-thread rings and a background sink thread
+ * @Ownership: TaimWay <taimway@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __CNTLIB_LOG_HPP__
+#define __CNTLIB_LOG_HPP__
+
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+// Calls below this level are compiled out: 0 trace, 1 debug, 2 info, 3 warn, 4 error
+#ifndef CNT_LOG_LEVEL
+#define CNT_LOG_LEVEL 1
+#endif
+
+// Arguments are only evaluated when the level passes the runtime filter
+#define CNT_LOG(level, ...)                            \
+    do {                                               \
+        if (::cnt::Log::enabled(level))                \
+            ::cnt::Log::write(level, __VA_ARGS__);     \
+    } while (0)
+
+#if CNT_LOG_LEVEL <= 0
+#define CNT_LOG_TRACE(...) CNT_LOG(::cnt::LogLevel::Trace, __VA_ARGS__)
+#else
+#define CNT_LOG_TRACE(...) ((void)0)
+#endif
+#if CNT_LOG_LEVEL <= 1
+#define CNT_LOG_DEBUG(...) CNT_LOG(::cnt::LogLevel::Debug, __VA_ARGS__)
+#else
+#define CNT_LOG_DEBUG(...) ((void)0)
+#endif
+#if CNT_LOG_LEVEL <= 2
+#define CNT_LOG_INFO(...) CNT_LOG(::cnt::LogLevel::Info, __VA_ARGS__)
+#else
+#define CNT_LOG_INFO(...) ((void)0)
+#endif
+#if CNT_LOG_LEVEL <= 3
+#define CNT_LOG_WARN(...) CNT_LOG(::cnt::LogLevel::Warn, __VA_ARGS__)
+#else
+#define CNT_LOG_WARN(...) ((void)0)
+#endif
+#if CNT_LOG_LEVEL <= 4
+#define CNT_LOG_ERROR(...) CNT_LOG(::cnt::LogLevel::Error, __VA_ARGS__)
+#else
+#define CNT_LOG_ERROR(...) ((void)0)
+#endif
+
+namespace cnt {
+
+enum class LogLevel {
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+// A formatted record, only valid during the sink call
+struct LogEntry {
+    LogLevel level;
+    std::chrono::system_clock::time_point time;
+    std::uint32_t thread; // small sequential id, not the OS id
+    std::string_view message;
+};
+
+// Called on the sink thread, one record at a time in timestamp order
+using LogSink = std::function<void(const LogEntry&)>;
+
+// Records go into a fixed ring owned by the calling thread: a string literal
+// format plus the raw arguments, no allocation and no lock. A background thread
+// formats "{}" placeholders and hands the result to the sinks. A full ring
+// drops the record instead of waiting.
+class Log {
+private:
+    static constexpr std::size_t PAYLOAD = 200;
+
+    struct Record {
+        std::chrono::system_clock::time_point time;
+        const char* format;
+        LogLevel level;
+        std::uint16_t size;
+        char data[PAYLOAD];
+    };
+
+    enum class Arg : std::uint8_t {
+        SIGNED,
+        UNSIGNED,
+        FLOAT,
+        BOOLEAN,
+        TEXT
+    };
+
+    static inline std::atomic<int> threshold{static_cast<int>(LogLevel::Info)};
+
+    // Reserve the next slot of this thread's ring, nullptr when it is full
+    static Record* begin(LogLevel level, const char* format);
+    static void commit();
+
+    // Expand the placeholders of a record, on the sink thread
+    static void format(const Record& record, std::string& out);
+
+    // Body of the sink thread
+    static void run();
+
+    static bool put(Record& record, const void* data, std::size_t size) {
+        if (record.size + size > PAYLOAD) return false;
+        std::memcpy(record.data + record.size, data, size);
+        record.size = static_cast<std::uint16_t>(record.size + size);
+        return true;
+    }
+
+    static void text(Record& record, std::string_view value) {
+        if (record.size + 1 + sizeof(std::uint16_t) > PAYLOAD) return;
+        std::uint16_t length = static_cast<std::uint16_t>(
+            std::min(value.size(), PAYLOAD - record.size - 1 - sizeof(std::uint16_t)));
+        Arg tag = Arg::TEXT;
+        put(record, &tag, 1);
+        put(record, &length, sizeof(length));
+        put(record, value.data(), length);
+    }
+
+    template <typename T>
+    static void encode(Record& record, const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            std::uint8_t data[2] = {static_cast<std::uint8_t>(Arg::BOOLEAN), value};
+            put(record, data, sizeof(data));
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            std::uint8_t data[1 + sizeof(std::int64_t)] = {static_cast<std::uint8_t>(Arg::SIGNED)};
+            std::int64_t number = value;
+            std::memcpy(data + 1, &number, sizeof(number));
+            put(record, data, sizeof(data));
+        } else if constexpr (std::is_integral_v<T>) {
+            std::uint8_t data[1 + sizeof(std::uint64_t)] = {static_cast<std::uint8_t>(Arg::UNSIGNED)};
+            std::uint64_t number = value;
+            std::memcpy(data + 1, &number, sizeof(number));
+            put(record, data, sizeof(data));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            std::uint8_t data[1 + sizeof(double)] = {static_cast<std::uint8_t>(Arg::FLOAT)};
+            double number = value;
+            std::memcpy(data + 1, &number, sizeof(number));
+            put(record, data, sizeof(data));
+        } else if constexpr (std::is_same_v<T, std::filesystem::path>) {
+            text(record, value.string());
+        } else {
+            static_assert(std::is_convertible_v<const T&, std::string_view>,
+                          "Log arguments must be numbers, strings or paths");
+            text(record, std::string_view(value));
+        }
+    }
+
+public:
+    static void setLevel(LogLevel level) { threshold.store(static_cast<int>(level), std::memory_order_relaxed); }
+    static LogLevel level() { return static_cast<LogLevel>(threshold.load(std::memory_order_relaxed)); }
+    static bool enabled(LogLevel level) {
+        return static_cast<int>(level) >= threshold.load(std::memory_order_relaxed);
+    }
+
+    template <typename... Args>
+    static void write(LogLevel level, const char* format, const Args&... args) {
+        Record* record = begin(level, format);
+        if (!record) return;
+        (encode(*record, args), ...);
+        commit();
+    }
+
+    // Sinks start as a single stderr sink
+    static void addSink(LogSink sink);
+    static void clearSinks();
+    static LogSink stderrSink();
+    static LogSink fileSink(const std::filesystem::path& path);
+
+    // "2026-10-18 12:34:56.789 WARN  [3] message"
+    static std::string line(const LogEntry& entry);
+
+    // Wait until everything logged before the call reached the sinks
+    static void flush();
+
+    // Records lost because a thread's ring was full
+    static std::uint64_t dropped();
+};
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include "source/log.cpp"
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // __CNTLIB_LOG_HPP__
@@ -0,0 +1,222 @@
+/*
+ * CNT Library
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: memory.hpp
+ * @Description: Tagged allocators with per-subsystem memory accounting
+ * @Ownership: TaimWay <taimway@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __CNTLIB_MEMORY_HPP__
+#define __CNTLIB_MEMORY_HPP__
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Live and peak bytes per tag are only tracked with CNT_MEMORY_ACCOUNTING defined,
+// otherwise tagged allocators cost nothing over std::allocator.
+// Define it (and CNT_ALLOCATION_COUNTER) the same way in every translation unit.
+
+// Per-thread allocation counts for AllocationCounter, opt in with -DCNT_ALLOCATION_COUNTER=1.
+// Not tied to NDEBUG: the library and its users rarely agree on it, and the inline
+// MemoryAccounting::allocated() must be the same everywhere.
+#ifndef CNT_ALLOCATION_COUNTER
+#define CNT_ALLOCATION_COUNTER 0
+#endif
+
+namespace cnt {
+
+enum class MemoryTag : std::uint8_t {
+    CONFIG,   // Parsed config trees
+    MANIFEST, // Compiled launch templates and resolved classpaths
+    JAVA,     // The Java registry
+    LOG,      // Per-thread log rings
+    COUNT
+};
+
+struct MemoryUsage {
+    MemoryTag tag;
+    const char* name;
+    std::uint64_t live = 0;
+    std::uint64_t peak = 0;
+    std::uint64_t allocations = 0; // Since start, not reset with the peaks
+};
+
+namespace internal {
+
+struct alignas(64) MemoryCounters {
+    std::atomic<std::uint64_t> live{0};
+    std::atomic<std::uint64_t> peak{0};
+    std::atomic<std::uint64_t> allocations{0};
+};
+
+inline MemoryCounters memoryCounters[static_cast<std::size_t>(MemoryTag::COUNT)];
+
+#if CNT_ALLOCATION_COUNTER
+inline thread_local std::uint64_t threadAllocations = 0;
+inline thread_local std::uint64_t threadAllocatedBytes = 0;
+#endif
+
+} // namespace internal
+
+class MemoryAccounting {
+public:
+    static constexpr bool enabled() {
+#ifdef CNT_MEMORY_ACCOUNTING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static void allocated(MemoryTag tag, std::size_t bytes) {
+#if CNT_ALLOCATION_COUNTER && !defined(CNT_COUNT_ALL_ALLOCATIONS)
+        internal::threadAllocations++;
+        internal::threadAllocatedBytes += bytes;
+#endif
+#ifdef CNT_MEMORY_ACCOUNTING
+        internal::MemoryCounters& counters = internal::memoryCounters[static_cast<std::size_t>(tag)];
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        std::uint64_t live = counters.live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::uint64_t peak = counters.peak.load(std::memory_order_relaxed);
+        while (live > peak && !counters.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+#else
+        (void)tag;
+        (void)bytes;
+#endif
+    }
+
+    static void freed(MemoryTag tag, std::size_t bytes) {
+#ifdef CNT_MEMORY_ACCOUNTING
+        internal::memoryCounters[static_cast<std::size_t>(tag)].live.fetch_sub(bytes, std::memory_order_relaxed);
+#else
+        (void)tag;
+        (void)bytes;
+#endif
+    }
+
+    static std::uint64_t live(MemoryTag tag) {
+        return internal::memoryCounters[static_cast<std::size_t>(tag)].live.load(std::memory_order_relaxed);
+    }
+
+    static std::uint64_t peak(MemoryTag tag) {
+        return internal::memoryCounters[static_cast<std::size_t>(tag)].peak.load(std::memory_order_relaxed);
+    }
+
+    static const char* name(MemoryTag tag);
+
+    // Usage of every tag, all zero without CNT_MEMORY_ACCOUNTING
+    static std::vector<MemoryUsage> report();
+
+    // report() as an aligned text table
+    static std::string format();
+
+    // Start measuring peaks again from the current live bytes
+    static void resetPeaks();
+};
+
+// std::allocator that accounts its bytes under a tag
+template <typename T, MemoryTag Tag>
+class TaggedAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = TaggedAllocator<U, Tag>;
+    };
+
+    TaggedAllocator() noexcept = default;
+
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        T* p = std::allocator<T>().allocate(n);
+        MemoryAccounting::allocated(Tag, n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        MemoryAccounting::freed(Tag, n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    friend bool operator==(const TaggedAllocator&, const TaggedAllocator&) noexcept { return true; }
+    friend bool operator!=(const TaggedAllocator&, const TaggedAllocator&) noexcept { return false; }
+};
+
+template <typename T, MemoryTag Tag>
+using TaggedVector = std::vector<T, TaggedAllocator<T, Tag>>;
+
+template <MemoryTag Tag>
+using TaggedString = std::basic_string<char, std::char_traits<char>, TaggedAllocator<char, Tag>>;
+
+/**
+ * Allocations made by this thread while the counter is alive, so benchmarks
+ * can assert that a warm path does not allocate
+ * Counts tagged allocators, or every operator new when the implementation is
+ * compiled with CNT_COUNT_ALL_ALLOCATIONS. Reads zero unless available.
+ */
+class AllocationCounter {
+private:
+    std::uint64_t _allocations = 0;
+    std::uint64_t _bytes = 0;
+
+public:
+    static constexpr bool available = CNT_ALLOCATION_COUNTER != 0;
+
+    AllocationCounter() { reset(); }
+
+    void reset() {
+#if CNT_ALLOCATION_COUNTER
+        _allocations = internal::threadAllocations;
+        _bytes = internal::threadAllocatedBytes;
+#endif
+    }
+
+    std::uint64_t allocations() const {
+#if CNT_ALLOCATION_COUNTER
+        return internal::threadAllocations - _allocations;
+#else
+        return 0;
+#endif
+    }
+
+    std::uint64_t bytes() const {
+#if CNT_ALLOCATION_COUNTER
+        return internal::threadAllocatedBytes - _bytes;
+#else
+        return 0;
+#endif
+    }
+};
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include "source/memory.cpp"
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // __CNTLIB_MEMORY_HPP__
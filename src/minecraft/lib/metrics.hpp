@@ -0,0 +1,376 @@
+/*
+ * CNT Library
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: metrics.hpp
+ * @Description: Sharded counters, gauges and log-bucketed histograms with Prometheus text exposition
+ * @Ownership: TaimWay <taimway@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __CNTLIB_METRICS_HPP__
+#define __CNTLIB_METRICS_HPP__
+
+#include <map>
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace cnt {
+
+// Monotonic count. Every thread adds to its own cache line, value() sums them.
+class Counter {
+private:
+    static constexpr std::size_t SHARDS = 16;
+
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    std::array<Slot, SHARDS> slots;
+
+    static std::size_t shard() {
+        static std::atomic<std::size_t> next{0};
+        static thread_local std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+        return index;
+    }
+
+public:
+    void add(std::uint64_t n = 1) { slots[shard()].value.fetch_add(n, std::memory_order_relaxed); }
+
+    std::uint64_t value() const {
+        std::uint64_t total = 0;
+        for (const auto& slot : slots) total += slot.value.load(std::memory_order_relaxed);
+        return total;
+    }
+};
+
+// Value that goes up and down (sizes, things in flight)
+class Gauge {
+private:
+    std::atomic<std::int64_t> current{0};
+
+public:
+    void set(std::int64_t value) { current.store(value, std::memory_order_relaxed); }
+    void add(std::int64_t delta) { current.fetch_add(delta, std::memory_order_relaxed); }
+    std::int64_t value() const { return current.load(std::memory_order_relaxed); }
+};
+
+struct HistogramSnapshot {
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    // (inclusive upper bound, count) of every non-empty bucket, ascending
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> buckets;
+
+    // Upper bound of the bucket holding the q-th quantile, 0 when empty
+    std::uint64_t quantile(double q) const {
+        if (count == 0) return 0;
+        double rank = q * static_cast<double>(count);
+        std::uint64_t seen = 0;
+        for (const auto& [upper, n] : buckets) {
+            seen += n;
+            if (static_cast<double>(seen) >= rank) return upper;
+        }
+        return buckets.back().first;
+    }
+};
+
+// Distribution of integer samples in log-linear buckets: every power of two is
+// split into 8 sub-buckets, so any recorded value is known within 12.5%
+class Histogram {
+public:
+    static constexpr int SUB_BITS = 3;
+    static constexpr std::size_t SUB = std::size_t(1) << SUB_BITS;
+    static constexpr std::size_t BUCKETS = (64 - SUB_BITS + 1) * SUB;
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKETS> counts{};
+    std::atomic<std::uint64_t> total{0};
+
+    static int log2(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(value);
+#else
+        int result = 0;
+        while (value >>= 1) ++result;
+        return result;
+#endif
+    }
+
+public:
+    static std::size_t bucket(std::uint64_t value) {
+        if (value < SUB) return static_cast<std::size_t>(value);
+        int exponent = log2(value);
+        return static_cast<std::size_t>(exponent - SUB_BITS + 1) * SUB +
+               static_cast<std::size_t>((value >> (exponent - SUB_BITS)) & (SUB - 1));
+    }
+
+    // Largest value that falls into a bucket
+    static std::uint64_t upper(std::size_t index) {
+        if (index < SUB) return index;
+        int shift = static_cast<int>(index / SUB) - 1;
+        std::uint64_t lower = (SUB + index % SUB) << shift;
+        return lower + ((std::uint64_t(1) << shift) - 1);
+    }
+
+    void record(std::uint64_t value) {
+        counts[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot snapshot() const {
+        HistogramSnapshot result;
+        result.sum = total.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < BUCKETS; ++i) {
+            std::uint64_t n = counts[i].load(std::memory_order_relaxed);
+            if (n == 0) continue;
+            result.count += n;
+            result.buckets.emplace_back(upper(i), n);
+        }
+        return result;
+    }
+};
+
+// Records the lifetime of a scope into a histogram, in microseconds
+class HistogramTimer {
+private:
+    Histogram& histogram;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit HistogramTimer(Histogram& _histogram)
+        : histogram(_histogram), start(std::chrono::steady_clock::now()) {}
+
+    ~HistogramTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        histogram.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    }
+
+    HistogramTimer(const HistogramTimer&) = delete;
+    HistogramTimer& operator=(const HistogramTimer&) = delete;
+};
+
+enum class MetricType {
+    COUNTER,
+    GAUGE,
+    HISTOGRAM
+};
+
+struct MetricSample {
+    std::string name;
+    std::string labels; // 'cache="natives"', empty for none
+    std::string help;
+    MetricType type;
+    double value = 0;             // counters and gauges
+    double scale = 1;             // unit of histogram samples in the exposition
+    HistogramSnapshot histogram;
+};
+
+// Named metrics of the process. Lookups take a lock, so call sites keep the
+// returned reference (a function-local static) and only touch the metric.
+class Metrics {
+private:
+    struct Entry {
+        std::string name;
+        std::string labels;
+        std::string help;
+        MetricType type;
+        double scale = 1;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    mutable std::mutex mutex;
+    std::map<std::string, Entry> entries;
+
+    Entry& entry(const std::string& name, const std::string& labels, const std::string& help, MetricType type) {
+        std::string key = labels.empty() ? name : name + '{' + labels + '}';
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            if (it->second.type != type) {
+                throw std::logic_error("Metric registered with another type: " + key);
+            }
+            return it->second;
+        }
+        Entry& created = entries[key];
+        created.name = name;
+        created.labels = labels;
+        created.help = help;
+        created.type = type;
+        return created;
+    }
+
+    static void format(std::string& out, double value) {
+        char number[32];
+        std::snprintf(number, sizeof(number), "%.12g", value);
+        out += number;
+    }
+
+public:
+    static Metrics& shared() {
+        static Metrics metrics;
+        return metrics;
+    }
+
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "") {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry& found = entry(name, labels, help, MetricType::COUNTER);
+        if (!found.counter) found.counter = std::make_unique<Counter>();
+        return *found.counter;
+    }
+
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "") {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry& found = entry(name, labels, help, MetricType::GAUGE);
+        if (!found.gauge) found.gauge = std::make_unique<Gauge>();
+        return *found.gauge;
+    }
+
+    /**
+     * @param scale Factor from recorded samples to the exposed unit, e.g. 1e-6
+     *              for microseconds from HistogramTimer exposed as seconds
+     */
+    Histogram& histogram(const std::string& name, const std::string& help, const std::string& labels = "",
+                         double scale = 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry& found = entry(name, labels, help, MetricType::HISTOGRAM);
+        if (!found.histogram) {
+            found.histogram = std::make_unique<Histogram>();
+            found.scale = scale;
+        }
+        return *found.histogram;
+    }
+
+    // Current value of every metric, sorted by name
+    std::vector<MetricSample> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<MetricSample> samples;
+        samples.reserve(entries.size());
+        for (const auto& [key, found] : entries) {
+            MetricSample sample;
+            sample.name = found.name;
+            sample.labels = found.labels;
+            sample.help = found.help;
+            sample.type = found.type;
+            sample.scale = found.scale;
+            if (found.counter) sample.value = static_cast<double>(found.counter->value());
+            if (found.gauge) sample.value = static_cast<double>(found.gauge->value());
+            if (found.histogram) sample.histogram = found.histogram->snapshot();
+            samples.push_back(std::move(sample));
+        }
+        return samples;
+    }
+
+    // Prometheus text exposition format 0.0.4
+    std::string prometheus() const {
+        static const char* types[] = {"counter", "gauge", "histogram"};
+        std::string out;
+        std::string previous;
+        for (const auto& sample : snapshot()) {
+            if (sample.name != previous) {
+                out += "# HELP " + sample.name + ' ' + sample.help + '\n';
+                out += "# TYPE " + sample.name + ' ' + types[static_cast<int>(sample.type)] + '\n';
+                previous = sample.name;
+            }
+
+            std::string labels = sample.labels.empty() ? "" : '{' + sample.labels + '}';
+            if (sample.type != MetricType::HISTOGRAM) {
+                out += sample.name + labels + ' ';
+                format(out, sample.value);
+                out += '\n';
+                continue;
+            }
+
+            std::string prefix = sample.labels.empty() ? "{" : '{' + sample.labels + ',';
+            std::uint64_t cumulative = 0;
+            for (const auto& [upper, n] : sample.histogram.buckets) {
+                cumulative += n;
+                out += sample.name + "_bucket" + prefix + "le=\"";
+                format(out, static_cast<double>(upper) * sample.scale);
+                out += "\"} " + std::to_string(cumulative) + '\n';
+            }
+            out += sample.name + "_bucket" + prefix + "le=\"+Inf\"} " + std::to_string(sample.histogram.count) + '\n';
+            out += sample.name + "_sum" + labels + ' ';
+            format(out, static_cast<double>(sample.histogram.sum) * sample.scale);
+            out += '\n';
+            out += sample.name + "_count" + labels + ' ' + std::to_string(sample.histogram.count) + '\n';
+        }
+        return out;
+    }
+
+    // Replace a file atomically, e.g. for the node_exporter textfile collector
+    void write(const std::filesystem::path& path) const {
+        // Unique per process and per call, concurrent writers must not share the file
+        static std::atomic<unsigned long long> sequence{0};
+#ifdef _WIN32
+        const auto pid = ::_getpid();
+#else
+        const auto pid = ::getpid();
+#endif
+        std::filesystem::path temporary = path;
+        temporary += ".tmp-" + std::to_string(pid) + '-' + std::to_string(sequence.fetch_add(1, std::memory_order_relaxed));
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                throw std::runtime_error("Cannot open file: " + temporary.string());
+            }
+            file << prometheus();
+            if (!file) {
+                throw std::runtime_error("Cannot write file: " + temporary.string());
+            }
+        }
+        std::filesystem::rename(temporary, path);
+    }
+
+#ifndef _WIN32
+    // Write the exposition to a connected socket or pipe
+    void write(int fd) const {
+        std::string text = prometheus();
+        std::size_t done = 0;
+        while (done < text.size()) {
+            ssize_t n = ::write(fd, text.data() + done, text.size() - done);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Cannot write metrics");
+            }
+            done += static_cast<std::size_t>(n);
+        }
+    }
+#endif
+};
+
+} // namespace cnt
+
+#endif // __CNTLIB_METRICS_HPP__
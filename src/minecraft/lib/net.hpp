@@ -37,6 +37,9 @@
 
 #include <string>
 
+#include "trace.hpp"
+#include "metrics.hpp"
+
 namespace cnt
 {
     class HttpState
@@ -73,22 +76,44 @@ namespace cnt
         bool isOk() const { return _code == 200; }
     };
 
-    HttpState DownloadFile(std::string url, std::string path)
+    inline HttpState DownloadFile(std::string url, std::string path)
     {
+        CNT_TRACE_SCOPE_DETAIL("download", "DownloadFile", url);
+        static Counter &downloads = Metrics::shared().counter("cnt_downloads_total", "Files requested with DownloadFile");
+        static Counter &failures = Metrics::shared().counter("cnt_download_failures_total", "Downloads that did not succeed");
+        static Counter &bytes = Metrics::shared().counter("cnt_download_bytes_total", "Bytes stored by successful downloads");
+        static Histogram &duration = Metrics::shared().histogram("cnt_download_duration_seconds", "Time spent in DownloadFile", "", 1e-6);
+        HistogramTimer timer(duration);
+        downloads.add();
+
+        HttpState state(400);
 #ifdef _WIN32
         switch (URLDownloadToFile(NULL, url.c_str(), path.c_str(), 0, NULL))
         {
         case S_OK:
-            return HttpState(200);
+            state = 200;
+            break;
         case E_OUTOFMEMORY:
-            return HttpState(500);
+            state = 500;
+            break;
         case INET_E_DOWNLOAD_FAILURE:
-            return HttpState(404);
+            state = 404;
+            break;
         default:
             break;
         }
-        return HttpState(400);
 #endif
+
+        if (state.isOk())
+        {
+            std::error_code ec;
+            std::uintmax_t size = std::filesystem::file_size(path, ec);
+            if (!ec)
+                bytes.add(size);
+        }
+        else
+            failures.add();
+        return state;
     }
 }
 
@@ -0,0 +1,132 @@
+/*
+ * CNT Library
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: result.hpp
+ * @Description: Result<T, E> for error propagation without exceptions
+ * @Ownership: TaimWay <taimway@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __CNTLIB_RESULT_HPP__
+#define __CNTLIB_RESULT_HPP__
+
+#include <string>
+#include <utility>
+#include <variant>
+#include <type_traits>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+
+namespace cnt {
+
+enum class Errc {
+    NOT_FOUND,
+    PERMISSION_DENIED,
+    IO,
+    PARSE,
+    INVALID,
+    OUT_OF_RANGE
+};
+
+struct Error {
+    Errc code = Errc::INVALID;
+    std::string context;    // what was being done, e.g. "Reading versions/1.20.json"
+    std::string detail;     // what went wrong
+    std::error_code system; // set when the operating system reported the failure
+
+    Error() = default;
+    Error(Errc _code, std::string _detail, std::string _context = {})
+        : code(_code), context(std::move(_context)), detail(std::move(_detail)) {}
+
+    static Error from(std::error_code ec, std::string context) {
+        Errc code = Errc::IO;
+        if (ec == std::errc::no_such_file_or_directory) code = Errc::NOT_FOUND;
+        else if (ec == std::errc::permission_denied || ec == std::errc::operation_not_permitted)
+            code = Errc::PERMISSION_DENIED;
+        Error error(code, ec.message(), std::move(context));
+        error.system = ec;
+        return error;
+    }
+
+    std::string message() const {
+        return context.empty() ? detail : context + ": " + detail;
+    }
+};
+
+// Either a value or the Error that prevented it. value() on a failed result
+// throws, which is what the throwing wrappers around try_* functions rely on.
+template <typename T, typename E = Error>
+class Result {
+private:
+    std::variant<T, E> state;
+
+    void check() const {
+        if (!ok()) {
+            if constexpr (std::is_same_v<E, Error>) throw std::runtime_error(std::get<1>(state).message());
+            else throw std::runtime_error("Result holds an error");
+        }
+    }
+
+public:
+    Result(T value) : state(std::in_place_index<0>, std::move(value)) {}
+    Result(E error) : state(std::in_place_index<1>, std::move(error)) {}
+
+    bool ok() const { return state.index() == 0; }
+    explicit operator bool() const { return ok(); }
+
+    T& value() & { check(); return std::get<0>(state); }
+    const T& value() const& { check(); return std::get<0>(state); }
+    T&& value() && { check(); return std::get<0>(std::move(state)); }
+
+    T value_or(T fallback) const& { return ok() ? std::get<0>(state) : std::move(fallback); }
+
+    // Only valid on a failed result
+    const E& error() const { return std::get<1>(state); }
+
+    T* operator->() { return &value(); }
+    const T* operator->() const { return &value(); }
+    T& operator*() & { return value(); }
+    const T& operator*() const& { return value(); }
+};
+
+template <typename E>
+class Result<void, E> {
+private:
+    std::optional<E> failure;
+
+public:
+    Result() = default;
+    Result(E error) : failure(std::move(error)) {}
+
+    bool ok() const { return !failure.has_value(); }
+    explicit operator bool() const { return ok(); }
+
+    void value() const {
+        if (!ok()) {
+            if constexpr (std::is_same_v<E, Error>) throw std::runtime_error(failure->message());
+            else throw std::runtime_error("Result holds an error");
+        }
+    }
+
+    const E& error() const { return *failure; }
+};
+
+} // namespace cnt
+
+#endif // __CNTLIB_RESULT_HPP__
@@ -0,0 +1,160 @@
+/*
+ * CNT Library
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: sha1.hpp
+ * @Description: SHA-1 digest
+ * @Ownership: TaimWay <taimway@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef __CNTLIB_SHA1_HPP__
+#define __CNTLIB_SHA1_HPP__
+
+#include <array>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+
+namespace cnt {
+
+class Sha1 {
+public:
+    using Digest = std::array<std::uint8_t, 20>;
+
+private:
+    std::uint32_t state[5];
+    std::uint8_t block[64];
+    std::size_t used = 0;
+    std::uint64_t length = 0;
+
+    static std::uint32_t rotl(std::uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+    void transform(const std::uint8_t* data) {
+        std::uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (std::uint32_t(data[i * 4]) << 24) | (std::uint32_t(data[i * 4 + 1]) << 16) |
+                   (std::uint32_t(data[i * 4 + 2]) << 8) | std::uint32_t(data[i * 4 + 3]);
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+        for (int i = 0; i < 80; ++i) {
+            std::uint32_t f, k;
+            if (i < 20) { f = (b & c) | (~b & d); k = 0x5A827999; }
+            else if (i < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1; }
+            else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+            else { f = b ^ c ^ d; k = 0xCA62C1D6; }
+            std::uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d; d = c; c = rotl(b, 30); b = a; a = temp;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d; state[4] += e;
+    }
+
+public:
+    Sha1() { reset(); }
+
+    void reset() {
+        state[0] = 0x67452301; state[1] = 0xEFCDAB89; state[2] = 0x98BADCFE;
+        state[3] = 0x10325476; state[4] = 0xC3D2E1F0;
+        used = 0;
+        length = 0;
+    }
+
+    void update(const void* data, std::size_t size) {
+        const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+        length += size;
+        if (used > 0) {
+            std::size_t take = std::min(size, sizeof(block) - used);
+            std::memcpy(block + used, bytes, take);
+            used += take; bytes += take; size -= take;
+            if (used < sizeof(block)) return;
+            transform(block);
+            used = 0;
+        }
+        while (size >= 64) {
+            transform(bytes);
+            bytes += 64; size -= 64;
+        }
+        std::memcpy(block, bytes, size);
+        used = size;
+    }
+
+    void update(const std::string& data) { update(data.data(), data.size()); }
+
+    Digest digest() {
+        std::uint64_t bits = length * 8;
+        std::uint8_t pad = 0x80;
+        update(&pad, 1);
+        pad = 0;
+        while (used != 56) update(&pad, 1);
+        std::uint8_t size[8];
+        for (int i = 0; i < 8; ++i) size[i] = std::uint8_t(bits >> (56 - i * 8));
+        update(size, 8);
+
+        Digest result;
+        for (int i = 0; i < 5; ++i) {
+            result[i * 4] = std::uint8_t(state[i] >> 24);
+            result[i * 4 + 1] = std::uint8_t(state[i] >> 16);
+            result[i * 4 + 2] = std::uint8_t(state[i] >> 8);
+            result[i * 4 + 3] = std::uint8_t(state[i]);
+        }
+        reset();
+        return result;
+    }
+
+    std::string hex_digest() { return to_hex(digest()); }
+
+    static std::string to_hex(const Digest& digest) {
+        static const char* digits = "0123456789abcdef";
+        std::string result(40, '0');
+        for (std::size_t i = 0; i < digest.size(); ++i) {
+            result[i * 2] = digits[digest[i] >> 4];
+            result[i * 2 + 1] = digits[digest[i] & 15];
+        }
+        return result;
+    }
+
+    static std::string hash(const std::string& data) {
+        Sha1 sha;
+        sha.update(data);
+        return sha.hex_digest();
+    }
+
+    static std::string hash_file(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open file: " + path.string());
+        }
+        Sha1 sha;
+        char buffer[1 << 16];
+        while (file) {
+            file.read(buffer, sizeof(buffer));
+            sha.update(buffer, static_cast<std::size_t>(file.gcount()));
+        }
+        return sha.hex_digest();
+    }
+};
+
+} // namespace cnt
+
+#endif // __CNTLIB_SHA1_HPP__
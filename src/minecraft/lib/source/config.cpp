@@ -0,0 +1,564 @@
+/*
+ * CNT Library
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: source/config.cpp
+ * @Description: Config file parser and writer
+ * @Ownership: TaimWay <taimway@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../config.hpp"
+#include "../trace.hpp"
+#include "../metrics.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+
+namespace cnt {
+
+Result<std::string> Config::read_file(const fs::path& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        Error error = Error::from(std::error_code(errno, std::generic_category()), {});
+        error.detail = "Cannot open file: " + path.string();
+        return error;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+void Config::skip_whitespace(const std::string& content, size_t& pos) {
+    while (pos < content.size() && std::isspace(content[pos])) {
+        pos++;
+    }
+}
+
+void Config::skip_comment(const std::string& content, size_t& pos) {
+    if (pos < content.size() && content[pos] == '/') {
+        if (pos + 1 < content.size()) {
+            if (content[pos + 1] == '/') {
+                // Single line comment
+                while (pos < content.size() && content[pos] != '\n') {
+                    pos++;
+                }
+            } else if (content[pos + 1] == '*') {
+                // Multi-line comment
+                pos += 2;
+                while (pos + 1 < content.size() && 
+                       !(content[pos] == '*' && content[pos + 1] == '/')) {
+                    pos++;
+                }
+                if (pos + 1 < content.size()) {
+                    pos += 2; // Skip "*/"
+                }
+            }
+        }
+    }
+}
+
+void Config::skip_blank(const std::string& content, size_t& pos) {
+    skip_whitespace(content, pos);
+    while (pos < content.size() && content[pos] == '/') {
+        size_t old_pos = pos;
+        skip_comment(content, pos);
+        if (pos == old_pos) break; // Not a comment
+        skip_whitespace(content, pos);
+    }
+}
+
+std::string Config::parse_key(const std::string& content, size_t& pos) {
+    skip_whitespace(content, pos);
+    
+    std::string key;
+    if (pos < content.size() && content[pos] == '"') {
+        // Quoted key
+        pos++;
+        while (pos < content.size() && content[pos] != '"') {
+            key += content[pos];
+            pos++;
+        }
+        if (pos < content.size() && content[pos] == '"') {
+            pos++;
+        }
+    } else {
+        // Unquoted identifier
+        while (pos < content.size() && 
+               (std::isalnum(content[pos]) || content[pos] == '_' || content[pos] == '-')) {
+            key += content[pos];
+            pos++;
+        }
+    }
+    return key;
+}
+
+// pos is on the 'u' of a unicode escape and is left on its last hex digit.
+// A surrogate pair becomes one code point, a lone surrogate U+FFFD.
+bool Config::parse_unicode_escape(const std::string& content, size_t& pos, std::string& out) {
+    auto hex4 = [&](size_t at, uint32_t& unit) {
+        if (content.size() - at < 4) return false;
+        unit = 0;
+        for (size_t i = at; i < at + 4; i++) {
+            char c = content[i];
+            unit <<= 4;
+            if (c >= '0' && c <= '9') unit |= uint32_t(c - '0');
+            else if (c >= 'a' && c <= 'f') unit |= uint32_t(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') unit |= uint32_t(c - 'A' + 10);
+            else return false;
+        }
+        return true;
+    };
+
+    uint32_t code = 0;
+    if (!hex4(pos + 1, code)) {
+        fail("Invalid unicode escape at " + std::to_string(pos - 1));
+        return false;
+    }
+    pos += 4;
+
+    if (code >= 0xD800 && code <= 0xDBFF) {
+        uint32_t low = 0;
+        if (content.compare(pos + 1, 2, "\\u") == 0 && hex4(pos + 3, low) && low >= 0xDC00 && low <= 0xDFFF) {
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            pos += 6;
+        } else {
+            code = 0xFFFD;
+        }
+    } else if (code >= 0xDC00 && code <= 0xDFFF) {
+        code = 0xFFFD;
+    }
+
+    if (code < 0x80) {
+        out += char(code);
+    } else if (code < 0x800) {
+        out += char(0xC0 | (code >> 6));
+        out += char(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += char(0xE0 | (code >> 12));
+        out += char(0x80 | ((code >> 6) & 0x3F));
+        out += char(0x80 | (code & 0x3F));
+    } else {
+        out += char(0xF0 | (code >> 18));
+        out += char(0x80 | ((code >> 12) & 0x3F));
+        out += char(0x80 | ((code >> 6) & 0x3F));
+        out += char(0x80 | (code & 0x3F));
+    }
+    return true;
+}
+
+ConfigObject Config::parse_value(const std::string& content, size_t& pos, size_t depth) {
+    skip_blank(content, pos);
+    
+    if (pos >= content.size()) return ConfigObject();
+    
+    // Check for None (JSON null is accepted as well)
+    if (content.compare(pos, 4, "None") == 0 || content.compare(pos, 4, "null") == 0) {
+        pos += 4;
+        return ConfigObject(nullptr);
+    }
+    
+    // Check for boolean
+    if (content.substr(pos, 4) == "true") {
+        pos += 4;
+        return ConfigObject(true);
+    }
+    if (content.substr(pos, 5) == "false") {
+        pos += 5;
+        return ConfigObject(false);
+    }
+    
+    // Check for string
+    if (content[pos] == '"') {
+        pos++;
+        std::string str;
+        while (pos < content.size() && content[pos] != '"') {
+            if (content[pos] == '\\' && pos + 1 < content.size()) {
+                // Handle escape sequences
+                pos++;
+                switch (content[pos]) {
+                    case 'n': str += '\n'; break;
+                    case 't': str += '\t'; break;
+                    case 'r': str += '\r'; break;
+                    case 'b': str += '\b'; break;
+                    case 'f': str += '\f'; break;
+                    case '\\': str += '\\'; break;
+                    case '"': str += '"'; break;
+                    case 'u':
+                        if (!parse_unicode_escape(content, pos, str)) return ConfigObject();
+                        break;
+                    default: str += content[pos]; break;
+                }
+            } else {
+                str += content[pos];
+            }
+            pos++;
+        }
+        if (pos < content.size() && content[pos] == '"') {
+            pos++;
+        }
+        return ConfigObject(str);
+    }
+    
+    // Check for character
+    if (content[pos] == '\'') {
+        pos++;
+        char ch = '\0';
+        if (pos < content.size()) {
+            if (content[pos] == '\\' && pos + 1 < content.size()) {
+                // Handle escape sequences
+                pos++;
+                switch (content[pos]) {
+                    case 'n': ch = '\n'; break;
+                    case 't': ch = '\t'; break;
+                    case 'r': ch = '\r'; break;
+                    case 'b': ch = '\b'; break;
+                    case 'f': ch = '\f'; break;
+                    case '\\': ch = '\\'; break;
+                    case '\'': ch = '\''; break;
+                    default: ch = content[pos]; break;
+                }
+            } else {
+                ch = content[pos];
+            }
+            pos++;
+        }
+        if (pos < content.size() && content[pos] == '\'') {
+            pos++;
+        }
+        return ConfigObject(ch);
+    }
+    
+    // Check for array
+    if (content[pos] == '[') {
+        if (depth >= MAX_DEPTH) {
+            return fail("Nesting deeper than " + std::to_string(MAX_DEPTH) + " at " + std::to_string(pos));
+        }
+        pos++;
+        ConfigArray array;
+        
+        skip_blank(content, pos);
+        while (pos < content.size() && content[pos] != ']') {
+            size_t start = pos;
+            auto value = parse_value(content, pos, depth + 1);
+            if (parse_error) return ConfigObject();
+            if (pos == start) {
+                return fail("Unexpected character in array at " + std::to_string(pos));
+            }
+            array.push_back(value);
+            
+            skip_blank(content, pos);
+            if (pos < content.size() && content[pos] == ',') {
+                pos++;
+                skip_blank(content, pos);
+            }
+        }
+        if (pos < content.size() && content[pos] == ']') {
+            pos++;
+        }
+        return ConfigObject(std::move(array));
+    }
+    
+    // Check for object
+    if (content[pos] == '{') {
+        if (depth >= MAX_DEPTH) {
+            return fail("Nesting deeper than " + std::to_string(MAX_DEPTH) + " at " + std::to_string(pos));
+        }
+        pos++;
+        ConfigMap object;
+        
+        skip_blank(content, pos);
+        while (pos < content.size() && content[pos] != '}') {
+            size_t start = pos;
+            auto key = parse_key(content, pos);
+            if (pos == start) {
+                return fail("Unexpected character in object at " + std::to_string(pos));
+            }
+            
+            skip_blank(content, pos);
+            if (pos < content.size() && content[pos] == ':') {
+                pos++;
+            }
+            
+            auto value = parse_value(content, pos, depth + 1);
+            if (parse_error) return ConfigObject();
+            object[key] = value;
+            
+            skip_blank(content, pos);
+            if (pos < content.size() && content[pos] == ',') {
+                pos++;
+                skip_blank(content, pos);
+            }
+        }
+        if (pos < content.size() && content[pos] == '}') {
+            pos++;
+        }
+        return ConfigObject(std::move(object));
+    }
+    
+    // Check for number
+    if (std::isdigit(content[pos]) || content[pos] == '-' || content[pos] == '+') {
+        std::string num_str;
+        bool has_decimal = false;
+        
+        // Handle sign
+        if (content[pos] == '-' || content[pos] == '+') {
+            num_str += content[pos];
+            pos++;
+        }
+        
+        // Parse number
+        while (pos < content.size() && 
+               (std::isdigit(content[pos]) || content[pos] == '.' || 
+                content[pos] == 'e' || content[pos] == 'E' ||
+                content[pos] == '+' || content[pos] == '-')) {
+            if (content[pos] == '.') has_decimal = true;
+            num_str += content[pos];
+            pos++;
+        }
+        
+        // strtod/strtoll instead of stod/stoll: a bad number must not unwind
+        char* end = nullptr;
+        errno = 0;
+        if (has_decimal) {
+            double number = std::strtod(num_str.c_str(), &end);
+            if (end == num_str.c_str() || *end != '\0' || errno == ERANGE) return fail("Invalid number: " + num_str);
+            return ConfigObject(number);
+        }
+        long long number = std::strtoll(num_str.c_str(), &end, 10);
+        if (end == num_str.c_str() || *end != '\0' || errno == ERANGE) return fail("Invalid number: " + num_str);
+        return ConfigObject(number);
+    }
+    
+    return ConfigObject();
+}
+
+ConfigObject Config::fail(std::string detail) {
+    if (!parse_error) parse_error = Error(Errc::PARSE, std::move(detail));
+    return ConfigObject();
+}
+
+Result<void> Config::parse_content(const std::string& content) {
+    static Counter& parsed = Metrics::shared().counter("cnt_configs_parsed_total", "Documents parsed by Config");
+    static Counter& bytes = Metrics::shared().counter("cnt_config_bytes_total", "Bytes of documents parsed by Config");
+    parsed.add();
+    bytes.add(content.size());
+
+    // Parsed aside, a failed parse keeps the previous contents
+    auto parsed_data = std::make_unique<ConfigMap>();
+    parse_error.reset();
+    size_t pos = 0;
+    
+    while (pos < content.size()) {
+        size_t start = pos;
+        skip_blank(content, pos);
+        
+        if (pos >= content.size()) break;
+        
+        // A JSON document: members of a top-level object become top-level keys,
+        // a top-level array is kept under "_root"
+        if (content[pos] == '{' || content[pos] == '[') {
+            ConfigObject root = parse_value(content, pos);
+            if (parse_error) break;
+            if (root.is_object()) {
+                for (const auto& key : root.keys()) {
+                    (*parsed_data)[key] = root.at(key);
+                }
+            } else {
+                (*parsed_data)["_root"] = root;
+            }
+            continue;
+        }
+        
+        // Parse key-value pair
+        std::string key = parse_key(content, pos);
+        
+        skip_whitespace(content, pos);
+        if (pos < content.size() && content[pos] == ':') {
+            pos++;
+        }
+        
+        ConfigObject value = parse_value(content, pos);
+        if (parse_error) break;
+        
+        if (!key.empty()) {
+            (*parsed_data)[key] = value;
+        }
+        
+        skip_whitespace(content, pos);
+        if (pos < content.size() && content[pos] == ',') {
+            pos++;
+        }
+        if (pos == start) {
+            fail("Unexpected character at " + std::to_string(pos));
+            break;
+        }
+    }
+
+    if (parse_error) {
+        Error error = std::move(*parse_error);
+        parse_error.reset();
+        return error;
+    }
+    data = std::move(parsed_data);
+    return {};
+}
+
+void Config::write_value(std::ostream& os, const ConfigObject& obj, int indent, bool is_inline) {
+    const std::string indent_str(indent * 4, ' ');
+    
+    switch (obj.get_type()) {
+        case ConfigType::NONE:
+            os << "None";
+            break;
+        case ConfigType::NUMBER:
+            os << obj.as_number().value();
+            break;
+        case ConfigType::FLOAT:
+            os << obj.as_float().value();
+            break;
+        case ConfigType::BOOLEAN:
+            os << (obj.as_boolean().value() ? "true" : "false");
+            break;
+        case ConfigType::STRING: {
+            std::string str = obj.as_string().value();
+            // Escape special characters
+            std::string escaped;
+            for (char c : str) {
+                switch (c) {
+                    case '\n': escaped += "\\n"; break;
+                    case '\t': escaped += "\\t"; break;
+                    case '\r': escaped += "\\r"; break;
+                    case '\b': escaped += "\\b"; break;
+                    case '\f': escaped += "\\f"; break;
+                    case '\\': escaped += "\\\\"; break;
+                    case '"': escaped += "\\\""; break;
+                    default: escaped += c; break;
+                }
+            }
+            os << "\"" << escaped << "\"";
+            break;
+        }
+        case ConfigType::CHARACTER: {
+            char ch = obj.as_character().value();
+            switch (ch) {
+                case '\n': os << "'\\n'"; break;
+                case '\t': os << "'\\t'"; break;
+                case '\r': os << "'\\r'"; break;
+                case '\\': os << "'\\\\'"; break;
+                case '\'': os << "'\\''"; break;
+                default: os << "'" << ch << "'"; break;
+            }
+            break;
+        }
+        case ConfigType::OBJECT: {
+            const auto obj_ptr = obj.get_as<std::shared_ptr<ConfigMap>>();
+            if (!obj_ptr) break;
+            
+            const auto& map_obj = *obj_ptr.value();
+            if (map_obj.empty()) {
+                os << "{}";
+            } else if (is_inline) {
+                os << "{";
+                bool first = true;
+                for (const auto& [key, value] : map_obj) {
+                    if (!first) os << ", ";
+                    os << "\"" << key << "\": ";
+                    write_value(os, value, 0, true);
+                    first = false;
+                }
+                os << "}";
+            } else {
+                os << "{\n";
+                bool first = true;
+                for (const auto& [key, value] : map_obj) {
+                    if (!first) os << ",\n";
+                    os << indent_str << "    \"" << key << "\": ";
+                    write_value(os, value, indent + 1, false);
+                    first = false;
+                }
+                os << "\n" << indent_str << "}";
+            }
+            break;
+        }
+        case ConfigType::ARRAY: {
+            const auto arr_ptr = obj.get_as<std::shared_ptr<ConfigArray>>();
+            if (!arr_ptr) break;
+            
+            const auto& vec = *arr_ptr.value();
+            if (vec.empty()) {
+                os << "[]";
+            } else if (is_inline || vec.size() <= 3) {
+                os << "[";
+                for (size_t i = 0; i < vec.size(); ++i) {
+                    if (i > 0) os << ", ";
+                    write_value(os, vec[i], 0, true);
+                }
+                os << "]";
+            } else {
+                os << "[\n";
+                for (size_t i = 0; i < vec.size(); ++i) {
+                    if (i > 0) os << ",\n";
+                    os << indent_str << "    ";
+                    write_value(os, vec[i], indent + 1, false);
+                }
+                os << "\n" << indent_str << "]";
+            }
+            break;
+        }
+    }
+}
+
+Result<void> Config::try_open(const fs::path& path) {
+    CNT_TRACE_SCOPE_DETAIL("config", "Config::open", path.filename().string());
+    Result<void> result;
+    Result<std::string> content = read_file(path);
+    if (content) result = parse_content(*content);
+    else result = content.error();
+
+    if (!result) {
+        static Counter& failures = Metrics::shared().counter("cnt_config_failures_total", "Config files that could not be read or parsed");
+        failures.add();
+        return result;
+    }
+    filepath = path;
+    opened = true;
+    return result;
+}
+
+Result<void> Config::try_parse(const std::string& content) {
+    Result<void> result = parse_content(content);
+    if (result) {
+        filepath = std::nullopt;
+        opened = true;
+    }
+    return result;
+}
+
+void Config::save(const fs::path& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot save to file: " + path.string());
+    }
+    
+    for (const auto& [key, value] : *data) {
+        file << key << ": ";
+        write_value(file, value, 0, false);
+        file << "\n";
+    }
+}
+
+} // namespace cnt
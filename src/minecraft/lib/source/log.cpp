@@ -0,0 +1,324 @@
+/*
+ * CNT Library
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: source/log.cpp
+ * @Description: Log rings, sink thread and formatting
+ * @Ownership: TaimWay <taimway@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "../log.hpp"
+#include "../memory.hpp"
+
+#include <mutex>
+#include <ctime>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <condition_variable>
+
+namespace cnt {
+
+namespace {
+
+constexpr std::size_t LOG_RING = 256;
+
+// Single producer (the owning thread), single consumer (the sink thread)
+struct LogRing {
+    std::atomic<LogRing*> next{nullptr};
+    std::atomic<bool> owned{true};
+    std::uint32_t thread = 0;
+    std::atomic<std::size_t> head{0};
+    std::atomic<std::size_t> tail{0};
+    TaggedVector<char, MemoryTag::LOG> storage;
+};
+
+struct LogState {
+    std::atomic<LogRing*> rings{nullptr};
+    std::atomic<std::uint32_t> nextThread{1};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<bool> sleeping{false};
+    std::atomic<bool> running{false};
+
+    std::once_flag started;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable drained;
+    std::uint64_t requested = 0;
+    std::uint64_t completed = 0;
+    bool stopping = false;
+    std::vector<LogSink> sinks{Log::stderrSink()};
+
+    ~LogState() {
+        if (!running.load(std::memory_order_acquire)) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_one();
+        thread.join();
+    }
+};
+
+LogState& logState() {
+    static LogState state;
+    return state;
+}
+
+struct LogOwner {
+    LogRing* ring = nullptr;
+    ~LogOwner() {
+        if (ring) ring->owned.store(false, std::memory_order_release);
+    }
+};
+
+thread_local LogOwner logOwner;
+
+const char* logLevelName(LogLevel level) {
+    static const char* names[] = {"TRACE", "DEBUG", "INFO ", "WARN ", "ERROR", "OFF  "};
+    return names[static_cast<int>(level)];
+}
+
+} // namespace
+
+Log::Record* Log::begin(LogLevel level, const char* format) {
+    LogState& state = logState();
+    LogRing* ring = logOwner.ring;
+    if (!ring) {
+        // Take over the ring of a thread that exited, or add a new one
+        for (LogRing* it = state.rings.load(std::memory_order_acquire); it && !ring;
+             it = it->next.load(std::memory_order_acquire)) {
+            bool expected = false;
+            if (it->owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) ring = it;
+        }
+        if (!ring) {
+            ring = new LogRing();
+            ring->storage.resize(LOG_RING * sizeof(Record));
+            ring->thread = state.nextThread.fetch_add(1, std::memory_order_relaxed);
+            LogRing* head = state.rings.load(std::memory_order_relaxed);
+            do {
+                ring->next.store(head, std::memory_order_relaxed);
+            } while (!state.rings.compare_exchange_weak(head, ring, std::memory_order_release,
+                                                        std::memory_order_relaxed));
+        }
+        logOwner.ring = ring;
+        std::call_once(state.started, [&state] {
+            state.thread = std::thread(&Log::run);
+            state.running.store(true, std::memory_order_release);
+        });
+    }
+
+    std::size_t tail = ring->tail.load(std::memory_order_relaxed);
+    if (tail - ring->head.load(std::memory_order_acquire) == LOG_RING) {
+        state.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Record* record = reinterpret_cast<Record*>(ring->storage.data()) + tail % LOG_RING;
+    record->time = std::chrono::system_clock::now();
+    record->format = format;
+    record->level = level;
+    record->size = 0;
+    return record;
+}
+
+void Log::commit() {
+    LogRing* ring = logOwner.ring;
+    ring->tail.store(ring->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    LogState& state = logState();
+    if (state.sleeping.exchange(false, std::memory_order_acq_rel)) state.wakeup.notify_one();
+}
+
+void Log::format(const Record& record, std::string& out) {
+    std::size_t offset = 0;
+    auto next = [&](std::string& target) {
+        if (offset >= record.size) return;
+        Arg tag = static_cast<Arg>(record.data[offset++]);
+        char number[32];
+        switch (tag) {
+            case Arg::SIGNED: {
+                std::int64_t value;
+                std::memcpy(&value, record.data + offset, sizeof(value));
+                offset += sizeof(value);
+                std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(value));
+                target += number;
+                break;
+            }
+            case Arg::UNSIGNED: {
+                std::uint64_t value;
+                std::memcpy(&value, record.data + offset, sizeof(value));
+                offset += sizeof(value);
+                std::snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(value));
+                target += number;
+                break;
+            }
+            case Arg::FLOAT: {
+                double value;
+                std::memcpy(&value, record.data + offset, sizeof(value));
+                offset += sizeof(value);
+                std::snprintf(number, sizeof(number), "%g", value);
+                target += number;
+                break;
+            }
+            case Arg::BOOLEAN:
+                target += record.data[offset++] ? "true" : "false";
+                break;
+            case Arg::TEXT: {
+                std::uint16_t length;
+                std::memcpy(&length, record.data + offset, sizeof(length));
+                offset += sizeof(length);
+                target.append(record.data + offset, length);
+                offset += length;
+                break;
+            }
+        }
+    };
+
+    for (const char* it = record.format; *it; ++it) {
+        if (it[0] == '{' && it[1] == '}') {
+            next(out);
+            ++it;
+        } else {
+            out += *it;
+        }
+    }
+}
+
+void Log::run() {
+    LogState& state = logState();
+    struct Pending {
+        std::chrono::system_clock::time_point time;
+        LogLevel level;
+        std::uint32_t thread;
+        std::string message;
+    };
+    std::vector<Pending> batch;
+
+    std::unique_lock<std::mutex> lock(state.mutex);
+    for (;;) {
+        std::uint64_t request = state.requested;
+        bool stopping = state.stopping;
+        lock.unlock();
+
+        for (LogRing* ring = state.rings.load(std::memory_order_acquire); ring;
+             ring = ring->next.load(std::memory_order_acquire)) {
+            std::size_t head = ring->head.load(std::memory_order_relaxed);
+            std::size_t tail = ring->tail.load(std::memory_order_acquire);
+            for (; head != tail; ++head) {
+                const Record& record = reinterpret_cast<const Record*>(ring->storage.data())[head % LOG_RING];
+                Pending pending{record.time, record.level, ring->thread, std::string()};
+                format(record, pending.message);
+                batch.push_back(std::move(pending));
+            }
+            ring->head.store(tail, std::memory_order_release);
+        }
+
+        // Rings are drained one after another, order the batch across threads
+        std::stable_sort(batch.begin(), batch.end(),
+                         [](const Pending& a, const Pending& b) { return a.time < b.time; });
+
+        lock.lock();
+        for (const auto& pending : batch) {
+            LogEntry entry{pending.level, pending.time, pending.thread, pending.message};
+            for (const auto& sink : state.sinks) {
+                try {
+                    sink(entry);
+                } catch (...) {
+                }
+            }
+        }
+        batch.clear();
+        state.completed = request;
+        state.drained.notify_all();
+        if (stopping) return;
+
+        if (state.requested == request && !state.stopping) {
+            state.sleeping.store(true, std::memory_order_release);
+            state.wakeup.wait_for(lock, std::chrono::milliseconds(50));
+            state.sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Log::addSink(LogSink sink) {
+    LogState& state = logState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.sinks.push_back(std::move(sink));
+}
+
+void Log::clearSinks() {
+    LogState& state = logState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.sinks.clear();
+}
+
+std::string Log::line(const LogEntry& entry) {
+    std::time_t seconds = std::chrono::system_clock::to_time_t(entry.time);
+    long millis = static_cast<long>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(entry.time.time_since_epoch()).count() % 1000);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+    char prefix[64];
+    std::size_t length = std::strftime(prefix, sizeof(prefix), "%Y-%m-%d %H:%M:%S", &local);
+    std::snprintf(prefix + length, sizeof(prefix) - length, ".%03ld %s [%u] ", millis, logLevelName(entry.level),
+                  entry.thread);
+    std::string result = prefix;
+    result.append(entry.message);
+    result += '\n';
+    return result;
+}
+
+LogSink Log::stderrSink() {
+    return [](const LogEntry& entry) {
+        std::string text = line(entry);
+        std::fwrite(text.data(), 1, text.size(), stderr);
+    };
+}
+
+LogSink Log::fileSink(const std::filesystem::path& path) {
+    auto file = std::make_shared<std::ofstream>(path, std::ios::binary | std::ios::app);
+    if (!file->is_open()) {
+        throw std::runtime_error("Cannot open file: " + path.string());
+    }
+    return [file](const LogEntry& entry) {
+        *file << line(entry);
+        file->flush();
+    };
+}
+
+void Log::flush() {
+    LogState& state = logState();
+    std::unique_lock<std::mutex> lock(state.mutex);
+    if (!state.running.load(std::memory_order_acquire) || state.stopping) return;
+    std::uint64_t request = ++state.requested;
+    state.wakeup.notify_one();
+    state.drained.wait(lock, [&state, request] { return state.completed >= request; });
+}
+
+std::uint64_t Log::dropped() {
+    return logState().dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace cnt
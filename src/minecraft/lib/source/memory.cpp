@@ -0,0 +1,108 @@
+/*
+ * CNT Library
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: source/memory.cpp
+ * @Description: Memory report and the optional global allocation hook
+ * @Ownership: TaimWay <taimway@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "../memory.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace cnt {
+
+const char* MemoryAccounting::name(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::CONFIG: return "config";
+        case MemoryTag::MANIFEST: return "manifest";
+        case MemoryTag::JAVA: return "java";
+        case MemoryTag::LOG: return "log";
+        default: return "unknown";
+    }
+}
+
+std::vector<MemoryUsage> MemoryAccounting::report() {
+    std::vector<MemoryUsage> usage;
+    usage.reserve(static_cast<std::size_t>(MemoryTag::COUNT));
+    for (std::size_t i = 0; i < static_cast<std::size_t>(MemoryTag::COUNT); ++i) {
+        const internal::MemoryCounters& counters = internal::memoryCounters[i];
+        MemoryUsage entry;
+        entry.tag = static_cast<MemoryTag>(i);
+        entry.name = name(entry.tag);
+        entry.live = counters.live.load(std::memory_order_relaxed);
+        entry.peak = counters.peak.load(std::memory_order_relaxed);
+        entry.allocations = counters.allocations.load(std::memory_order_relaxed);
+        usage.push_back(entry);
+    }
+    return usage;
+}
+
+std::string MemoryAccounting::format() {
+    std::string out;
+    char line[128];
+    std::snprintf(line, sizeof(line), "%-10s %14s %14s %14s\n", "tag", "live", "peak", "allocations");
+    out += line;
+    for (const auto& entry : report()) {
+        std::snprintf(line, sizeof(line), "%-10s %14llu %14llu %14llu\n", entry.name,
+                      static_cast<unsigned long long>(entry.live), static_cast<unsigned long long>(entry.peak),
+                      static_cast<unsigned long long>(entry.allocations));
+        out += line;
+    }
+    if (!enabled()) out += "(built without CNT_MEMORY_ACCOUNTING)\n";
+    return out;
+}
+
+void MemoryAccounting::resetPeaks() {
+    for (auto& counters : internal::memoryCounters)
+        counters.peak.store(counters.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+} // namespace cnt
+
+#if CNT_ALLOCATION_COUNTER && defined(CNT_COUNT_ALL_ALLOCATIONS)
+// Every allocation of the program feeds AllocationCounter. Replacing the global
+// operators is process wide, so this is strictly opt-in for benchmark builds.
+void* operator new(std::size_t size) {
+    ++cnt::internal::threadAllocations;
+    cnt::internal::threadAllocatedBytes += size;
+    for (;;) {
+        if (void* p = std::malloc(size ? size : 1)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+// Kept out of line: once inlined, GCC pairs free() with operator new at every
+// call site and reports a mismatch
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+#endif
@@ -0,0 +1,276 @@
+/*
+ * CNT Library
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: trace.hpp
+ * @Description: Scoped trace spans in per-thread buffers, exported as Chrome trace JSON
+ * @Ownership: TaimWay <taimway@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __CNTLIB_TRACE_HPP__
+#define __CNTLIB_TRACE_HPP__
+
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+#include <string_view>
+
+// Define CNT_DISABLE_TRACE to compile every CNT_TRACE_SCOPE out
+#ifndef CNT_DISABLE_TRACE
+#define CNT_TRACE_CONCAT_(a, b) a##b
+#define CNT_TRACE_CONCAT(a, b) CNT_TRACE_CONCAT_(a, b)
+#define CNT_TRACE_SCOPE(category, name) ::cnt::TraceSpan CNT_TRACE_CONCAT(cntTraceSpan, __LINE__)(category, name)
+// The value expression is only evaluated while tracing is enabled
+#define CNT_TRACE_SCOPE_DETAIL(category, name, value)  \
+    CNT_TRACE_SCOPE(category, name);                   \
+    if (CNT_TRACE_CONCAT(cntTraceSpan, __LINE__)) CNT_TRACE_CONCAT(cntTraceSpan, __LINE__).detail(value)
+#else
+#define CNT_TRACE_SCOPE(category, name) ((void)0)
+#define CNT_TRACE_SCOPE_DETAIL(category, name, value) ((void)0)
+#endif
+
+namespace cnt {
+
+// Process-wide trace recorder. Off unless enable() is called or CNT_TRACE names
+// the file the trace is written to when the process exits.
+class Trace {
+public:
+    static constexpr std::size_t DETAIL = 48;
+
+    struct Event {
+        const char* category; // string literals, never copied
+        const char* name;
+        std::uint64_t begin;  // nanoseconds since the process started
+        std::uint64_t end;
+        char detail[DETAIL];
+    };
+
+private:
+    static constexpr std::size_t CHUNK = 1024;
+    static constexpr std::size_t MAX_CHUNKS = 64; // about 5 MiB per thread
+
+    struct Chunk {
+        Event events[CHUNK];
+        std::atomic<std::size_t> size{0};
+        std::atomic<Chunk*> next{nullptr};
+    };
+
+    // Written by one thread at a time, read by the exporter up to the published sizes.
+    // Buffers are never freed: a thread that exits hands its buffer to the next new thread.
+    struct Buffer {
+        std::atomic<Buffer*> next{nullptr};
+        std::atomic<bool> owned{true};
+        std::uint32_t tid = 0;
+        Chunk head;
+        Chunk* tail = &head;
+        std::size_t chunks = 1;
+    };
+
+    struct Owner {
+        Buffer* buffer = nullptr;
+        ~Owner() {
+            if (buffer) buffer->owned.store(false, std::memory_order_release);
+        }
+    };
+
+    struct AutoSave {
+        std::string path;
+        AutoSave() {
+            const char* value = std::getenv("CNT_TRACE");
+            if (value && *value) {
+                path = value;
+                enable();
+            }
+        }
+        ~AutoSave() {
+            if (path.empty()) return;
+            try {
+                save(path);
+            } catch (...) {
+            }
+        }
+    };
+
+    static inline const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    static inline std::atomic<bool> flag{false};
+    static inline std::atomic<Buffer*> buffers{nullptr};
+    static inline std::atomic<std::uint32_t> nextTid{1};
+    static inline std::atomic<std::uint64_t> droppedEvents{0};
+    static inline AutoSave autosave;
+
+    static Buffer* acquire() {
+        for (Buffer* buffer = buffers.load(std::memory_order_acquire); buffer;
+             buffer = buffer->next.load(std::memory_order_acquire)) {
+            bool expected = false;
+            if (buffer->owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) return buffer;
+        }
+        Buffer* buffer = new Buffer();
+        buffer->tid = nextTid.fetch_add(1, std::memory_order_relaxed);
+        Buffer* head = buffers.load(std::memory_order_relaxed);
+        do {
+            buffer->next.store(head, std::memory_order_relaxed);
+        } while (!buffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+        return buffer;
+    }
+
+    static Buffer* local() {
+        static thread_local Owner owner;
+        if (!owner.buffer) owner.buffer = acquire();
+        return owner.buffer;
+    }
+
+    static void escape(std::string& out, const char* text) {
+        for (; *text; ++text) {
+            unsigned char c = static_cast<unsigned char>(*text);
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += static_cast<char>(c);
+            } else if (c < 0x20) {
+                char code[8];
+                std::snprintf(code, sizeof(code), "\\u%04x", c);
+                out += code;
+            } else {
+                out += static_cast<char>(c);
+            }
+        }
+    }
+
+public:
+    static void enable(bool on = true) { flag.store(on, std::memory_order_relaxed); }
+    static bool enabled() { return flag.load(std::memory_order_relaxed); }
+
+    static std::uint64_t now() {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count());
+    }
+
+    // Events lost because a thread filled its buffer
+    static std::uint64_t dropped() { return droppedEvents.load(std::memory_order_relaxed); }
+
+    static void record(const char* category, const char* name, std::uint64_t begin, std::uint64_t end,
+                       std::string_view detail = {}) {
+        Buffer* buffer = local();
+        Chunk* chunk = buffer->tail;
+        std::size_t size = chunk->size.load(std::memory_order_relaxed);
+        if (size == CHUNK) {
+            if (buffer->chunks == MAX_CHUNKS) {
+                droppedEvents.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            Chunk* fresh = new Chunk();
+            chunk->next.store(fresh, std::memory_order_release);
+            buffer->tail = chunk = fresh;
+            buffer->chunks++;
+            size = 0;
+        }
+
+        Event& event = chunk->events[size];
+        event.category = category;
+        event.name = name;
+        event.begin = begin;
+        event.end = end;
+        std::size_t length = std::min(detail.size(), DETAIL - 1);
+        std::memcpy(event.detail, detail.data(), length);
+        event.detail[length] = '\0';
+        chunk->size.store(size + 1, std::memory_order_release);
+    }
+
+    // Everything recorded so far in the Chrome trace event format (chrome://tracing, Perfetto)
+    static std::string json() {
+        std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        char number[64];
+        for (Buffer* buffer = buffers.load(std::memory_order_acquire); buffer;
+             buffer = buffer->next.load(std::memory_order_acquire)) {
+            for (Chunk* chunk = &buffer->head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+                std::size_t size = chunk->size.load(std::memory_order_acquire);
+                for (std::size_t i = 0; i < size; ++i) {
+                    const Event& event = chunk->events[i];
+                    out += first ? "\n{\"name\":\"" : ",\n{\"name\":\"";
+                    first = false;
+                    escape(out, event.name);
+                    out += "\",\"cat\":\"";
+                    escape(out, event.category);
+                    std::snprintf(number, sizeof(number), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                                  buffer->tid, event.begin / 1000.0, (event.end - event.begin) / 1000.0);
+                    out += number;
+                    if (event.detail[0]) {
+                        out += ",\"args\":{\"detail\":\"";
+                        escape(out, event.detail);
+                        out += "\"}";
+                    }
+                    out += '}';
+                }
+            }
+        }
+        out += "\n]}\n";
+        return out;
+    }
+
+    static void save(const std::filesystem::path& path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open file: " + path.string());
+        }
+        file << json();
+    }
+};
+
+// Records the lifetime of a scope as one complete event while tracing is enabled
+class TraceSpan {
+private:
+    const char* category;
+    const char* name;
+    std::uint64_t begin = 0;
+    char text[Trace::DETAIL];
+    std::size_t length = 0;
+
+public:
+    TraceSpan(const char* _category, const char* _name)
+        : category(_category), name(Trace::enabled() ? _name : nullptr) {
+        if (name) begin = Trace::now();
+    }
+
+    ~TraceSpan() {
+        if (name) Trace::record(category, name, begin, Trace::now(), std::string_view(text, length));
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    explicit operator bool() const { return name != nullptr; }
+
+    // Attach a short argument (a path, a URL); long values keep their tail
+    void detail(std::string_view value) {
+        if (value.size() >= Trace::DETAIL) value.remove_prefix(value.size() - (Trace::DETAIL - 1));
+        length = value.size();
+        std::memcpy(text, value.data(), length);
+    }
+};
+
+} // namespace cnt
+
+#endif // __CNTLIB_TRACE_HPP__
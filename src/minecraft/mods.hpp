@@ -0,0 +1,177 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/mods.hpp
+ * @Description: Mod metadata scanner and dependency graph
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__MODS_HPP__
+#define __MINECRAFT_ENGINE__MODS_HPP__
+
+#include <minecraft/cntconfig.hpp>
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        enum class ModLoader
+        {
+            Fabric,     // fabric.mod.json
+            Quilt,      // quilt.mod.json
+            Forge,      // META-INF/mods.toml (Forge and NeoForge)
+            LegacyForge // mcmod.info
+        };
+
+        enum class ModDependencyKind
+        {
+            Required,
+            Optional,
+            Incompatible
+        };
+
+        struct ModDependency
+        {
+            String id;
+
+            // Version predicate as written by the mod: "*", ">=1.2 <2", "[1.0,2.0)", ...
+            String versionRange;
+
+            ModDependencyKind kind = ModDependencyKind::Required;
+        };
+
+        struct ModInfo
+        {
+            fs::path file;
+            // Entry of a jar-in-jar mod inside file ("META-INF/jars/x.jar"), empty for the jar itself
+            String nested;
+            ModLoader loader = ModLoader::Fabric;
+            String id;
+            String version;
+            String name;
+            String description;
+
+            // Additional ids this mod stands in for
+            std::vector<String> provides;
+            std::vector<ModDependency> dependencies;
+        };
+
+        enum class ModProblemKind
+        {
+            Missing,         // A required dependency is not installed
+            VersionMismatch, // A required dependency is installed in a version out of range
+            Incompatible,    // A mod that declares it breaks another one is installed with it
+            Duplicate        // Two jars provide the same id
+        };
+
+        struct ModProblem
+        {
+            ModProblemKind kind;
+            String mod;
+            String dependency;
+            String detail;
+        };
+
+        struct ModGraph
+        {
+            // Mods ordered by id
+            std::vector<std::shared_ptr<const ModInfo>> mods;
+
+            // Mod ids and provided ids to their index in mods
+            std::unordered_map<String, std::size_t> ids;
+
+            // Indices of the installed required dependencies of every mod
+            std::vector<std::vector<std::size_t>> dependencies;
+
+            std::vector<ModProblem> problems;
+
+            bool ok() const { return problems.empty(); }
+        };
+
+        /**
+         * Scans mods directories, caching the metadata of every jar by
+         * (path, size, mtime). An unchanged directory costs one stat per jar.
+         */
+        class ModScanner
+        {
+        private:
+            struct Entry
+            {
+                std::uint64_t size;
+                std::int64_t time;
+                std::vector<std::shared_ptr<const ModInfo>> mods;
+            };
+
+            std::mutex _mutex;
+            std::unordered_map<String, std::unordered_map<String, Entry>> _directories;
+
+        public:
+            static ModScanner &shared();
+
+            /**
+             * Metadata of all mods in a directory
+             * Only the metadata entries of each jar are read, jars that changed
+             * are parsed in parallel. Jars without metadata are skipped.
+             * @param directory Mods directory
+             * @param threads Concurrent runners on the CPU pool of the shared Scheduler including the caller, 0 means every CPU worker
+             */
+            std::vector<std::shared_ptr<const ModInfo>> scan(const fs::path &directory, unsigned int threads = 0);
+
+            void clear();
+        };
+
+        /**
+         * Link mods to their dependencies and collect problems
+         * @param mods Scanned mods
+         * @param platform Ids provided by the environment with their versions
+         *                 (e.g. {"minecraft", "1.20.1"}, {"fabricloader", "0.15.0"}).
+         *                 Dependencies on loader and game ids that are not listed
+         *                 here are not checked.
+         */
+        ModGraph BuildModGraph(const std::vector<std::shared_ptr<const ModInfo>> &mods,
+                               const std::unordered_map<String, String> &platform = {});
+
+        namespace internal
+        {
+            // Parse the metadata entries of one jar and of the jars bundled in it
+            std::vector<ModInfo> readModMetadata(const fs::path &file);
+
+            /**
+             * Check a version against a dependency predicate
+             * Understands Fabric/Quilt predicates (*, =, >=, <, ~, ^, x wildcards,
+             * space for "and", || for "or") and Maven ranges ([1.0,2.0), (,3]).
+             */
+            bool matchesVersionRange(std::string_view version, std::string_view range);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/mods.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__MODS_HPP__
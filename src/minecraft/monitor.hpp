@@ -0,0 +1,173 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/monitor.hpp
+ * @Description: Low-overhead resource sampling of game processes and cgroup v2 limits
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__MONITOR_HPP__
+#define __MINECRAFT_ENGINE__MONITOR_HPP__
+
+#include <minecraft/cntconfig.hpp>
+#include <minecraft/process.hpp>
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <optional>
+#include <functional>
+#include <string_view>
+#include <condition_variable>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        struct ProcessSample
+        {
+            int pid = -1;
+            String label;
+            std::chrono::steady_clock::time_point time;
+
+            // False once the process is gone, the sample then holds the last values
+            bool alive = true;
+
+            std::uint64_t residentMemory = 0; // bytes
+            std::uint64_t virtualMemory = 0;  // bytes
+
+            // User plus system time in seconds, and cores used since the previous sample
+            double cpuTime = 0;
+            double cpuUsage = 0;
+
+            unsigned int threads = 0;
+            unsigned int openFiles = 0;
+
+            // Bytes that went to or came from storage
+            std::uint64_t readBytes = 0;
+            std::uint64_t writeBytes = 0;
+        };
+
+        // Called from the monitor thread with the samples of one tick
+        using ProcessSampleHandler = std::function<void(const std::vector<ProcessSample> &)>;
+
+        /**
+         * Samples memory, CPU, threads, I/O and open files of watched processes
+         * The /proc files of every process are opened once and re-read with
+         * pread, so a tick costs a handful of syscalls per process and no path
+         * lookups. The descriptors stay bound to the original process even if
+         * its pid is reused.
+         */
+        class ProcessMonitor
+        {
+        private:
+            struct Watched
+            {
+                int pid;
+                String label;
+                int stat = -1;
+                int statm = -1;
+                int io = -1;
+                int fds = -1;
+                ProcessSample last;
+                bool sampled = false;
+
+                Watched(int pid, String label) : pid(pid), label(std::move(label)) {}
+                ~Watched();
+            };
+
+            std::chrono::milliseconds _interval;
+            mutable std::mutex _mutex;
+            std::mutex _sampling;
+            std::condition_variable _wakeup;
+            std::vector<std::shared_ptr<Watched>> _watched;
+            std::vector<ProcessSample> _latest;
+            std::vector<ProcessSampleHandler> _handlers;
+            bool _stopping = false;
+            std::thread _thread;
+
+            void _run();
+            static bool _sample(Watched &watched, ProcessSample &sample, std::vector<char> &buffer);
+
+        public:
+            explicit ProcessMonitor(std::chrono::milliseconds interval = std::chrono::seconds(1));
+            ~ProcessMonitor();
+            ProcessMonitor(const ProcessMonitor &) = delete;
+            ProcessMonitor &operator=(const ProcessMonitor &) = delete;
+
+            // Watch a process until it exits
+            void watch(int pid, String label = "");
+            void watch(const GameProcess &process, String label = "");
+
+            void unwatch(int pid);
+
+            // Sample all watched processes now, on the calling thread
+            std::vector<ProcessSample> sampleNow();
+
+            // Samples of the last tick
+            std::vector<ProcessSample> latest() const;
+            std::optional<ProcessSample> latest(int pid) const;
+
+            void subscribe(ProcessSampleHandler handler);
+        };
+
+        struct CgroupLimits
+        {
+            // memory.max and memory.high in bytes, 0 leaves them unlimited
+            std::uint64_t memoryMax = 0;
+            std::uint64_t memoryHigh = 0;
+
+            // cpu.max in cores, 0 for unlimited
+            double cpuMax = 0;
+
+            // cpu.weight (1 - 10000), 0 keeps the default of 100
+            unsigned int cpuWeight = 0;
+        };
+
+        /**
+         * Create (or update) a cgroup v2 group for an instance
+         * The group is created below the cgroup of this process, which must be
+         * delegated to us (e.g. a systemd unit with Delegate=yes). Pass the
+         * result as ProcessOptions::cgroup to place a game process in it.
+         * @param name Group name, e.g. the instance name
+         * @param limits Hard and soft limits to apply
+         * @return Directory of the group
+         */
+        fs::path CreateCgroup(const String &name, const CgroupLimits &limits);
+
+        namespace internal
+        {
+            // Fields of /proc/<pid>/stat after the command name, which may contain spaces
+            bool parseProcStat(std::string_view text, ProcessSample &sample, double ticksPerSecond);
+
+            // cgroup v2 directory of this process, empty without a unified hierarchy
+            fs::path ownCgroup();
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/monitor.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__MONITOR_HPP__
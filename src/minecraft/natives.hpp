@@ -0,0 +1,134 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/natives.hpp
+ * @Description: Content-addressed cache of extracted native libraries
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__NATIVES_HPP__
+#define __MINECRAFT_ENGINE__NATIVES_HPP__
+
+#include <minecraft/cntconfig.hpp>
+#include <minecraft/lib/config.hpp>
+#include <minecraft/launch.hpp>
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <unordered_map>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        // A natives jar of a profile and what to leave out when extracting it
+        struct NativeLibrary
+        {
+            fs::path jar;
+
+            // SHA-1 of the jar from the profile, empty if the profile has none
+            String sha1;
+
+            // Entry name prefixes that are not extracted (e.g. "META-INF/")
+            std::vector<String> exclude;
+        };
+
+        /**
+         * Extracted natives shared by all instances of an index
+         * Every jar is extracted once into <index>/natives/<key>, where the key is
+         * the SHA-1 of the jar and its exclude rules. Instances link to those
+         * directories instead of extracting on every launch.
+         */
+        class NativesCache
+        {
+        private:
+            struct FileHash
+            {
+                std::uintmax_t size;
+                fs::file_time_type time;
+                String sha1;
+            };
+
+            std::mutex _mutex;
+            std::unordered_map<String, FileHash> _hashes;
+
+            // Key of the directory last prepared at each target
+            internal::ProfileCache<String> _prepared{"natives_prepare"};
+
+            String _hashFile(const fs::path &file);
+
+        public:
+            static NativesCache &shared();
+
+            /**
+             * Cache key of a natives jar
+             * Uses the SHA-1 from the profile when present, otherwise hashes the
+             * jar once per (path, size, mtime).
+             */
+            String key(const NativeLibrary &library);
+
+            /**
+             * Extract a natives jar into the shared store unless it is already there
+             * A jar whose profile declares a SHA-1 is checked against it first.
+             * @param indexPath Root of the index
+             * @param library Natives jar
+             * @return Directory holding the extracted files
+             */
+            fs::path extract(const fs::path &indexPath, const NativeLibrary &library);
+
+            /**
+             * Make the natives of a profile available in a directory
+             * A single natives jar is linked with a symlink, several are merged
+             * with hardlinks. Nothing is touched when the directory is already up
+             * to date.
+             * @param indexPath Root of the index
+             * @param id Profile id
+             * @param target Natives directory of the instance
+             */
+            void prepare(const fs::path &indexPath, const String &id, const fs::path &target);
+
+            void clear();
+        };
+
+        namespace internal
+        {
+            // Legacy "natives" libraries of a loaded profile chain (root first) for this platform
+            std::vector<NativeLibrary> resolveNatives(const std::vector<std::unique_ptr<Config>> &chain, const fs::path &indexPath);
+
+            /**
+             * Extract the entries of a zip file into a directory, files in parallel
+             * @param file Zip file
+             * @param directory Destination directory, created if missing
+             * @param exclude Entry name prefixes to skip
+             * @param threads Concurrent runners on the CPU pool of the shared Scheduler including the caller, 0 means every CPU worker
+             * @return Number of files written
+             */
+            std::size_t extractZip(const fs::path &file, const fs::path &directory, const std::vector<String> &exclude, unsigned int threads = 0);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/natives.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__NATIVES_HPP__
@@ -0,0 +1,381 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/nbt.hpp
+ * @Description: Named Binary Tag codec: pull parser, arena DOM, writer and compression wrappers
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__NBT_HPP__
+#define __MINECRAFT_ENGINE__NBT_HPP__
+
+#include <minecraft/cntconfig.hpp>
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        enum class NbtType : std::uint8_t
+        {
+            End = 0,
+            Byte = 1,
+            Short = 2,
+            Int = 3,
+            Long = 4,
+            Float = 5,
+            Double = 6,
+            ByteArray = 7,
+            String = 8,
+            List = 9,
+            Compound = 10,
+            IntArray = 11,
+            LongArray = 12
+        };
+
+        enum class NbtCompression
+        {
+            None,
+            GZip, // level.dat, playerdata
+            Zlib  // region chunks
+        };
+
+        // Big-endian elements of a byte, int or long array, read in place
+        class NbtArrayView
+        {
+        private:
+            NbtType _type = NbtType::ByteArray;
+            const std::uint8_t *_data = nullptr;
+            std::size_t _size = 0;
+
+        public:
+            NbtArrayView() = default;
+            NbtArrayView(NbtType type, const std::uint8_t *data, std::size_t size) : _type(type), _data(data), _size(size) {}
+
+            NbtType type() const { return _type; }
+            std::size_t size() const { return _size; }
+            bool empty() const { return _size == 0; }
+
+            // Raw big-endian bytes
+            const std::uint8_t *data() const { return _data; }
+
+            std::int64_t operator[](std::size_t index) const;
+        };
+
+        /**
+         * Pull parser over a complete, uncompressed NBT document
+         * Each next() yields one token; names, strings and arrays are views into
+         * the input and nothing is allocated. Subtrees that are not needed can be
+         * skipped, strings, arrays and lists of numbers by their lengths.
+         */
+        class NbtReader
+        {
+        public:
+            enum class Token
+            {
+                Value,         // a number, string or array
+                BeginCompound, // followed by its children and EndCompound
+                EndCompound,
+                BeginList,     // followed by listSize() elements and EndList
+                EndList,
+                End            // the document is complete
+            };
+
+            static constexpr std::size_t MaxDepth = 512;
+
+        private:
+            struct Frame
+            {
+                NbtType type;     // Compound or List
+                NbtType element;  // of lists
+                std::int32_t remaining;
+            };
+
+            const std::uint8_t *_data;
+            std::size_t _size;
+            std::size_t _pos = 0;
+            std::array<Frame, MaxDepth> _stack;
+            std::size_t _depth = 0;
+            bool _started = false;
+
+            Token _token = Token::End;
+            NbtType _type = NbtType::End;
+            std::string_view _name;
+            const std::uint8_t *_payload = nullptr;
+            std::int32_t _count = 0;
+            NbtType _element = NbtType::End;
+
+            void _need(std::size_t count) const;
+            std::uint8_t _byte();
+            std::int32_t _int();
+            std::string_view _string();
+            Token _tag(NbtType type);
+
+        public:
+            NbtReader(const void *data, std::size_t size);
+
+            Token next();
+
+            Token token() const { return _token; }
+            NbtType type() const { return _type; }
+
+            // Name of the current tag, empty for list elements
+            std::string_view name() const { return _name; }
+
+            // Open compounds and lists, the root compound counts
+            std::size_t depth() const { return _depth; }
+
+            // Bytes consumed so far
+            std::size_t position() const { return _pos; }
+
+            // Value of a Byte, Short, Int or Long (also accepts Float and Double)
+            std::int64_t integer() const;
+
+            // Value of a Float or Double (also accepts the integer types)
+            double number() const;
+
+            // Value of a String, in modified UTF-8
+            std::string_view string() const;
+
+            NbtArrayView array() const;
+
+            // Element type and length of the list just begun
+            NbtType elementType() const { return _element; }
+            std::int32_t listSize() const { return _count; }
+
+            // After BeginCompound or BeginList, move past the matching end token
+            void skip();
+
+            /**
+             * Descend to a tag by a dotted path of compound keys, e.g. "Data.Version.Name"
+             * Works from the start of the document or right after BeginCompound;
+             * unrelated subtrees are skipped. On success the reader is positioned
+             * on the tag.
+             */
+            bool seek(std::string_view path);
+        };
+
+        class NbtDocument;
+
+        // Handle to a tag of an NbtDocument, invalid handles read as empty
+        class NbtNode
+        {
+        private:
+            const NbtDocument *_document = nullptr;
+            std::uint32_t _index = 0;
+
+            friend class NbtDocument;
+            NbtNode(const NbtDocument *document, std::uint32_t index) : _document(document), _index(index) {}
+
+        public:
+            class Iterator
+            {
+            private:
+                const NbtDocument *_document;
+                std::uint32_t _index;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = NbtNode;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = NbtNode;
+
+                Iterator(const NbtDocument *document, std::uint32_t index) : _document(document), _index(index) {}
+                NbtNode operator*() const { return NbtNode(_document, _index); }
+                Iterator &operator++();
+                bool operator==(const Iterator &other) const { return _index == other._index; }
+                bool operator!=(const Iterator &other) const { return _index != other._index; }
+            };
+
+            NbtNode() = default;
+
+            bool valid() const { return _document != nullptr; }
+            explicit operator bool() const { return valid(); }
+
+            NbtType type() const;
+            std::string_view name() const;
+
+            std::int64_t asInteger(std::int64_t fallback = 0) const;
+            double asNumber(double fallback = 0) const;
+            std::string_view asString(std::string_view fallback = std::string_view()) const;
+            NbtArrayView asArray() const;
+
+            // Children of a compound or list, elements of an array, bytes of a string
+            std::size_t size() const;
+
+            // Element type of a list
+            NbtType elementType() const;
+
+            // Child of a compound by name
+            NbtNode operator[](std::string_view key) const;
+
+            // Element of a list
+            NbtNode at(std::size_t index) const;
+
+            // Descendant by a dotted path of compound keys
+            NbtNode find(std::string_view path) const;
+
+            // Children of a compound or list
+            Iterator begin() const;
+            Iterator end() const;
+        };
+
+        class NbtWriter;
+
+        /**
+         * Read-only tree of an NBT document
+         * Tags are stored in one array in document order, each knowing where its
+         * subtree ends, so siblings are one jump apart. Names, strings and arrays
+         * stay views into the document's own copy of the data.
+         */
+        class NbtDocument
+        {
+        private:
+            struct Tag
+            {
+                NbtType type;
+                NbtType element;     // of lists
+                std::uint32_t count; // children, array elements or string bytes
+                std::uint32_t end;   // index after the subtree
+                std::string_view name;
+                union
+                {
+                    std::int64_t integer;
+                    double number;
+                    const std::uint8_t *data;
+                };
+            };
+
+            std::vector<std::uint8_t> _bytes;
+            std::vector<Tag> _tags;
+            NbtCompression _compression = NbtCompression::None;
+
+            friend class NbtNode;
+            void _build();
+
+        public:
+            NbtDocument() = default;
+            NbtDocument(NbtDocument &&) = default;
+            NbtDocument &operator=(NbtDocument &&) = default;
+            NbtDocument(const NbtDocument &) = delete;
+            NbtDocument &operator=(const NbtDocument &) = delete;
+
+            // Parse a document, gzip and zlib input is detected and inflated
+            static NbtDocument parse(std::vector<std::uint8_t> data);
+            static NbtDocument load(const fs::path &path);
+
+            NbtNode root() const;
+
+            // Compression the document was read with
+            NbtCompression compression() const { return _compression; }
+
+            // Uncompressed bytes of the document
+            const std::vector<std::uint8_t> &bytes() const { return _bytes; }
+        };
+
+        /**
+         * Builds an NBT document in a growable buffer
+         * Names are ignored for list elements. Misuse (a wrong element type in a
+         * list, unbalanced ends) throws std::logic_error.
+         */
+        class NbtWriter
+        {
+        private:
+            struct Frame
+            {
+                NbtType type;
+                NbtType element;
+                std::int32_t remaining;
+                std::size_t countOffset; // of lists whose size is patched on end
+            };
+
+            std::vector<std::uint8_t> _out;
+            std::vector<Frame> _stack;
+            bool _rootWritten = false;
+
+            void _header(NbtType type, std::string_view name);
+            void _put(std::uint64_t value, int bytes);
+            void _putString(std::string_view value);
+
+        public:
+            explicit NbtWriter(std::size_t reserve = 4096);
+
+            void beginCompound(std::string_view name = std::string_view());
+            void endCompound();
+
+            // A negative count is patched in by endList
+            void beginList(std::string_view name, NbtType element, std::int32_t count = -1);
+            void endList();
+
+            void writeByte(std::string_view name, std::int8_t value);
+            void writeShort(std::string_view name, std::int16_t value);
+            void writeInt(std::string_view name, std::int32_t value);
+            void writeLong(std::string_view name, std::int64_t value);
+            void writeFloat(std::string_view name, float value);
+            void writeDouble(std::string_view name, double value);
+            void writeString(std::string_view name, std::string_view value);
+            void writeByteArray(std::string_view name, const void *data, std::size_t size);
+            void writeIntArray(std::string_view name, const std::int32_t *data, std::size_t size);
+            void writeLongArray(std::string_view name, const std::int64_t *data, std::size_t size);
+
+            // Copy a tag and its subtree, under its own name
+            void write(const NbtNode &node);
+            void write(std::string_view name, const NbtNode &node);
+
+            const std::vector<std::uint8_t> &data() const { return _out; }
+
+            // The finished document, compressed as asked
+            std::vector<std::uint8_t> finish(NbtCompression compression = NbtCompression::None);
+
+            void save(const fs::path &path, NbtCompression compression = NbtCompression::GZip);
+        };
+
+        namespace internal
+        {
+            // Compression of a buffer from its magic bytes
+            NbtCompression detectNbtCompression(const std::uint8_t *data, std::size_t size);
+
+            // Largest uncompressed document accepted, far above any real level.dat or chunk
+            constexpr std::size_t MaxInflatedNbt = 256 * 1024 * 1024;
+
+            // Inflate a gzip member or a zlib stream, appending at most limit bytes to out
+            void inflateGzip(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out, std::size_t limit = MaxInflatedNbt);
+            void inflateZlib(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out, std::size_t limit = MaxInflatedNbt);
+
+            // Wrap data as a gzip member or zlib stream, appending to out
+            void deflateGzip(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out);
+            void deflateZlib(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out);
+
+            std::uint32_t adler32(const std::uint8_t *data, std::size_t size, std::uint32_t adler = 1);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/nbt.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__NBT_HPP__
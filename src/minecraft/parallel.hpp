@@ -0,0 +1,56 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/parallel.hpp
+ * @Description: Small helpers for running independent work on all cores
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__PARALLEL_HPP__
+#define __MINECRAFT_ENGINE__PARALLEL_HPP__
+
+#include <minecraft/cntconfig.hpp>
+
+#include <cstddef>
+#include <functional>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            /**
+             * Run fn(0) .. fn(count - 1) on the CPU pool of the shared Scheduler and wait for all of them
+             * The first exception thrown by fn stops handing out new indices and is rethrown.
+             * @param count Number of work items
+             * @param fn Work item, must be safe to call concurrently
+             * @param threads Concurrent runners including the caller, 0 means every CPU worker
+             */
+            void parallelFor(std::size_t count, const std::function<void(std::size_t)> &fn, unsigned int threads = 0);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/parallel.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__PARALLEL_HPP__
@@ -0,0 +1,186 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/process.hpp
+ * @Description: Spawns and supervises game processes from a single reactor thread
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__PROCESS_HPP__
+#define __MINECRAFT_ENGINE__PROCESS_HPP__
+
+#include <minecraft/cntconfig.hpp>
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        enum class ProcessStream
+        {
+            Stdout,
+            Stderr
+        };
+
+        // Called on the reactor thread with every chunk read from a pipe, keep it short.
+        // An empty chunk marks the end of a stream once the process has exited
+        using ProcessOutputHandler = std::function<void(ProcessStream, std::string_view)>;
+
+        // Called on the reactor thread with the exit status once the process is
+        // reaped, before exited() resolves
+        using ProcessExitHandler = std::function<void(int)>;
+
+        struct ProcessOptions
+        {
+            // Working directory of the child, empty keeps the current one
+            fs::path workingDirectory;
+
+            // "KEY=VALUE" entries added to (or replacing) the inherited environment
+            std::vector<String> environment;
+
+            // Do not inherit the environment of this process
+            bool clearEnvironment = false;
+
+            ProcessOutputHandler output;
+
+            ProcessExitHandler onExit;
+
+            // cgroup v2 directory the child is moved into right after it is
+            // spawned (see CreateCgroup), empty leaves it in ours
+            fs::path cgroup;
+        };
+
+        // Move a process into a cgroup v2 group
+        void AttachToCgroup(const fs::path &group, int pid);
+
+        class ProcessReactor;
+
+        // Handle to a spawned process
+        class GameProcess
+        {
+        private:
+            int _pid = -1;
+            int _pidfd = -1;
+            int _stdin = -1;
+            int _stdout = -1;
+            int _stderr = -1;
+            std::atomic<bool> _running{true};
+            std::promise<int> _promise;
+            std::shared_future<int> _exit;
+            ProcessOutputHandler _output;
+            ProcessExitHandler _onExit;
+            std::mutex _inputMutex;
+
+            friend class ProcessReactor;
+
+        public:
+            GameProcess();
+            ~GameProcess();
+            GameProcess(const GameProcess &) = delete;
+            GameProcess &operator=(const GameProcess &) = delete;
+
+            int pid() const { return _pid; }
+            bool running() const { return _running.load(std::memory_order_acquire); }
+
+            // Exit status: the exit code, or -signal if the process was killed
+            std::shared_future<int> exited() const { return _exit; }
+
+            // Block until the process exits
+            int wait() const { return _exit.get(); }
+
+            // Write to the standard input of the process (e.g. server console commands)
+            bool sendInput(std::string_view data);
+
+            // Ask the process to stop (SIGTERM)
+            void terminate();
+
+            // Stop the process immediately (SIGKILL)
+            void kill();
+        };
+
+        // Owns one epoll loop that drains the pipes of every spawned process and
+        // resolves their exit futures
+        class ProcessReactor
+        {
+        private:
+            struct Registration
+            {
+                std::shared_ptr<GameProcess> process;
+                int fd;
+                int kind; // 0 stdout, 1 stderr, 2 pidfd
+            };
+
+            int _epoll = -1;
+            int _wakeup = -1;
+            std::atomic<bool> _stopping{false};
+            std::thread _thread;
+
+            mutable std::mutex _mutex;
+            std::uint64_t _nextToken = 1;
+            std::unordered_map<std::uint64_t, Registration> _registrations;
+            std::vector<std::shared_ptr<GameProcess>> _processes;
+
+            void _run();
+            // Add fd to the epoll set, the registration is only published by the caller
+            void _register(const std::shared_ptr<GameProcess> &process, int fd, int kind,
+                           std::vector<std::pair<std::uint64_t, Registration>> &registrations);
+            // Bytes read from one pipe per wakeup, so a chatty process cannot starve the others
+            static constexpr std::size_t DrainLimit = 256 * 1024;
+
+            // Read until the pipe is empty or limit bytes were read, true if it is empty
+            bool _drain(GameProcess &process, int fd, ProcessStream stream, std::vector<char> &buffer, std::size_t limit);
+            void _reap(const std::shared_ptr<GameProcess> &process, std::vector<char> &buffer);
+
+        public:
+            ProcessReactor();
+            ~ProcessReactor();
+            ProcessReactor(const ProcessReactor &) = delete;
+            ProcessReactor &operator=(const ProcessReactor &) = delete;
+
+            static ProcessReactor &shared();
+
+            /**
+             * Spawn a process with posix_spawn and supervise it
+             * @param argv Null-terminated argument vector, argv[0] is the executable
+             * @param options Working directory, environment and output handler
+             * @return Handle of the running process
+             */
+            std::shared_ptr<GameProcess> spawn(char *const *argv, const ProcessOptions &options);
+
+            // Number of processes still running
+            std::size_t size() const;
+        };
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/process.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__PROCESS_HPP__
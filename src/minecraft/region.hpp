@@ -0,0 +1,184 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/region.hpp
+ * @Description: Anvil region file reader and compactor
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__REGION_HPP__
+#define __MINECRAFT_ENGINE__REGION_HPP__
+
+#include <minecraft/cntconfig.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        enum class RegionCompression : std::uint8_t
+        {
+            GZip = 1,
+            Zlib = 2,
+            None = 3,
+            LZ4 = 4,
+            Custom = 127
+        };
+
+        struct RegionChunk
+        {
+            // Position inside the region, 0 - 31
+            int x = 0;
+            int z = 0;
+
+            // Location in 4 KiB sectors, as stored in the header
+            std::uint32_t sectorOffset = 0;
+            std::uint32_t sectorCount = 0;
+
+            // Last save, seconds since the epoch
+            std::uint32_t timestamp = 0;
+
+            // Payload bytes after the length field (compression byte included),
+            // 0 if the length field is unusable
+            std::uint32_t length = 0;
+
+            std::uint8_t compression = 0;
+
+            // Data lives in c.<x>.<z>.mcc next to the region file (chunks over 1 MiB)
+            bool external = false;
+        };
+
+        /**
+         * Read-only view of an Anvil region file (r.<x>.<z>.mca)
+         * The file is mapped; only the 8 KiB location and timestamp header is
+         * parsed on open, chunk sectors are touched when they are read.
+         */
+        class RegionFile
+        {
+        private:
+            fs::path _path;
+            const std::uint8_t *_data = nullptr;
+            std::size_t _size = 0;
+            bool _mapped = false;
+            std::vector<std::uint8_t> _buffer; // Used where mapping is unavailable
+            std::vector<RegionChunk> _chunks;
+            std::uint32_t _invalid = 0;
+
+            void _map();
+            void _parse();
+
+        public:
+            static constexpr std::size_t SectorSize = 4096;
+
+            explicit RegionFile(const fs::path &path);
+            ~RegionFile();
+            RegionFile(const RegionFile &) = delete;
+            RegionFile &operator=(const RegionFile &) = delete;
+
+            const fs::path &path() const { return _path; }
+            std::size_t fileSize() const { return _size; }
+
+            // Chunks present in the header and inside the file, in header order
+            const std::vector<RegionChunk> &chunks() const { return _chunks; }
+
+            // Header entries pointing outside the file, the game treats them as missing
+            std::uint32_t invalidChunks() const { return _invalid; }
+
+            const RegionChunk *find(int x, int z) const;
+
+            // Compressed payload of a chunk stored in the region file, empty for external chunks
+            std::string_view raw(const RegionChunk &chunk) const;
+
+            // Sectors of a chunk as stored, length field first, cut at the end of the file
+            std::string_view sectors(const RegionChunk &chunk) const;
+
+            /**
+             * Decompressed NBT of a chunk
+             * Throws for LZ4, custom compression and corrupt data.
+             */
+            std::vector<std::uint8_t> read(const RegionChunk &chunk) const;
+
+            // Path of the external file of a chunk
+            fs::path externalPath(const RegionChunk &chunk) const;
+        };
+
+        struct RegionCompactOptions
+        {
+            // Drop chunks whose InhabitedTime (ticks players spent nearby) is below
+            // this, negative keeps every chunk. 1200 is one minute
+            std::int64_t minInhabitedTime = -1;
+
+            // Only report what would change
+            bool dryRun = false;
+
+            // Worker threads, 0 means hardware_concurrency
+            unsigned int threads = 0;
+        };
+
+        struct RegionCompactStats
+        {
+            std::size_t files = 0;
+            std::size_t rewrittenFiles = 0;
+            std::size_t chunks = 0;
+            std::size_t prunedChunks = 0;
+            std::uint64_t bytesBefore = 0;
+            std::uint64_t bytesAfter = 0;
+
+            // "<path>: <reason>" for files that were left alone
+            std::vector<String> errors;
+        };
+
+        /**
+         * Rewrite a region file with its chunks stored back to back
+         * The new file replaces the old one with a rename, so a crash never
+         * leaves a half written region. Files whose header points outside the
+         * file are refused. The world must not be open.
+         */
+        RegionCompactStats CompactRegionFile(const fs::path &file, const RegionCompactOptions &options = {});
+
+        /**
+         * Compact every region file in the region/ directories below a directory
+         * (an instance, its saves or one world), files are processed in parallel.
+         */
+        RegionCompactStats CompactRegions(const fs::path &directory, const RegionCompactOptions &options = {});
+
+        namespace internal
+        {
+            // Decompress a chunk payload (after the compression byte)
+            std::vector<std::uint8_t> decompressChunk(std::uint8_t compression, const std::uint8_t *data, std::size_t size);
+
+            /**
+             * InhabitedTime of chunk NBT, at the root (1.18+) or in "Level" (older)
+             * Uses NbtReader, other subtrees are skipped without building a tree.
+             */
+            std::optional<std::int64_t> readInhabitedTime(const std::uint8_t *nbt, std::size_t size);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/region.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__REGION_HPP__
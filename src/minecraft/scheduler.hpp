@@ -0,0 +1,157 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/scheduler.hpp
+ * @Description: Shared work-stealing task scheduler with CPU and I/O pools
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__SCHEDULER_HPP__
+#define __MINECRAFT_ENGINE__SCHEDULER_HPP__
+
+#include <minecraft/cntconfig.hpp>
+
+#include <deque>
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        enum class TaskPool
+        {
+            Cpu, // hashing, parsing, compression: one worker per usable core
+            Io   // process probes, downloads, file system walks: mostly waiting
+        };
+
+        /**
+         * Executor shared by every subsystem of the engine
+         * Each pool has one deque per worker. Workers push and pop their own
+         * tasks at the back and steal from the front of the others when idle;
+         * tasks submitted from outside go to a shared queue. Threads that wait
+         * for a TaskGroup run pending tasks instead of blocking, so groups can
+         * nest without deadlocking. Workers start on first use.
+         */
+        class Scheduler
+        {
+        public:
+            using Task = std::function<void()>;
+
+        private:
+            struct Worker
+            {
+                std::mutex mutex;
+                std::deque<Task> tasks;
+            };
+
+            struct Pool
+            {
+                unsigned int size = 0;
+                std::vector<std::unique_ptr<Worker>> workers;
+                std::vector<std::thread> threads;
+                std::once_flag started;
+
+                std::mutex mutex; // guards injected and sleeping
+                std::condition_variable wakeup;
+                std::deque<Task> injected;
+                std::atomic<std::size_t> pending{0};
+                bool stopping = false;
+            };
+
+            std::array<Pool, 2> _pools;
+
+            Pool &_pool(TaskPool pool) { return _pools[static_cast<std::size_t>(pool)]; }
+            void _start(Pool &pool);
+            void _run(Pool &pool, std::size_t index);
+            bool _take(Pool &pool, std::size_t self, Task &task);
+
+        public:
+            /**
+             * @param cpuWorkers Workers of the CPU pool, 0 sizes it to the usable cores
+             *                   (cgroup CPU quota included)
+             * @param ioWorkers Workers of the I/O pool, 0 means twice the CPU pool (at least 4)
+             */
+            explicit Scheduler(unsigned int cpuWorkers = 0, unsigned int ioWorkers = 0);
+            ~Scheduler();
+            Scheduler(const Scheduler &) = delete;
+            Scheduler &operator=(const Scheduler &) = delete;
+
+            static Scheduler &shared();
+
+            void submit(Task task, TaskPool pool = TaskPool::Cpu);
+
+            unsigned int workers(TaskPool pool) const { return _pools[static_cast<std::size_t>(pool)].size; }
+
+            // Run one queued task of a pool on the calling thread, false if there was none
+            bool runPending(TaskPool pool);
+        };
+
+        /**
+         * Tasks that are waited for together
+         * The first exception cancels the tasks that have not started yet and is
+         * rethrown by wait(). The destructor waits as well.
+         */
+        class TaskGroup
+        {
+        private:
+            struct State
+            {
+                std::mutex mutex;
+                std::condition_variable done;
+                std::atomic<std::size_t> pending{0};
+                std::atomic<bool> cancelled{false};
+                std::exception_ptr error;
+            };
+
+            Scheduler &_scheduler;
+            TaskPool _pool;
+            std::shared_ptr<State> _state;
+
+        public:
+            explicit TaskGroup(TaskPool pool = TaskPool::Cpu, Scheduler &scheduler = Scheduler::shared());
+            ~TaskGroup();
+            TaskGroup(const TaskGroup &) = delete;
+            TaskGroup &operator=(const TaskGroup &) = delete;
+
+            void run(std::function<void()> task);
+
+            // Wait for every task, running queued work meanwhile; rethrows the first exception
+            void wait();
+
+            // Skip tasks that have not started, running ones may poll cancelled()
+            void cancel();
+            bool cancelled() const { return _state->cancelled.load(std::memory_order_relaxed); }
+        };
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/scheduler.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__SCHEDULER_HPP__
@@ -0,0 +1,699 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/backup.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/backup.hpp>
+#include <minecraft/parallel.hpp>
+#include <minecraft/lib/sha1.hpp>
+#include <minecraft/lib/deflate.hpp>
+#include <minecraft/lib/inflate.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            // Region files change a few KiB at a time, small enough chunks keep edits local
+            static constexpr std::size_t MIN_CHUNK = 16 * 1024;
+            static constexpr std::size_t AVERAGE_CHUNK = 64 * 1024;
+            static constexpr std::size_t MAX_CHUNK = 256 * 1024;
+
+            using ChunkId = std::array<std::uint8_t, 20>;
+
+            static const std::uint64_t *gearTable()
+            {
+                static const auto table = []
+                {
+                    std::array<std::uint64_t, 256> result{};
+                    std::uint64_t state = 0x6d696e6563726166ull; // fixed seed, boundaries must be stable
+                    for (auto &value : result)
+                    {
+                        // splitmix64
+                        std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+                        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                        value = z ^ (z >> 31);
+                    }
+                    return result;
+                }();
+                return table.data();
+            }
+
+            std::size_t nextChunkBoundary(const std::uint8_t *data, std::size_t size)
+            {
+                if (size <= MIN_CHUNK)
+                    return size;
+
+                // Normalized chunking: a stricter mask before the average size and
+                // a looser one after it pull chunk sizes towards the average.
+                // The gear hash shifts left, so the high bits cover the most bytes
+                constexpr std::uint64_t strict = ~0ull << (64 - 18);
+                constexpr std::uint64_t loose = ~0ull << (64 - 14);
+
+                const std::uint64_t *gear = gearTable();
+                std::size_t limit = std::min(size, MAX_CHUNK);
+                std::size_t normal = std::min(limit, AVERAGE_CHUNK);
+                std::uint64_t hash = 0;
+                std::size_t i = MIN_CHUNK;
+                for (; i < normal; i++)
+                {
+                    hash = (hash << 1) + gear[data[i]];
+                    if ((hash & strict) == 0)
+                        return i + 1;
+                }
+                for (; i < limit; i++)
+                {
+                    hash = (hash << 1) + gear[data[i]];
+                    if ((hash & loose) == 0)
+                        return i + 1;
+                }
+                return limit;
+            }
+
+            static String hexChunkId(const ChunkId &id)
+            {
+                return cnt::Sha1::to_hex(id);
+            }
+
+            static bool parseChunkId(std::string_view text, ChunkId &id)
+            {
+                if (text.size() != 40)
+                    return false;
+                auto digit = [](char c) -> int
+                {
+                    if (c >= '0' && c <= '9')
+                        return c - '0';
+                    if (c >= 'a' && c <= 'f')
+                        return c - 'a' + 10;
+                    return -1;
+                };
+                for (std::size_t i = 0; i < 20; i++)
+                {
+                    int high = digit(text[i * 2]), low = digit(text[i * 2 + 1]);
+                    if (high < 0 || low < 0)
+                        return false;
+                    id[i] = static_cast<std::uint8_t>(high << 4 | low);
+                }
+                return true;
+            }
+
+            struct ChunkIdHash
+            {
+                std::size_t operator()(const ChunkId &id) const
+                {
+                    // Already uniformly distributed
+                    std::size_t value;
+                    std::memcpy(&value, id.data(), sizeof(value));
+                    return value;
+                }
+            };
+
+            static constexpr std::string_view MANIFEST_MAGIC = "cnt-backup 1";
+
+            // Paths are the last field of a line, only '\' and newlines need escaping
+            static String escapePath(const String &path)
+            {
+                String result;
+                result.reserve(path.size());
+                for (char c : path)
+                {
+                    if (c == '\\')
+                        result += "\\\\";
+                    else if (c == '\n')
+                        result += "\\n";
+                    else
+                        result += c;
+                }
+                return result;
+            }
+
+            static String unescapePath(std::string_view text)
+            {
+                String result;
+                result.reserve(text.size());
+                for (std::size_t i = 0; i < text.size(); i++)
+                {
+                    if (text[i] == '\\' && i + 1 < text.size())
+                    {
+                        result += text[i + 1] == 'n' ? '\n' : text[i + 1];
+                        i++;
+                    }
+                    else
+                    {
+                        result += text[i];
+                    }
+                }
+                return result;
+            }
+
+            String formatBackupManifest(const std::vector<BackupFile> &files)
+            {
+                // <size> <mtime> <inode> <mode> <count> <chunk>... <path>
+                String text(MANIFEST_MAGIC);
+                text += '\n';
+                for (const auto &file : files)
+                {
+                    text += std::to_string(file.size) + ' ' + std::to_string(file.mtime) + ' ' + std::to_string(file.inode) + ' ' +
+                            std::to_string(file.mode) + ' ' + std::to_string(file.chunks.size()) + ' ';
+                    for (const auto &chunk : file.chunks)
+                        text += hexChunkId(chunk) + ' ';
+                    text += escapePath(file.path);
+                    text += '\n';
+                }
+                return text;
+            }
+
+            std::vector<BackupFile> parseBackupManifest(const String &text)
+            {
+                std::vector<BackupFile> files;
+                std::string_view rest(text);
+
+                auto nextLine = [&rest]()
+                {
+                    std::size_t end = rest.find('\n');
+                    std::string_view line = rest.substr(0, end);
+                    rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+                    return line;
+                };
+                if (nextLine() != MANIFEST_MAGIC)
+                    throw std::runtime_error("Not a backup manifest");
+
+                while (!rest.empty())
+                {
+                    std::string_view line = nextLine();
+                    if (line.empty())
+                        continue;
+
+                    auto token = [&line]()
+                    {
+                        std::size_t end = line.find(' ');
+                        if (end == std::string_view::npos)
+                            throw std::runtime_error("Truncated backup manifest");
+                        std::string_view value = line.substr(0, end);
+                        line.remove_prefix(end + 1);
+                        return value;
+                    };
+                    auto number = [&token]()
+                    {
+                        std::string_view value = token();
+                        bool negative = !value.empty() && value[0] == '-';
+                        if (negative)
+                            value.remove_prefix(1);
+                        std::uint64_t result = 0;
+                        for (char c : value)
+                        {
+                            if (c < '0' || c > '9')
+                                throw std::runtime_error("Invalid number in backup manifest");
+                            result = result * 10 + static_cast<std::uint64_t>(c - '0');
+                        }
+                        return negative ? static_cast<std::uint64_t>(-static_cast<std::int64_t>(result)) : result;
+                    };
+
+                    BackupFile file;
+                    file.size = number();
+                    file.mtime = static_cast<std::int64_t>(number());
+                    file.inode = number();
+                    file.mode = static_cast<std::uint32_t>(number());
+                    std::size_t count = static_cast<std::size_t>(number());
+                    // Every chunk id takes 41 bytes of the line, a larger count is damage
+                    if (count > line.size() / 41)
+                        throw std::runtime_error("Truncated backup manifest");
+                    file.chunks.resize(count);
+                    for (auto &chunk : file.chunks)
+                    {
+                        if (!parseChunkId(token(), chunk))
+                            throw std::runtime_error("Invalid chunk id in backup manifest");
+                    }
+                    file.path = unescapePath(line);
+                    files.push_back(std::move(file));
+                }
+                return files;
+            }
+
+            static String readWholeFile(const fs::path &path)
+            {
+                std::ifstream file(path, std::ios::binary);
+                if (!file.is_open())
+                    throw std::runtime_error("Cannot open file: " + path.string());
+                std::ostringstream content;
+                content << file.rdbuf();
+                return content.str();
+            }
+
+            static void writeFileAtomically(const fs::path &path, const void *data, std::size_t size)
+            {
+                // Processes backing up into the same store must never share a name
+                static std::atomic<std::uint64_t> counter{0};
+#ifdef _WIN32
+                const auto pid = ::_getpid();
+#else
+                const auto pid = ::getpid();
+#endif
+                const fs::path temporary = path.parent_path() / (".tmp-" + std::to_string(pid) + '-' + std::to_string(counter.fetch_add(1)));
+                {
+                    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+                    if (!file.is_open())
+                        throw std::runtime_error("Cannot write file: " + temporary.string());
+                    file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+                    file.close();
+                    if (!file)
+                    {
+                        std::error_code ec;
+                        fs::remove(temporary, ec);
+                        throw std::runtime_error("Cannot write file: " + temporary.string());
+                    }
+                }
+                std::error_code ec;
+                fs::rename(temporary, path, ec);
+                if (ec)
+                {
+                    fs::remove(temporary, ec);
+                    throw std::runtime_error("Cannot write file: " + path.string());
+                }
+            }
+
+            static bool validSeriesName(const String &name)
+            {
+                return !name.empty() && name != "." && name != ".." && name.find('/') == String::npos && name.find('\\') == String::npos;
+            }
+
+            // "<name>/<time>" with a filesystem-safe UTC timestamp that sorts chronologically
+            static String snapshotTime()
+            {
+                auto now = std::chrono::system_clock::now();
+                std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+                auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+                std::tm utc{};
+#ifdef _WIN32
+                gmtime_s(&utc, &seconds);
+#else
+                gmtime_r(&seconds, &utc);
+#endif
+                char buffer[80];
+                std::snprintf(buffer, sizeof(buffer), "%04d%02d%02dT%02d%02d%02d.%03dZ", utc.tm_year + 1900, utc.tm_mon + 1, utc.tm_mday,
+                              utc.tm_hour, utc.tm_min, utc.tm_sec, static_cast<int>(millis));
+                return buffer;
+            }
+        }
+
+        BackupStore::BackupStore(fs::path root) : _root(std::move(root)) {}
+
+        fs::path BackupStore::_chunkPath(const std::array<std::uint8_t, 20> &hash) const
+        {
+            String hex = internal::hexChunkId(hash);
+            return _root / "chunks" / hex.substr(0, 2) / hex;
+        }
+
+        std::vector<String> BackupStore::snapshots(const String &name) const
+        {
+            std::vector<String> result;
+            if (!internal::validSeriesName(name))
+                return result;
+
+            std::error_code ec;
+            for (fs::directory_iterator it(_root / "snapshots" / name, ec), end; !ec && it != end; it.increment(ec))
+            {
+                if (it->path().extension() == ".manifest")
+                    result.push_back(name + '/' + it->path().stem().string());
+            }
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        std::vector<BackupFile> BackupStore::files(const String &snapshot) const
+        {
+            std::size_t slash = snapshot.find('/');
+            if (slash == String::npos || !internal::validSeriesName(snapshot.substr(0, slash)) ||
+                !internal::validSeriesName(snapshot.substr(slash + 1)))
+                throw std::runtime_error("Invalid snapshot id: " + snapshot);
+            return internal::parseBackupManifest(internal::readWholeFile(_root / "snapshots" / (snapshot + ".manifest")));
+        }
+
+        BackupStats BackupStore::backup(const fs::path &source, const String &name, const BackupOptions &options)
+        {
+            if (!internal::validSeriesName(name))
+                throw std::runtime_error("Invalid backup name: " + name);
+            if (!fs::is_directory(source))
+                throw std::runtime_error("Backup source is not a directory: " + source.string());
+
+            BackupStats stats;
+
+            // Records of the previous snapshot let unchanged files skip reading entirely
+            std::unordered_map<String, const BackupFile *> previous;
+            std::vector<BackupFile> parent;
+            std::vector<String> existing = snapshots(name);
+            if (!existing.empty())
+            {
+                parent = files(existing.back());
+                for (const auto &file : parent)
+                    previous.emplace(file.path, &file);
+            }
+
+            std::error_code ec;
+            const fs::path storeRoot = fs::weakly_canonical(_root, ec);
+
+            std::vector<BackupFile> manifest;
+            std::vector<std::size_t> changed;
+            fs::recursive_directory_iterator it(source, fs::directory_options::skip_permission_denied, ec), end;
+            if (ec)
+                throw std::runtime_error("Cannot read " + source.string() + ": " + ec.message());
+            for (; it != end; it.increment(ec))
+            {
+                if (ec)
+                    throw std::runtime_error("Cannot read " + source.string() + ": " + ec.message());
+
+                const fs::path &path = it->path();
+                String relative = path.lexically_relative(source).generic_string();
+                bool excluded = false;
+                for (const auto &prefix : options.exclude)
+                {
+                    if (relative == prefix || (relative.size() > prefix.size() && relative.compare(0, prefix.size(), prefix) == 0 &&
+                                               relative[prefix.size()] == '/'))
+                    {
+                        excluded = true;
+                        break;
+                    }
+                }
+                std::error_code typeError;
+                if (!excluded && it->is_directory(typeError) && fs::weakly_canonical(path, typeError) == storeRoot)
+                    excluded = true; // never back up the store into itself
+                if (excluded)
+                {
+                    it.disable_recursion_pending();
+                    continue;
+                }
+
+                BackupFile file;
+                file.path = std::move(relative);
+#ifndef _WIN32
+                // Symbolic links and special files are skipped
+                struct stat st;
+                if (::lstat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+                    continue;
+                file.size = static_cast<std::uint64_t>(st.st_size);
+                file.mtime = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+                file.inode = static_cast<std::uint64_t>(st.st_ino);
+                file.mode = static_cast<std::uint32_t>(st.st_mode & 07777);
+#else
+                if (it->is_symlink(typeError) || !it->is_regular_file(typeError))
+                    continue;
+                file.size = it->file_size(typeError);
+                file.mtime = it->last_write_time(typeError).time_since_epoch().count();
+                file.mode = 0644;
+#endif
+                stats.totalBytes += file.size;
+
+                auto hit = previous.find(file.path);
+                if (hit != previous.end() && hit->second->size == file.size && hit->second->mtime == file.mtime &&
+                    hit->second->inode == file.inode)
+                {
+                    file.chunks = hit->second->chunks;
+                    stats.unchangedFiles++;
+                }
+                else
+                {
+                    changed.push_back(manifest.size());
+                }
+                manifest.push_back(std::move(file));
+            }
+
+            // Chunks of the previous snapshot are known to be stored
+            std::mutex mutex;
+            std::unordered_set<internal::ChunkId, internal::ChunkIdHash> known;
+            for (const auto &file : parent)
+                known.insert(file.chunks.begin(), file.chunks.end());
+
+            // Big files first so the last worker is not left with one
+            std::sort(changed.begin(), changed.end(), [&manifest](std::size_t a, std::size_t b)
+                      { return manifest[a].size > manifest[b].size; });
+
+            std::atomic<std::size_t> newChunks{0};
+            std::atomic<std::uint64_t> readBytes{0}, writtenBytes{0};
+
+            auto storeChunk = [&](const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &packed) -> internal::ChunkId
+            {
+                cnt::Sha1 sha;
+                sha.update(data, size);
+                internal::ChunkId id = sha.digest();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!known.insert(id).second)
+                        return id;
+                }
+                const fs::path path = _chunkPath(id);
+                std::error_code existsError;
+                if (fs::exists(path, existsError))
+                    return id;
+
+                packed.clear();
+                packed.push_back(0);
+                if (options.compress && size > 64)
+                {
+                    // Chunks of already compressed data (region sectors, jars, pngs) give
+                    // up after a cheap probe instead of a full pass
+                    std::size_t probe = std::min<std::size_t>(size, 4096);
+                    cnt::Deflater::deflate(data, probe, packed, 4);
+                    if (packed.size() - 1 < probe - probe / 8)
+                    {
+                        packed.resize(1);
+                        cnt::Deflater::deflate(data, size, packed);
+                        if (packed.size() - 1 < size)
+                            packed[0] = 8;
+                    }
+                }
+                if (packed[0] == 0)
+                {
+                    packed.resize(1);
+                    packed.insert(packed.end(), data, data + size);
+                }
+
+                std::error_code dirError;
+                fs::create_directories(path.parent_path(), dirError);
+                internal::writeFileAtomically(path, packed.data(), packed.size());
+                newChunks.fetch_add(1, std::memory_order_relaxed);
+                writtenBytes.fetch_add(packed.size(), std::memory_order_relaxed);
+                return id;
+            };
+
+            internal::parallelFor(changed.size(), [&](std::size_t index)
+                                  {
+                BackupFile &file = manifest[changed[index]];
+                file.chunks.clear();
+
+                std::ifstream input(source / fs::path(file.path), std::ios::binary);
+                if (!input.is_open())
+                    throw std::runtime_error("Cannot open file: " + (source / fs::path(file.path)).string());
+
+                thread_local std::vector<std::uint8_t> buffer;
+                thread_local std::vector<std::uint8_t> packed;
+                buffer.resize(internal::MAX_CHUNK * 4);
+
+                // Keep at least one maximum chunk buffered so boundaries do not
+                // depend on how the file was read
+                std::size_t begin = 0, filled = 0;
+                std::uint64_t total = 0;
+                bool eof = false;
+                for (;;)
+                {
+                    if (!eof && filled - begin < internal::MAX_CHUNK)
+                    {
+                        std::memmove(buffer.data(), buffer.data() + begin, filled - begin);
+                        filled -= begin;
+                        begin = 0;
+                        input.read(reinterpret_cast<char *>(buffer.data() + filled), static_cast<std::streamsize>(buffer.size() - filled));
+                        std::size_t got = static_cast<std::size_t>(input.gcount());
+                        filled += got;
+                        total += got;
+                        eof = !input;
+                    }
+                    if (begin == filled)
+                        break;
+
+                    std::size_t length = internal::nextChunkBoundary(buffer.data() + begin, filled - begin);
+                    file.chunks.push_back(storeChunk(buffer.data() + begin, length, packed));
+                    begin += length;
+                }
+                // The file may have changed since it was listed, record what was read
+                file.size = total;
+                readBytes.fetch_add(total, std::memory_order_relaxed); },
+                                  options.threads);
+
+            for (const auto &file : manifest)
+                stats.chunks += file.chunks.size();
+            stats.files = manifest.size();
+            stats.newChunks = newChunks.load();
+            stats.readBytes = readBytes.load();
+            stats.writtenBytes = writtenBytes.load();
+
+            // The manifest is written last, a crash before it leaves only unreferenced chunks
+            const fs::path series = _root / "snapshots" / name;
+            fs::create_directories(series, ec);
+            String time = internal::snapshotTime();
+            String id = time;
+            for (int attempt = 1; fs::exists(series / (id + ".manifest"), ec); attempt++)
+                id = time + '-' + std::to_string(attempt);
+
+            const String text = internal::formatBackupManifest(manifest);
+            internal::writeFileAtomically(series / (id + ".manifest"), text.data(), text.size());
+            stats.snapshot = name + '/' + id;
+            return stats;
+        }
+
+        void BackupStore::restore(const String &snapshot, const fs::path &target, unsigned int threads) const
+        {
+            const std::vector<BackupFile> manifest = files(snapshot);
+            for (const auto &file : manifest)
+            {
+                for (const auto &part : fs::path(file.path))
+                {
+                    if (part == ".." || fs::path(file.path).is_absolute())
+                        throw std::runtime_error("Unsafe path in backup manifest: " + file.path);
+                }
+            }
+
+            std::error_code ec;
+            fs::create_directories(target, ec);
+
+            internal::parallelFor(manifest.size(), [&](std::size_t index)
+                                  {
+                const BackupFile &file = manifest[index];
+                const fs::path destination = target / fs::path(file.path);
+                std::error_code dirError;
+                fs::create_directories(destination.parent_path(), dirError);
+
+                std::ofstream output(destination, std::ios::binary | std::ios::trunc);
+                if (!output.is_open())
+                    throw std::runtime_error("Cannot write file: " + destination.string());
+
+                std::vector<std::uint8_t> decoded;
+                for (const auto &chunk : file.chunks)
+                {
+                    const String stored = internal::readWholeFile(_chunkPath(chunk));
+                    if (stored.empty())
+                        throw std::runtime_error("Corrupt backup chunk " + internal::hexChunkId(chunk));
+
+                    const std::uint8_t *data = reinterpret_cast<const std::uint8_t *>(stored.data()) + 1;
+                    std::size_t size = stored.size() - 1;
+                    if (stored[0] == 8)
+                    {
+                        decoded.clear();
+                        cnt::Inflater::inflate(data, size, decoded, internal::MAX_CHUNK);
+                        data = decoded.data();
+                        size = decoded.size();
+                    }
+                    else if (stored[0] != 0)
+                    {
+                        throw std::runtime_error("Corrupt backup chunk " + internal::hexChunkId(chunk));
+                    }
+
+                    cnt::Sha1 sha;
+                    sha.update(data, size);
+                    if (sha.digest() != chunk)
+                        throw std::runtime_error("Corrupt backup chunk " + internal::hexChunkId(chunk));
+                    output.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+                }
+                output.close();
+                if (!output)
+                    throw std::runtime_error("Cannot write file: " + destination.string());
+
+#ifndef _WIN32
+                ::chmod(destination.c_str(), static_cast<mode_t>(file.mode));
+                struct timespec times[2];
+                times[0].tv_sec = times[1].tv_sec = static_cast<time_t>(file.mtime / 1000000000);
+                times[0].tv_nsec = times[1].tv_nsec = static_cast<long>(file.mtime % 1000000000);
+                ::utimensat(AT_FDCWD, destination.c_str(), times, 0);
+#else
+                fs::last_write_time(destination, fs::file_time_type(fs::file_time_type::duration(file.mtime)), dirError);
+#endif
+                                  },
+                                  threads);
+        }
+
+        void BackupStore::prune(const String &name, std::size_t keep)
+        {
+            std::vector<String> existing = snapshots(name);
+            if (existing.size() <= keep)
+                return;
+            existing.resize(existing.size() - keep);
+            for (const auto &snapshot : existing)
+            {
+                std::error_code ec;
+                fs::remove(_root / "snapshots" / (snapshot + ".manifest"), ec);
+            }
+        }
+
+        std::size_t BackupStore::collectGarbage()
+        {
+            // Must not run while a backup into the same store is in progress
+            std::unordered_set<internal::ChunkId, internal::ChunkIdHash> referenced;
+            std::error_code ec;
+            for (fs::directory_iterator series(_root / "snapshots", ec), end; !ec && series != end; series.increment(ec))
+            {
+                for (const auto &snapshot : snapshots(series->path().filename().string()))
+                {
+                    for (const auto &file : files(snapshot))
+                        referenced.insert(file.chunks.begin(), file.chunks.end());
+                }
+            }
+
+            std::size_t removed = 0;
+            for (fs::recursive_directory_iterator it(_root / "chunks", ec), end; !ec && it != end; it.increment(ec))
+            {
+                const String name = it->path().filename().string();
+                internal::ChunkId id;
+                bool stale = name.compare(0, 5, ".tmp-") == 0;
+                if (stale || (internal::parseChunkId(name, id) && !referenced.count(id)))
+                {
+                    std::error_code removeError;
+                    if (fs::remove(it->path(), removeError))
+                        removed++;
+                }
+            }
+            return removed;
+        }
+    } // namespace minecraft
+
+} // namespace cnt
@@ -0,0 +1,648 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/cache.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/cache.hpp>
+#include <minecraft/zip.hpp>
+#include <minecraft/lib/metrics.hpp>
+#include <minecraft/lib/log.hpp>
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            // File header: magic, u32 version, u32 retired, u64 end of the log, padding.
+            // Records: u32 crc, u32 key size, u32 value size, u16 namespace size,
+            // u16 flags, u64 expiry (unix ms, 0 never), then namespace, key and
+            // value, padded to 8 bytes. The CRC covers everything after itself.
+            // Integers are in host byte order, the file is a local cache.
+            constexpr char StoreMagic[8] = {'C', 'N', 'T', 'S', 'T', 'O', 'R', 'E'};
+            constexpr std::uint32_t StoreVersion = 1;
+            constexpr std::uint64_t StoreHeaderSize = 64;
+            constexpr std::uint64_t StoreRecordHeaderSize = 24;
+            constexpr std::uint16_t StoreRecordErased = 1;
+
+            // Compact once the log is past this size and mostly dead records
+            constexpr std::uint64_t StoreCompactThreshold = 1 << 20;
+
+            struct StoreRecord
+            {
+                std::uint32_t crc;
+                std::uint32_t keySize;
+                std::uint32_t valueSize;
+                std::uint16_t nsSize;
+                std::uint16_t flags;
+                std::uint64_t expires;
+
+                std::uint64_t size() const
+                {
+                    return (StoreRecordHeaderSize + nsSize + keySize + valueSize + 7) & ~std::uint64_t(7);
+                }
+            };
+
+            static StoreRecord readStoreRecord(const std::uint8_t *data)
+            {
+                StoreRecord record;
+                std::memcpy(&record.crc, data, 4);
+                std::memcpy(&record.keySize, data + 4, 4);
+                std::memcpy(&record.valueSize, data + 8, 4);
+                std::memcpy(&record.nsSize, data + 12, 2);
+                std::memcpy(&record.flags, data + 14, 2);
+                std::memcpy(&record.expires, data + 16, 8);
+                return record;
+            }
+
+            // The header fields other processes poll are accessed atomically through the shared mapping
+            static std::atomic<std::uint32_t> &storeRetired(std::uint8_t *data)
+            {
+                return *reinterpret_cast<std::atomic<std::uint32_t> *>(data + 12);
+            }
+
+            static std::atomic<std::uint64_t> &storeEnd(std::uint8_t *data)
+            {
+                return *reinterpret_cast<std::atomic<std::uint64_t> *>(data + 16);
+            }
+
+            static String storeHeader(std::uint64_t end)
+            {
+                String header(StoreHeaderSize, '\0');
+                std::memcpy(&header[0], StoreMagic, 8);
+                std::memcpy(&header[8], &StoreVersion, 4);
+                std::memcpy(&header[16], &end, 8);
+                return header;
+            }
+
+            static std::uint64_t storeNow()
+            {
+                return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                      std::chrono::system_clock::now().time_since_epoch())
+                                                      .count());
+            }
+
+            static String storeKey(std::string_view ns, std::string_view key)
+            {
+                String composite;
+                composite.reserve(ns.size() + 1 + key.size());
+                composite.append(ns.data(), ns.size());
+                composite.push_back('\0');
+                composite.append(key.data(), key.size());
+                return composite;
+            }
+
+            fs::path defaultCacheStorePath()
+            {
+#ifdef _WIN32
+                const char *base = std::getenv("LOCALAPPDATA");
+                if (!base || !*base)
+                    return fs::path();
+                return fs::path(base) / "minecraft-engine" / "store.kv";
+#else
+                const char *base = std::getenv("XDG_CACHE_HOME");
+                if (base && *base)
+                    return fs::path(base) / "minecraft-engine" / "store.kv";
+                const char *home = std::getenv("HOME");
+                if (!home || !*home)
+                    return fs::path();
+                return fs::path(home) / ".cache" / "minecraft-engine" / "store.kv";
+#endif
+            }
+
+            String fileCacheKey(const fs::path &file)
+            {
+                std::error_code ec;
+                std::uintmax_t size = fs::file_size(file, ec);
+                if (ec)
+                    return String();
+                fs::file_time_type time = fs::last_write_time(file, ec);
+                if (ec)
+                    return String();
+                return file.string() + '\n' + std::to_string(size) + '\n' + std::to_string(time.time_since_epoch().count());
+            }
+        }
+
+        CacheStore &CacheStore::shared()
+        {
+            static CacheStore store;
+            static std::once_flag once;
+            std::call_once(once, []()
+                           {
+                store.setTtl("java-version", std::chrono::hours(24 * 30));
+                store.setTtl("sha1", std::chrono::hours(24 * 30));
+
+                fs::path path = internal::defaultCacheStorePath();
+                Result<void> opened = path.empty() ? Result<void>(Error(Errc::NOT_FOUND, "No cache directory")) : store.open(path);
+                if (!opened)
+                    CNT_LOG_WARN("Cache store disabled: {}", opened.error().message()); });
+            return store;
+        }
+
+        CacheStore::~CacheStore()
+        {
+            _closeFile();
+#ifndef _WIN32
+            if (_lockFd >= 0)
+                ::close(_lockFd);
+#endif
+        }
+
+        bool CacheStore::isOpen() const
+        {
+            std::shared_lock<std::shared_mutex> lock(_mutex);
+            return _data != nullptr;
+        }
+
+        void CacheStore::setTtl(std::string_view ns, std::chrono::seconds ttl)
+        {
+            std::unique_lock<std::shared_mutex> lock(_mutex);
+            _ttl[String(ns)] = ttl;
+        }
+
+#ifndef _WIN32
+        namespace internal
+        {
+            // Exclusive lock on <path>.lock for the duration of a write
+            class StoreWriteLock
+            {
+            private:
+                int _fd;
+
+            public:
+                explicit StoreWriteLock(int fd) : _fd(fd)
+                {
+                    while (::flock(_fd, LOCK_EX) != 0 && errno == EINTR)
+                    {
+                    }
+                }
+                ~StoreWriteLock() { ::flock(_fd, LOCK_UN); }
+            };
+
+            static bool writeAll(int fd, const char *data, std::size_t size, std::uint64_t offset)
+            {
+                while (size > 0)
+                {
+                    ssize_t n = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+                    if (n < 0 && errno == EINTR)
+                        continue;
+                    if (n <= 0)
+                        return false;
+                    data += n;
+                    size -= static_cast<std::size_t>(n);
+                    offset += static_cast<std::uint64_t>(n);
+                }
+                return true;
+            }
+        }
+
+        Result<void> CacheStore::open(const fs::path &path)
+        {
+            std::unique_lock<std::shared_mutex> lock(_mutex);
+            _closeFile();
+            if (_lockFd >= 0)
+            {
+                ::close(_lockFd);
+                _lockFd = -1;
+            }
+
+            _path = path;
+            std::error_code ec;
+            if (path.has_parent_path())
+                fs::create_directories(path.parent_path(), ec);
+
+            fs::path lockPath = path;
+            lockPath += ".lock";
+            _lockFd = ::open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (_lockFd < 0)
+                return Error::from(std::error_code(errno, std::generic_category()), "Opening " + lockPath.string());
+
+            Result<void> opened = _openFile();
+            if (!opened)
+                return opened;
+            return _sync(false);
+        }
+
+        Result<void> CacheStore::_openFile()
+        {
+            for (int attempt = 0; attempt < 2; attempt++)
+            {
+                _fd = ::open(_path.c_str(), O_RDWR | O_CLOEXEC);
+                if (_fd >= 0 || errno != ENOENT)
+                    break;
+
+                // Publish a complete header with link(), which fails if another process won
+                fs::path temporary = _path;
+                temporary += ".init-" + std::to_string(::getpid());
+                int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+                if (fd < 0)
+                    return Error::from(std::error_code(errno, std::generic_category()), "Creating " + _path.string());
+                String header = internal::storeHeader(internal::StoreHeaderSize);
+                bool written = internal::writeAll(fd, header.data(), header.size(), 0);
+                ::close(fd);
+                if (written)
+                    ::link(temporary.c_str(), _path.c_str());
+                ::unlink(temporary.c_str());
+            }
+            if (_fd < 0)
+                return Error::from(std::error_code(errno, std::generic_category()), "Opening " + _path.string());
+
+            struct stat st;
+            if (::fstat(_fd, &st) != 0 || static_cast<std::uint64_t>(st.st_size) < internal::StoreHeaderSize)
+            {
+                _closeFile();
+                return Error(Errc::PARSE, "Not a cache store", _path.string());
+            }
+
+            _mapped = static_cast<std::size_t>(st.st_size);
+            void *mapping = ::mmap(nullptr, _mapped, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                Error error = Error::from(std::error_code(errno, std::generic_category()), "Mapping " + _path.string());
+                _mapped = 0;
+                _closeFile();
+                return error;
+            }
+            _data = static_cast<std::uint8_t *>(mapping);
+
+            std::uint32_t version = 0;
+            std::memcpy(&version, _data + 8, 4);
+            if (std::memcmp(_data, internal::StoreMagic, 8) != 0 || version != internal::StoreVersion)
+            {
+                _closeFile();
+                return Error(Errc::PARSE, "Not a cache store of this version", _path.string());
+            }
+
+            _indexed = internal::StoreHeaderSize;
+            return {};
+        }
+
+        void CacheStore::_closeFile()
+        {
+            if (_data)
+                ::munmap(_data, _mapped);
+            if (_fd >= 0)
+                ::close(_fd);
+            _data = nullptr;
+            _mapped = 0;
+            _fd = -1;
+            _index.clear();
+            _indexed = 0;
+            _liveBytes = 0;
+        }
+
+        bool CacheStore::_current() const
+        {
+            return _data && internal::storeRetired(_data).load(std::memory_order_acquire) == 0 &&
+                   internal::storeEnd(_data).load(std::memory_order_acquire) == _indexed;
+        }
+
+        Result<void> CacheStore::_sync(bool writer)
+        {
+            // A compaction replaced the file, follow it to the new one
+            while (_data && internal::storeRetired(_data).load(std::memory_order_acquire) != 0)
+            {
+                _closeFile();
+                Result<void> reopened = _openFile();
+                if (!reopened)
+                    return reopened;
+            }
+            if (!_data)
+                return Error(Errc::INVALID, "Cache store is not open");
+
+            std::uint64_t end = internal::storeEnd(_data).load(std::memory_order_acquire);
+            if (end < _indexed)
+            {
+                // Only a damaged header moves the end backwards, index again
+                _index.clear();
+                _liveBytes = 0;
+                _indexed = internal::StoreHeaderSize;
+            }
+
+            if (end > _mapped)
+            {
+                struct stat st;
+                if (::fstat(_fd, &st) != 0)
+                    return Error::from(std::error_code(errno, std::generic_category()), "Reading " + _path.string());
+                std::size_t size = static_cast<std::size_t>(st.st_size);
+                void *mapping = ::mremap(_data, _mapped, size, MREMAP_MAYMOVE);
+                if (mapping == MAP_FAILED)
+                    return Error::from(std::error_code(errno, std::generic_category()), "Mapping " + _path.string());
+                _data = static_cast<std::uint8_t *>(mapping);
+                _mapped = size;
+                end = std::min<std::uint64_t>(end, size);
+            }
+
+            std::uint64_t valid = _scan(end);
+            if (valid < end && writer)
+            {
+                // Torn tail of a crashed writer, the next append overwrites it
+                CNT_LOG_WARN("Cache store {}: dropping {} bytes after a damaged record", _path, end - valid);
+                internal::storeEnd(_data).store(valid, std::memory_order_release);
+            }
+            return {};
+        }
+
+        Result<void> CacheStore::_append(std::string_view ns, std::string_view key, std::string_view value, bool erase)
+        {
+            internal::StoreRecord record{};
+            record.keySize = static_cast<std::uint32_t>(key.size());
+            record.valueSize = static_cast<std::uint32_t>(value.size());
+            record.nsSize = static_cast<std::uint16_t>(ns.size());
+            record.flags = erase ? internal::StoreRecordErased : 0;
+            auto ttl = _ttl.find(String(ns));
+            if (!erase && ttl != _ttl.end() && ttl->second.count() > 0)
+                record.expires = internal::storeNow() + static_cast<std::uint64_t>(ttl->second.count()) * 1000;
+
+            String buffer(record.size(), '\0');
+            std::memcpy(&buffer[4], &record.keySize, 4);
+            std::memcpy(&buffer[8], &record.valueSize, 4);
+            std::memcpy(&buffer[12], &record.nsSize, 2);
+            std::memcpy(&buffer[14], &record.flags, 2);
+            std::memcpy(&buffer[16], &record.expires, 8);
+            std::size_t pos = internal::StoreRecordHeaderSize;
+            std::memcpy(&buffer[pos], ns.data(), ns.size());
+            std::memcpy(&buffer[pos + ns.size()], key.data(), key.size());
+            std::memcpy(&buffer[pos + ns.size() + key.size()], value.data(), value.size());
+            record.crc = internal::crc32(buffer.data() + 4, internal::StoreRecordHeaderSize - 4 + ns.size() + key.size() + value.size());
+            std::memcpy(&buffer[0], &record.crc, 4);
+
+            std::uint64_t end = internal::storeEnd(_data).load(std::memory_order_acquire);
+            if (!internal::writeAll(_fd, buffer.data(), buffer.size(), end))
+                return Error::from(std::error_code(errno, std::generic_category()), "Writing " + _path.string());
+
+            // Readers only look at records below the end, publish it last
+            internal::storeEnd(_data).store(end + buffer.size(), std::memory_order_release);
+            return _sync(true);
+        }
+
+        Result<void> CacheStore::_compact()
+        {
+            fs::path temporary = _path;
+            temporary += ".compact";
+            int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0)
+                return Error::from(std::error_code(errno, std::generic_category()), "Creating " + temporary.string());
+
+            // Live records in log order, expired ones are dropped
+            std::vector<std::uint64_t> offsets;
+            offsets.reserve(_index.size());
+            for (const auto &entry : _index)
+                offsets.push_back(entry.second);
+            std::sort(offsets.begin(), offsets.end());
+
+            const std::uint64_t now = internal::storeNow();
+            String buffer = internal::storeHeader(0);
+            std::uint64_t written = 0;
+            bool ok = true;
+            for (std::uint64_t offset : offsets)
+            {
+                internal::StoreRecord record = internal::readStoreRecord(_data + offset);
+                if (record.expires != 0 && record.expires <= now)
+                    continue;
+                buffer.append(reinterpret_cast<const char *>(_data + offset), record.size());
+                if (buffer.size() >= (1 << 20))
+                {
+                    ok = ok && internal::writeAll(fd, buffer.data(), buffer.size(), written);
+                    written += buffer.size();
+                    buffer.clear();
+                }
+            }
+            ok = ok && internal::writeAll(fd, buffer.data(), buffer.size(), written);
+            written += buffer.size();
+
+            String header = internal::storeHeader(written);
+            ok = ok && internal::writeAll(fd, header.data(), header.size(), 0) && ::fdatasync(fd) == 0;
+            int error = errno;
+            ::close(fd);
+            if (!ok || ::rename(temporary.c_str(), _path.c_str()) != 0)
+            {
+                error = ok ? errno : error;
+                ::unlink(temporary.c_str());
+                return Error::from(std::error_code(error, std::generic_category()), "Compacting " + _path.string());
+            }
+
+            // Handles of every process move to the new file on their next access
+            internal::storeRetired(_data).store(1, std::memory_order_release);
+            return _sync(true);
+        }
+
+        Result<void> CacheStore::put(std::string_view ns, std::string_view key, std::string_view value)
+        {
+            if (ns.size() > 0xffff || key.size() > 0xffffffffu || value.size() > 0xffffffffu)
+                return Error(Errc::OUT_OF_RANGE, "Cache record is too large");
+
+            std::unique_lock<std::shared_mutex> lock(_mutex);
+            if (!_data)
+                return Error(Errc::INVALID, "Cache store is not open");
+            internal::StoreWriteLock writeLock(_lockFd);
+            Result<void> synced = _sync(true);
+            if (!synced)
+                return synced;
+            Result<void> appended = _append(ns, key, value, false);
+            if (!appended)
+                return appended;
+
+            std::uint64_t used = _indexed - internal::StoreHeaderSize;
+            if (used > internal::StoreCompactThreshold && _liveBytes * 2 < used)
+                return _compact();
+            return {};
+        }
+
+        Result<void> CacheStore::erase(std::string_view ns, std::string_view key)
+        {
+            if (ns.size() > 0xffff || key.size() > 0xffffffffu)
+                return Error(Errc::OUT_OF_RANGE, "Cache record is too large");
+
+            std::unique_lock<std::shared_mutex> lock(_mutex);
+            if (!_data)
+                return Error(Errc::INVALID, "Cache store is not open");
+            internal::StoreWriteLock writeLock(_lockFd);
+            Result<void> synced = _sync(true);
+            if (!synced)
+                return synced;
+            if (_index.find(internal::storeKey(ns, key)) == _index.end())
+                return {};
+            return _append(ns, key, std::string_view(), true);
+        }
+
+        Result<void> CacheStore::compact()
+        {
+            std::unique_lock<std::shared_mutex> lock(_mutex);
+            if (!_data)
+                return Error(Errc::INVALID, "Cache store is not open");
+            internal::StoreWriteLock writeLock(_lockFd);
+            Result<void> synced = _sync(true);
+            if (!synced)
+                return synced;
+            return _compact();
+        }
+
+        Result<void> CacheStore::flush()
+        {
+            std::shared_lock<std::shared_mutex> lock(_mutex);
+            if (!_data)
+                return Error(Errc::INVALID, "Cache store is not open");
+            if (::fdatasync(_fd) != 0)
+                return Error::from(std::error_code(errno, std::generic_category()), "Flushing " + _path.string());
+            return {};
+        }
+#else
+        Result<void> CacheStore::open(const fs::path &path)
+        {
+            _path = path;
+            return Error(Errc::INVALID, "The cache store is not supported on this platform yet");
+        }
+
+        void CacheStore::_closeFile() {}
+        bool CacheStore::_current() const { return false; }
+
+        Result<void> CacheStore::_sync(bool)
+        {
+            return Error(Errc::INVALID, "Cache store is not open");
+        }
+
+        Result<void> CacheStore::put(std::string_view, std::string_view, std::string_view)
+        {
+            return Error(Errc::INVALID, "Cache store is not open");
+        }
+
+        Result<void> CacheStore::erase(std::string_view, std::string_view)
+        {
+            return Error(Errc::INVALID, "Cache store is not open");
+        }
+
+        Result<void> CacheStore::compact()
+        {
+            return Error(Errc::INVALID, "Cache store is not open");
+        }
+
+        Result<void> CacheStore::flush()
+        {
+            return Error(Errc::INVALID, "Cache store is not open");
+        }
+#endif
+
+        std::uint64_t CacheStore::_scan(std::uint64_t end)
+        {
+            std::uint64_t pos = _indexed;
+            while (pos + internal::StoreRecordHeaderSize <= end)
+            {
+                internal::StoreRecord record = internal::readStoreRecord(_data + pos);
+                std::uint64_t size = record.size();
+                if (pos + size > end)
+                    break;
+                std::size_t body = internal::StoreRecordHeaderSize - 4 + record.nsSize + record.keySize + record.valueSize;
+                if (internal::crc32(_data + pos + 4, body) != record.crc)
+                    break;
+
+                const char *text = reinterpret_cast<const char *>(_data + pos + internal::StoreRecordHeaderSize);
+                String key = internal::storeKey(std::string_view(text, record.nsSize), std::string_view(text + record.nsSize, record.keySize));
+                auto it = _index.find(key);
+                if (it != _index.end())
+                {
+                    _liveBytes -= internal::readStoreRecord(_data + it->second).size();
+                    if (record.flags & internal::StoreRecordErased)
+                        _index.erase(it);
+                    else
+                        it->second = pos;
+                }
+                else if (!(record.flags & internal::StoreRecordErased))
+                {
+                    _index.emplace(std::move(key), pos);
+                }
+                if (!(record.flags & internal::StoreRecordErased))
+                    _liveBytes += size;
+                pos += size;
+            }
+            _indexed = pos;
+            return pos;
+        }
+
+        std::optional<String> CacheStore::get(std::string_view ns, std::string_view key)
+        {
+            static Counter &hits = Metrics::shared().counter("cnt_cache_hits_total", "Lookups served from a cache", "cache=\"store\"");
+            static Counter &misses = Metrics::shared().counter("cnt_cache_misses_total", "Lookups that had to rebuild the entry", "cache=\"store\"");
+            const String composite = internal::storeKey(ns, key);
+
+            auto lookup = [&]() -> std::optional<String>
+            {
+                auto it = _index.find(composite);
+                if (it == _index.end())
+                {
+                    misses.add();
+                    return std::nullopt;
+                }
+                internal::StoreRecord record = internal::readStoreRecord(_data + it->second);
+                if (record.expires != 0 && record.expires <= internal::storeNow())
+                {
+                    misses.add();
+                    return std::nullopt;
+                }
+                hits.add();
+                const char *value = reinterpret_cast<const char *>(_data + it->second + internal::StoreRecordHeaderSize + record.nsSize + record.keySize);
+                return String(value, record.valueSize);
+            };
+
+            {
+                std::shared_lock<std::shared_mutex> lock(_mutex);
+                if (!_data)
+                    return std::nullopt;
+                if (_current())
+                    return lookup();
+            }
+
+            std::unique_lock<std::shared_mutex> lock(_mutex);
+            if (!_sync(false))
+                return std::nullopt;
+            return lookup();
+        }
+
+        CacheStoreStats CacheStore::stats()
+        {
+            std::unique_lock<std::shared_mutex> lock(_mutex);
+            CacheStoreStats stats;
+            if (!_data || !_sync(false))
+                return stats;
+            stats.fileBytes = _indexed;
+            stats.liveBytes = _liveBytes;
+            stats.liveRecords = _index.size();
+            return stats;
+        }
+    } // namespace minecraft
+
+} // namespace cnt
@@ -0,0 +1,118 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/cds.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/cds.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <thread>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            // Mix size and mtime of a file into a hash, missing files count too
+            static std::uint64_t hashFileStamp(const fs::path &file, std::uint64_t hash)
+            {
+                std::error_code ec;
+                std::uint64_t stamp[2] = {0, 0};
+                stamp[0] = fs::file_size(file, ec);
+                if (ec)
+                    stamp[0] = 0;
+                auto time = fs::last_write_time(file, ec);
+                if (!ec)
+                    stamp[1] = static_cast<std::uint64_t>(time.time_since_epoch().count());
+                return fnv1a64(std::string_view(reinterpret_cast<const char *>(stamp), sizeof(stamp)), hash);
+            }
+
+            std::uint64_t cdsArchiveKey(const JavaInfo &java, const Classpath &classpath)
+            {
+                std::uint64_t hash = fnv1a64(java.path.string());
+                hash = fnv1a64(java.version, hash);
+
+                // An in-place runtime update changes the image and the VM library
+                hash = hashFileStamp(java.path / "lib" / "modules", hash);
+#ifdef _WIN32
+                hash = hashFileStamp(java.path / "bin" / "server" / "jvm.dll", hash);
+#elif defined(__APPLE__)
+                hash = hashFileStamp(java.path / "lib" / "server" / "libjvm.dylib", hash);
+#else
+                hash = hashFileStamp(java.path / "lib" / "server" / "libjvm.so", hash);
+#endif
+
+                // The JVM rejects an archive whose jars changed, rebuild it instead
+                hash = fnv1a64(std::string_view(reinterpret_cast<const char *>(&classpath.hash), sizeof(classpath.hash)), hash);
+                for (const auto &entry : classpath.entries)
+                    hash = hashFileStamp(entry, hash);
+                return hash;
+            }
+        }
+
+        CdsPlan PlanCdsArchive(const JavaInfo &java, const Classpath &classpath, const fs::path &directory)
+        {
+            CdsPlan plan;
+            if (java.majorVersion() < 13)
+                return plan;
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(internal::cdsArchiveKey(java, classpath)));
+            plan.archive = directory / (String(name) + ".jsa");
+
+            std::error_code ec;
+            if (fs::file_size(plan.archive, ec) > 0 && !ec)
+            {
+                plan.arguments.push_back("-XX:SharedArchiveFile=" + plan.archive.string());
+                plan.arguments.push_back("-Xshare:auto");
+                return plan;
+            }
+
+            // Concurrent first launches each dump to their own file, the first to
+            // finish cleanly wins
+            fs::create_directories(directory);
+            const String suffix = std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + '-' +
+                                  std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+            plan.pending = directory / (String(name) + '.' + suffix + ".tmp");
+            plan.arguments.push_back("-XX:ArchiveClassesAtExit=" + plan.pending.string());
+            return plan;
+        }
+
+        void CommitCdsArchive(const CdsPlan &plan, int exitCode)
+        {
+            if (!plan.dumping())
+                return;
+
+            std::error_code ec;
+            if (exitCode == 0 && fs::file_size(plan.pending, ec) > 0 && !ec && !fs::exists(plan.archive))
+            {
+                fs::rename(plan.pending, plan.archive, ec);
+                if (!ec)
+                    return;
+            }
+            fs::remove(plan.pending, ec);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
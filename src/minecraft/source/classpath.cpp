@@ -0,0 +1,338 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/classpath.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <minecraft/classpath.hpp>
+#include <minecraft/launch.hpp>
+#include <minecraft/lib/trace.hpp>
+#include <minecraft/lib/metrics.hpp>
+
+#include <atomic>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            String MavenName::key() const
+            {
+                String result = group + ':' + artifact;
+                if (!classifier.empty())
+                    result += ':' + classifier;
+                return result;
+            }
+
+            fs::path MavenName::path() const
+            {
+                String groupPath = group;
+                std::replace(groupPath.begin(), groupPath.end(), '.', '/');
+
+                String file = artifact + '-' + version;
+                if (!classifier.empty())
+                    file += '-' + classifier;
+                file += '.' + extension;
+
+                return fs::path(groupPath) / artifact / version / file;
+            }
+
+            MavenName parseMavenName(const String &name)
+            {
+                MavenName result;
+
+                String coordinate = name;
+                std::size_t at = coordinate.find('@');
+                if (at != String::npos)
+                {
+                    result.extension = coordinate.substr(at + 1);
+                    coordinate.erase(at);
+                }
+
+                std::vector<String> parts;
+                std::size_t start = 0;
+                for (;;)
+                {
+                    std::size_t end = coordinate.find(':', start);
+                    parts.push_back(coordinate.substr(start, end - start));
+                    if (end == String::npos)
+                        break;
+                    start = end + 1;
+                }
+
+                if (parts.size() < 3)
+                    throw std::runtime_error("Invalid maven coordinate: " + name);
+
+                result.group = parts[0];
+                result.artifact = parts[1];
+                result.version = parts[2];
+                if (parts.size() > 3)
+                    result.classifier = parts[3];
+                return result;
+            }
+
+            int compareMavenVersions(std::string_view a, std::string_view b)
+            {
+                std::size_t i = 0, j = 0;
+                auto isSeparator = [](char c)
+                { return c == '.' || c == '-' || c == '_' || c == '+'; };
+
+                while (i < a.size() || j < b.size())
+                {
+                    std::size_t ei = i, ej = j;
+                    while (ei < a.size() && !isSeparator(a[ei]))
+                        ei++;
+                    while (ej < b.size() && !isSeparator(b[ej]))
+                        ej++;
+
+                    std::string_view sa = a.substr(i, ei - i);
+                    std::string_view sb = b.substr(j, ej - j);
+
+                    // A missing segment sorts before any present one (1.0 < 1.0.1)
+                    if (sa.empty() != sb.empty())
+                        return sa.empty() ? -1 : 1;
+
+                    bool numericA = !sa.empty() && std::all_of(sa.begin(), sa.end(), [](unsigned char c)
+                                                               { return std::isdigit(c); });
+                    bool numericB = !sb.empty() && std::all_of(sb.begin(), sb.end(), [](unsigned char c)
+                                                               { return std::isdigit(c); });
+
+                    if (numericA && numericB)
+                    {
+                        // Compare without overflow: strip leading zeros, longer is bigger
+                        while (sa.size() > 1 && sa.front() == '0')
+                            sa.remove_prefix(1);
+                        while (sb.size() > 1 && sb.front() == '0')
+                            sb.remove_prefix(1);
+                        if (sa.size() != sb.size())
+                            return sa.size() < sb.size() ? -1 : 1;
+                    }
+                    else if (numericA != numericB)
+                    {
+                        // Release segments sort after qualifiers (1.0-beta < 1.0.0)
+                        return numericA ? 1 : -1;
+                    }
+
+                    int cmp = sa.compare(sb);
+                    if (cmp != 0)
+                        return cmp < 0 ? -1 : 1;
+
+                    i = ei < a.size() ? ei + 1 : ei;
+                    j = ej < b.size() ? ej + 1 : ej;
+                }
+                return 0;
+            }
+
+            std::uint64_t fnv1a64(std::string_view data, std::uint64_t seed)
+            {
+                std::uint64_t hash = seed;
+                for (unsigned char c : data)
+                {
+                    hash ^= c;
+                    hash *= 1099511628211ull;
+                }
+                return hash;
+            }
+
+            Classpath resolveClasspath(const std::vector<std::unique_ptr<Config>> &chain, const fs::path &indexPath, const String &id)
+            {
+                CNT_TRACE_SCOPE_DETAIL("classpath", "resolveClasspath", id);
+                const fs::path librariesDir = indexPath / "libraries";
+                const fs::path versionsDir = indexPath / "versions";
+                const LaunchFeatures features;
+
+                struct Candidate
+                {
+                    String version;
+                    fs::path path;
+                };
+                std::vector<Candidate> candidates;
+                std::unordered_map<String, std::size_t> seen;
+
+                // Children first, so loader libraries lead the classpath
+                for (std::size_t p = chain.size(); p-- > 0;)
+                {
+                    ConfigObject libraries = chain[p]->get("libraries");
+                    for (std::size_t i = 0; i < libraries.size(); i++)
+                    {
+                        const ConfigObject &library = libraries.at(i);
+                        if (!library.has_key("name"))
+                            continue;
+                        if (library.has_key("rules") && !evaluateRules(library.at("rules"), features))
+                            continue;
+
+                        // Legacy natives entries are extracted, never put on the classpath
+                        if (library.has_key("natives") &&
+                            !(library.has_key("downloads") && library.at("downloads").has_key("artifact")))
+                            continue;
+
+                        MavenName name = parseMavenName(library.at("name").as_string().value_or(""));
+
+                        fs::path relative = name.path();
+                        if (library.has_key("downloads") && library.at("downloads").has_key("artifact"))
+                        {
+                            const ConfigObject &artifact = library.at("downloads").at("artifact");
+                            if (artifact.has_key("path"))
+                                relative = artifact.at("path").as_string().value_or(relative.string());
+                        }
+
+                        Candidate candidate{name.version, librariesDir / relative};
+                        auto it = seen.find(name.key());
+                        if (it == seen.end())
+                        {
+                            seen.emplace(name.key(), candidates.size());
+                            candidates.push_back(std::move(candidate));
+                        }
+                        else if (compareMavenVersions(candidates[it->second].version, candidate.version) < 0)
+                        {
+                            // Keep the position of the first occurrence, but the newest version
+                            candidates[it->second] = std::move(candidate);
+                        }
+                    }
+                }
+
+                // The client jar: an explicit "jar" wins, then the first profile that has one
+                std::vector<String> ids = profileChainIds(chain, id);
+                fs::path clientJar;
+                for (std::size_t p = chain.size(); p-- > 0 && clientJar.empty();)
+                {
+                    if (auto jar = chain[p]->get("jar").as_string())
+                        clientJar = versionsDir / *jar / (*jar + ".jar");
+                    else if (fs::exists(versionsDir / ids[p] / (ids[p] + ".jar")))
+                        clientJar = versionsDir / ids[p] / (ids[p] + ".jar");
+                }
+                if (clientJar.empty())
+                    clientJar = versionsDir / ids.front() / (ids.front() + ".jar");
+
+#ifdef _WIN32
+                const char separator = ';';
+#else
+                const char separator = ':';
+#endif
+
+                Classpath result;
+                result.entries.reserve(candidates.size() + 1);
+                for (auto &candidate : candidates)
+                    result.entries.push_back(std::move(candidate.path));
+                result.entries.push_back(clientJar);
+
+                // Join into one exactly reserved buffer
+                std::size_t length = 0;
+                for (const auto &entry : result.entries)
+                    length += entry.native().size() + 1;
+                result.value.reserve(length);
+
+                result.hash = fnv1a64("");
+                for (const auto &entry : result.entries)
+                {
+                    if (!result.value.empty())
+                        result.value += separator;
+                    const String text = entry.string();
+                    result.value += text;
+                    result.hash = fnv1a64(text, result.hash);
+                    result.hash = fnv1a64(std::string_view("\0", 1), result.hash);
+                }
+                return result;
+            }
+        }
+
+        ClasspathCache &ClasspathCache::shared()
+        {
+            static ClasspathCache cache;
+            return cache;
+        }
+
+        std::shared_ptr<const Classpath> ClasspathCache::get(const fs::path &indexPath, const String &id)
+        {
+            CNT_TRACE_SCOPE_DETAIL("classpath", "ClasspathCache::get", id);
+            const fs::path versionsDir = indexPath / "versions";
+            return _cache.get((versionsDir / id).string(), versionsDir, id, [&](const std::vector<std::unique_ptr<Config>> &chain)
+                              { return std::make_shared<const Classpath>(internal::resolveClasspath(chain, indexPath, id)); });
+        }
+
+        void ClasspathCache::clear()
+        {
+            _cache.clear();
+        }
+
+        fs::path WriteClasspathArgFile(const Classpath &classpath, const fs::path &directory)
+        {
+            CNT_TRACE_SCOPE("classpath", "WriteClasspathArgFile");
+            char name[32];
+            std::snprintf(name, sizeof(name), "%016llx.args", static_cast<unsigned long long>(classpath.hash));
+            fs::path target = directory / name;
+            if (fs::exists(target))
+                return target;
+
+            fs::create_directories(directory);
+
+            // Quote the value, the java launcher treats backslashes as escapes inside quotes
+            String content;
+            content.reserve(classpath.value.size() + 16);
+            content += "-cp\n\"";
+            for (char c : classpath.value)
+            {
+                if (c == '\\' || c == '"')
+                    content += '\\';
+                content += c;
+            }
+            content += "\"\n";
+
+            // Write to a temporary file first so concurrent launches never see a partial file.
+            // The name is unique per process and per call, so writers never share it
+            static std::atomic<unsigned long long> sequence{0};
+#ifdef _WIN32
+            const auto pid = ::_getpid();
+#else
+            const auto pid = ::getpid();
+#endif
+            fs::path temporary = target;
+            temporary += ".tmp-" + std::to_string(pid) + '-' + std::to_string(sequence.fetch_add(1, std::memory_order_relaxed));
+            {
+                std::ofstream file(temporary, std::ios::binary);
+                if (!file.is_open())
+                    throw std::runtime_error("Failed to open file: " + temporary.string());
+                file << content;
+                // A published file is reused as is, so a short write must never reach the target
+                file.close();
+                if (!file)
+                {
+                    std::error_code ec;
+                    fs::remove(temporary, ec);
+                    throw std::runtime_error("Failed to write file: " + temporary.string());
+                }
+            }
+            fs::rename(temporary, target);
+            return target;
+        }
+    } // namespace minecraft
+
+} // namespace cnt
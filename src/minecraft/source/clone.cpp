@@ -0,0 +1,294 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/clone.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <minecraft/clone.hpp>
+#include <minecraft/scheduler.hpp>
+
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <cerrno>
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+#ifndef _WIN32
+            // Small RAII wrapper so every early return closes its descriptors
+            struct FileDescriptor
+            {
+                int fd = -1;
+                explicit FileDescriptor(int _fd) : fd(_fd) {}
+                ~FileDescriptor()
+                {
+                    if (fd >= 0)
+                        ::close(fd);
+                }
+                FileDescriptor(const FileDescriptor &) = delete;
+                FileDescriptor &operator=(const FileDescriptor &) = delete;
+            };
+#endif
+
+            CloneMethod cloneFile(const fs::path &from, const fs::path &to, bool immutable, bool overwrite)
+            {
+                std::error_code ec;
+                if (fs::exists(fs::symlink_status(to, ec)))
+                {
+                    if (!overwrite)
+                        throw std::runtime_error("Clone target already exists: " + to.string());
+                    fs::remove(to, ec);
+                }
+
+                // Immutable content can safely share the same inode
+                if (immutable)
+                {
+                    fs::create_hard_link(from, to, ec);
+                    if (!ec)
+                        return CloneMethod::Hardlink;
+                }
+
+#ifndef _WIN32
+                FileDescriptor src(::open(from.c_str(), O_RDONLY | O_CLOEXEC));
+                if (src.fd < 0)
+                    throw std::runtime_error("Failed to open file: " + from.string());
+
+                struct stat st;
+                if (::fstat(src.fd, &st) != 0)
+                    throw std::runtime_error("Failed to stat file: " + from.string());
+
+                FileDescriptor dst(::open(to.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, st.st_mode & 07777));
+                if (dst.fd < 0)
+                    throw std::runtime_error("Failed to create file: " + to.string());
+
+#ifdef FICLONE
+                // Reflink shares all extents in O(1) on btrfs/xfs/bcachefs
+                if (::ioctl(dst.fd, FICLONE, src.fd) == 0)
+                    return CloneMethod::Reflink;
+#endif
+
+#ifdef __linux__
+                // In-kernel copy, which may still reflink or use server-side copy on NFS
+                off_t remaining = st.st_size;
+                bool rangeOk = true;
+                while (remaining > 0)
+                {
+                    ssize_t n = ::copy_file_range(src.fd, nullptr, dst.fd, nullptr, static_cast<size_t>(remaining), 0);
+                    if (n < 0)
+                    {
+                        if (errno == EINTR)
+                            continue;
+                        rangeOk = false;
+                        break;
+                    }
+                    if (n == 0)
+                        break;
+                    remaining -= n;
+                }
+                if (rangeOk)
+                    return CloneMethod::CopyRange;
+
+                // Restart from a clean file for the plain copy
+                if (::ftruncate(dst.fd, 0) != 0 || ::lseek(src.fd, 0, SEEK_SET) != 0)
+                    throw std::runtime_error("Failed to reset copy of: " + from.string());
+#endif
+
+                char buffer[1 << 16];
+                for (;;)
+                {
+                    ssize_t n = ::read(src.fd, buffer, sizeof(buffer));
+                    if (n < 0)
+                    {
+                        if (errno == EINTR)
+                            continue;
+                        throw std::runtime_error("Failed to read file: " + from.string());
+                    }
+                    if (n == 0)
+                        break;
+                    for (ssize_t off = 0; off < n;)
+                    {
+                        ssize_t w = ::write(dst.fd, buffer + off, static_cast<size_t>(n - off));
+                        if (w < 0)
+                        {
+                            if (errno == EINTR)
+                                continue;
+                            throw std::runtime_error("Failed to write file: " + to.string());
+                        }
+                        off += w;
+                    }
+                }
+                return CloneMethod::Copy;
+#else
+                fs::copy_file(from, to, fs::copy_options::overwrite_existing);
+                return CloneMethod::Copy;
+#endif
+            }
+        }
+
+        CloneStats CloneTree(const fs::path &from, const fs::path &to, const CloneOptions &options)
+        {
+            if (!fs::is_directory(from))
+                throw std::runtime_error("Clone source is not a directory: " + from.string());
+
+            fs::create_directories(to);
+
+            Scheduler &scheduler = Scheduler::shared();
+            unsigned int threads = options.threads;
+            if (threads == 0)
+                threads = scheduler.workers(TaskPool::Io) + 1;
+
+            // Directories still waiting to be walked, relative to the source root
+            std::deque<fs::path> queue;
+            queue.push_back(fs::path());
+            std::size_t busy = 0;
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::exception_ptr error;
+            CloneStats total;
+
+            auto isImmutable = [&](const fs::path &relative)
+            {
+                if (relative.empty())
+                    return false;
+                const String top = relative.begin()->string();
+                return std::find(options.immutableDirs.begin(), options.immutableDirs.end(), top) != options.immutableDirs.end();
+            };
+
+            auto worker = [&]()
+            {
+                CloneStats local;
+                for (;;)
+                {
+                    fs::path relative;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cv.wait(lock, [&]
+                                { return !queue.empty() || busy == 0 || error; });
+                        if (queue.empty() || error)
+                            break;
+                        relative = std::move(queue.front());
+                        queue.pop_front();
+                        busy++;
+                    }
+
+                    std::vector<fs::path> children;
+                    try
+                    {
+                        for (const auto &entry : fs::directory_iterator(from / relative))
+                        {
+                            fs::path child = relative / entry.path().filename();
+                            if (options.filter && !options.filter(child))
+                                continue;
+
+                            fs::path target = to / (options.rename ? options.rename(child) : child);
+                            auto status = entry.symlink_status();
+
+                            if (fs::is_symlink(status))
+                            {
+                                std::error_code ec;
+                                if (options.overwrite)
+                                    fs::remove(target, ec);
+                                fs::copy_symlink(entry.path(), target);
+                                local.symlinks++;
+                            }
+                            else if (fs::is_directory(status))
+                            {
+                                fs::create_directories(target);
+                                local.directories++;
+                                children.push_back(std::move(child));
+                            }
+                            else if (fs::is_regular_file(status))
+                            {
+                                switch (internal::cloneFile(entry.path(), target, isImmutable(child), options.overwrite))
+                                {
+                                case CloneMethod::Reflink:
+                                    local.reflinked++;
+                                    break;
+                                case CloneMethod::Hardlink:
+                                    local.hardlinked++;
+                                    break;
+                                case CloneMethod::CopyRange:
+                                case CloneMethod::Copy:
+                                    local.copied++;
+                                    break;
+                                }
+                                local.files++;
+                                local.bytes += entry.file_size();
+                            }
+                        }
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (!error)
+                            error = std::current_exception();
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        for (auto &child : children)
+                            queue.push_back(std::move(child));
+                        busy--;
+                    }
+                    cv.notify_all();
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                total.directories += local.directories;
+                total.files += local.files;
+                total.symlinks += local.symlinks;
+                total.reflinked += local.reflinked;
+                total.hardlinked += local.hardlinked;
+                total.copied += local.copied;
+                total.bytes += local.bytes;
+            };
+
+            // Walkers wait on each other only while one of them is busy, so a
+            // walker queued behind them finds nothing left and returns at once
+            TaskGroup group(TaskPool::Io, scheduler);
+            for (unsigned int i = 1; i < threads; i++)
+                group.run(worker);
+            worker();
+            group.wait();
+
+            if (error)
+                std::rethrow_exception(error);
+
+            return total;
+        }
+    } // namespace minecraft
+
+} // namespace cnt
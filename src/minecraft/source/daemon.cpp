@@ -0,0 +1,783 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/daemon.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/daemon.hpp>
+#include <minecraft/scheduler.hpp>
+#include <minecraft/lib/trace.hpp>
+#include <minecraft/lib/metrics.hpp>
+#include <minecraft/lib/log.hpp>
+
+#include <cstring>
+#include <climits>
+#include <stdexcept>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <cerrno>
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            void DaemonWriter::u32(std::uint32_t value)
+            {
+                for (int i = 0; i < 4; i++)
+                    _buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+            }
+
+            void DaemonWriter::string(std::string_view value)
+            {
+                u32(static_cast<std::uint32_t>(value.size()));
+                _buffer.append(value.data(), value.size());
+            }
+
+            void DaemonWriter::strings(const std::vector<String> &values)
+            {
+                u32(static_cast<std::uint32_t>(values.size()));
+                for (const auto &value : values)
+                    string(value);
+            }
+
+            String &DaemonWriter::finish()
+            {
+                std::uint32_t size = static_cast<std::uint32_t>(_buffer.size() - 4);
+                for (int i = 0; i < 4; i++)
+                    _buffer[i] = static_cast<char>((size >> (i * 8)) & 0xff);
+                return _buffer;
+            }
+
+            std::uint8_t DaemonReader::u8()
+            {
+                if (_data.empty())
+                {
+                    _ok = false;
+                    return 0;
+                }
+                std::uint8_t value = static_cast<std::uint8_t>(_data[0]);
+                _data.remove_prefix(1);
+                return value;
+            }
+
+            std::uint32_t DaemonReader::u32()
+            {
+                if (_data.size() < 4)
+                {
+                    _ok = false;
+                    _data = std::string_view();
+                    return 0;
+                }
+                std::uint32_t value = 0;
+                for (int i = 0; i < 4; i++)
+                    value |= std::uint32_t(static_cast<std::uint8_t>(_data[i])) << (i * 8);
+                _data.remove_prefix(4);
+                return value;
+            }
+
+            std::string_view DaemonReader::string()
+            {
+                std::uint32_t size = u32();
+                if (size > _data.size())
+                {
+                    _ok = false;
+                    _data = std::string_view();
+                    return std::string_view();
+                }
+                std::string_view value = _data.substr(0, size);
+                _data.remove_prefix(size);
+                return value;
+            }
+
+            std::vector<String> DaemonReader::strings()
+            {
+                std::vector<String> values;
+                std::uint32_t count = u32();
+                // Every string takes at least its length prefix
+                if (count > _data.size() / 4)
+                {
+                    _ok = false;
+                    _data = std::string_view();
+                    return values;
+                }
+                values.reserve(count);
+                for (std::uint32_t i = 0; i < count && _ok; i++)
+                    values.emplace_back(string());
+                return values;
+            }
+
+            const JavaInfo *selectJava(const JavaList &java, int major)
+            {
+                const JavaInfo *best = nullptr;
+                int bestMajor = INT_MAX;
+                for (const auto &candidate : java)
+                {
+                    int candidateMajor = candidate.majorVersion();
+                    if (candidateMajor == major)
+                        return &candidate;
+                    if (candidateMajor > major && candidateMajor < bestMajor)
+                    {
+                        best = &candidate;
+                        bestMajor = candidateMajor;
+                    }
+                }
+                return best;
+            }
+
+#ifndef _WIN32
+            bool sendDaemonFrame(int fd, const String &frame)
+            {
+                std::size_t sent = 0;
+                while (sent < frame.size())
+                {
+                    ssize_t n = ::send(fd, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+                    if (n < 0 && errno == EINTR)
+                        continue;
+                    if (n <= 0)
+                        return false;
+                    sent += static_cast<std::size_t>(n);
+                }
+                return true;
+            }
+
+            static bool receiveExact(int fd, char *data, std::size_t size)
+            {
+                std::size_t received = 0;
+                while (received < size)
+                {
+                    ssize_t n = ::recv(fd, data + received, size - received, 0);
+                    if (n < 0 && errno == EINTR)
+                        continue;
+                    if (n <= 0)
+                        return false;
+                    received += static_cast<std::size_t>(n);
+                }
+                return true;
+            }
+
+            bool receiveDaemonFrame(int fd, String &body)
+            {
+                char header[4];
+                if (!receiveExact(fd, header, sizeof(header)))
+                    return false;
+
+                DaemonReader reader(std::string_view(header, sizeof(header)));
+                std::uint32_t size = reader.u32();
+                if (size > DaemonMaxFrame)
+                    return false;
+
+                body.resize(size);
+                return size == 0 || receiveExact(fd, &body[0], size);
+            }
+#else
+            bool sendDaemonFrame(int, const String &)
+            {
+                return false;
+            }
+
+            bool receiveDaemonFrame(int, String &)
+            {
+                return false;
+            }
+#endif
+
+            // Response carrying an error: 1 + Errc, then the message
+            static String daemonFailure(const Error &error)
+            {
+                DaemonWriter out;
+                out.u8(static_cast<std::uint8_t>(1 + static_cast<int>(error.code)));
+                out.string(error.message());
+                return std::move(out.finish());
+            }
+
+            static void writeJavaInfo(DaemonWriter &out, const JavaInfo &java)
+            {
+                out.string(java.name);
+                out.string(java.publisher);
+                out.string(java.structure);
+                out.string(java.path.string());
+                out.string(java.version);
+            }
+
+            static JavaInfo readJavaInfo(DaemonReader &in)
+            {
+                String name(in.string());
+                String publisher(in.string());
+                String structure(in.string());
+                fs::path path(String(in.string()));
+                String version(in.string());
+                return JavaInfo(name, publisher, structure, path, version);
+            }
+
+            static void writeVariables(DaemonWriter &out, const DaemonVariables &variables)
+            {
+                out.u32(static_cast<std::uint32_t>(variables.size()));
+                for (const auto &variable : variables)
+                {
+                    out.string(variable.first);
+                    out.string(variable.second);
+                }
+            }
+        }
+
+#ifndef _WIN32
+        EngineDaemon::EngineDaemon(DaemonOptions options)
+            : _options(std::move(options)), _index(_options.index), _versionsDir(_options.index / "versions")
+        {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            const String &socketPath = _options.socket.native();
+            if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+                throw std::runtime_error("Invalid daemon socket path: " + socketPath);
+            std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+            _listen = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (_listen < 0)
+                throw std::runtime_error(String("Cannot create daemon socket: ") + std::strerror(errno));
+
+            int bound = ::bind(_listen, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+            if (bound != 0 && errno == EADDRINUSE)
+            {
+                // Only replace the socket if nobody answers on it
+                int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+                bool alive = probe >= 0 && ::connect(probe, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0;
+                if (probe >= 0)
+                    ::close(probe);
+                if (alive)
+                {
+                    ::close(_listen);
+                    throw std::runtime_error("Another daemon is listening on " + socketPath);
+                }
+                ::unlink(socketPath.c_str());
+                bound = ::bind(_listen, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+            }
+
+            // Only the owner may connect; no connection is accepted before listen()
+            if (bound == 0 && ::chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) != 0)
+            {
+                int error = errno;
+                ::close(_listen);
+                ::unlink(socketPath.c_str());
+                throw std::runtime_error("Cannot restrict " + socketPath + ": " + std::strerror(error));
+            }
+
+            if (bound != 0 || ::listen(_listen, 64) != 0)
+            {
+                int error = errno;
+                ::close(_listen);
+                throw std::runtime_error("Cannot listen on " + socketPath + ": " + std::strerror(error));
+            }
+
+            _wakeup = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (_wakeup < 0)
+            {
+                int error = errno;
+                ::close(_listen);
+                ::unlink(socketPath.c_str());
+                throw std::runtime_error(String("Cannot create daemon wakeup: ") + std::strerror(error));
+            }
+
+            _refreshJava(_options.deepJavaSearch);
+            _listVersions();
+            if (_options.warmProfiles)
+                _warm();
+            CNT_LOG_INFO("Engine daemon listening on {} ({} Java installations)", socketPath, _java.size());
+        }
+
+        EngineDaemon::~EngineDaemon()
+        {
+            stop();
+
+            std::vector<std::unique_ptr<Client>> clients;
+            {
+                std::lock_guard<std::mutex> lock(_clientsMutex);
+                clients.swap(_clients);
+            }
+            // Unblock readers, a request in progress still completes
+            for (auto &client : clients)
+                ::shutdown(client->fd, SHUT_RDWR);
+            for (auto &client : clients)
+            {
+                if (client->thread.joinable())
+                    client->thread.join();
+                ::close(client->fd);
+            }
+
+            ::close(_listen);
+            ::close(_wakeup);
+            ::unlink(_options.socket.c_str());
+        }
+
+        void EngineDaemon::serve()
+        {
+            pollfd fds[2] = {{_listen, POLLIN, 0}, {_wakeup, POLLIN, 0}};
+            while (!_stopping.load())
+            {
+                int count = ::poll(fds, 2, -1);
+                if (count < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::runtime_error(String("Daemon poll failed: ") + std::strerror(errno));
+                }
+                if (fds[1].revents)
+                    break;
+                if (!(fds[0].revents & POLLIN))
+                    continue;
+
+                int fd = ::accept4(_listen, nullptr, nullptr, SOCK_CLOEXEC);
+                if (fd < 0)
+                    continue;
+
+                // Requests launch processes as this user, so other users are refused
+                // even if the socket mode was loosened after it was created
+                ucred peer{};
+                socklen_t peerSize = sizeof(peer);
+                if (::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &peer, &peerSize) != 0 || peer.uid != ::geteuid())
+                {
+                    CNT_LOG_WARN("Rejected daemon connection from another user");
+                    ::close(fd);
+                    continue;
+                }
+
+                std::lock_guard<std::mutex> lock(_clientsMutex);
+                for (auto it = _clients.begin(); it != _clients.end();)
+                {
+                    if ((*it)->done.load())
+                    {
+                        (*it)->thread.join();
+                        ::close((*it)->fd);
+                        it = _clients.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+                if (_clients.size() >= _options.maxClients)
+                {
+                    ::close(fd);
+                    continue;
+                }
+
+                auto client = std::make_unique<Client>();
+                client->fd = fd;
+                client->thread = std::thread(&EngineDaemon::_serveClient, this, std::ref(*client));
+                _clients.push_back(std::move(client));
+            }
+        }
+
+        void EngineDaemon::stop()
+        {
+            _stopping.store(true);
+            std::uint64_t one = 1;
+            ssize_t written = ::write(_wakeup, &one, sizeof(one));
+            (void)written;
+        }
+
+        void EngineDaemon::_serveClient(Client &client)
+        {
+            String request;
+            while (!_stopping.load() && internal::receiveDaemonFrame(client.fd, request))
+            {
+                if (!internal::sendDaemonFrame(client.fd, _handle(request)))
+                    break;
+                if (!request.empty() && static_cast<DaemonOp>(request[0]) == DaemonOp::Shutdown)
+                    stop();
+            }
+            client.done.store(true);
+        }
+#else
+        EngineDaemon::EngineDaemon(DaemonOptions options)
+            : _options(std::move(options)), _index(_options.index), _versionsDir(_options.index / "versions")
+        {
+            throw std::runtime_error("The engine daemon is not supported on this platform yet");
+        }
+
+        EngineDaemon::~EngineDaemon() = default;
+        void EngineDaemon::serve() {}
+        void EngineDaemon::stop() {}
+#endif
+
+        String EngineDaemon::_handle(std::string_view request)
+        {
+            CNT_TRACE_SCOPE("daemon", "EngineDaemon::handle");
+            static Histogram &duration = Metrics::shared().histogram("cnt_daemon_request_duration_seconds", "Time to answer a daemon request", "", 1e-6);
+            HistogramTimer timer(duration);
+
+            internal::DaemonReader in(request);
+            internal::DaemonWriter out;
+            out.u8(0);
+            const Error malformed(Errc::INVALID, "Malformed daemon request");
+
+            // Arguments shared by PrepareInstance and Launch
+            auto readLaunch = [&](String &name, fs::path &javaPath, LaunchOptions &options) -> Result<void>
+            {
+                name = String(in.string());
+                javaPath = String(in.string());
+                std::uint32_t count = in.u32();
+                for (std::uint32_t i = 0; i < count && in.ok(); i++)
+                {
+                    std::string_view variable = in.string();
+                    std::string_view value = in.string();
+                    LaunchSlot slot = internal::lookupLaunchSlot(variable);
+                    if (slot == LaunchSlot::Count)
+                        return Error(Errc::INVALID, "Unknown launch variable: " + String(variable));
+                    options.variables.set(slot, String(value));
+                }
+                if (!in.ok() || !in.done())
+                    return malformed;
+                return {};
+            };
+
+            // An explicit Java home is used as is, known ones come from the registry
+            auto javaFor = [&](const String &name, const fs::path &javaPath) -> Result<JavaInfo>
+            {
+                if (javaPath.empty())
+                    return _resolveJava(name, 0);
+                {
+                    std::shared_lock<std::shared_mutex> lock(_javaMutex);
+                    for (const auto &java : _java)
+                    {
+                        if (java.path == javaPath)
+                            return java;
+                    }
+                }
+                JavaInfo java(javaPath.filename().string(), internal::getJavaPublisher(javaPath),
+                              internal::getJavaStructure(javaPath), javaPath, "");
+                java.version = internal::getJavaVersionInfo(java.executable());
+                return java;
+            };
+
+            DaemonOp op = static_cast<DaemonOp>(in.u8());
+            if (!in.ok())
+                return internal::daemonFailure(malformed);
+
+            try
+            {
+                switch (op)
+                {
+                case DaemonOp::Ping:
+                    out.u32(DaemonProtocolVersion);
+                    break;
+
+                case DaemonOp::ListVersions:
+                    out.strings(_listVersions());
+                    break;
+
+                case DaemonOp::ResolveJava:
+                {
+                    String name(in.string());
+                    std::uint32_t major = in.u32();
+                    if (!in.ok() || !in.done() || major > INT_MAX)
+                        return internal::daemonFailure(malformed);
+                    Result<JavaInfo> java = _resolveJava(name, static_cast<int>(major));
+                    if (!java)
+                        return internal::daemonFailure(java.error());
+                    internal::writeJavaInfo(out, *java);
+                    break;
+                }
+
+                case DaemonOp::PrepareInstance:
+                case DaemonOp::Launch:
+                {
+                    String name;
+                    fs::path javaPath;
+                    LaunchOptions options;
+                    Result<void> parsed = readLaunch(name, javaPath, options);
+                    if (!parsed)
+                        return internal::daemonFailure(parsed.error());
+
+                    Result<Instance> instance = _instance(name);
+                    if (!instance)
+                        return internal::daemonFailure(instance.error());
+                    Result<JavaInfo> java = javaFor(name, javaPath);
+                    if (!java)
+                        return internal::daemonFailure(java.error());
+
+                    if (op == DaemonOp::Launch)
+                    {
+                        out.u32(static_cast<std::uint32_t>(instance->launch(*java, options)->pid()));
+                        break;
+                    }
+                    // The caller spawns the command, nobody would commit a CDS dump
+                    options.classDataSharing = false;
+                    instance->prepareNatives();
+                    LaunchCommand command;
+                    instance->buildLaunchCommand(*java, options, command);
+                    out.strings(command.toVector());
+                    break;
+                }
+
+                case DaemonOp::Refresh:
+                {
+                    bool deep = in.u8() != 0;
+                    if (!in.ok() || !in.done())
+                        return internal::daemonFailure(malformed);
+                    _refreshJava(deep);
+                    LaunchTemplateCache::shared().clear();
+                    ClasspathCache::shared().clear();
+                    {
+                        std::lock_guard<std::mutex> lock(_versionsMutex);
+                        _versionsStamp = fs::file_time_type::min();
+                    }
+                    std::shared_lock<std::shared_mutex> lock(_javaMutex);
+                    out.u32(static_cast<std::uint32_t>(_java.size()));
+                    break;
+                }
+
+                case DaemonOp::Shutdown:
+                    break;
+
+                default:
+                    return internal::daemonFailure(Error(Errc::INVALID, "Unknown daemon request"));
+                }
+            }
+            catch (const std::exception &e)
+            {
+                return internal::daemonFailure(Error(Errc::IO, e.what()));
+            }
+            return std::move(out.finish());
+        }
+
+        void EngineDaemon::_refreshJava(bool deep)
+        {
+            JavaList found = deep ? SearchJava$Deep() : SearchJava$Quick();
+            std::unique_lock<std::shared_mutex> lock(_javaMutex);
+            _java = std::move(found);
+        }
+
+        void EngineDaemon::_warm()
+        {
+            CNT_TRACE_SCOPE("daemon", "EngineDaemon::warm");
+            TaskGroup group(TaskPool::Io);
+            for (const auto &id : _listVersions())
+            {
+                group.run([this, id]()
+                          {
+                    // A broken profile only fails when it is requested
+                    try
+                    {
+                        LaunchTemplateCache::shared().get(_versionsDir, id, LaunchFeatures{});
+                        ClasspathCache::shared().get(_options.index, id);
+                    }
+                    catch (const std::exception &e)
+                    {
+                        CNT_LOG_DEBUG("Cannot warm version {}: {}", id, e.what());
+                    } });
+            }
+            group.wait();
+        }
+
+        std::vector<String> EngineDaemon::_listVersions()
+        {
+            std::lock_guard<std::mutex> lock(_versionsMutex);
+            // Adding or removing a version directory touches versions/
+            std::error_code ec;
+            fs::file_time_type stamp = fs::last_write_time(_versionsDir, ec);
+            if (!ec && stamp == _versionsStamp)
+                return _versions;
+
+            _versions.clear();
+            for (fs::directory_iterator it(_versionsDir, ec), end; !ec && it != end; it.increment(ec))
+            {
+                String id = it->path().filename().string();
+                std::error_code fileError;
+                if (fs::is_regular_file(it->path() / (id + ".json"), fileError))
+                    _versions.push_back(std::move(id));
+            }
+            std::sort(_versions.begin(), _versions.end());
+            _versionsStamp = stamp;
+            return _versions;
+        }
+
+        Result<JavaInfo> EngineDaemon::_resolveJava(const String &instance, int major)
+        {
+            if (major == 0)
+            {
+                Result<Instance> resolved = _instance(instance);
+                if (!resolved)
+                    return resolved.error();
+                // Profiles older than javaVersion all run on Java 8
+                major = LaunchTemplateCache::shared().get(_versionsDir, instance, LaunchFeatures{})->javaMajor();
+                if (major == 0)
+                    major = 8;
+            }
+
+            std::shared_lock<std::shared_mutex> lock(_javaMutex);
+            const JavaInfo *java = internal::selectJava(_java, major);
+            if (!java)
+                return Error(Errc::NOT_FOUND, "No Java " + std::to_string(major) + " runtime found", instance);
+            return *java;
+        }
+
+        Result<Instance> EngineDaemon::_instance(const String &name)
+        {
+            // Instance creates its directory, so only known versions get one
+            std::vector<String> versions = _listVersions();
+            if (!std::binary_search(versions.begin(), versions.end(), name))
+                return Error(Errc::NOT_FOUND, "Unknown version: " + name);
+            return Instance(_index, name);
+        }
+
+#ifndef _WIN32
+        DaemonClient::DaemonClient(const fs::path &socket)
+        {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            const String &socketPath = socket.native();
+            if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+                throw std::runtime_error("Invalid daemon socket path: " + socketPath);
+            std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+            _fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (_fd < 0 || ::connect(_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+            {
+                int error = errno;
+                if (_fd >= 0)
+                    ::close(_fd);
+                throw std::runtime_error("Cannot connect to the daemon at " + socketPath + ": " + std::strerror(error));
+            }
+        }
+
+        DaemonClient::~DaemonClient()
+        {
+            if (_fd >= 0)
+                ::close(_fd);
+        }
+#else
+        DaemonClient::DaemonClient(const fs::path &)
+        {
+            throw std::runtime_error("The engine daemon is not supported on this platform yet");
+        }
+
+        DaemonClient::~DaemonClient() = default;
+#endif
+
+        Result<String> DaemonClient::_call(const String &request)
+        {
+            String response;
+            if (!internal::sendDaemonFrame(_fd, request) || !internal::receiveDaemonFrame(_fd, response))
+                throw std::runtime_error("Connection to the daemon was lost");
+
+            internal::DaemonReader in(response);
+            std::uint8_t status = in.u8();
+            if (!in.ok())
+                throw std::runtime_error("Empty response from the daemon");
+            if (status != 0)
+            {
+                String message(in.string());
+                return Error(static_cast<Errc>(status - 1), message);
+            }
+            return response.substr(1);
+        }
+
+        Result<std::uint32_t> DaemonClient::ping()
+        {
+            internal::DaemonWriter out;
+            out.u8(static_cast<std::uint8_t>(DaemonOp::Ping));
+            Result<String> response = _call(out.finish());
+            if (!response)
+                return response.error();
+            return internal::DaemonReader(*response).u32();
+        }
+
+        Result<std::vector<String>> DaemonClient::listVersions()
+        {
+            internal::DaemonWriter out;
+            out.u8(static_cast<std::uint8_t>(DaemonOp::ListVersions));
+            Result<String> response = _call(out.finish());
+            if (!response)
+                return response.error();
+            return internal::DaemonReader(*response).strings();
+        }
+
+        Result<JavaInfo> DaemonClient::resolveJava(const String &instance, int major)
+        {
+            internal::DaemonWriter out;
+            out.u8(static_cast<std::uint8_t>(DaemonOp::ResolveJava));
+            out.string(instance);
+            out.u32(static_cast<std::uint32_t>(std::max(major, 0)));
+            Result<String> response = _call(out.finish());
+            if (!response)
+                return response.error();
+            internal::DaemonReader in(*response);
+            return internal::readJavaInfo(in);
+        }
+
+        Result<std::vector<String>> DaemonClient::prepare(const String &instance, const fs::path &java, const DaemonVariables &variables)
+        {
+            internal::DaemonWriter out;
+            out.u8(static_cast<std::uint8_t>(DaemonOp::PrepareInstance));
+            out.string(instance);
+            out.string(java.string());
+            internal::writeVariables(out, variables);
+            Result<String> response = _call(out.finish());
+            if (!response)
+                return response.error();
+            return internal::DaemonReader(*response).strings();
+        }
+
+        Result<int> DaemonClient::launch(const String &instance, const fs::path &java, const DaemonVariables &variables)
+        {
+            internal::DaemonWriter out;
+            out.u8(static_cast<std::uint8_t>(DaemonOp::Launch));
+            out.string(instance);
+            out.string(java.string());
+            internal::writeVariables(out, variables);
+            Result<String> response = _call(out.finish());
+            if (!response)
+                return response.error();
+            return static_cast<int>(internal::DaemonReader(*response).u32());
+        }
+
+        Result<std::uint32_t> DaemonClient::refresh(bool deep)
+        {
+            internal::DaemonWriter out;
+            out.u8(static_cast<std::uint8_t>(DaemonOp::Refresh));
+            out.u8(deep ? 1 : 0);
+            Result<String> response = _call(out.finish());
+            if (!response)
+                return response.error();
+            return internal::DaemonReader(*response).u32();
+        }
+
+        Result<void> DaemonClient::shutdown()
+        {
+            internal::DaemonWriter out;
+            out.u8(static_cast<std::uint8_t>(DaemonOp::Shutdown));
+            Result<String> response = _call(out.finish());
+            if (!response)
+                return response.error();
+            return {};
+        }
+    } // namespace minecraft
+
+} // namespace cnt
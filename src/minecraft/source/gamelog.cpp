@@ -0,0 +1,293 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/gamelog.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <minecraft/gamelog.hpp>
+
+#include <cstring>
+#include <algorithm>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            GameLogLevel parseGameLogLevel(std::string_view name)
+            {
+                if (name == "INFO")
+                    return GameLogLevel::Info;
+                if (name == "WARN" || name == "WARNING")
+                    return GameLogLevel::Warn;
+                if (name == "ERROR")
+                    return GameLogLevel::Error;
+                if (name == "DEBUG")
+                    return GameLogLevel::Debug;
+                if (name == "TRACE")
+                    return GameLogLevel::Trace;
+                if (name == "FATAL")
+                    return GameLogLevel::Fatal;
+                return GameLogLevel::Unknown;
+            }
+
+            std::string_view findXmlAttribute(std::string_view tag, std::string_view name)
+            {
+                std::size_t pos = 0;
+                while ((pos = tag.find(name, pos)) != std::string_view::npos)
+                {
+                    // Must be a whole attribute name followed by ="
+                    bool boundary = pos > 0 && (tag[pos - 1] == ' ' || tag[pos - 1] == '\t' || tag[pos - 1] == '\n');
+                    std::size_t quote = pos + name.size();
+                    if (boundary && quote + 1 < tag.size() && tag[quote] == '=' && tag[quote + 1] == '"')
+                    {
+                        std::size_t end = tag.find('"', quote + 2);
+                        if (end == std::string_view::npos)
+                            return std::string_view();
+                        return tag.substr(quote + 2, end - quote - 2);
+                    }
+                    pos += name.size();
+                }
+                return std::string_view();
+            }
+
+            // Text of <tag>...</tag> inside an event, unwrapped from CDATA
+            static std::string_view findXmlElement(std::string_view event, std::string_view open, std::string_view close)
+            {
+                std::size_t start = event.find(open);
+                if (start == std::string_view::npos)
+                    return std::string_view();
+                start += open.size();
+                std::size_t end = event.find(close, start);
+                if (end == std::string_view::npos)
+                    return std::string_view();
+
+                std::string_view text = event.substr(start, end - start);
+                constexpr std::string_view cdataOpen = "<![CDATA[";
+                constexpr std::string_view cdataClose = "]]>";
+                if (text.substr(0, cdataOpen.size()) == cdataOpen && text.size() >= cdataOpen.size() + cdataClose.size() &&
+                    text.substr(text.size() - cdataClose.size()) == cdataClose)
+                {
+                    text = text.substr(cdataOpen.size(), text.size() - cdataOpen.size() - cdataClose.size());
+                }
+                return text;
+            }
+
+            // "[12:34:56] [Server thread/INFO]: message" and "[..] [thread/LEVEL] [logger/]: message"
+            static void parsePlainLine(std::string_view line, GameLogRecord &record)
+            {
+                record.message = line;
+                if (line.empty() || line[0] != '[')
+                    return;
+
+                std::size_t close = line.find(']');
+                if (close == std::string_view::npos || close + 2 >= line.size() || line[close + 1] != ' ' || line[close + 2] != '[')
+                    return;
+
+                std::string_view rest = line.substr(close + 2);
+                std::size_t closeThread = rest.find(']');
+                if (closeThread == std::string_view::npos)
+                    return;
+
+                std::string_view inner = rest.substr(1, closeThread - 1);
+                std::size_t slash = inner.rfind('/');
+                if (slash == std::string_view::npos)
+                    return;
+
+                record.thread = inner.substr(0, slash);
+                record.level = parseGameLogLevel(inner.substr(slash + 1));
+                rest = rest.substr(closeThread + 1);
+
+                if (rest.size() > 2 && rest[0] == ' ' && rest[1] == '[')
+                {
+                    std::size_t closeLogger = rest.find(']');
+                    if (closeLogger != std::string_view::npos)
+                    {
+                        std::string_view logger = rest.substr(2, closeLogger - 2);
+                        record.logger = logger.substr(0, logger.find('/'));
+                        rest = rest.substr(closeLogger + 1);
+                    }
+                }
+
+                if (rest.size() >= 2 && rest[0] == ':' && rest[1] == ' ')
+                    rest.remove_prefix(2);
+                else if (!rest.empty() && rest[0] == ':')
+                    rest.remove_prefix(1);
+                record.message = rest;
+            }
+        }
+
+        GameLogStream::GameLogStream(std::size_t capacity, std::size_t batchSize)
+            : _capacity(std::max<std::size_t>(capacity, 256)), _batchSize(std::max<std::size_t>(batchSize, 1))
+        {
+            for (auto &channel : _channels)
+                channel.data.reset(new char[_capacity]);
+            _batch.reserve(_batchSize);
+        }
+
+        void GameLogStream::subscribe(GameLogSubscriber subscriber)
+        {
+            _subscribers.push_back(std::move(subscriber));
+        }
+
+        void GameLogStream::_deliver()
+        {
+            if (_batch.empty())
+                return;
+            for (const auto &subscriber : _subscribers)
+                subscriber(_batch.data(), _batch.size());
+            _batch.clear();
+        }
+
+        void GameLogStream::_parse(ProcessStream stream, bool final)
+        {
+            constexpr std::string_view eventOpen = "<log4j:Event";
+            constexpr std::string_view eventClose = "</log4j:Event>";
+
+            Channel &channel = _channels[static_cast<std::size_t>(stream)];
+            while (channel.begin < channel.end)
+            {
+                std::string_view view(channel.data.get() + channel.begin, channel.end - channel.begin);
+
+                // Blank lines between events carry nothing
+                if (view[0] == '\n' || view[0] == '\r')
+                {
+                    channel.begin++;
+                    continue;
+                }
+
+                GameLogRecord record;
+                record.stream = stream;
+                std::size_t consumed = 0;
+
+                if (view.size() < eventOpen.size() && eventOpen.substr(0, view.size()) == view && !final)
+                {
+                    // Possibly the start of an event, wait for more data
+                    break;
+                }
+
+                if (view.substr(0, eventOpen.size()) == eventOpen)
+                {
+                    std::size_t close = view.find(eventClose);
+                    if (close == std::string_view::npos)
+                    {
+                        if (!final)
+                            break;
+                        record.message = view;
+                        consumed = view.size();
+                    }
+                    else
+                    {
+                        std::string_view event = view.substr(0, close);
+                        std::string_view tag = event.substr(0, event.find('>'));
+
+                        record.structured = true;
+                        record.logger = internal::findXmlAttribute(tag, "logger");
+                        record.thread = internal::findXmlAttribute(tag, "thread");
+                        record.level = internal::parseGameLogLevel(internal::findXmlAttribute(tag, "level"));
+                        for (char c : internal::findXmlAttribute(tag, "timestamp"))
+                        {
+                            if (c < '0' || c > '9')
+                                break;
+                            record.timestamp = record.timestamp * 10 + (c - '0');
+                        }
+                        record.message = internal::findXmlElement(event, "<log4j:Message>", "</log4j:Message>");
+                        record.throwable = internal::findXmlElement(event, "<log4j:Throwable>", "</log4j:Throwable>");
+                        consumed = close + eventClose.size();
+                    }
+                }
+                else
+                {
+                    std::size_t newline = view.find('\n');
+                    std::string_view line;
+                    if (newline == std::string_view::npos)
+                    {
+                        if (!final)
+                            break;
+                        line = view;
+                        consumed = view.size();
+                    }
+                    else
+                    {
+                        line = view.substr(0, newline);
+                        consumed = newline + 1;
+                    }
+                    if (!line.empty() && line.back() == '\r')
+                        line.remove_suffix(1);
+                    internal::parsePlainLine(line, record);
+                }
+
+                channel.begin += consumed;
+                _batch.push_back(record);
+                if (_batch.size() >= _batchSize)
+                    _deliver();
+            }
+        }
+
+        void GameLogStream::feed(ProcessStream stream, std::string_view data)
+        {
+            Channel &channel = _channels[static_cast<std::size_t>(stream)];
+
+            if (data.empty())
+            {
+                _parse(stream, true);
+                _deliver();
+                channel.begin = channel.end = 0;
+                return;
+            }
+
+            while (!data.empty())
+            {
+                // Records handed out so far are delivered, the tail can move
+                if (channel.begin > 0)
+                {
+                    std::memmove(channel.data.get(), channel.data.get() + channel.begin, channel.end - channel.begin);
+                    channel.end -= channel.begin;
+                    channel.begin = 0;
+                }
+
+                if (channel.end == _capacity)
+                {
+                    // A single record larger than the buffer is cut at the capacity
+                    _parse(stream, true);
+                    _deliver();
+                    channel.begin = channel.end = 0;
+                }
+
+                std::size_t count = std::min(_capacity - channel.end, data.size());
+                std::memcpy(channel.data.get() + channel.end, data.data(), count);
+                channel.end += count;
+                data.remove_prefix(count);
+
+                _parse(stream, false);
+                _deliver();
+            }
+        }
+
+        ProcessOutputHandler GameLogStream::bind(std::shared_ptr<GameLogStream> stream)
+        {
+            return [stream](ProcessStream kind, std::string_view data)
+            {
+                stream->feed(kind, data);
+            };
+        }
+    } // namespace minecraft
+
+} // namespace cnt
@@ -0,0 +1,309 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/host.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/host.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            double parsePressureSome(std::string_view text)
+            {
+                std::size_t line = text.find("some ");
+                if (line == std::string_view::npos)
+                    return -1;
+                std::size_t avg = text.find("avg10=", line);
+                if (avg == std::string_view::npos)
+                    return -1;
+                return std::strtod(String(text.substr(avg + 6, 16)).c_str(), nullptr);
+            }
+
+            std::uint64_t parseMeminfoValue(std::string_view meminfo, std::string_view key)
+            {
+                std::size_t pos = 0;
+                while (pos < meminfo.size())
+                {
+                    std::size_t end = meminfo.find('\n', pos);
+                    if (end == std::string_view::npos)
+                        end = meminfo.size();
+                    std::string_view line = meminfo.substr(pos, end - pos);
+                    pos = end + 1;
+
+                    if (line.size() <= key.size() || line.substr(0, key.size()) != key || line[key.size()] != ':')
+                        continue;
+
+                    std::uint64_t value = 0;
+                    std::size_t i = key.size() + 1;
+                    while (i < line.size() && line[i] == ' ')
+                        i++;
+                    while (i < line.size() && line[i] >= '0' && line[i] <= '9')
+                        value = value * 10 + static_cast<std::uint64_t>(line[i++] - '0');
+                    if (line.find("kB", i) != std::string_view::npos)
+                        value *= 1024;
+                    return value;
+                }
+                return 0;
+            }
+
+            double parseCgroupCpuMax(std::string_view text)
+            {
+                if (text.empty() || text.substr(0, 3) == "max")
+                    return 0;
+                char *end = nullptr;
+                const String copy(text);
+                double quota = std::strtod(copy.c_str(), &end);
+                double period = std::strtod(end, nullptr);
+                if (quota <= 0 || period <= 0)
+                    return 0;
+                return quota / period;
+            }
+
+            std::uint64_t parseCgroupMemoryLimit(std::string_view text)
+            {
+                if (text.empty() || text.substr(0, 3) == "max")
+                    return 0;
+                std::uint64_t value = std::strtoull(String(text).c_str(), nullptr, 10);
+                // cgroup v1 reports "unlimited" as a huge page-aligned number
+                if (value >= (std::uint64_t(1) << 60))
+                    return 0;
+                return value;
+            }
+
+            String readSmallFile(const fs::path &path)
+            {
+                std::ifstream file(path);
+                if (!file.is_open())
+                    return String();
+                String content;
+                char buffer[4096];
+                while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+                    content.append(buffer, static_cast<std::size_t>(file.gcount()));
+                return content;
+            }
+
+#ifdef __linux__
+            // Directories of our cgroup and its ancestors for a controller, innermost first
+            static std::vector<fs::path> cgroupDirectories(const fs::path &mount, const String &relative)
+            {
+                std::vector<fs::path> result;
+                fs::path current = mount / fs::path(relative).relative_path();
+                // Inside a container the cgroup namespace may hide the host path
+                if (!fs::exists(current))
+                    current = mount;
+                for (;;)
+                {
+                    result.push_back(current);
+                    if (current == mount || !current.has_parent_path() || current.parent_path() == current)
+                        break;
+                    current = current.parent_path();
+                }
+                return result;
+            }
+
+            static void readCgroupLimits(HostResources &host)
+            {
+                const String cgroups = readSmallFile("/proc/self/cgroup");
+
+                auto tighten = [](std::uint64_t &limit, std::uint64_t value)
+                {
+                    if (value != 0 && (limit == 0 || value < limit))
+                        limit = value;
+                };
+                auto tightenCpu = [](double &quota, double value)
+                {
+                    if (value > 0 && (quota == 0 || value < quota))
+                        quota = value;
+                };
+
+                std::size_t pos = 0;
+                while (pos < cgroups.size())
+                {
+                    std::size_t end = cgroups.find('\n', pos);
+                    if (end == String::npos)
+                        end = cgroups.size();
+                    std::string_view line(cgroups.data() + pos, end - pos);
+                    pos = end + 1;
+
+                    // hierarchy-ID:controller-list:path
+                    std::size_t first = line.find(':');
+                    std::size_t second = first == std::string_view::npos ? first : line.find(':', first + 1);
+                    if (second == std::string_view::npos)
+                        continue;
+                    std::string_view controllers = line.substr(first + 1, second - first - 1);
+                    const String relative(line.substr(second + 1));
+
+                    if (controllers.empty())
+                    {
+                        // cgroup v2, mounted directly or under "unified" on hybrid hosts
+                        fs::path mount = "/sys/fs/cgroup";
+                        if (!fs::exists(mount / "cgroup.controllers"))
+                            mount /= "unified";
+                        for (const auto &dir : cgroupDirectories(mount, relative))
+                        {
+                            tighten(host.memoryLimit, parseCgroupMemoryLimit(readSmallFile(dir / "memory.max")));
+                            tightenCpu(host.cpuQuota, parseCgroupCpuMax(readSmallFile(dir / "cpu.max")));
+                        }
+                        continue;
+                    }
+
+                    auto has = [&controllers](std::string_view name)
+                    {
+                        std::size_t start = 0;
+                        while (start <= controllers.size())
+                        {
+                            std::size_t comma = controllers.find(',', start);
+                            if (controllers.substr(start, comma == std::string_view::npos ? comma : comma - start) == name)
+                                return true;
+                            if (comma == std::string_view::npos)
+                                break;
+                            start = comma + 1;
+                        }
+                        return false;
+                    };
+
+                    if (has("memory"))
+                    {
+                        for (const auto &dir : cgroupDirectories("/sys/fs/cgroup/memory", relative))
+                            tighten(host.memoryLimit, parseCgroupMemoryLimit(readSmallFile(dir / "memory.limit_in_bytes")));
+                    }
+                    if (has("cpu"))
+                    {
+                        fs::path mount = "/sys/fs/cgroup/" + String(controllers);
+                        if (!fs::exists(mount))
+                            mount = "/sys/fs/cgroup/cpu";
+                        for (const auto &dir : cgroupDirectories(mount, relative))
+                        {
+                            String quota = readSmallFile(dir / "cpu.cfs_quota_us");
+                            String period = readSmallFile(dir / "cpu.cfs_period_us");
+                            if (!quota.empty() && quota[0] != '-' && !period.empty())
+                                tightenCpu(host.cpuQuota, parseCgroupCpuMax(quota.substr(0, quota.find('\n')) + " " + period));
+                        }
+                    }
+                }
+            }
+#endif
+        }
+
+        std::uint64_t HostResources::effectiveMemory() const
+        {
+            if (memoryLimit != 0 && (totalMemory == 0 || memoryLimit < totalMemory))
+                return memoryLimit;
+            return totalMemory;
+        }
+
+        unsigned int HostResources::effectiveCpus() const
+        {
+            unsigned int result = std::max(1u, cpus);
+            if (cpuQuota > 0)
+                result = std::min(result, std::max(1u, static_cast<unsigned int>(std::ceil(cpuQuota))));
+            return result;
+        }
+
+        HostResources HostResources::detect()
+        {
+            HostResources host;
+            host.cpus = std::max(1u, std::thread::hardware_concurrency());
+
+#ifdef _WIN32
+            MEMORYSTATUSEX status;
+            status.dwLength = sizeof(status);
+            if (GlobalMemoryStatusEx(&status))
+            {
+                host.totalMemory = status.ullTotalPhys;
+                host.availableMemory = status.ullAvailPhys;
+            }
+#else
+            long pages = ::sysconf(_SC_PHYS_PAGES);
+            long pageSize = ::sysconf(_SC_PAGESIZE);
+            if (pages > 0 && pageSize > 0)
+                host.totalMemory = host.availableMemory = static_cast<std::uint64_t>(pages) * static_cast<std::uint64_t>(pageSize);
+
+#ifdef __linux__
+            const String meminfo = internal::readSmallFile("/proc/meminfo");
+            if (std::uint64_t total = internal::parseMeminfoValue(meminfo, "MemTotal"))
+                host.totalMemory = total;
+            if (std::uint64_t available = internal::parseMeminfoValue(meminfo, "MemAvailable"))
+                host.availableMemory = available;
+            host.hugePageSize = internal::parseMeminfoValue(meminfo, "Hugepagesize");
+            host.hugePagesFree = internal::parseMeminfoValue(meminfo, "HugePages_Free");
+
+            const String thp = internal::readSmallFile("/sys/kernel/mm/transparent_hugepage/enabled");
+            host.transparentHugePages = thp.find("[always]") != String::npos || thp.find("[madvise]") != String::npos;
+
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (::sched_getaffinity(0, sizeof(set), &set) == 0)
+                host.cpus = std::max(1, CPU_COUNT(&set));
+
+            internal::readCgroupLimits(host);
+#endif
+#endif
+            return host;
+        }
+        HostLoad HostLoad::sample()
+        {
+            HostLoad load;
+#ifdef __linux__
+            double cpu = internal::parsePressureSome(internal::readSmallFile("/proc/pressure/cpu"));
+            if (cpu >= 0)
+            {
+                load.hasPressure = true;
+                load.cpuPressure = cpu;
+                load.ioPressure = std::max(0.0, internal::parsePressureSome(internal::readSmallFile("/proc/pressure/io")));
+                load.memoryPressure = std::max(0.0, internal::parsePressureSome(internal::readSmallFile("/proc/pressure/memory")));
+            }
+
+            // "0.52 0.58 0.59 3/1234 5678": averages, then runnable/total tasks
+            const String loadavg = internal::readSmallFile("/proc/loadavg");
+            if (!loadavg.empty())
+            {
+                load.loadAverage = std::strtod(loadavg.c_str(), nullptr);
+                std::size_t slash = loadavg.find('/');
+                std::size_t space = loadavg.rfind(' ', slash);
+                if (slash != String::npos && space != String::npos)
+                    load.runQueue = static_cast<unsigned int>(std::strtoul(loadavg.c_str() + space + 1, nullptr, 10));
+            }
+#endif
+            return load;
+        }
+    } // namespace minecraft
+
+} // namespace cnt
@@ -30,6 +30,20 @@ void cnt::minecraft::Index::_init()
 
     if (!fs::exists(path / "meic.cco"))
         _create_meic();
+    else
+        _migrate_meic();
+}
+
+cnt::minecraft::CloneStats cnt::minecraft::Index::cloneFrom(const Index &other)
+{
+    if (fs::equivalent(path, other.path))
+        throw std::runtime_error("Cannot clone an index into itself");
+
+    CloneOptions options;
+    options.overwrite = true;
+    options.filter = [](const fs::path &relative)
+    { return relative != "meic.cco" && relative != "meic.cco.old"; };
+    return CloneTree(other.path, path, options);
 }
 
 void cnt::minecraft::Index::_create_meic()
@@ -37,18 +51,44 @@ void cnt::minecraft::Index::_create_meic()
     std::ofstream file(path / "meic.cco");
     if (!file.is_open())
         throw std::runtime_error("Failed to open file");
+
+    // The directory name is written as a quoted string so any name parses back
+    String name;
+    for (char c : path.filename().string())
+    {
+        if (c == '\\' || c == '"')
+            name += '\\';
+        name += c;
+    }
+
     file << R"(/* Minecraft Engine Index Config (MEIC)
  *
  * This file is used to configure the runtime environment of the game. 
  * It is generated by the minecraft engine and should not be modified by the user.
  */
 
-name: )" + path.filename().string() + R"(
+name: ")" + name + R"("
 lastVersion: None,
 config: {
     VersionIsolation: 2, // 0: Disable, 1: Enable, 2: Global
     WindowsTitle: "${..config.WindowsTitle}", // Title of the game window
     GameInfo: "${..config.GameInfo}", // Custom game information, it will display when u press F3 in game
-}.
+}
 )";
-}
\ No newline at end of file
+}
+
+void cnt::minecraft::Index::_migrate_meic()
+{
+    // Older versions wrote the name unquoted and closed the object with "}.", which
+    // does not parse. Nothing but the defaults was ever written to it, so the file
+    // is generated again and the old one kept next to it as meic.cco.old.
+    cnt::Config config;
+    if (config.try_open(path / "meic.cco") && config.get("name").is_string() && config.get("config").is_object())
+        return;
+
+    std::error_code ec;
+    fs::rename(path / "meic.cco", path / "meic.cco.old", ec);
+    if (ec)
+        throw std::runtime_error("Failed to move old meic.cco: " + ec.message());
+    _create_meic();
+}
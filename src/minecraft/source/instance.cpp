@@ -0,0 +1,187 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/instance.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <minecraft/instance.hpp>
+#include <minecraft/lib/trace.hpp>
+#include <minecraft/lib/metrics.hpp>
+
+void cnt::minecraft::Instance::_init()
+{
+    if (name.empty())
+        throw std::runtime_error("Instance name cannot be empty");
+
+    path = _father_path / "versions" / name;
+    if (!fs::exists(path))
+        fs::create_directories(path);
+}
+
+cnt::minecraft::Instance cnt::minecraft::Instance::cloneTo(const String &newName) const
+{
+    return _clone(_father_path, newName);
+}
+
+cnt::minecraft::Instance cnt::minecraft::Instance::cloneTo(const Index &index, const String &newName) const
+{
+    return _clone(index.getPath(), newName);
+}
+
+cnt::minecraft::Instance cnt::minecraft::Instance::_clone(const fs::path &indexPath, const String &newName) const
+{
+    fs::path target = indexPath / "versions" / newName;
+    if (fs::exists(target) && !fs::is_empty(target))
+        throw std::runtime_error("Instance already exists: " + newName);
+
+    const String oldName = name;
+    CloneOptions options;
+    // The client jar of an instance is never modified in place
+    options.immutableDirs = {oldName + ".jar"};
+    options.rename = [oldName, newName](const fs::path &relative)
+    {
+        if (relative == oldName + ".json" || relative == oldName + ".jar")
+            return fs::path(newName + relative.extension().string());
+        return relative;
+    };
+    CloneTree(path, target, options);
+
+    return Instance(indexPath, newName);
+}
+
+void cnt::minecraft::Instance::buildLaunchCommand(const JavaInfo &java, const LaunchOptions &options, LaunchCommand &out, CdsPlan *cds) const
+{
+    CNT_TRACE_SCOPE_DETAIL("launch", "Instance::buildLaunchCommand", name);
+    auto compiled = LaunchTemplateCache::shared().get(_father_path / "versions", name, options.features);
+
+    LaunchVariables variables = options.variables;
+    auto fallback = [&variables](LaunchSlot slot, String value)
+    {
+        if (!variables.has(slot))
+            variables.set(slot, std::move(value));
+    };
+
+    fallback(LaunchSlot::VersionName, name);
+    fallback(LaunchSlot::VersionType, compiled->type());
+    fallback(LaunchSlot::GameDirectory, path.string());
+    fallback(LaunchSlot::AssetsRoot, (_father_path / "assets").string());
+    fallback(LaunchSlot::AssetsIndexName, compiled->assets());
+    fallback(LaunchSlot::GameAssets, (_father_path / "assets" / "virtual" / "legacy").string());
+    fallback(LaunchSlot::LibraryDirectory, (_father_path / "libraries").string());
+    fallback(LaunchSlot::NativesDirectory, (path / "natives").string());
+    fallback(LaunchSlot::LauncherName, "MinecraftEngine");
+    fallback(LaunchSlot::LauncherVersion, "1.0");
+    fallback(LaunchSlot::UserType, "msa");
+    fallback(LaunchSlot::UserProperties, "{}");
+    fallback(LaunchSlot::AuthSession, variables.get(LaunchSlot::AuthAccessToken));
+    if (options.launcherLogging && !compiled->loggingFile().empty())
+    {
+        fs::path logging = _father_path / "assets" / "log_configs" / compiled->loggingFile();
+        if (fs::exists(logging))
+            fallback(LaunchSlot::LoggingPath, logging.string());
+    }
+#ifdef _WIN32
+    fallback(LaunchSlot::ClasspathSeparator, ";");
+#else
+    fallback(LaunchSlot::ClasspathSeparator, ":");
+#endif
+
+    String argFile;
+    CdsPlan sharing;
+    if (!variables.has(LaunchSlot::Classpath))
+    {
+        auto classpath = ClasspathCache::shared().get(_father_path, name);
+        if (options.classpathArgFile && java.majorVersion() >= 9)
+            argFile = WriteClasspathArgFile(*classpath, _father_path / "cache" / "argfiles").string();
+        else
+            variables.set(LaunchSlot::Classpath, classpath->value);
+
+        // Archives are only keyed on classpaths resolved here
+        if (options.classDataSharing)
+            sharing = PlanCdsArchive(java, *classpath, _father_path / "cache" / "cds");
+    }
+
+    if (sharing.arguments.empty())
+    {
+        compiled->fill(java.executable(), variables, options.jvmArgs, out, argFile);
+    }
+    else
+    {
+        std::vector<String> jvmArgs = sharing.arguments;
+        jvmArgs.insert(jvmArgs.end(), options.jvmArgs.begin(), options.jvmArgs.end());
+        compiled->fill(java.executable(), variables, jvmArgs, out, argFile);
+    }
+
+    if (cds)
+        *cds = std::move(sharing);
+}
+
+fs::path cnt::minecraft::Instance::prepareNatives() const
+{
+    CNT_TRACE_SCOPE_DETAIL("natives", "Instance::prepareNatives", name);
+    fs::path natives = path / "natives";
+    NativesCache::shared().prepare(_father_path, name, natives);
+    return natives;
+}
+
+std::vector<std::shared_ptr<const cnt::minecraft::ModInfo>> cnt::minecraft::Instance::mods() const
+{
+    return ModScanner::shared().scan(path / "mods");
+}
+
+cnt::minecraft::RegionCompactStats cnt::minecraft::Instance::compactWorlds(const RegionCompactOptions &options) const
+{
+    return CompactRegions(path, options);
+}
+
+cnt::minecraft::JvmPlan cnt::minecraft::Instance::planJvm(const JavaInfo &java, JvmPlanOptions options) const
+{
+    auto installed = mods();
+    if (!installed.empty())
+    {
+        options.modded = true;
+        options.modCount = std::max(options.modCount, installed.size());
+    }
+    return PlanJvmOptions(java, HostResources::detect(), options);
+}
+
+std::shared_ptr<cnt::minecraft::GameProcess> cnt::minecraft::Instance::launch(const JavaInfo &java, const LaunchOptions &options, ProcessOutputHandler output) const
+{
+    CNT_TRACE_SCOPE_DETAIL("launch", "Instance::launch", name);
+    static Histogram &duration = Metrics::shared().histogram("cnt_launch_duration_seconds", "Time from Instance::launch to the spawned game process", "", 1e-6);
+    HistogramTimer timer(duration);
+    if (!options.variables.has(LaunchSlot::NativesDirectory))
+        prepareNatives();
+
+    LaunchCommand command;
+    CdsPlan cds;
+    buildLaunchCommand(java, options, command, &cds);
+
+    ProcessOptions process;
+    process.workingDirectory = path;
+    process.environment = options.environment;
+    process.cgroup = options.cgroup;
+    process.output = std::move(output);
+    if (cds.dumping())
+    {
+        process.onExit = [cds](int code)
+        { CommitCdsArchive(cds, code); };
+    }
+    return ProcessReactor::shared().spawn(command.argv(), process);
+}
@@ -21,6 +21,13 @@
  */
 
 #include <minecraft/java.hpp>
+#include <minecraft/scheduler.hpp>
+#include <minecraft/cache.hpp>
+#include <minecraft/lib/trace.hpp>
+#include <minecraft/lib/metrics.hpp>
+#include <minecraft/lib/log.hpp>
+
+#include <mutex>
 
 namespace cnt
 {
@@ -32,6 +39,40 @@ namespace cnt
         JavaInfo::JavaInfo(String _$name, String _$publisher, String _$structure, fs::path _$path, std::string _$version)
             : name(_$name), publisher(_$publisher), structure(_$structure), path(_$path), version(_$version) {}
 
+        fs::path JavaInfo::executable() const
+        {
+#ifdef _WIN32
+            return path / "bin" / "java.exe";
+#else
+            return path / "bin" / "java";
+#endif
+        }
+
+        int JavaInfo::majorVersion() const
+        {
+            int first = 0;
+            std::size_t pos = 0;
+            while (pos < version.size() && std::isdigit(static_cast<unsigned char>(version[pos])))
+            {
+                first = first * 10 + (version[pos] - '0');
+                pos++;
+            }
+
+            // Legacy scheme "1.x.y_z"
+            if (first == 1 && pos < version.size() && version[pos] == '.')
+            {
+                int second = 0;
+                pos++;
+                while (pos < version.size() && std::isdigit(static_cast<unsigned char>(version[pos])))
+                {
+                    second = second * 10 + (version[pos] - '0');
+                    pos++;
+                }
+                return second;
+            }
+            return first;
+        }
+
         bool JavaInfo::operator==(const JavaInfo &other) const
         {
             return path == other.path;
@@ -42,7 +83,8 @@ namespace cnt
             // Helper function to check if a path is a valid Java executable
             bool isValidJavaExecutable(const fs::path &javaPath)
             {
-                if (!fs::exists(javaPath) || !fs::is_regular_file(javaPath))
+                std::error_code ec;
+                if (!fs::is_regular_file(javaPath, ec))
                 {
                     return false;
                 }
@@ -71,6 +113,20 @@ namespace cnt
             // Helper function to get Java version info from executable
             std::string getJavaVersionInfo(const fs::path &javaPath)
             {
+                CNT_TRACE_SCOPE_DETAIL("java", "getJavaVersionInfo", javaPath.string());
+
+                // Running java takes tens of milliseconds, remember the answer per binary
+                const String cacheKey = fileCacheKey(javaPath);
+                if (!cacheKey.empty())
+                {
+                    if (auto cached = CacheStore::shared().get("java-version", cacheKey))
+                        return *cached;
+                }
+
+                static Counter &probes = Metrics::shared().counter("cnt_java_probes_total", "Java executables run to read their version");
+                static Histogram &latency = Metrics::shared().histogram("cnt_java_probe_duration_seconds", "Time to run java -version", "", 1e-6);
+                HistogramTimer timer(latency);
+                probes.add();
                 std::string command;
                 
 #ifdef _WIN32
@@ -105,7 +161,10 @@ namespace cnt
                     size_t end = result.find("\"", start);
                     if (end != std::string::npos)
                     {
-                        return result.substr(start, end - start);
+                        std::string version = result.substr(start, end - start);
+                        if (!cacheKey.empty())
+                            CacheStore::shared().put("java-version", cacheKey, version);
+                        return version;
                     }
                 }
                 
@@ -209,12 +268,14 @@ namespace cnt
 
 // Check for typical JDK directories
 #ifdef _WIN32
-                if (fs::exists(javaDir / "bin" / "javac.exe"))
+                std::error_code ec;
+                if (fs::exists(javaDir / "bin" / "javac.exe", ec))
                 {
                     return "JDK";
                 }
 #else
-                if (fs::exists(javaDir / "bin" / "javac"))
+                std::error_code ec;
+                if (fs::exists(javaDir / "bin" / "javac", ec))
                 {
                     return "JDK";
                 }
@@ -240,128 +301,102 @@ namespace cnt
                 return javaExePath.parent_path();
             }
 
-            // Helper function to scan directory for Java installations
-            void scanDirectoryForJava(const fs::path &directory, JavaList &result, bool recursive)
+            // Add the installation rooted at javaDir if it has a usable java executable
+            static void appendJavaInstallation(const fs::path &javaDir, JavaList &result)
             {
-                if (!fs::exists(directory) || !fs::is_directory(directory))
-                {
-                    return;
-                }
-
-                try
-                {
-                    if (recursive)
-                    {
-                        // Recursive scan - look for Java installation directories
-                        try
-                        {
-                            for (const auto &entry : fs::recursive_directory_iterator(directory,
-                                                                                      fs::directory_options::skip_permission_denied))
-                            {
-                                if (fs::is_directory(entry.path()))
-                                {
-                                    // Skip some common non-Java directories for performance
-                                    std::string dirName = entry.path().filename().string();
-                                    std::transform(dirName.begin(), dirName.end(), dirName.begin(),
-                                                   [](unsigned char c)
-                                                   { return std::tolower(c); });
-
-                                    // Skip common non-Java directories to speed up scanning
-                                    if (dirName.find("microsoft") != std::string::npos &&
-                                        dirName.find("office") != std::string::npos)
-                                    {
-                                        continue;
-                                    }
-
 #ifdef _WIN32
-                                    fs::path javaExe = entry.path() / "bin" / "java.exe";
+                fs::path javaExe = javaDir / "bin" / "java.exe";
 #else
-                                    fs::path javaExe = entry.path() / "bin" / "java";
+                fs::path javaExe = javaDir / "bin" / "java";
 #endif
+                if (!isValidJavaExecutable(javaExe))
+                {
+                    return;
+                }
 
-                                    if (fs::exists(javaExe) && fs::is_regular_file(javaExe) &&
-                                        isValidJavaExecutable(javaExe))
-                                    {
+                std::string version = getJavaVersionInfo(javaExe);
+                std::string publisher = getJavaPublisher(javaDir);
+                std::string structure = getJavaStructure(javaDir);
 
-                                        // Get Java installation directory
-                                        fs::path javaDir = getJavaDirFromExecutable(javaExe);
+                JavaInfo javaInfo(javaDir.filename().string(), publisher, structure, javaDir, version);
 
-                                        // Only add if it's a proper Java installation
-                                        if (fs::exists(javaDir / "bin" / javaExe.filename()))
-                                        {
-                                            std::string version = getJavaVersionInfo(javaExe);
-                                            std::string publisher = getJavaPublisher(javaDir);
-                                            std::string structure = getJavaStructure(javaDir);
+                // Avoid duplicates
+                if (std::find(result.begin(), result.end(), javaInfo) == result.end())
+                {
+                    result.push_back(javaInfo);
+                }
+            }
 
-                                            JavaInfo javaInfo(javaDir.filename().string(), publisher, structure, javaDir, version);
+            Result<void> tryScanDirectoryForJava(const fs::path &directory, JavaList &result, bool recursive)
+            {
+                CNT_TRACE_SCOPE_DETAIL("java", "scanDirectoryForJava", directory.string());
+                std::error_code ec;
+                if (!fs::is_directory(directory, ec))
+                {
+                    return {};
+                }
 
-                                            // Avoid duplicates
-                                            if (std::find(result.begin(), result.end(), javaInfo) == result.end())
-                                            {
-                                                result.push_back(javaInfo);
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                        catch (const fs::filesystem_error &e)
-                        {
-                            // Log error but continue
-                            std::cerr << "Recursive scan error in " << directory << ": " << e.what() << std::endl;
-                            // Try non-recursive scan as fallback
-                            scanDirectoryForJava(directory, result, false);
-                        }
-                    }
-                    else
+                constexpr auto options = fs::directory_options::skip_permission_denied;
+                if (recursive)
+                {
+                    // Recursive scan - look for Java installation directories
+                    fs::recursive_directory_iterator it(directory, options, ec), end;
+                    for (; !ec && it != end; it.increment(ec))
                     {
-                        // Non-recursive scan - look for Java installations in standard structure
-                        try
+                        std::error_code entryError;
+                        if (!it->is_directory(entryError))
                         {
-                            for (const auto &entry : fs::directory_iterator(directory,
-                                                                            fs::directory_options::skip_permission_denied))
-                            {
-                                if (fs::is_directory(entry.path()))
-                                {
-#ifdef _WIN32
-                                    fs::path javaExe = entry.path() / "bin" / "java.exe";
-#else
-                                    fs::path javaExe = entry.path() / "bin" / "java";
-#endif
-
-                                    if (fs::exists(javaExe) && fs::is_regular_file(javaExe) &&
-                                        isValidJavaExecutable(javaExe))
-                                    {
+                            continue;
+                        }
 
-                                        // Get Java installation directory
-                                        fs::path javaDir = entry.path();
+                        // Skip common non-Java directories to speed up scanning
+                        std::string dirName = it->path().filename().string();
+                        std::transform(dirName.begin(), dirName.end(), dirName.begin(),
+                                       [](unsigned char c)
+                                       { return std::tolower(c); });
+                        if (dirName.find("microsoft") != std::string::npos &&
+                            dirName.find("office") != std::string::npos)
+                        {
+                            continue;
+                        }
 
-                                        std::string version = getJavaVersionInfo(javaExe);
-                                        std::string publisher = getJavaPublisher(javaDir);
-                                        std::string structure = getJavaStructure(javaDir);
+                        appendJavaInstallation(it->path(), result);
+                    }
 
-                                        JavaInfo javaInfo(javaDir.filename().string(), publisher, structure, javaDir, version);
+                    if (ec)
+                    {
+                        // Keep what was found and fall back to the top level
+                        Error error = Error::from(ec, "Recursive scan of " + directory.string());
+                        tryScanDirectoryForJava(directory, result, false);
+                        return error;
+                    }
+                    return {};
+                }
 
-                                        // Avoid duplicates
-                                        if (std::find(result.begin(), result.end(), javaInfo) == result.end())
-                                        {
-                                            result.push_back(javaInfo);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                        catch (const fs::filesystem_error &e)
-                        {
-                            // Log error but continue
-                            std::cerr << "Non-recursive scan error in " << directory << ": " << e.what() << std::endl;
-                        }
+                // Non-recursive scan - look for Java installations in standard structure
+                fs::directory_iterator it(directory, options, ec), end;
+                for (; !ec && it != end; it.increment(ec))
+                {
+                    std::error_code entryError;
+                    if (it->is_directory(entryError))
+                    {
+                        appendJavaInstallation(it->path(), result);
                     }
                 }
-                catch (const std::exception &e)
+
+                if (ec)
                 {
-                    // General error handling
-                    std::cerr << "General error scanning directory " << directory << ": " << e.what() << std::endl;
+                    return Error::from(ec, "Scan of " + directory.string());
+                }
+                return {};
+            }
+
+            void scanDirectoryForJava(const fs::path &directory, JavaList &result, bool recursive)
+            {
+                Result<void> scanned = tryScanDirectoryForJava(directory, result, recursive);
+                if (!scanned)
+                {
+                    CNT_LOG_WARN("{}", scanned.error().message());
                 }
             }
 
@@ -661,6 +696,9 @@ namespace cnt
              */
         JavaList SearchJava$Quick()
         {
+            CNT_TRACE_SCOPE("java", "SearchJava$Quick");
+            static Histogram &duration = Metrics::shared().histogram("cnt_java_search_duration_seconds", "Time to search for Java installations", "mode=\"quick\"", 1e-6);
+            HistogramTimer timer(duration);
             JavaList result;
 
             // Get common Java locations
@@ -669,14 +707,11 @@ namespace cnt
             // Scan each location (non-recursive for speed)
             for (const auto &location : locations)
             {
-                try
-                {
-                    internal::scanDirectoryForJava(location, result, false);
-                }
-                catch (const std::exception &e)
+                Result<void> scanned = internal::tryScanDirectoryForJava(location, result, false);
+                if (!scanned)
                 {
                     // Skip problematic locations
-                    std::cerr << "Skipping location " << location << ": " << e.what() << std::endl;
+                    CNT_LOG_WARN("Skipping location {}: {}", location, scanned.error().message());
                     continue;
                 }
             }
@@ -688,7 +723,7 @@ namespace cnt
             }
             catch (const std::exception &e)
             {
-                std::cerr << "Error checking PATH: " << e.what() << std::endl;
+                CNT_LOG_WARN("Error checking PATH: {}", e.what());
             }
 
             // Remove duplicates by path
@@ -700,6 +735,8 @@ namespace cnt
                                      { return a.path == b.path; }),
                          result.end());
 
+            Metrics::shared().gauge("cnt_java_installations", "Java installations found by the last search", "mode=\"quick\"").set(static_cast<std::int64_t>(result.size()));
+
             return result;
         }
 
@@ -711,12 +748,18 @@ namespace cnt
              */
         JavaList SearchJava$Deep()
         {
+            CNT_TRACE_SCOPE("java", "SearchJava$Deep");
+            static Histogram &duration = Metrics::shared().histogram("cnt_java_search_duration_seconds", "Time to search for Java installations", "mode=\"deep\"", 1e-6);
+            HistogramTimer timer(duration);
             JavaList result;
+            std::mutex mutex;
 
             // Get deep search locations
             auto locations = internal::getDeepSearchLocations();
 
-            // Scan each location (with recursive scanning in appropriate directories)
+            // Scan each location on the I/O pool (with recursive scanning in appropriate
+            // directories), every probe of a found executable waits on a child process
+            TaskGroup group(TaskPool::Io);
             for (const auto &location : locations)
             {
                 bool recursive = false;
@@ -755,27 +798,35 @@ namespace cnt
                 }
 #endif
 
+                group.run([&, location, recursive]()
+                          {
+                    JavaList found;
+                    Result<void> scanned = internal::tryScanDirectoryForJava(location, found, recursive);
+                    if (!scanned)
+                    {
+                        // Partial results of a failed recursive scan are still kept
+                        CNT_LOG_WARN("Skipping location {}: {}", location, scanned.error().message());
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    result.insert(result.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end())); });
+            }
+
+            // Check PATH for java executables
+            group.run([&]()
+                      {
+                JavaList found;
                 try
                 {
-                    internal::scanDirectoryForJava(location, result, recursive);
+                    internal::checkPathForJava(found);
                 }
                 catch (const std::exception &e)
                 {
-                    // Skip problematic locations
-                    std::cerr << "Skipping location " << location << ": " << e.what() << std::endl;
-                    continue;
+                    CNT_LOG_WARN("Error checking PATH: {}", e.what());
+                    return;
                 }
-            }
-
-            // Check PATH for java executables
-            try
-            {
-                internal::checkPathForJava(result);
-            }
-            catch (const std::exception &e)
-            {
-                std::cerr << "Error checking PATH: " << e.what() << std::endl;
-            }
+                std::lock_guard<std::mutex> lock(mutex);
+                result.insert(result.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end())); });
+            group.wait();
 
             // Remove duplicates by path
             std::sort(result.begin(), result.end(),
@@ -786,6 +837,8 @@ namespace cnt
                                      { return a.path == b.path; }),
                          result.end());
 
+            Metrics::shared().gauge("cnt_java_installations", "Java installations found by the last search", "mode=\"deep\"").set(static_cast<std::int64_t>(result.size()));
+
             return result;
         }
     }
@@ -0,0 +1,487 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/launch.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <minecraft/launch.hpp>
+#include <minecraft/lib/trace.hpp>
+#include <minecraft/lib/metrics.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            LaunchSlot lookupLaunchSlot(std::string_view name)
+            {
+                static const std::pair<std::string_view, LaunchSlot> table[] = {
+                    {"auth_player_name", LaunchSlot::AuthPlayerName},
+                    {"auth_uuid", LaunchSlot::AuthUuid},
+                    {"auth_access_token", LaunchSlot::AuthAccessToken},
+                    {"auth_session", LaunchSlot::AuthSession},
+                    {"auth_xuid", LaunchSlot::AuthXuid},
+                    {"clientid", LaunchSlot::ClientId},
+                    {"user_type", LaunchSlot::UserType},
+                    {"user_properties", LaunchSlot::UserProperties},
+                    {"version_name", LaunchSlot::VersionName},
+                    {"version_type", LaunchSlot::VersionType},
+                    {"game_directory", LaunchSlot::GameDirectory},
+                    {"assets_root", LaunchSlot::AssetsRoot},
+                    {"assets_index_name", LaunchSlot::AssetsIndexName},
+                    {"game_assets", LaunchSlot::GameAssets},
+                    {"classpath", LaunchSlot::Classpath},
+                    {"classpath_separator", LaunchSlot::ClasspathSeparator},
+                    {"natives_directory", LaunchSlot::NativesDirectory},
+                    {"library_directory", LaunchSlot::LibraryDirectory},
+                    {"launcher_name", LaunchSlot::LauncherName},
+                    {"launcher_version", LaunchSlot::LauncherVersion},
+                    {"resolution_width", LaunchSlot::ResolutionWidth},
+                    {"resolution_height", LaunchSlot::ResolutionHeight},
+                    {"quickPlayPath", LaunchSlot::QuickPlayPath},
+                    {"quickPlaySingleplayer", LaunchSlot::QuickPlaySingleplayer},
+                    {"quickPlayMultiplayer", LaunchSlot::QuickPlayMultiplayer},
+                    {"quickPlayRealms", LaunchSlot::QuickPlayRealms},
+                    {"path", LaunchSlot::LoggingPath},
+                };
+
+                for (const auto &[key, slot] : table)
+                {
+                    if (key == name)
+                        return slot;
+                }
+                return LaunchSlot::Count;
+            }
+
+            bool evaluateRules(const ConfigObject &rules, const LaunchFeatures &features)
+            {
+                if (!rules.is_array())
+                    return true;
+
+#if defined(_WIN32)
+                const String osName = "windows";
+#elif defined(__APPLE__)
+                const String osName = "osx";
+#else
+                const String osName = "linux";
+#endif
+                const bool is32Bit = sizeof(void *) == 4;
+
+                bool allowed = false;
+                for (std::size_t i = 0; i < rules.size(); i++)
+                {
+                    const ConfigObject &rule = rules.at(i);
+                    bool matches = true;
+
+                    if (rule.has_key("os"))
+                    {
+                        const ConfigObject &os = rule.at("os");
+                        if (os.has_key("name") && os.at("name").as_string().value_or("") != osName)
+                            matches = false;
+                        if (os.has_key("arch") && (os.at("arch").as_string().value_or("") == "x86") != is32Bit)
+                            matches = false;
+                    }
+
+                    if (matches && rule.has_key("features"))
+                    {
+                        const ConfigObject &required = rule.at("features");
+                        for (const auto &key : required.keys())
+                        {
+                            bool value = false;
+                            if (key == "is_demo_user")
+                                value = features.isDemoUser;
+                            else if (key == "has_custom_resolution")
+                                value = features.hasCustomResolution;
+                            else if (key == "has_quick_plays_support")
+                                value = features.hasQuickPlaysSupport;
+                            else if (key == "is_quick_play_singleplayer")
+                                value = features.isQuickPlaySingleplayer;
+                            else if (key == "is_quick_play_multiplayer")
+                                value = features.isQuickPlayMultiplayer;
+                            else if (key == "is_quick_play_realms")
+                                value = features.isQuickPlayRealms;
+
+                            if (required.at(key).as_boolean().value_or(false) != value)
+                            {
+                                matches = false;
+                                break;
+                            }
+                        }
+                    }
+
+                    if (matches)
+                        allowed = rule.has_key("action") && rule.at("action").as_string().value_or("") == "allow";
+                }
+                return allowed;
+            }
+
+            std::vector<std::unique_ptr<Config>> loadProfileChain(const fs::path &versionsDir, const String &id, ProfileSources *sources)
+            {
+                CNT_TRACE_SCOPE_DETAIL("version", "loadProfileChain", id);
+                std::vector<std::unique_ptr<Config>> chain;
+                String current = id;
+                while (!current.empty())
+                {
+                    if (chain.size() > 16)
+                        throw std::runtime_error("Profile inheritance is too deep: " + id);
+
+                    const fs::path path = versionsDir / current / (current + ".json");
+                    if (sources)
+                    {
+                        std::error_code ec;
+                        sources->emplace_back(path, fs::last_write_time(path, ec));
+                    }
+                    auto config = std::make_unique<Config>();
+                    config->open(path);
+                    current = config->get("inheritsFrom").as_string().value_or("");
+                    chain.push_back(std::move(config));
+                }
+
+                // Root profile first
+                std::reverse(chain.begin(), chain.end());
+                return chain;
+            }
+
+            bool profileSourcesFresh(const ProfileSources &sources)
+            {
+                for (const auto &[source, time] : sources)
+                {
+                    std::error_code ec;
+                    if (fs::last_write_time(source, ec) != time || ec)
+                        return false;
+                }
+                return true;
+            }
+
+            std::vector<String> profileChainIds(const std::vector<std::unique_ptr<Config>> &chain, const String &id)
+            {
+                std::vector<String> ids(chain.size());
+                String current = id;
+                for (std::size_t i = chain.size(); i-- > 0;)
+                {
+                    ids[i] = current;
+                    current = chain[i]->get("inheritsFrom").as_string().value_or("");
+                }
+                return ids;
+            }
+        }
+
+        std::uint32_t LaunchFeatures::mask() const
+        {
+            return (isDemoUser ? 1u : 0u) |
+                   (hasCustomResolution ? 2u : 0u) |
+                   (hasQuickPlaysSupport ? 4u : 0u) |
+                   (isQuickPlaySingleplayer ? 8u : 0u) |
+                   (isQuickPlayMultiplayer ? 16u : 0u) |
+                   (isQuickPlayRealms ? 32u : 0u);
+        }
+
+        std::vector<String> LaunchCommand::toVector() const
+        {
+            std::vector<String> result;
+            result.reserve(size());
+            for (std::size_t i = 0; i < size(); i++)
+                result.emplace_back((*this)[i]);
+            return result;
+        }
+
+        void LaunchTemplate::_append(ArgumentList &target, const String &argument)
+        {
+            Argument arg{static_cast<std::uint32_t>(_pieces.size()), 0};
+
+            auto literal = [&](std::size_t from, std::size_t to)
+            {
+                if (from >= to)
+                    return;
+                _pieces.push_back({static_cast<std::uint32_t>(_literals.size()), static_cast<std::uint32_t>(to - from), LaunchSlot::Count});
+                _literals.append(argument, from, to - from);
+                arg.count++;
+            };
+
+            std::size_t pos = 0;
+            std::size_t literalStart = 0;
+            while ((pos = argument.find("${", pos)) != String::npos)
+            {
+                std::size_t end = argument.find('}', pos + 2);
+                if (end == String::npos)
+                    break;
+
+                LaunchSlot slot = internal::lookupLaunchSlot(std::string_view(argument).substr(pos + 2, end - pos - 2));
+                if (slot == LaunchSlot::Count)
+                {
+                    // Unknown variables are kept verbatim
+                    pos = end + 1;
+                    continue;
+                }
+
+                literal(literalStart, pos);
+                _pieces.push_back({0, 0, slot});
+                arg.count++;
+                pos = end + 1;
+                literalStart = pos;
+            }
+            literal(literalStart, argument.size());
+
+            target.push_back(arg);
+        }
+
+        void LaunchTemplate::_appendValue(ArgumentList &target, const ConfigObject &value, const LaunchFeatures &features)
+        {
+            if (value.is_string())
+            {
+                _append(target, value.as_string().value());
+            }
+            else if (value.is_object())
+            {
+                if (value.has_key("rules") && !internal::evaluateRules(value.at("rules"), features))
+                    return;
+                if (value.has_key("value"))
+                    _appendValue(target, value.at("value"), features);
+            }
+            else if (value.is_array())
+            {
+                for (std::size_t i = 0; i < value.size(); i++)
+                    _appendValue(target, value.at(i), features);
+            }
+        }
+
+        std::shared_ptr<const LaunchTemplate> LaunchTemplate::compile(const std::vector<std::unique_ptr<Config>> &chain, const LaunchFeatures &features)
+        {
+            CNT_TRACE_SCOPE("version", "LaunchTemplate::compile");
+            if (chain.empty())
+                throw std::runtime_error("Cannot compile an empty profile chain");
+
+            auto result = std::make_shared<LaunchTemplate>();
+
+            bool modern = false;
+            String legacyArguments;
+            for (const auto &profile : chain)
+            {
+                ConfigObject arguments = profile->get("arguments");
+                if (arguments.is_object())
+                {
+                    modern = true;
+                    if (arguments.has_key("jvm"))
+                        result->_appendValue(result->_jvm, arguments.at("jvm"), features);
+                    if (arguments.has_key("game"))
+                        result->_appendValue(result->_game, arguments.at("game"), features);
+                }
+
+                // Legacy profiles replace the arguments of their parent
+                if (auto legacy = profile->get("minecraftArguments").as_string())
+                    legacyArguments = *legacy;
+
+                if (auto value = profile->get("id").as_string())
+                    result->_id = *value;
+                if (auto value = profile->get("mainClass").as_string())
+                    result->_mainClass = *value;
+                if (auto value = profile->get("assets").as_string())
+                    result->_assets = *value;
+                if (auto value = profile->get("type").as_string())
+                    result->_type = *value;
+                ConfigObject javaVersion = profile->get("javaVersion");
+                if (javaVersion.has_key("majorVersion"))
+                    result->_javaMajor = static_cast<int>(javaVersion.at("majorVersion").as_number().value_or(0));
+
+                ConfigObject logging = profile->get("logging");
+                if (logging.has_key("client") && logging.at("client").has_key("argument"))
+                {
+                    const ConfigObject &client = logging.at("client");
+                    result->_logging.clear();
+                    result->_append(result->_logging, client.at("argument").as_string().value_or(""));
+                    if (client.has_key("file") && client.at("file").has_key("id"))
+                        result->_loggingFile = client.at("file").at("id").as_string().value_or("");
+                }
+            }
+
+            if (!modern)
+            {
+                result->_append(result->_jvm, "-Djava.library.path=${natives_directory}");
+                result->_append(result->_jvm, "-cp");
+                result->_append(result->_jvm, "${classpath}");
+
+                std::size_t start = 0;
+                while (start < legacyArguments.size())
+                {
+                    std::size_t end = legacyArguments.find(' ', start);
+                    if (end == String::npos)
+                        end = legacyArguments.size();
+                    if (end > start)
+                        result->_append(result->_game, legacyArguments.substr(start, end - start));
+                    start = end + 1;
+                }
+            }
+
+            if (result->_mainClass.empty())
+                throw std::runtime_error("Profile has no main class: " + result->_id);
+
+            for (std::size_t i = 0; i + 1 < result->_jvm.size(); i++)
+            {
+                const Argument &flag = result->_jvm[i];
+                const Argument &value = result->_jvm[i + 1];
+                if (flag.count != 1 || value.count != 1 || result->_pieces[value.first].slot != LaunchSlot::Classpath)
+                    continue;
+
+                const Piece &piece = result->_pieces[flag.first];
+                std::string_view text = std::string_view(result->_literals).substr(piece.offset, piece.length);
+                if (piece.slot == LaunchSlot::Count && (text == "-cp" || text == "-classpath" || text == "--class-path"))
+                {
+                    result->_classpathArg = static_cast<std::int32_t>(i);
+                    break;
+                }
+            }
+
+            return result;
+        }
+
+        void LaunchTemplate::fill(const fs::path &java, const LaunchVariables &variables, const std::vector<String> &extraJvmArgs, LaunchCommand &out,
+                                  std::string_view classpathArgFile) const
+        {
+            const String &javaPath = java.native();
+            const std::int32_t skipped = classpathArgFile.empty() ? -1 : _classpathArg;
+
+            auto pieceLength = [&](const Piece &piece) -> std::size_t
+            {
+                return piece.slot == LaunchSlot::Count ? piece.length : variables.get(piece.slot).size();
+            };
+            auto argumentLength = [&](const Argument &arg)
+            {
+                std::size_t length = 0;
+                for (std::uint32_t i = arg.first; i < arg.first + arg.count; i++)
+                    length += pieceLength(_pieces[i]);
+                return length;
+            };
+
+            // First pass: size the buffer exactly once
+            std::size_t total = javaPath.size() + 1 + _mainClass.size() + 1;
+            for (const auto &arg : _jvm)
+                total += argumentLength(arg) + 1;
+            if (skipped >= 0)
+                total += classpathArgFile.size() + 2;
+            const bool logging = variables.has(LaunchSlot::LoggingPath);
+            if (logging)
+            {
+                for (const auto &arg : _logging)
+                    total += argumentLength(arg) + 1;
+            }
+            for (const auto &arg : extraJvmArgs)
+                total += arg.size() + 1;
+            for (const auto &arg : _game)
+                total += argumentLength(arg) + 1;
+
+            out._buffer.resize(total);
+            out._offsets.clear();
+            out._offsets.reserve(2 + _jvm.size() + extraJvmArgs.size() + _game.size());
+
+            // Second pass: copy literals and slot values in place
+            char *data = &out._buffer[0];
+            std::size_t pos = 0;
+            auto put = [&](const char *text, std::size_t length)
+            {
+                std::memcpy(data + pos, text, length);
+                pos += length;
+            };
+            auto begin = [&]()
+            { out._offsets.push_back(static_cast<std::uint32_t>(pos)); };
+            auto end = [&]()
+            { data[pos++] = '\0'; };
+            auto putArgument = [&](const Argument &arg)
+            {
+                begin();
+                for (std::uint32_t i = arg.first; i < arg.first + arg.count; i++)
+                {
+                    const Piece &piece = _pieces[i];
+                    if (piece.slot == LaunchSlot::Count)
+                    {
+                        put(_literals.data() + piece.offset, piece.length);
+                    }
+                    else
+                    {
+                        const String &value = variables.get(piece.slot);
+                        put(value.data(), value.size());
+                    }
+                }
+                end();
+            };
+
+            begin();
+            put(javaPath.data(), javaPath.size());
+            end();
+            for (std::size_t i = 0; i < _jvm.size(); i++)
+            {
+                if (skipped >= 0 && i == static_cast<std::size_t>(skipped))
+                {
+                    // "-cp ${classpath}" collapses into one "@argfile" argument
+                    begin();
+                    put("@", 1);
+                    put(classpathArgFile.data(), classpathArgFile.size());
+                    end();
+                    i++;
+                    continue;
+                }
+                putArgument(_jvm[i]);
+            }
+            if (logging)
+            {
+                for (const auto &arg : _logging)
+                    putArgument(arg);
+            }
+            for (const auto &arg : extraJvmArgs)
+            {
+                begin();
+                put(arg.data(), arg.size());
+                end();
+            }
+            begin();
+            put(_mainClass.data(), _mainClass.size());
+            end();
+            for (const auto &arg : _game)
+                putArgument(arg);
+
+            out._argv.resize(out._offsets.size() + 1);
+            for (std::size_t i = 0; i < out._offsets.size(); i++)
+                out._argv[i] = data + out._offsets[i];
+            out._argv.back() = nullptr;
+        }
+
+        LaunchTemplateCache &LaunchTemplateCache::shared()
+        {
+            static LaunchTemplateCache cache;
+            return cache;
+        }
+
+        std::shared_ptr<const LaunchTemplate> LaunchTemplateCache::get(const fs::path &versionsDir, const String &id, const LaunchFeatures &features)
+        {
+            const String key = (versionsDir / id).string() + '#' + std::to_string(features.mask());
+            return _cache.get(key, versionsDir, id, [&](const std::vector<std::unique_ptr<Config>> &chain)
+                              { return LaunchTemplate::compile(chain, features); });
+        }
+
+        void LaunchTemplateCache::clear()
+        {
+            _cache.clear();
+        }
+    } // namespace minecraft
+
+} // namespace cnt
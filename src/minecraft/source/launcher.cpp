@@ -0,0 +1,299 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/launcher.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/launcher.hpp>
+
+#include <algorithm>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        LaunchScheduler::LaunchScheduler(LaunchSchedulerOptions options)
+            : _options(options), _cpus(HostResources::detect().effectiveCpus())
+        {
+            _thread = std::thread(&LaunchScheduler::_run, this);
+        }
+
+        LaunchScheduler::~LaunchScheduler()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _wakeup.notify_all();
+            if (_thread.joinable())
+                _thread.join();
+        }
+
+        std::uint64_t LaunchScheduler::submit(LaunchRequest request)
+        {
+            std::uint64_t id;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                id = _nextId++;
+                auto entry = std::make_unique<Entry>(std::move(request));
+                entry->order = id;
+                entry->status.id = id;
+                entry->status.instance = entry->request.instance.getName();
+                entry->status.priority = entry->request.priority;
+                _entries.push_back(std::move(entry));
+            }
+            _wakeup.notify_all();
+            return id;
+        }
+
+        bool LaunchScheduler::cancel(std::uint64_t id)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto &entry : _entries)
+            {
+                if (entry->status.id != id)
+                    continue;
+                if (entry->cancelled || entry->status.state == LaunchState::Stopped || entry->status.state == LaunchState::Failed)
+                    return false;
+                entry->cancelled = true;
+                if (entry->status.process)
+                    entry->status.process->terminate();
+                _wakeup.notify_all();
+                return true;
+            }
+            return false;
+        }
+
+        std::optional<LaunchStatus> LaunchScheduler::status(std::uint64_t id) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const auto &entry : _entries)
+            {
+                if (entry->status.id == id)
+                    return entry->status;
+            }
+            return std::nullopt;
+        }
+
+        std::vector<LaunchStatus> LaunchScheduler::statuses() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::vector<LaunchStatus> result;
+            result.reserve(_entries.size());
+            for (const auto &entry : _entries)
+                result.push_back(entry->status);
+            return result;
+        }
+
+        void LaunchScheduler::subscribe(LaunchObserver observer)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _observers.push_back(std::move(observer));
+        }
+
+        void LaunchScheduler::_setState(Entry &entry, LaunchState state, std::vector<LaunchStatus> &changes)
+        {
+            if (entry.status.state == state)
+                return;
+            entry.status.state = state;
+            if (state == LaunchState::Stopped || state == LaunchState::Failed)
+                entry.finishedAt = std::chrono::steady_clock::now();
+            changes.push_back(entry.status);
+        }
+
+        bool LaunchScheduler::_loadAllows(const HostLoad &load) const
+        {
+            if (load.hasPressure &&
+                (load.cpuPressure > _options.maxCpuPressure || load.ioPressure > _options.maxIoPressure ||
+                 load.memoryPressure > _options.maxMemoryPressure))
+                return false;
+            // The sampling thread itself is one of the runnable tasks
+            double runnable = load.runQueue > 0 ? load.runQueue - 1 : 0;
+            return runnable / std::max(1u, _cpus) <= _options.maxRunQueuePerCpu;
+        }
+
+        void LaunchScheduler::_exited(Entry &entry, std::optional<int> code, std::vector<LaunchStatus> &changes)
+        {
+            entry.status.lastExit = code;
+            entry.status.process.reset();
+
+            if (entry.cancelled || (code && *code == 0))
+            {
+                _setState(entry, LaunchState::Stopped, changes);
+                return;
+            }
+            if (!entry.request.restartOnCrash || entry.status.restarts >= entry.request.maxRestarts)
+            {
+                _setState(entry, LaunchState::Failed, changes);
+                return;
+            }
+
+            // 1x, 2x, 4x ... the initial backoff, capped
+            auto delay = entry.request.backoff;
+            for (unsigned int i = 0; i < entry.status.restarts && delay < entry.request.maxBackoff; i++)
+                delay *= 2;
+            delay = std::min(delay, entry.request.maxBackoff);
+
+            entry.status.restarts++;
+            entry.notBefore = std::chrono::steady_clock::now() + delay;
+            _setState(entry, LaunchState::Backoff, changes);
+        }
+
+        void LaunchScheduler::_start(Entry &entry, std::unique_lock<std::mutex> &lock, std::vector<LaunchStatus> &changes)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            _lastStart = now;
+            entry.startedAt = now;
+            entry.ready = std::make_shared<std::atomic<bool>>(false);
+            entry.status.error.clear();
+            _setState(entry, LaunchState::Starting, changes);
+
+            // Preparing and spawning touches the disk, do it without the lock;
+            // the entry stays in place since only _tick on this thread removes entries
+            auto ready = entry.ready;
+            auto predicate = entry.request.ready;
+            auto output = entry.request.output;
+            ProcessOutputHandler handler = [ready, predicate, output](ProcessStream stream, std::string_view data)
+            {
+                if (predicate && !data.empty() && !ready->load(std::memory_order_relaxed) && predicate(data))
+                    ready->store(true, std::memory_order_relaxed);
+                if (output)
+                    output(stream, data);
+            };
+
+            std::shared_ptr<GameProcess> process;
+            String error;
+            lock.unlock();
+            try
+            {
+                process = entry.request.instance.launch(entry.request.java, entry.request.options, handler);
+            }
+            catch (const std::exception &e)
+            {
+                error = e.what();
+            }
+            lock.lock();
+
+            if (!process)
+            {
+                entry.status.error = error;
+                _exited(entry, std::nullopt, changes);
+                return;
+            }
+            entry.status.process = process;
+            if (entry.cancelled)
+                process->terminate();
+        }
+
+        void LaunchScheduler::_tick(std::unique_lock<std::mutex> &lock, std::vector<LaunchStatus> &changes)
+        {
+            const auto now = std::chrono::steady_clock::now();
+
+            // Finished launches are only kept around for status()
+            _entries.erase(std::remove_if(_entries.begin(), _entries.end(), [&](const std::unique_ptr<Entry> &entry)
+                                          {
+                LaunchState state = entry->status.state;
+                return (state == LaunchState::Stopped || state == LaunchState::Failed) &&
+                       now - entry->finishedAt >= _options.retention; }),
+                           _entries.end());
+
+            unsigned int starting = 0;
+            for (auto &entry : _entries)
+            {
+                LaunchState state = entry->status.state;
+                if (state == LaunchState::Starting || state == LaunchState::Running)
+                {
+                    auto &process = entry->status.process;
+                    if (process && process->exited().wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        _exited(*entry, process->exited().get(), changes);
+                        continue;
+                    }
+                    if (state == LaunchState::Starting &&
+                        (entry->ready->load(std::memory_order_relaxed) || now - entry->startedAt >= entry->request.warmup))
+                        _setState(*entry, LaunchState::Running, changes);
+                    else if (state == LaunchState::Starting)
+                        starting++;
+                }
+                else if (entry->cancelled && (state == LaunchState::Queued || state == LaunchState::Waiting || state == LaunchState::Backoff))
+                {
+                    _setState(*entry, LaunchState::Stopped, changes);
+                }
+            }
+
+            // Next in line: highest priority, then first submitted
+            Entry *next = nullptr;
+            for (auto &entry : _entries)
+            {
+                LaunchState state = entry->status.state;
+                if (state != LaunchState::Queued && state != LaunchState::Waiting && state != LaunchState::Backoff)
+                    continue;
+                if (state == LaunchState::Backoff && entry->notBefore > now)
+                    continue;
+                if (!next || entry->request.priority > next->request.priority ||
+                    (entry->request.priority == next->request.priority && entry->order < next->order))
+                    next = entry.get();
+            }
+            // Only the entry next in line is Waiting, one passed over by a later
+            // submission or held back before another start goes back to Queued
+            for (auto &entry : _entries)
+            {
+                if (entry.get() != next && entry->status.state == LaunchState::Waiting)
+                    _setState(*entry, LaunchState::Queued, changes);
+            }
+            if (!next)
+                return;
+
+            if (starting >= _options.maxColdStarts || now - _lastStart < _options.stagger || !_loadAllows(HostLoad::sample()))
+            {
+                _setState(*next, LaunchState::Waiting, changes);
+                return;
+            }
+            _start(*next, lock, changes);
+        }
+
+        void LaunchScheduler::_run()
+        {
+            std::vector<LaunchStatus> changes;
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_stopping)
+            {
+                changes.clear();
+                _tick(lock, changes);
+
+                if (!changes.empty())
+                {
+                    auto observers = _observers;
+                    lock.unlock();
+                    for (const auto &change : changes)
+                    {
+                        for (const auto &observer : observers)
+                            observer(change);
+                    }
+                    lock.lock();
+                }
+                if (_stopping)
+                    break;
+                _wakeup.wait_for(lock, _options.interval);
+            }
+        }
+    } // namespace minecraft
+
+} // namespace cnt
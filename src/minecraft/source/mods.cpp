@@ -0,0 +1,904 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/mods.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/mods.hpp>
+#include <minecraft/zip.hpp>
+#include <minecraft/classpath.hpp>
+#include <minecraft/parallel.hpp>
+#include <minecraft/lib/config.hpp>
+#include <minecraft/lib/metrics.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            static std::string_view trimView(std::string_view text)
+            {
+                while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+                    text.remove_prefix(1);
+                while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+                    text.remove_suffix(1);
+                return text;
+            }
+
+            // One [table] or [[array.of.tables]] of a mods.toml, values as text
+            struct TomlTable
+            {
+                String name;
+                std::unordered_map<String, String> values;
+            };
+
+            // Enough TOML for mods.toml: headers, key = value, all four string
+            // forms and comments. Inline tables and arrays are kept as raw text.
+            static std::vector<TomlTable> parseToml(std::string_view text)
+            {
+                std::vector<TomlTable> tables(1);
+                std::size_t pos = 0;
+
+                auto skipLine = [&]()
+                {
+                    std::size_t end = text.find('\n', pos);
+                    pos = end == std::string_view::npos ? text.size() : end + 1;
+                };
+
+                while (pos < text.size())
+                {
+                    char c = text[pos];
+                    if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+                    {
+                        pos++;
+                        continue;
+                    }
+                    if (c == '#')
+                    {
+                        skipLine();
+                        continue;
+                    }
+                    if (c == '[')
+                    {
+                        bool array = pos + 1 < text.size() && text[pos + 1] == '[';
+                        std::size_t start = pos + (array ? 2 : 1);
+                        std::size_t end = text.find(']', start);
+                        if (end == std::string_view::npos)
+                            break;
+                        TomlTable table;
+                        for (char n : trimView(text.substr(start, end - start)))
+                        {
+                            if (n != '"' && n != '\'' && n != ' ')
+                                table.name += n;
+                        }
+                        tables.push_back(std::move(table));
+                        pos = end;
+                        skipLine();
+                        continue;
+                    }
+
+                    std::size_t equals = text.find('=', pos);
+                    std::size_t newline = text.find('\n', pos);
+                    if (equals == std::string_view::npos || equals > newline)
+                    {
+                        skipLine();
+                        continue;
+                    }
+                    String key;
+                    for (char k : trimView(text.substr(pos, equals - pos)))
+                    {
+                        if (k != '"' && k != '\'')
+                            key += k;
+                    }
+                    pos = equals + 1;
+                    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t'))
+                        pos++;
+
+                    String value;
+                    if (text.substr(pos, 3) == "\"\"\"" || text.substr(pos, 3) == "'''")
+                    {
+                        std::string_view quote = text.substr(pos, 3);
+                        std::size_t start = pos + 3;
+                        // A newline right after the opening quotes is trimmed
+                        if (start < text.size() && text[start] == '\r')
+                            start++;
+                        if (start < text.size() && text[start] == '\n')
+                            start++;
+                        std::size_t end = text.find(quote, start);
+                        if (end == std::string_view::npos)
+                            end = text.size();
+                        value = String(text.substr(start, end - start));
+                        pos = std::min(end + 3, text.size());
+                    }
+                    else if (pos < text.size() && text[pos] == '"')
+                    {
+                        pos++;
+                        while (pos < text.size() && text[pos] != '"' && text[pos] != '\n')
+                        {
+                            if (text[pos] == '\\' && pos + 1 < text.size())
+                            {
+                                pos++;
+                                switch (text[pos])
+                                {
+                                case 'n': value += '\n'; break;
+                                case 't': value += '\t'; break;
+                                case 'r': value += '\r'; break;
+                                default: value += text[pos]; break;
+                                }
+                            }
+                            else
+                            {
+                                value += text[pos];
+                            }
+                            pos++;
+                        }
+                        pos++;
+                    }
+                    else if (pos < text.size() && text[pos] == '\'')
+                    {
+                        std::size_t end = text.find('\'', pos + 1);
+                        if (end == std::string_view::npos || end > text.find('\n', pos))
+                            end = std::min(text.find('\n', pos), text.size());
+                        value = String(text.substr(pos + 1, end - pos - 1));
+                        pos = end + 1;
+                    }
+                    else
+                    {
+                        std::size_t end = std::min(text.find('\n', pos), text.size());
+                        std::size_t comment = text.find('#', pos);
+                        value = String(trimView(text.substr(pos, std::min(end, comment) - pos)));
+                        pos = end;
+                    }
+                    tables.back().values[key] = std::move(value);
+                    skipLine();
+                }
+                return tables;
+            }
+
+            static String manifestAttribute(const String &manifest, std::string_view name)
+            {
+                std::size_t pos = 0;
+                while (pos < manifest.size())
+                {
+                    std::size_t end = manifest.find('\n', pos);
+                    if (end == String::npos)
+                        end = manifest.size();
+                    std::string_view line(manifest.data() + pos, end - pos);
+                    if (line.size() > name.size() && line.substr(0, name.size()) == name && line[name.size()] == ':')
+                        return String(trimView(line.substr(name.size() + 1)));
+                    pos = end + 1;
+                }
+                return String();
+            }
+
+            static String configString(const ConfigObject &object, const String &key)
+            {
+                if (!object.has_key(key))
+                    return String();
+                return object.at(key).as_string().value_or("");
+            }
+
+            // Fabric allows a single predicate or an array of alternatives
+            static String fabricRange(const ConfigObject &value)
+            {
+                if (!value.is_array())
+                    return value.as_string().value_or("*");
+                String result;
+                for (std::size_t i = 0; i < value.size(); i++)
+                {
+                    if (!result.empty())
+                        result += " || ";
+                    result += value.at(i).as_string().value_or("*");
+                }
+                return result.empty() ? "*" : result;
+            }
+
+            static ModInfo parseFabric(const String &content)
+            {
+                Config config;
+                config.parse(content);
+
+                ModInfo info;
+                info.loader = ModLoader::Fabric;
+                info.id = config.get("id").as_string().value_or("");
+                info.version = config.get("version").as_string().value_or("");
+                info.name = config.get("name").as_string().value_or(info.id);
+                info.description = config.get("description").as_string().value_or("");
+
+                ConfigObject provides = config.get("provides");
+                for (std::size_t i = 0; provides.is_array() && i < provides.size(); i++)
+                    info.provides.push_back(provides.at(i).as_string().value_or(""));
+
+                const std::pair<const char *, ModDependencyKind> sections[] = {
+                    {"depends", ModDependencyKind::Required},
+                    {"recommends", ModDependencyKind::Optional},
+                    {"suggests", ModDependencyKind::Optional},
+                    {"breaks", ModDependencyKind::Incompatible}};
+                for (const auto &[section, kind] : sections)
+                {
+                    ConfigObject entries = config.get(section);
+                    if (!entries.is_object())
+                        continue;
+                    for (const auto &id : entries.keys())
+                        info.dependencies.push_back(ModDependency{id, fabricRange(entries.at(id)), kind});
+                }
+                return info;
+            }
+
+            static ModInfo parseQuilt(const String &content)
+            {
+                Config config;
+                config.parse(content);
+                ConfigObject loader = config.get("quilt_loader");
+
+                ModInfo info;
+                info.loader = ModLoader::Quilt;
+                info.id = configString(loader, "id");
+                info.version = configString(loader, "version");
+                if (loader.has_key("metadata"))
+                {
+                    info.name = configString(loader.at("metadata"), "name");
+                    info.description = configString(loader.at("metadata"), "description");
+                }
+                if (info.name.empty())
+                    info.name = info.id;
+
+                if (loader.has_key("provides"))
+                {
+                    const ConfigObject &provides = loader.at("provides");
+                    for (std::size_t i = 0; i < provides.size(); i++)
+                    {
+                        const ConfigObject &entry = provides.at(i);
+                        info.provides.push_back(entry.is_object() ? configString(entry, "id") : entry.as_string().value_or(""));
+                    }
+                }
+
+                const std::pair<const char *, ModDependencyKind> sections[] = {
+                    {"depends", ModDependencyKind::Required},
+                    {"breaks", ModDependencyKind::Incompatible}};
+                for (const auto &[section, kind] : sections)
+                {
+                    if (!loader.has_key(section))
+                        continue;
+                    const ConfigObject &entries = loader.at(section);
+                    for (std::size_t i = 0; i < entries.size(); i++)
+                    {
+                        const ConfigObject &entry = entries.at(i);
+                        ModDependency dependency{String(), "*", kind};
+                        if (entry.is_object())
+                        {
+                            dependency.id = configString(entry, "id");
+                            if (entry.has_key("versions"))
+                                dependency.versionRange = fabricRange(entry.at("versions"));
+                            if (kind == ModDependencyKind::Required && entry.has_key("optional") &&
+                                entry.at("optional").as_boolean().value_or(false))
+                                dependency.kind = ModDependencyKind::Optional;
+                        }
+                        else
+                        {
+                            dependency.id = entry.as_string().value_or("");
+                        }
+                        // Quilt ids may carry a maven group ("org.quiltmc:quilt_loader")
+                        std::size_t colon = dependency.id.find(':');
+                        if (colon != String::npos)
+                            dependency.id.erase(0, colon + 1);
+                        info.dependencies.push_back(std::move(dependency));
+                    }
+                }
+                return info;
+            }
+
+            static std::vector<ModInfo> parseModsToml(const String &content, const ZipArchive &archive)
+            {
+                std::vector<TomlTable> tables = parseToml(content);
+
+                std::vector<ModInfo> result;
+                for (const auto &table : tables)
+                {
+                    if (table.name != "mods")
+                        continue;
+                    auto value = [&table](const char *key)
+                    {
+                        auto it = table.values.find(key);
+                        return it == table.values.end() ? String() : it->second;
+                    };
+
+                    ModInfo info;
+                    info.loader = ModLoader::Forge;
+                    info.id = value("modId");
+                    info.version = value("version");
+                    info.name = value("displayName");
+                    info.description = String(trimView(value("description")));
+                    if (info.name.empty())
+                        info.name = info.id;
+
+                    // The version usually comes from the jar manifest
+                    if (info.version == "${file.jarVersion}")
+                    {
+                        String manifest;
+                        if (archive.readString("META-INF/MANIFEST.MF", manifest))
+                            info.version = manifestAttribute(manifest, "Implementation-Version");
+                    }
+                    result.push_back(std::move(info));
+                }
+
+                for (const auto &table : tables)
+                {
+                    const String prefix = "dependencies.";
+                    if (table.name.compare(0, prefix.size(), prefix) != 0)
+                        continue;
+                    const String owner = table.name.substr(prefix.size());
+                    auto mod = std::find_if(result.begin(), result.end(), [&](const ModInfo &info)
+                                            { return info.id == owner; });
+                    if (mod == result.end())
+                        continue;
+
+                    auto value = [&table](const char *key)
+                    {
+                        auto it = table.values.find(key);
+                        return it == table.values.end() ? String() : it->second;
+                    };
+
+                    ModDependency dependency;
+                    dependency.id = value("modId");
+                    dependency.versionRange = value("versionRange");
+                    if (dependency.versionRange.empty())
+                        dependency.versionRange = "*";
+
+                    // Forge has "mandatory", NeoForge has "type"
+                    String type = value("type");
+                    std::transform(type.begin(), type.end(), type.begin(), [](unsigned char c)
+                                   { return static_cast<char>(std::tolower(c)); });
+                    if (type == "incompatible" || type == "discouraged")
+                        dependency.kind = ModDependencyKind::Incompatible;
+                    else if (type == "optional" || value("mandatory") == "false")
+                        dependency.kind = ModDependencyKind::Optional;
+                    mod->dependencies.push_back(std::move(dependency));
+                }
+                return result;
+            }
+
+            // "id@[1.0,)" in requiredMods
+            static ModDependency parseLegacyDependency(const String &text, ModDependencyKind kind)
+            {
+                ModDependency dependency{text, "*", kind};
+                std::size_t at = text.find('@');
+                if (at != String::npos)
+                {
+                    dependency.id = text.substr(0, at);
+                    dependency.versionRange = text.substr(at + 1);
+                }
+                return dependency;
+            }
+
+            static std::vector<ModInfo> parseMcmodInfo(const String &content)
+            {
+                Config config;
+                config.parse(content);
+
+                // Either a bare array or {"modListVersion": 2, "modList": [...]}
+                ConfigObject list = config.get("_root");
+                if (!list.is_array())
+                    list = config.get("modList");
+
+                std::vector<ModInfo> result;
+                for (std::size_t i = 0; list.is_array() && i < list.size(); i++)
+                {
+                    const ConfigObject &entry = list.at(i);
+                    ModInfo info;
+                    info.loader = ModLoader::LegacyForge;
+                    info.id = configString(entry, "modid");
+                    info.version = configString(entry, "version");
+                    info.name = configString(entry, "name");
+                    info.description = configString(entry, "description");
+                    if (info.name.empty())
+                        info.name = info.id;
+
+                    if (entry.has_key("requiredMods"))
+                    {
+                        const ConfigObject &required = entry.at("requiredMods");
+                        for (std::size_t d = 0; d < required.size(); d++)
+                            info.dependencies.push_back(parseLegacyDependency(required.at(d).as_string().value_or(""), ModDependencyKind::Required));
+                    }
+                    if (!info.id.empty())
+                        result.push_back(std::move(info));
+                }
+                return result;
+            }
+
+            // Bundled jars are read into memory, nesting deeper than this is not followed
+            constexpr int MaxNestedDepth = 4;
+            constexpr std::uint64_t MaxNestedJar = 128 * 1024 * 1024;
+
+            // Entries of the jars bundled in an archive, as listed by its loader metadata
+            static std::vector<String> nestedJars(const ZipArchive &archive, ModLoader loader, const String &content)
+            {
+                std::vector<String> result;
+                Config config;
+                if (loader == ModLoader::Fabric)
+                {
+                    // "jars": [{"file": "META-INF/jars/x.jar"}]
+                    config.parse(content);
+                    ConfigObject jars = config.get("jars");
+                    for (std::size_t i = 0; jars.is_array() && i < jars.size(); i++)
+                        result.push_back(configString(jars.at(i), "file"));
+                }
+                else if (loader == ModLoader::Quilt)
+                {
+                    // "quilt_loader": {"jars": ["META-INF/jars/x.jar"]}
+                    config.parse(content);
+                    ConfigObject quilt = config.get("quilt_loader");
+                    if (quilt.has_key("jars"))
+                    {
+                        const ConfigObject &jars = quilt.at("jars");
+                        for (std::size_t i = 0; i < jars.size(); i++)
+                            result.push_back(jars.at(i).as_string().value_or(""));
+                    }
+                }
+                else if (loader == ModLoader::Forge)
+                {
+                    // Forge and NeoForge JarJar: {"jars": [{"path": "META-INF/jarjar/x.jar", ...}]}
+                    String metadata;
+                    if (archive.readString("META-INF/jarjar/metadata.json", metadata))
+                    {
+                        config.parse(metadata);
+                        ConfigObject jars = config.get("jars");
+                        for (std::size_t i = 0; jars.is_array() && i < jars.size(); i++)
+                            result.push_back(configString(jars.at(i), "path"));
+                    }
+                }
+                result.erase(std::remove(result.begin(), result.end(), String()), result.end());
+                return result;
+            }
+
+            static void readArchiveMetadata(const ZipArchive &archive, const String &nested, int depth, std::vector<ModInfo> &result)
+            {
+                std::vector<ModInfo> mods;
+                ModLoader loader;
+                String content;
+                if (archive.readString("fabric.mod.json", content))
+                {
+                    loader = ModLoader::Fabric;
+                    mods.push_back(parseFabric(content));
+                }
+                else if (archive.readString("quilt.mod.json", content))
+                {
+                    loader = ModLoader::Quilt;
+                    mods.push_back(parseQuilt(content));
+                }
+                else if (archive.readString("META-INF/neoforge.mods.toml", content) ||
+                         archive.readString("META-INF/mods.toml", content))
+                {
+                    loader = ModLoader::Forge;
+                    mods = parseModsToml(content, archive);
+                }
+                else if (archive.readString("mcmod.info", content))
+                {
+                    loader = ModLoader::LegacyForge;
+                    mods = parseMcmodInfo(content);
+                }
+                else
+                {
+                    return;
+                }
+
+                for (auto &info : mods)
+                {
+                    if (info.id.empty())
+                        continue;
+                    info.nested = nested;
+                    result.push_back(std::move(info));
+                }
+
+                if (depth >= MaxNestedDepth)
+                    return;
+                for (const auto &name : nestedJars(archive, loader, content))
+                {
+                    const ZipEntry *entry = archive.find(name);
+                    if (entry == nullptr || entry->size > MaxNestedJar)
+                        continue;
+                    // A broken bundled jar does not hide the mods of the outer one
+                    try
+                    {
+                        ZipArchive inner(archive.read(*entry), archive.path() / name);
+                        readArchiveMetadata(inner, nested.empty() ? name : nested + '!' + name, depth + 1, result);
+                    }
+                    catch (const std::exception &)
+                    {
+                    }
+                }
+            }
+
+            std::vector<ModInfo> readModMetadata(const fs::path &file)
+            {
+                ZipArchive archive(file);
+
+                std::vector<ModInfo> result;
+                readArchiveMetadata(archive, String(), 0, result);
+                for (auto &info : result)
+                    info.file = file;
+                return result;
+            }
+
+            // Strip semver build metadata, it does not take part in ordering
+            static std::string_view withoutBuild(std::string_view version)
+            {
+                return version.substr(0, version.find('+'));
+            }
+
+            static bool matchesPredicate(std::string_view version, std::string_view predicate)
+            {
+                if (predicate.empty() || predicate == "*")
+                    return true;
+
+                std::string_view op;
+                for (std::string_view candidate : {">=", "<=", ">", "<", "=", "~", "^"})
+                {
+                    if (predicate.substr(0, candidate.size()) == candidate)
+                    {
+                        op = candidate;
+                        break;
+                    }
+                }
+                std::string_view target = trimView(predicate.substr(op.size()));
+                version = withoutBuild(version);
+                target = withoutBuild(target);
+
+                // "1.20.x" and "1.20.*" match on the leading segments
+                std::size_t wildcard = target.find_first_of("xX*");
+                if (wildcard != std::string_view::npos && (op.empty() || op == "="))
+                {
+                    std::string_view prefix = target.substr(0, wildcard);
+                    return version.substr(0, prefix.size()) == prefix;
+                }
+
+                int cmp = compareMavenVersions(version, target);
+                if (op.empty() || op == "=")
+                    return cmp == 0;
+                if (op == ">=")
+                    return cmp >= 0;
+                if (op == "<=")
+                    return cmp <= 0;
+                if (op == ">")
+                    return cmp > 0;
+                if (op == "<")
+                    return cmp < 0;
+
+                // ~1.2.3 allows patch changes, ^1.2.3 allows minor changes
+                if (cmp < 0)
+                    return false;
+                const std::size_t keep = op == "~" ? 2 : 1;
+                std::size_t cut = target.size();
+                for (std::size_t p = 0, segments = 0; p < target.size(); p++)
+                {
+                    if (target[p] == '.' && ++segments == keep)
+                    {
+                        cut = p;
+                        break;
+                    }
+                }
+                std::string_view fixed = target.substr(0, cut);
+                return version.substr(0, fixed.size()) == fixed &&
+                       (version.size() == fixed.size() || !std::isalnum(static_cast<unsigned char>(version[fixed.size()])));
+            }
+
+            // [1.0,2.0) (,3] [1.0] and unions of them separated by commas
+            static bool matchesMavenRange(std::string_view version, std::string_view range)
+            {
+                std::size_t pos = 0;
+                while (pos < range.size())
+                {
+                    std::size_t open = range.find_first_of("[(", pos);
+                    if (open == std::string_view::npos)
+                        break;
+                    std::size_t close = range.find_first_of("])", open);
+                    if (close == std::string_view::npos)
+                        return false;
+
+                    std::string_view inside = range.substr(open + 1, close - open - 1);
+                    std::size_t comma = inside.find(',');
+                    bool matched;
+                    if (comma == std::string_view::npos)
+                    {
+                        matched = compareMavenVersions(version, trimView(inside)) == 0;
+                    }
+                    else
+                    {
+                        std::string_view low = trimView(inside.substr(0, comma));
+                        std::string_view high = trimView(inside.substr(comma + 1));
+                        matched = true;
+                        if (!low.empty())
+                        {
+                            int cmp = compareMavenVersions(version, low);
+                            matched = range[open] == '[' ? cmp >= 0 : cmp > 0;
+                        }
+                        if (matched && !high.empty())
+                        {
+                            int cmp = compareMavenVersions(version, high);
+                            matched = range[close] == ']' ? cmp <= 0 : cmp < 0;
+                        }
+                    }
+                    if (matched)
+                        return true;
+                    pos = close + 1;
+                }
+                return false;
+            }
+
+            bool matchesVersionRange(std::string_view version, std::string_view range)
+            {
+                range = trimView(range);
+                if (range.empty() || range == "*")
+                    return true;
+                if (range[0] == '[' || range[0] == '(')
+                    return matchesMavenRange(version, range);
+
+                // Alternatives separated by ||, each a list of predicates that must all hold
+                std::size_t pos = 0;
+                for (;;)
+                {
+                    std::size_t bar = range.find("||", pos);
+                    std::string_view alternative = range.substr(pos, bar == std::string_view::npos ? std::string_view::npos : bar - pos);
+
+                    bool all = true;
+                    std::size_t start = 0;
+                    while (all && start < alternative.size())
+                    {
+                        while (start < alternative.size() && alternative[start] == ' ')
+                            start++;
+                        std::size_t end = alternative.find(' ', start);
+                        // Allow a space between an operator and its version (">= 1.2")
+                        while (end != std::string_view::npos && end > start &&
+                               std::string_view("<>=~^").find(alternative[end - 1]) != std::string_view::npos)
+                        {
+                            std::size_t next = alternative.find_first_not_of(' ', end);
+                            end = next == std::string_view::npos ? next : alternative.find(' ', next);
+                        }
+                        std::string_view predicate = alternative.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+                        if (!predicate.empty() && !matchesPredicate(version, predicate))
+                            all = false;
+                        start = end == std::string_view::npos ? alternative.size() : end;
+                    }
+                    if (all)
+                        return true;
+                    if (bar == std::string_view::npos)
+                        return false;
+                    pos = bar + 2;
+                }
+            }
+        }
+
+        ModScanner &ModScanner::shared()
+        {
+            static ModScanner scanner;
+            return scanner;
+        }
+
+        std::vector<std::shared_ptr<const ModInfo>> ModScanner::scan(const fs::path &directory, unsigned int threads)
+        {
+            struct Candidate
+            {
+                fs::path path;
+                std::uint64_t size;
+                std::int64_t time;
+                bool cached;
+                Entry entry;
+            };
+            std::vector<Candidate> candidates;
+
+            // The lock is only held to read and to replace the directory cache,
+            // listing and parsing run unlocked so other scans are not serialized
+            std::error_code ec;
+            for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec))
+            {
+                const fs::path &path = it->path();
+                if (path.extension() != ".jar")
+                    continue;
+
+                Candidate candidate{path, 0, 0, false, {}};
+#ifndef _WIN32
+                struct stat st;
+                if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+                    continue;
+                candidate.size = static_cast<std::uint64_t>(st.st_size);
+                candidate.time = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#else
+                std::error_code statError;
+                if (!it->is_regular_file(statError))
+                    continue;
+                candidate.size = it->file_size(statError);
+                candidate.time = it->last_write_time(statError).time_since_epoch().count();
+#endif
+                candidates.push_back(std::move(candidate));
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto found = _directories.find(directory.string());
+                if (found != _directories.end())
+                {
+                    for (auto &candidate : candidates)
+                    {
+                        auto hit = found->second.find(candidate.path.string());
+                        if (hit != found->second.end() && hit->second.size == candidate.size && hit->second.time == candidate.time)
+                        {
+                            candidate.cached = true;
+                            candidate.entry = hit->second;
+                        }
+                    }
+                }
+            }
+
+            // Only new or changed jars are opened
+            std::vector<std::size_t> misses;
+            for (std::size_t i = 0; i < candidates.size(); i++)
+            {
+                if (!candidates[i].cached)
+                    misses.push_back(i);
+            }
+            static Counter &cacheHits = Metrics::shared().counter("cnt_cache_hits_total", "Lookups served from a cache", "cache=\"mods\"");
+            static Counter &cacheMisses = Metrics::shared().counter("cnt_cache_misses_total", "Lookups that had to rebuild the entry", "cache=\"mods\"");
+            cacheHits.add(candidates.size() - misses.size());
+            cacheMisses.add(misses.size());
+            internal::parallelFor(misses.size(), [&](std::size_t i)
+                                  {
+                Candidate &candidate = candidates[misses[i]];
+                candidate.entry.size = candidate.size;
+                candidate.entry.time = candidate.time;
+                try
+                {
+                    for (auto &info : internal::readModMetadata(candidate.path))
+                        candidate.entry.mods.push_back(std::make_shared<const ModInfo>(std::move(info)));
+                }
+                catch (const std::exception &)
+                {
+                    // Broken jars and metadata are cached as having no mods until they change
+                } },
+                                  threads);
+
+            // Rebuild the directory cache, dropping jars that disappeared
+            std::unordered_map<String, Entry> next;
+            next.reserve(candidates.size());
+            std::vector<std::shared_ptr<const ModInfo>> result;
+            for (auto &candidate : candidates)
+            {
+                result.insert(result.end(), candidate.entry.mods.begin(), candidate.entry.mods.end());
+                next.emplace(candidate.path.string(), std::move(candidate.entry));
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _directories[directory.string()] = std::move(next);
+            }
+
+            std::sort(result.begin(), result.end(), [](const auto &a, const auto &b)
+                      { return a->file < b->file || (a->file == b->file && a->id < b->id); });
+            return result;
+        }
+
+        void ModScanner::clear()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _directories.clear();
+        }
+
+        ModGraph BuildModGraph(const std::vector<std::shared_ptr<const ModInfo>> &mods, const std::unordered_map<String, String> &platform)
+        {
+            // Loader and game ids are only checked when the caller says what is installed
+            static const std::vector<String> platformIds = {
+                "minecraft", "java", "fabricloader", "quilt_loader", "forge", "neoforge", "fml"};
+
+            ModGraph graph;
+            graph.mods = mods;
+            std::sort(graph.mods.begin(), graph.mods.end(), [](const auto &a, const auto &b)
+                      { return a->id < b->id; });
+
+            for (std::size_t i = 0; i < graph.mods.size(); i++)
+            {
+                const ModInfo &mod = *graph.mods[i];
+                auto [it, inserted] = graph.ids.emplace(mod.id, i);
+                if (!inserted && (!mod.nested.empty() || !graph.mods[it->second]->nested.empty()))
+                {
+                    // Loaders dedupe bundled copies and keep the newest one
+                    if (internal::compareMavenVersions(graph.mods[it->second]->version, mod.version) < 0)
+                        it->second = i;
+                }
+                else if (!inserted)
+                {
+                    const ModInfo &other = *graph.mods[it->second];
+                    graph.problems.push_back(ModProblem{ModProblemKind::Duplicate, mod.id, other.id,
+                                                        other.file.filename().string() + " and " + mod.file.filename().string()});
+                }
+            }
+            // Provided ids never shadow a real mod id
+            for (std::size_t i = 0; i < graph.mods.size(); i++)
+            {
+                for (const auto &provided : graph.mods[i]->provides)
+                    graph.ids.emplace(provided, i);
+            }
+
+            graph.dependencies.resize(graph.mods.size());
+            for (std::size_t i = 0; i < graph.mods.size(); i++)
+            {
+                const ModInfo &mod = *graph.mods[i];
+                for (const auto &dependency : mod.dependencies)
+                {
+                    String installedVersion;
+                    bool installed = false;
+                    auto it = graph.ids.find(dependency.id);
+                    if (it != graph.ids.end())
+                    {
+                        installed = true;
+                        installedVersion = graph.mods[it->second]->version;
+                    }
+                    else
+                    {
+                        auto env = platform.find(dependency.id);
+                        if (env != platform.end())
+                        {
+                            installed = true;
+                            installedVersion = env->second;
+                        }
+                        else
+                        {
+                            // Legacy metadata spells them "Forge", "FML"
+                            String lower = dependency.id;
+                            std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c)
+                                           { return static_cast<char>(std::tolower(c)); });
+                            if (std::find(platformIds.begin(), platformIds.end(), lower) != platformIds.end())
+                                continue;
+                        }
+                    }
+
+                    bool inRange = installed && internal::matchesVersionRange(installedVersion, dependency.versionRange);
+                    switch (dependency.kind)
+                    {
+                    case ModDependencyKind::Required:
+                        if (!installed)
+                            graph.problems.push_back(ModProblem{ModProblemKind::Missing, mod.id, dependency.id, dependency.versionRange});
+                        else if (!inRange)
+                            graph.problems.push_back(ModProblem{ModProblemKind::VersionMismatch, mod.id, dependency.id,
+                                                                "requires " + dependency.versionRange + ", found " + installedVersion});
+                        if (installed && it != graph.ids.end() && it->second != i)
+                            graph.dependencies[i].push_back(it->second);
+                        break;
+                    case ModDependencyKind::Incompatible:
+                        if (inRange)
+                            graph.problems.push_back(ModProblem{ModProblemKind::Incompatible, mod.id, dependency.id,
+                                                                "breaks " + dependency.versionRange + ", found " + installedVersion});
+                        break;
+                    case ModDependencyKind::Optional:
+                        break;
+                    }
+                }
+            }
+            return graph;
+        }
+    } // namespace minecraft
+
+} // namespace cnt
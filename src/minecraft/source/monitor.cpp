@@ -0,0 +1,507 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/monitor.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/monitor.hpp>
+#include <minecraft/host.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <cerrno>
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            bool parseProcStat(std::string_view text, ProcessSample &sample, double ticksPerSecond)
+            {
+                // The command name is in parentheses and may itself contain ") "
+                std::size_t close = text.rfind(')');
+                if (close == std::string_view::npos)
+                    return false;
+                text.remove_prefix(close + 1);
+
+                // Field 3 is the state, utime and stime are 14 and 15, num_threads is 20
+                std::uint64_t utime = 0, stime = 0, threads = 0;
+                int field = 2;
+                std::size_t pos = 0;
+                while (pos < text.size() && field < 20)
+                {
+                    while (pos < text.size() && text[pos] == ' ')
+                        pos++;
+                    std::size_t end = text.find(' ', pos);
+                    if (end == std::string_view::npos)
+                        end = text.size();
+                    std::string_view value = text.substr(pos, end - pos);
+                    pos = end;
+                    field++;
+
+                    if (field == 3)
+                    {
+                        // Zombies and dead tasks no longer use anything
+                        if (value == "Z" || value == "X" || value == "x")
+                            sample.alive = false;
+                        continue;
+                    }
+                    if (field != 14 && field != 15 && field != 20)
+                        continue;
+
+                    std::uint64_t number = 0;
+                    for (char c : value)
+                    {
+                        if (c < '0' || c > '9')
+                            break;
+                        number = number * 10 + static_cast<std::uint64_t>(c - '0');
+                    }
+                    if (field == 14)
+                        utime = number;
+                    else if (field == 15)
+                        stime = number;
+                    else
+                        threads = number;
+                }
+                if (field < 20)
+                    return false;
+
+                sample.cpuTime = static_cast<double>(utime + stime) / ticksPerSecond;
+                sample.threads = static_cast<unsigned int>(threads);
+                return true;
+            }
+
+            fs::path ownCgroup()
+            {
+                // The unified hierarchy is the "0::<path>" line
+                const String cgroups = readSmallFile("/proc/self/cgroup");
+                std::size_t pos = 0;
+                while (pos < cgroups.size())
+                {
+                    std::size_t end = cgroups.find('\n', pos);
+                    if (end == String::npos)
+                        end = cgroups.size();
+                    std::string_view line(cgroups.data() + pos, end - pos);
+                    pos = end + 1;
+
+                    if (line.substr(0, 3) != "0::")
+                        continue;
+                    fs::path group = fs::path("/sys/fs/cgroup") / fs::path(String(line.substr(3))).relative_path();
+                    std::error_code ec;
+                    if (fs::exists(group / "cgroup.controllers", ec))
+                        return group;
+                }
+                return fs::path();
+            }
+        }
+
+#ifdef __linux__
+        namespace internal
+        {
+            static ssize_t preadAll(int fd, std::vector<char> &buffer)
+            {
+                for (;;)
+                {
+                    ssize_t n = ::pread(fd, buffer.data(), buffer.size() - 1, 0);
+                    if (n < 0 && errno == EINTR)
+                        continue;
+                    if (n >= 0)
+                        buffer[static_cast<std::size_t>(n)] = '\0';
+                    return n;
+                }
+            }
+
+            static std::uint64_t parseIoValue(std::string_view text, std::string_view key)
+            {
+                std::size_t pos = 0;
+                while ((pos = text.find(key, pos)) != std::string_view::npos)
+                {
+                    if (pos == 0 || text[pos - 1] == '\n')
+                        return std::strtoull(text.data() + pos + key.size(), nullptr, 10);
+                    pos += key.size();
+                }
+                return 0;
+            }
+
+            static unsigned int countDirectory(int fd)
+            {
+                // The fd directory reports its entry count as size on Linux 6.2+
+                struct stat info;
+                if (::fstat(fd, &info) == 0 && info.st_size > 0)
+                    return static_cast<unsigned int>(info.st_size);
+
+                if (::lseek(fd, 0, SEEK_SET) < 0)
+                    return 0;
+                alignas(8) char buffer[8192];
+                unsigned int count = 0;
+                for (;;)
+                {
+                    long n = ::syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+                    if (n <= 0)
+                        break;
+                    for (long offset = 0; offset < n;)
+                    {
+                        auto *entry = reinterpret_cast<struct dirent64 *>(buffer + offset);
+                        if (entry->d_name[0] != '.')
+                            count++;
+                        offset += entry->d_reclen;
+                    }
+                }
+                return count;
+            }
+
+            // errno of a failed write, 0 on success
+            static int tryWriteCgroupFile(const fs::path &path, const String &value)
+            {
+                int fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+                if (fd < 0)
+                    return errno;
+                ssize_t n = ::write(fd, value.data(), value.size());
+                int error = n == static_cast<ssize_t>(value.size()) ? 0 : (n < 0 ? errno : EIO);
+                ::close(fd);
+                return error;
+            }
+
+            static void writeCgroupFile(const fs::path &path, const String &value)
+            {
+                int error = tryWriteCgroupFile(path, value);
+                if (error != 0)
+                    throw std::runtime_error("Cannot write \"" + value + "\" to " + path.string() + ": " + std::strerror(error));
+            }
+        }
+
+        ProcessMonitor::Watched::~Watched()
+        {
+            for (int fd : {stat, statm, io, fds})
+            {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        }
+
+        void ProcessMonitor::watch(int pid, String label)
+        {
+            auto watched = std::make_shared<Watched>(pid, std::move(label));
+
+            // Open every file relative to one directory so they all refer to the same process
+            String path = "/proc/" + std::to_string(pid);
+            int dir = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (dir < 0)
+                throw std::runtime_error("Cannot watch process " + std::to_string(pid) + ": " + std::strerror(errno));
+            watched->stat = ::openat(dir, "stat", O_RDONLY | O_CLOEXEC);
+            watched->statm = ::openat(dir, "statm", O_RDONLY | O_CLOEXEC);
+            // io and fd need ptrace access, they stay closed for foreign processes
+            watched->io = ::openat(dir, "io", O_RDONLY | O_CLOEXEC);
+            watched->fds = ::openat(dir, "fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            ::close(dir);
+            if (watched->stat < 0 || watched->statm < 0)
+                throw std::runtime_error("Cannot watch process " + std::to_string(pid));
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _watched.erase(std::remove_if(_watched.begin(), _watched.end(),
+                                          [pid](const std::shared_ptr<Watched> &item)
+                                          { return item->pid == pid; }),
+                           _watched.end());
+            _watched.push_back(std::move(watched));
+        }
+
+        bool ProcessMonitor::_sample(Watched &watched, ProcessSample &sample, std::vector<char> &buffer)
+        {
+            static const double ticksPerSecond = static_cast<double>(::sysconf(_SC_CLK_TCK));
+            static const std::uint64_t pageSize = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+
+            sample.pid = watched.pid;
+            sample.label = watched.label;
+            sample.time = std::chrono::steady_clock::now();
+
+            // Reads fail with ESRCH once the process has been reaped, even if the pid was reused
+            ssize_t n = internal::preadAll(watched.stat, buffer);
+            if (n <= 0 || !internal::parseProcStat(std::string_view(buffer.data(), static_cast<std::size_t>(n)), sample, ticksPerSecond))
+                return false;
+            if (!sample.alive)
+                return false;
+
+            if (internal::preadAll(watched.statm, buffer) > 0)
+            {
+                char *end = nullptr;
+                std::uint64_t size = std::strtoull(buffer.data(), &end, 10);
+                std::uint64_t resident = std::strtoull(end, nullptr, 10);
+                sample.virtualMemory = size * pageSize;
+                sample.residentMemory = resident * pageSize;
+            }
+
+            if (watched.io >= 0 && (n = internal::preadAll(watched.io, buffer)) > 0)
+            {
+                std::string_view text(buffer.data(), static_cast<std::size_t>(n));
+                sample.readBytes = internal::parseIoValue(text, "read_bytes:");
+                sample.writeBytes = internal::parseIoValue(text, "write_bytes:");
+            }
+
+            if (watched.fds >= 0)
+                sample.openFiles = internal::countDirectory(watched.fds);
+
+            if (watched.sampled)
+            {
+                double elapsed = std::chrono::duration<double>(sample.time - watched.last.time).count();
+                if (elapsed > 0)
+                    sample.cpuUsage = std::max(0.0, sample.cpuTime - watched.last.cpuTime) / elapsed;
+            }
+            return true;
+        }
+
+        fs::path CreateCgroup(const String &name, const CgroupLimits &limits)
+        {
+            if (name.empty() || name.find('/') != String::npos || name == "." || name == "..")
+                throw std::runtime_error("Invalid cgroup name: " + name);
+
+            fs::path base = internal::ownCgroup();
+            if (base.empty())
+                throw std::runtime_error("No cgroup v2 hierarchy is available");
+
+            // A group with processes cannot hand controllers to children ("no
+            // internal processes"), so the launcher first moves into a leaf of its own
+            const fs::path subtree = base / "cgroup.subtree_control";
+            int error = internal::tryWriteCgroupFile(subtree, "+memory +cpu");
+            if (error == EBUSY)
+            {
+                fs::path self = base / "launcher";
+                std::error_code ec;
+                fs::create_directory(self, ec);
+                if (ec)
+                    throw std::runtime_error("Cannot create cgroup " + self.string() + ": " + ec.message());
+
+                const String procs = internal::readSmallFile(base / "cgroup.procs");
+                std::size_t pos = 0;
+                while (pos < procs.size())
+                {
+                    std::size_t end = procs.find('\n', pos);
+                    if (end == String::npos)
+                        end = procs.size();
+                    if (end > pos)
+                        AttachToCgroup(self, std::atoi(procs.c_str() + pos));
+                    pos = end + 1;
+                }
+                error = internal::tryWriteCgroupFile(subtree, "+memory +cpu");
+            }
+            if (error != 0)
+                throw std::runtime_error("Cannot enable cgroup controllers in " + base.string() + ": " + std::strerror(error));
+
+            fs::path group = base / name;
+            std::error_code ec;
+            fs::create_directory(group, ec);
+            if (ec)
+                throw std::runtime_error("Cannot create cgroup " + group.string() + ": " + ec.message());
+
+            auto bytes = [](std::uint64_t value)
+            {
+                return value == 0 ? String("max") : std::to_string(value);
+            };
+            internal::writeCgroupFile(group / "memory.max", bytes(limits.memoryMax));
+            internal::writeCgroupFile(group / "memory.high", bytes(limits.memoryHigh));
+
+            constexpr long period = 100000;
+            String cpuMax = "max";
+            if (limits.cpuMax > 0)
+                cpuMax = std::to_string(std::max<long>(1000, std::lround(limits.cpuMax * period)));
+            internal::writeCgroupFile(group / "cpu.max", cpuMax + " " + std::to_string(period));
+
+            unsigned int weight = limits.cpuWeight == 0 ? 100 : std::min(10000u, std::max(1u, limits.cpuWeight));
+            internal::writeCgroupFile(group / "cpu.weight", std::to_string(weight));
+            return group;
+        }
+#else
+        ProcessMonitor::Watched::~Watched() {}
+
+        void ProcessMonitor::watch(int, String)
+        {
+            throw std::runtime_error("Process monitoring is not supported on this platform yet");
+        }
+
+        bool ProcessMonitor::_sample(Watched &, ProcessSample &, std::vector<char> &)
+        {
+            return false;
+        }
+
+        fs::path CreateCgroup(const String &, const CgroupLimits &)
+        {
+            throw std::runtime_error("cgroups are not supported on this platform");
+        }
+#endif
+
+        ProcessMonitor::ProcessMonitor(std::chrono::milliseconds interval)
+            : _interval(std::max(interval, std::chrono::milliseconds(10)))
+        {
+            _thread = std::thread(&ProcessMonitor::_run, this);
+        }
+
+        ProcessMonitor::~ProcessMonitor()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _wakeup.notify_all();
+            if (_thread.joinable())
+                _thread.join();
+        }
+
+        void ProcessMonitor::watch(const GameProcess &process, String label)
+        {
+            if (!process.running())
+                return;
+            watch(process.pid(), std::move(label));
+        }
+
+        void ProcessMonitor::unwatch(int pid)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _watched.erase(std::remove_if(_watched.begin(), _watched.end(),
+                                          [pid](const std::shared_ptr<Watched> &item)
+                                          { return item->pid == pid; }),
+                           _watched.end());
+            _latest.erase(std::remove_if(_latest.begin(), _latest.end(),
+                                         [pid](const ProcessSample &sample)
+                                         { return sample.pid == pid; }),
+                          _latest.end());
+        }
+
+        std::vector<ProcessSample> ProcessMonitor::sampleNow()
+        {
+            std::lock_guard<std::mutex> sampling(_sampling);
+
+            std::vector<std::shared_ptr<Watched>> watched;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                watched = _watched;
+            }
+
+            // Syscalls happen outside the lock so watch() never waits on a tick
+            std::vector<char> buffer(4096);
+            std::vector<ProcessSample> samples;
+            std::vector<int> gone;
+            samples.reserve(watched.size());
+            for (const auto &item : watched)
+            {
+                ProcessSample sample;
+                if (_sample(*item, sample, buffer))
+                {
+                    item->last = sample;
+                    item->sampled = true;
+                }
+                else
+                {
+                    // Report the last known values once, then forget the process
+                    sample = item->last;
+                    sample.pid = item->pid;
+                    sample.label = item->label;
+                    sample.time = std::chrono::steady_clock::now();
+                    sample.cpuUsage = 0;
+                    sample.alive = false;
+                    gone.push_back(item->pid);
+                }
+                samples.push_back(std::move(sample));
+            }
+
+            std::vector<ProcessSampleHandler> handlers;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!gone.empty())
+                {
+                    _watched.erase(std::remove_if(_watched.begin(), _watched.end(),
+                                                  [&gone](const std::shared_ptr<Watched> &item)
+                                                  { return std::find(gone.begin(), gone.end(), item->pid) != gone.end(); }),
+                                   _watched.end());
+                }
+                _latest = samples;
+                handlers = _handlers;
+            }
+            for (const auto &handler : handlers)
+                handler(samples);
+            return samples;
+        }
+
+        std::vector<ProcessSample> ProcessMonitor::latest() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _latest;
+        }
+
+        std::optional<ProcessSample> ProcessMonitor::latest(int pid) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const auto &sample : _latest)
+            {
+                if (sample.pid == pid)
+                    return sample;
+            }
+            return std::nullopt;
+        }
+
+        void ProcessMonitor::subscribe(ProcessSampleHandler handler)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _handlers.push_back(std::move(handler));
+        }
+
+        void ProcessMonitor::_run()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            auto next = std::chrono::steady_clock::now() + _interval;
+            while (!_stopping)
+            {
+                if (_wakeup.wait_until(lock, next, [this]
+                                       { return _stopping; }))
+                    break;
+                next += _interval;
+                if (_watched.empty())
+                    continue;
+
+                lock.unlock();
+                try
+                {
+                    sampleNow();
+                }
+                catch (...)
+                {
+                    // A failing subscriber must not stop the monitor
+                }
+                lock.lock();
+
+                // Skip ticks instead of bursting after a stall
+                auto now = std::chrono::steady_clock::now();
+                if (next < now)
+                    next = now + _interval;
+            }
+        }
+    } // namespace minecraft
+
+} // namespace cnt
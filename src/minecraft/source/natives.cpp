@@ -0,0 +1,365 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/natives.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/natives.hpp>
+#include <minecraft/launch.hpp>
+#include <minecraft/classpath.hpp>
+#include <minecraft/clone.hpp>
+#include <minecraft/parallel.hpp>
+#include <minecraft/zip.hpp>
+#include <minecraft/cache.hpp>
+#include <minecraft/lib/sha1.hpp>
+#include <minecraft/lib/trace.hpp>
+#include <minecraft/lib/metrics.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            // Entry names come from the archive, never let them leave the destination
+            static bool isSafeEntryName(const String &name)
+            {
+                if (name.empty() || name[0] == '/' || name[0] == '\\' || name.find(':') != String::npos)
+                    return false;
+                for (const auto &part : fs::path(name))
+                {
+                    if (part == "..")
+                        return false;
+                }
+                return true;
+            }
+
+            std::vector<NativeLibrary> resolveNatives(const std::vector<std::unique_ptr<Config>> &chain, const fs::path &indexPath)
+            {
+#ifdef _WIN32
+                const String osName = "windows";
+#elif defined(__APPLE__)
+                const String osName = "osx";
+#else
+                const String osName = "linux";
+#endif
+                const String arch = sizeof(void *) == 8 ? "64" : "32";
+                const LaunchFeatures features;
+
+                std::vector<NativeLibrary> result;
+                for (const auto &profile : chain)
+                {
+                    ConfigObject libraries = profile->get("libraries");
+                    for (std::size_t i = 0; i < libraries.size(); i++)
+                    {
+                        const ConfigObject &library = libraries.at(i);
+                        if (!library.has_key("name") || !library.has_key("natives"))
+                            continue;
+                        if (library.has_key("rules") && !evaluateRules(library.at("rules"), features))
+                            continue;
+
+                        const ConfigObject &natives = library.at("natives");
+                        if (!natives.has_key(osName))
+                            continue;
+
+                        String classifier = natives.at(osName).as_string().value_or("");
+                        std::size_t placeholder = classifier.find("${arch}");
+                        if (placeholder != String::npos)
+                            classifier.replace(placeholder, 7, arch);
+
+                        MavenName name = parseMavenName(library.at("name").as_string().value_or(""));
+                        name.classifier = classifier;
+
+                        NativeLibrary native;
+                        native.jar = indexPath / "libraries" / name.path();
+                        if (library.has_key("downloads") && library.at("downloads").has_key("classifiers") &&
+                            library.at("downloads").at("classifiers").has_key(classifier))
+                        {
+                            const ConfigObject &download = library.at("downloads").at("classifiers").at(classifier);
+                            if (download.has_key("path"))
+                                native.jar = indexPath / "libraries" / download.at("path").as_string().value_or("");
+                            native.sha1 = download.at("sha1").as_string().value_or("");
+                        }
+
+                        if (library.has_key("extract") && library.at("extract").has_key("exclude"))
+                        {
+                            const ConfigObject &exclude = library.at("extract").at("exclude");
+                            for (std::size_t e = 0; e < exclude.size(); e++)
+                                native.exclude.push_back(exclude.at(e).as_string().value_or(""));
+                        }
+                        result.push_back(std::move(native));
+                    }
+                }
+                return result;
+            }
+
+            std::size_t extractZip(const fs::path &file, const fs::path &directory, const std::vector<String> &exclude, unsigned int threads)
+            {
+                ZipArchive archive(file);
+
+                std::vector<const ZipEntry *> files;
+                std::vector<fs::path> directories;
+                for (const auto &entry : archive.entries())
+                {
+                    bool excluded = std::any_of(exclude.begin(), exclude.end(), [&](const String &prefix)
+                                                { return !prefix.empty() && entry.name.substr(0, prefix.size()) == prefix; });
+                    if (excluded)
+                        continue;
+                    if (!isSafeEntryName(String(entry.name)))
+                        throw std::runtime_error("Unsafe zip entry name: " + String(entry.name));
+
+                    if (entry.isDirectory())
+                    {
+                        directories.push_back(directory / entry.name);
+                        continue;
+                    }
+                    directories.push_back((directory / entry.name).parent_path());
+                    files.push_back(&entry);
+                }
+
+                // Create the directory skeleton first so workers only write files
+                fs::create_directories(directory);
+                std::sort(directories.begin(), directories.end());
+                directories.erase(std::unique(directories.begin(), directories.end()), directories.end());
+                for (const auto &dir : directories)
+                    fs::create_directories(dir);
+
+                parallelFor(files.size(), [&](std::size_t index)
+                            {
+                    const ZipEntry &entry = *files[index];
+                    const fs::path target = directory / entry.name;
+                    std::ofstream out(target, std::ios::binary | std::ios::trunc);
+                    if (!out.is_open())
+                        throw std::runtime_error("Cannot create file: " + target.string());
+
+                    archive.read(entry, [&out](const std::uint8_t *chunk, std::size_t length)
+                                 { out.write(reinterpret_cast<const char *>(chunk), static_cast<std::streamsize>(length)); });
+                    if (!out)
+                        throw std::runtime_error("Cannot write file: " + target.string()); },
+                            threads);
+
+                return files.size();
+            }
+        }
+
+        NativesCache &NativesCache::shared()
+        {
+            static NativesCache cache;
+            return cache;
+        }
+
+        String NativesCache::_hashFile(const fs::path &file)
+        {
+            CNT_TRACE_SCOPE_DETAIL("verify", "NativesCache::hashFile", file.filename().string());
+            std::error_code ec;
+            std::uintmax_t size = fs::file_size(file, ec);
+            fs::file_time_type time = fs::last_write_time(file, ec);
+            if (ec)
+                throw std::runtime_error("Native library not found: " + file.string());
+
+            const String path = file.string();
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it = _hashes.find(path);
+                if (it != _hashes.end() && it->second.size == size && it->second.time == time)
+                    return it->second.sha1;
+            }
+
+            // Hashes verified by earlier runs are kept in the shared cache store
+            const String cacheKey = internal::fileCacheKey(file);
+            std::optional<String> stored = CacheStore::shared().get("sha1", cacheKey);
+            String sha1 = stored ? std::move(*stored) : cnt::Sha1::hash_file(file);
+            if (!stored)
+                CacheStore::shared().put("sha1", cacheKey, sha1);
+            std::lock_guard<std::mutex> lock(_mutex);
+            _hashes[path] = FileHash{size, time, sha1};
+            return sha1;
+        }
+
+        String NativesCache::key(const NativeLibrary &library)
+        {
+            std::vector<String> exclude = library.exclude;
+            std::sort(exclude.begin(), exclude.end());
+
+            String material = library.sha1.empty() ? _hashFile(library.jar) : library.sha1;
+            for (const auto &prefix : exclude)
+                material += '\n' + prefix;
+            return cnt::Sha1::hash(material);
+        }
+
+        fs::path NativesCache::extract(const fs::path &indexPath, const NativeLibrary &library)
+        {
+            CNT_TRACE_SCOPE_DETAIL("natives", "NativesCache::extract", library.jar.filename().string());
+            const fs::path store = indexPath / "natives";
+            const fs::path target = store / key(library);
+            static Counter &hits = Metrics::shared().counter("cnt_cache_hits_total", "Lookups served from a cache", "cache=\"natives\"");
+            static Counter &misses = Metrics::shared().counter("cnt_cache_misses_total", "Lookups that had to rebuild the entry", "cache=\"natives\"");
+            if (fs::is_directory(target))
+            {
+                hits.add();
+                return target;
+            }
+            misses.add();
+
+            if (!fs::exists(library.jar))
+                throw std::runtime_error("Native library not found: " + library.jar.string());
+
+            // The key trusts the profile's SHA-1, so a corrupt or partial jar must
+            // not be stored under it; the hash is kept per (path, size, mtime)
+            if (!library.sha1.empty())
+            {
+                String expected = library.sha1;
+                std::transform(expected.begin(), expected.end(), expected.begin(), [](unsigned char c)
+                               { return static_cast<char>(std::tolower(c)); });
+                if (_hashFile(library.jar) != expected)
+                    throw std::runtime_error("Native library does not match its SHA-1: " + library.jar.string());
+            }
+
+            // Extract next to the final place and publish with one rename, so a
+            // crashed or concurrent extraction never leaves a partial directory
+            static std::atomic<unsigned long long> sequence{0};
+#ifdef _WIN32
+            const auto pid = ::_getpid();
+#else
+            const auto pid = ::getpid();
+#endif
+            const fs::path temporary = store / (".tmp-" + std::to_string(pid) + '-' + std::to_string(sequence.fetch_add(1, std::memory_order_relaxed)));
+            try
+            {
+                internal::extractZip(library.jar, temporary, library.exclude);
+            }
+            catch (...)
+            {
+                std::error_code ec;
+                fs::remove_all(temporary, ec);
+                throw;
+            }
+
+            std::error_code ec;
+            fs::rename(temporary, target, ec);
+            if (ec)
+            {
+                // Someone else published the same key first
+                fs::remove_all(temporary, ec);
+                if (!fs::is_directory(target))
+                    throw std::runtime_error("Cannot store natives: " + target.string());
+            }
+            return target;
+        }
+
+        void NativesCache::prepare(const fs::path &indexPath, const String &id, const fs::path &target)
+        {
+            CNT_TRACE_SCOPE_DETAIL("natives", "NativesCache::prepare", id);
+            const fs::path versionsDir = indexPath / "versions";
+
+            auto build = [&](const std::vector<std::unique_ptr<Config>> &chain)
+            {
+                std::vector<NativeLibrary> libraries = internal::resolveNatives(chain, indexPath);
+                std::vector<String> keys;
+                keys.reserve(libraries.size());
+                for (const auto &library : libraries)
+                    keys.push_back(key(library));
+
+                cnt::Sha1 combined;
+                for (const auto &libraryKey : keys)
+                    combined.update(libraryKey + '\n');
+                const String directoryKey = combined.hex_digest();
+
+                // The stamp records what the directory was built from, so a warm
+                // launch in a new process only compares keys
+                const fs::path stamp = target.parent_path() / ("." + target.filename().string() + ".key");
+                String current;
+                {
+                    std::ifstream in(stamp);
+                    std::getline(in, current);
+                }
+
+                if (current != directoryKey || !fs::exists(target))
+                {
+                    // Each jar is already extracted on all cores, one at a time
+                    std::vector<fs::path> sources;
+                    sources.reserve(libraries.size());
+                    for (const auto &library : libraries)
+                        sources.push_back(extract(indexPath, library));
+
+                    std::error_code ec;
+                    fs::remove(stamp, ec);
+                    fs::remove_all(target, ec);
+                    fs::create_directories(target.parent_path());
+
+                    bool linked = false;
+    #ifndef _WIN32
+                    if (sources.size() == 1)
+                    {
+                        fs::create_directory_symlink(fs::absolute(sources.front()), target, ec);
+                        linked = !ec;
+                    }
+    #endif
+                    if (!linked)
+                    {
+                        // Later jars win on name clashes, like extracting them in order
+                        fs::create_directories(target);
+                        for (const auto &source : sources)
+                        {
+                            for (auto it = fs::recursive_directory_iterator(source); it != fs::recursive_directory_iterator(); ++it)
+                            {
+                                fs::path destination = target / fs::relative(it->path(), source);
+                                if (it->is_directory())
+                                    fs::create_directories(destination);
+                                else
+                                    internal::cloneFile(it->path(), destination, true, true);
+                            }
+                        }
+                    }
+
+                    std::ofstream out(stamp, std::ios::trunc);
+                    out << directoryKey << '\n';
+                }
+
+                return std::make_shared<const String>(directoryKey);
+            };
+
+            // A directory removed behind the cache's back is rebuilt even if the profile did not change
+            _prepared.get(target.string(), versionsDir, id, build, fs::exists(target));
+        }
+
+        void NativesCache::clear()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _hashes.clear();
+            }
+            _prepared.clear();
+        }
+    } // namespace minecraft
+
+} // namespace cnt
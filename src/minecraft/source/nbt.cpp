@@ -0,0 +1,953 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/nbt.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/nbt.hpp>
+#include <minecraft/zip.hpp>
+#include <minecraft/lib/inflate.hpp>
+#include <minecraft/lib/deflate.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            static std::uint16_t readBigEndian16(const std::uint8_t *p)
+            {
+                return static_cast<std::uint16_t>(p[0] << 8 | p[1]);
+            }
+
+            static std::uint32_t readBigEndian32(const std::uint8_t *p)
+            {
+                return (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) | (std::uint32_t(p[2]) << 8) | std::uint32_t(p[3]);
+            }
+
+            static std::uint64_t readBigEndian64(const std::uint8_t *p)
+            {
+                return (std::uint64_t(readBigEndian32(p)) << 32) | readBigEndian32(p + 4);
+            }
+
+            // Width of a tag whose payload has a fixed size, 0 for the others
+            static std::size_t fixedNbtWidth(NbtType type)
+            {
+                switch (type)
+                {
+                case NbtType::Byte:
+                    return 1;
+                case NbtType::Short:
+                    return 2;
+                case NbtType::Int:
+                case NbtType::Float:
+                    return 4;
+                case NbtType::Long:
+                case NbtType::Double:
+                    return 8;
+                default:
+                    return 0;
+                }
+            }
+
+            std::uint32_t adler32(const std::uint8_t *data, std::size_t size, std::uint32_t adler)
+            {
+                std::uint32_t a = adler & 0xffff, b = adler >> 16;
+                while (size > 0)
+                {
+                    // 5552 bytes is the most that cannot overflow before the modulo
+                    std::size_t block = std::min<std::size_t>(size, 5552);
+                    size -= block;
+                    while (block--)
+                    {
+                        a += *data++;
+                        b += a;
+                    }
+                    a %= 65521;
+                    b %= 65521;
+                }
+                return b << 16 | a;
+            }
+
+            NbtCompression detectNbtCompression(const std::uint8_t *data, std::size_t size)
+            {
+                if (size >= 2 && data[0] == 0x1f && data[1] == 0x8b)
+                    return NbtCompression::GZip;
+                if (size >= 2 && (data[0] & 0x0f) == 8 && ((data[0] << 8) | data[1]) % 31 == 0)
+                    return NbtCompression::Zlib;
+                return NbtCompression::None;
+            }
+
+            void inflateGzip(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out, std::size_t limit)
+            {
+                if (size < 18 || data[0] != 0x1f || data[1] != 0x8b || data[2] != 8)
+                    throw std::runtime_error("Invalid gzip data");
+                std::uint8_t flags = data[3];
+                std::size_t pos = 10;
+                if (flags & 4)
+                    pos += 2 + (data[pos] | (std::size_t(data[pos + 1]) << 8));
+                for (int field : {8, 16})
+                {
+                    if (!(flags & field))
+                        continue;
+                    while (pos < size && data[pos] != 0)
+                        pos++;
+                    pos++;
+                }
+                if (flags & 2)
+                    pos += 2;
+                if (pos >= size)
+                    throw std::runtime_error("Invalid gzip data");
+
+                std::size_t start = out.size();
+                pos += cnt::Inflater::inflate(data + pos, size - pos, out, limit);
+                if (pos + 8 > size)
+                    throw std::runtime_error("Truncated gzip data");
+                std::uint32_t crc = data[pos] | (std::uint32_t(data[pos + 1]) << 8) | (std::uint32_t(data[pos + 2]) << 16) | (std::uint32_t(data[pos + 3]) << 24);
+                if (crc32(out.data() + start, out.size() - start) != crc)
+                    throw std::runtime_error("gzip checksum mismatch");
+            }
+
+            void inflateZlib(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out, std::size_t limit)
+            {
+                if (detectNbtCompression(data, size) != NbtCompression::Zlib || (data[1] & 0x20))
+                    throw std::runtime_error("Invalid zlib data");
+
+                std::size_t start = out.size();
+                std::size_t pos = 2 + cnt::Inflater::inflate(data + 2, size - 2, out, limit);
+                // Some writers leave the trailer out, the deflate stream is self-terminating
+                if (pos + 4 <= size && adler32(out.data() + start, out.size() - start) != readBigEndian32(data + pos))
+                    throw std::runtime_error("zlib checksum mismatch");
+            }
+
+            void deflateGzip(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out)
+            {
+                static const std::uint8_t header[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+                out.insert(out.end(), header, header + sizeof(header));
+                cnt::Deflater::deflate(data, size, out);
+                std::uint32_t crc = crc32(data, size);
+                std::uint32_t length = static_cast<std::uint32_t>(size);
+                for (std::uint32_t value : {crc, length})
+                {
+                    for (int shift = 0; shift < 32; shift += 8)
+                        out.push_back(static_cast<std::uint8_t>(value >> shift));
+                }
+            }
+
+            void deflateZlib(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out)
+            {
+                out.push_back(0x78);
+                out.push_back(0x9c);
+                cnt::Deflater::deflate(data, size, out);
+                std::uint32_t adler = adler32(data, size);
+                for (int shift = 24; shift >= 0; shift -= 8)
+                    out.push_back(static_cast<std::uint8_t>(adler >> shift));
+            }
+        }
+
+        std::int64_t NbtArrayView::operator[](std::size_t index) const
+        {
+            switch (_type)
+            {
+            case NbtType::IntArray:
+                return static_cast<std::int32_t>(internal::readBigEndian32(_data + index * 4));
+            case NbtType::LongArray:
+                return static_cast<std::int64_t>(internal::readBigEndian64(_data + index * 8));
+            default:
+                return static_cast<std::int8_t>(_data[index]);
+            }
+        }
+
+        NbtReader::NbtReader(const void *data, std::size_t size)
+            : _data(static_cast<const std::uint8_t *>(data)), _size(size) {}
+
+        void NbtReader::_need(std::size_t count) const
+        {
+            if (count > _size - _pos)
+                throw std::runtime_error("Truncated NBT data");
+        }
+
+        std::uint8_t NbtReader::_byte()
+        {
+            _need(1);
+            return _data[_pos++];
+        }
+
+        std::int32_t NbtReader::_int()
+        {
+            _need(4);
+            std::int32_t value = static_cast<std::int32_t>(internal::readBigEndian32(_data + _pos));
+            _pos += 4;
+            return value;
+        }
+
+        std::string_view NbtReader::_string()
+        {
+            _need(2);
+            std::size_t length = internal::readBigEndian16(_data + _pos);
+            _pos += 2;
+            _need(length);
+            std::string_view value(reinterpret_cast<const char *>(_data + _pos), length);
+            _pos += length;
+            return value;
+        }
+
+        NbtReader::Token NbtReader::_tag(NbtType type)
+        {
+            _type = type;
+            _payload = _data + _pos;
+            _count = 0;
+
+            auto push = [this](NbtType kind, NbtType element, std::int32_t remaining)
+            {
+                if (_depth == MaxDepth)
+                    throw std::runtime_error("NBT nested too deeply");
+                _stack[_depth++] = Frame{kind, element, remaining};
+            };
+            auto array = [this](std::size_t width)
+            {
+                std::int32_t count = _int();
+                if (count < 0)
+                    throw std::runtime_error("Invalid NBT array length");
+                _need(static_cast<std::size_t>(count) * width);
+                _payload = _data + _pos;
+                _pos += static_cast<std::size_t>(count) * width;
+                _count = count;
+            };
+
+            switch (type)
+            {
+            case NbtType::Byte:
+            case NbtType::Short:
+            case NbtType::Int:
+            case NbtType::Long:
+            case NbtType::Float:
+            case NbtType::Double:
+            {
+                std::size_t width = internal::fixedNbtWidth(type);
+                _need(width);
+                _pos += width;
+                return Token::Value;
+            }
+            case NbtType::ByteArray:
+                array(1);
+                return Token::Value;
+            case NbtType::IntArray:
+                array(4);
+                return Token::Value;
+            case NbtType::LongArray:
+                array(8);
+                return Token::Value;
+            case NbtType::String:
+            {
+                std::string_view value = _string();
+                _payload = reinterpret_cast<const std::uint8_t *>(value.data());
+                _count = static_cast<std::int32_t>(value.size());
+                return Token::Value;
+            }
+            case NbtType::List:
+            {
+                std::uint8_t element = _byte();
+                std::int32_t count = _int();
+                if (element > static_cast<std::uint8_t>(NbtType::LongArray) || count < 0 ||
+                    (element == 0 && count > 0))
+                    throw std::runtime_error("Invalid NBT list");
+                _element = static_cast<NbtType>(element);
+                _count = count;
+                push(NbtType::List, _element, count);
+                return Token::BeginList;
+            }
+            case NbtType::Compound:
+                push(NbtType::Compound, NbtType::End, 0);
+                return Token::BeginCompound;
+            default:
+                throw std::runtime_error("Invalid NBT tag type " + std::to_string(static_cast<int>(type)));
+            }
+        }
+
+        NbtReader::Token NbtReader::next()
+        {
+            if (!_started)
+            {
+                _started = true;
+                NbtType type = static_cast<NbtType>(_byte());
+                if (type == NbtType::End)
+                    return _token = Token::End;
+                _name = _string();
+                return _token = _tag(type);
+            }
+
+            _name = std::string_view();
+            if (_depth == 0)
+            {
+                _type = NbtType::End;
+                return _token = Token::End;
+            }
+
+            Frame &top = _stack[_depth - 1];
+            if (top.type == NbtType::Compound)
+            {
+                NbtType type = static_cast<NbtType>(_byte());
+                if (type == NbtType::End)
+                {
+                    _depth--;
+                    _type = NbtType::Compound;
+                    return _token = Token::EndCompound;
+                }
+                _name = _string();
+                return _token = _tag(type);
+            }
+
+            if (top.remaining == 0)
+            {
+                _depth--;
+                _type = NbtType::List;
+                return _token = Token::EndList;
+            }
+            top.remaining--;
+            return _token = _tag(top.element);
+        }
+
+        std::int64_t NbtReader::integer() const
+        {
+            switch (_type)
+            {
+            case NbtType::Byte:
+                return static_cast<std::int8_t>(_payload[0]);
+            case NbtType::Short:
+                return static_cast<std::int16_t>(internal::readBigEndian16(_payload));
+            case NbtType::Int:
+                return static_cast<std::int32_t>(internal::readBigEndian32(_payload));
+            case NbtType::Long:
+                return static_cast<std::int64_t>(internal::readBigEndian64(_payload));
+            case NbtType::Float:
+            case NbtType::Double:
+                return static_cast<std::int64_t>(number());
+            default:
+                throw std::runtime_error("NBT tag is not a number");
+            }
+        }
+
+        double NbtReader::number() const
+        {
+            if (_type == NbtType::Float)
+            {
+                std::uint32_t bits = internal::readBigEndian32(_payload);
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+            if (_type == NbtType::Double)
+            {
+                std::uint64_t bits = internal::readBigEndian64(_payload);
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+            return static_cast<double>(integer());
+        }
+
+        std::string_view NbtReader::string() const
+        {
+            if (_type != NbtType::String)
+                throw std::runtime_error("NBT tag is not a string");
+            return std::string_view(reinterpret_cast<const char *>(_payload), static_cast<std::size_t>(_count));
+        }
+
+        NbtArrayView NbtReader::array() const
+        {
+            if (_type != NbtType::ByteArray && _type != NbtType::IntArray && _type != NbtType::LongArray)
+                throw std::runtime_error("NBT tag is not an array");
+            return NbtArrayView(_type, _payload, static_cast<std::size_t>(_count));
+        }
+
+        void NbtReader::skip()
+        {
+            if (_token != Token::BeginCompound && _token != Token::BeginList)
+                return;
+
+            const std::size_t target = _depth - 1;
+            while (_depth > target)
+            {
+                // Lists of numbers are jumped over in one step
+                Frame &top = _stack[_depth - 1];
+                if (top.type == NbtType::List && top.remaining > 0)
+                {
+                    if (std::size_t width = internal::fixedNbtWidth(top.element))
+                    {
+                        _need(static_cast<std::size_t>(top.remaining) * width);
+                        _pos += static_cast<std::size_t>(top.remaining) * width;
+                        top.remaining = 0;
+                    }
+                }
+                next();
+            }
+        }
+
+        bool NbtReader::seek(std::string_view path)
+        {
+            if (!_started)
+            {
+                if (next() != Token::BeginCompound)
+                    return false;
+            }
+            else if (_token != Token::BeginCompound)
+            {
+                return false;
+            }
+
+            for (;;)
+            {
+                std::size_t dot = path.find('.');
+                std::string_view key = path.substr(0, dot);
+                path = dot == std::string_view::npos ? std::string_view() : path.substr(dot + 1);
+
+                for (;;)
+                {
+                    Token token = next();
+                    if (token == Token::EndCompound || token == Token::End)
+                        return false;
+                    if (_name == key)
+                    {
+                        if (dot == std::string_view::npos)
+                            return true;
+                        if (token != Token::BeginCompound)
+                            return false;
+                        break;
+                    }
+                    if (token == Token::BeginCompound || token == Token::BeginList)
+                        skip();
+                }
+            }
+        }
+
+        NbtNode::Iterator &NbtNode::Iterator::operator++()
+        {
+            _index = _document->_tags[_index].end;
+            return *this;
+        }
+
+        NbtType NbtNode::type() const
+        {
+            return _document ? _document->_tags[_index].type : NbtType::End;
+        }
+
+        std::string_view NbtNode::name() const
+        {
+            return _document ? _document->_tags[_index].name : std::string_view();
+        }
+
+        std::int64_t NbtNode::asInteger(std::int64_t fallback) const
+        {
+            switch (type())
+            {
+            case NbtType::Byte:
+            case NbtType::Short:
+            case NbtType::Int:
+            case NbtType::Long:
+                return _document->_tags[_index].integer;
+            case NbtType::Float:
+            case NbtType::Double:
+                return static_cast<std::int64_t>(_document->_tags[_index].number);
+            default:
+                return fallback;
+            }
+        }
+
+        double NbtNode::asNumber(double fallback) const
+        {
+            switch (type())
+            {
+            case NbtType::Byte:
+            case NbtType::Short:
+            case NbtType::Int:
+            case NbtType::Long:
+                return static_cast<double>(_document->_tags[_index].integer);
+            case NbtType::Float:
+            case NbtType::Double:
+                return _document->_tags[_index].number;
+            default:
+                return fallback;
+            }
+        }
+
+        std::string_view NbtNode::asString(std::string_view fallback) const
+        {
+            if (type() != NbtType::String)
+                return fallback;
+            const auto &tag = _document->_tags[_index];
+            return std::string_view(reinterpret_cast<const char *>(tag.data), tag.count);
+        }
+
+        NbtArrayView NbtNode::asArray() const
+        {
+            NbtType kind = type();
+            if (kind != NbtType::ByteArray && kind != NbtType::IntArray && kind != NbtType::LongArray)
+                return NbtArrayView();
+            const auto &tag = _document->_tags[_index];
+            return NbtArrayView(kind, tag.data, tag.count);
+        }
+
+        std::size_t NbtNode::size() const
+        {
+            return _document ? _document->_tags[_index].count : 0;
+        }
+
+        NbtType NbtNode::elementType() const
+        {
+            return type() == NbtType::List ? _document->_tags[_index].element : NbtType::End;
+        }
+
+        NbtNode NbtNode::operator[](std::string_view key) const
+        {
+            if (type() != NbtType::Compound)
+                return NbtNode();
+            const auto &tags = _document->_tags;
+            for (std::uint32_t child = _index + 1; child < tags[_index].end; child = tags[child].end)
+            {
+                if (tags[child].name == key)
+                    return NbtNode(_document, child);
+            }
+            return NbtNode();
+        }
+
+        NbtNode NbtNode::at(std::size_t index) const
+        {
+            if (type() != NbtType::List || index >= size())
+                return NbtNode();
+            const auto &tags = _document->_tags;
+            NbtType element = tags[_index].element;
+            // Elements without children take one slot each
+            if (element != NbtType::Compound && element != NbtType::List)
+                return NbtNode(_document, _index + 1 + static_cast<std::uint32_t>(index));
+            std::uint32_t child = _index + 1;
+            while (index--)
+                child = tags[child].end;
+            return NbtNode(_document, child);
+        }
+
+        NbtNode NbtNode::find(std::string_view path) const
+        {
+            NbtNode node = *this;
+            while (node && !path.empty())
+            {
+                std::size_t dot = path.find('.');
+                node = node[path.substr(0, dot)];
+                path = dot == std::string_view::npos ? std::string_view() : path.substr(dot + 1);
+            }
+            return node;
+        }
+
+        NbtNode::Iterator NbtNode::begin() const
+        {
+            NbtType kind = type();
+            if (kind != NbtType::Compound && kind != NbtType::List)
+                return end();
+            return Iterator(_document, _index + 1);
+        }
+
+        NbtNode::Iterator NbtNode::end() const
+        {
+            return _document ? Iterator(_document, _document->_tags[_index].end) : Iterator(nullptr, 0);
+        }
+
+        void NbtDocument::_build()
+        {
+            NbtReader reader(_bytes.data(), _bytes.size());
+            std::vector<std::uint32_t> open;
+            // Real documents average well over 16 bytes per tag
+            _tags.reserve(_bytes.size() / 16 + 16);
+
+            for (;;)
+            {
+                NbtReader::Token token = reader.next();
+                if (token == NbtReader::Token::End)
+                    break;
+                if (token == NbtReader::Token::EndCompound || token == NbtReader::Token::EndList)
+                {
+                    _tags[open.back()].end = static_cast<std::uint32_t>(_tags.size());
+                    open.pop_back();
+                    continue;
+                }
+
+                Tag tag;
+                tag.type = reader.type();
+                tag.element = NbtType::End;
+                tag.count = 0;
+                tag.end = static_cast<std::uint32_t>(_tags.size() + 1);
+                tag.name = reader.name();
+                tag.integer = 0;
+                switch (tag.type)
+                {
+                case NbtType::Byte:
+                case NbtType::Short:
+                case NbtType::Int:
+                case NbtType::Long:
+                    tag.integer = reader.integer();
+                    break;
+                case NbtType::Float:
+                case NbtType::Double:
+                    tag.number = reader.number();
+                    break;
+                case NbtType::String:
+                {
+                    std::string_view value = reader.string();
+                    tag.data = reinterpret_cast<const std::uint8_t *>(value.data());
+                    tag.count = static_cast<std::uint32_t>(value.size());
+                    break;
+                }
+                case NbtType::ByteArray:
+                case NbtType::IntArray:
+                case NbtType::LongArray:
+                {
+                    NbtArrayView array = reader.array();
+                    tag.data = array.data();
+                    tag.count = static_cast<std::uint32_t>(array.size());
+                    break;
+                }
+                case NbtType::List:
+                    tag.element = reader.elementType();
+                    tag.count = static_cast<std::uint32_t>(reader.listSize());
+                    break;
+                default:
+                    break;
+                }
+
+                if (!open.empty() && _tags[open.back()].type == NbtType::Compound)
+                    _tags[open.back()].count++;
+                if (token == NbtReader::Token::BeginCompound || token == NbtReader::Token::BeginList)
+                    open.push_back(static_cast<std::uint32_t>(_tags.size()));
+                _tags.push_back(tag);
+            }
+            if (_tags.empty() || !open.empty())
+                throw std::runtime_error("Empty or truncated NBT document");
+        }
+
+        NbtDocument NbtDocument::parse(std::vector<std::uint8_t> data)
+        {
+            NbtDocument document;
+            document._compression = internal::detectNbtCompression(data.data(), data.size());
+            switch (document._compression)
+            {
+            case NbtCompression::GZip:
+                document._bytes.reserve(std::min(data.size() * 4, internal::MaxInflatedNbt));
+                internal::inflateGzip(data.data(), data.size(), document._bytes);
+                break;
+            case NbtCompression::Zlib:
+                document._bytes.reserve(std::min(data.size() * 4, internal::MaxInflatedNbt));
+                internal::inflateZlib(data.data(), data.size(), document._bytes);
+                break;
+            default:
+                document._bytes = std::move(data);
+                break;
+            }
+            document._build();
+            return document;
+        }
+
+        NbtDocument NbtDocument::load(const fs::path &path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open())
+                throw std::runtime_error("Cannot open file: " + path.string());
+            std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            return parse(std::move(data));
+        }
+
+        NbtNode NbtDocument::root() const
+        {
+            return _tags.empty() ? NbtNode() : NbtNode(this, 0);
+        }
+
+        NbtWriter::NbtWriter(std::size_t reserve)
+        {
+            _out.reserve(reserve);
+        }
+
+        void NbtWriter::_put(std::uint64_t value, int bytes)
+        {
+            for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8)
+                _out.push_back(static_cast<std::uint8_t>(value >> shift));
+        }
+
+        void NbtWriter::_putString(std::string_view value)
+        {
+            if (value.size() > 0xffff)
+                throw std::logic_error("NBT string longer than 65535 bytes");
+            _put(value.size(), 2);
+            _out.insert(_out.end(), value.begin(), value.end());
+        }
+
+        void NbtWriter::_header(NbtType type, std::string_view name)
+        {
+            if (_stack.empty())
+            {
+                if (_rootWritten)
+                    throw std::logic_error("NBT document already has a root tag");
+                _rootWritten = true;
+                _out.push_back(static_cast<std::uint8_t>(type));
+                _putString(name);
+                return;
+            }
+
+            Frame &top = _stack.back();
+            if (top.type == NbtType::Compound)
+            {
+                _out.push_back(static_cast<std::uint8_t>(type));
+                _putString(name);
+                return;
+            }
+
+            if (type != top.element)
+                throw std::logic_error("NBT list element of the wrong type");
+            if (top.countOffset != 0)
+                top.remaining++;
+            else if (top.remaining-- == 0)
+                throw std::logic_error("More NBT list elements than announced");
+        }
+
+        void NbtWriter::beginCompound(std::string_view name)
+        {
+            _header(NbtType::Compound, name);
+            _stack.push_back(Frame{NbtType::Compound, NbtType::End, 0, 0});
+        }
+
+        void NbtWriter::endCompound()
+        {
+            if (_stack.empty() || _stack.back().type != NbtType::Compound)
+                throw std::logic_error("endCompound without beginCompound");
+            _out.push_back(0);
+            _stack.pop_back();
+        }
+
+        void NbtWriter::beginList(std::string_view name, NbtType element, std::int32_t count)
+        {
+            _header(NbtType::List, name);
+            _out.push_back(static_cast<std::uint8_t>(element));
+            // A list with an unknown size counts up from 0, a known one down to 0
+            std::size_t countOffset = count < 0 ? _out.size() : 0;
+            _put(static_cast<std::uint32_t>(count < 0 ? 0 : count), 4);
+            _stack.push_back(Frame{NbtType::List, element, count < 0 ? 0 : count, countOffset});
+        }
+
+        void NbtWriter::endList()
+        {
+            if (_stack.empty() || _stack.back().type != NbtType::List)
+                throw std::logic_error("endList without beginList");
+            Frame frame = _stack.back();
+            _stack.pop_back();
+            if (frame.countOffset != 0)
+            {
+                for (int i = 0; i < 4; i++)
+                    _out[frame.countOffset + static_cast<std::size_t>(i)] = static_cast<std::uint8_t>(static_cast<std::uint32_t>(frame.remaining) >> (24 - i * 8));
+            }
+            else if (frame.remaining != 0)
+            {
+                throw std::logic_error("Fewer NBT list elements than announced");
+            }
+        }
+
+        void NbtWriter::writeByte(std::string_view name, std::int8_t value)
+        {
+            _header(NbtType::Byte, name);
+            _put(static_cast<std::uint8_t>(value), 1);
+        }
+
+        void NbtWriter::writeShort(std::string_view name, std::int16_t value)
+        {
+            _header(NbtType::Short, name);
+            _put(static_cast<std::uint16_t>(value), 2);
+        }
+
+        void NbtWriter::writeInt(std::string_view name, std::int32_t value)
+        {
+            _header(NbtType::Int, name);
+            _put(static_cast<std::uint32_t>(value), 4);
+        }
+
+        void NbtWriter::writeLong(std::string_view name, std::int64_t value)
+        {
+            _header(NbtType::Long, name);
+            _put(static_cast<std::uint64_t>(value), 8);
+        }
+
+        void NbtWriter::writeFloat(std::string_view name, float value)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            _header(NbtType::Float, name);
+            _put(bits, 4);
+        }
+
+        void NbtWriter::writeDouble(std::string_view name, double value)
+        {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            _header(NbtType::Double, name);
+            _put(bits, 8);
+        }
+
+        void NbtWriter::writeString(std::string_view name, std::string_view value)
+        {
+            _header(NbtType::String, name);
+            _putString(value);
+        }
+
+        void NbtWriter::writeByteArray(std::string_view name, const void *data, std::size_t size)
+        {
+            _header(NbtType::ByteArray, name);
+            _put(size, 4);
+            const std::uint8_t *bytes = static_cast<const std::uint8_t *>(data);
+            _out.insert(_out.end(), bytes, bytes + size);
+        }
+
+        void NbtWriter::writeIntArray(std::string_view name, const std::int32_t *data, std::size_t size)
+        {
+            _header(NbtType::IntArray, name);
+            _put(size, 4);
+            _out.reserve(_out.size() + size * 4);
+            for (std::size_t i = 0; i < size; i++)
+                _put(static_cast<std::uint32_t>(data[i]), 4);
+        }
+
+        void NbtWriter::writeLongArray(std::string_view name, const std::int64_t *data, std::size_t size)
+        {
+            _header(NbtType::LongArray, name);
+            _put(size, 4);
+            _out.reserve(_out.size() + size * 8);
+            for (std::size_t i = 0; i < size; i++)
+                _put(static_cast<std::uint64_t>(data[i]), 8);
+        }
+
+        void NbtWriter::write(const NbtNode &node)
+        {
+            write(node.name(), node);
+        }
+
+        void NbtWriter::write(std::string_view name, const NbtNode &node)
+        {
+            switch (node.type())
+            {
+            case NbtType::Byte:
+                writeByte(name, static_cast<std::int8_t>(node.asInteger()));
+                break;
+            case NbtType::Short:
+                writeShort(name, static_cast<std::int16_t>(node.asInteger()));
+                break;
+            case NbtType::Int:
+                writeInt(name, static_cast<std::int32_t>(node.asInteger()));
+                break;
+            case NbtType::Long:
+                writeLong(name, node.asInteger());
+                break;
+            case NbtType::Float:
+                writeFloat(name, static_cast<float>(node.asNumber()));
+                break;
+            case NbtType::Double:
+                writeDouble(name, node.asNumber());
+                break;
+            case NbtType::String:
+                writeString(name, node.asString());
+                break;
+            case NbtType::ByteArray:
+            case NbtType::IntArray:
+            case NbtType::LongArray:
+            {
+                // Already big-endian, copied as is
+                NbtArrayView array = node.asArray();
+                std::size_t width = node.type() == NbtType::ByteArray ? 1 : node.type() == NbtType::IntArray ? 4 : 8;
+                _header(node.type(), name);
+                _put(array.size(), 4);
+                _out.insert(_out.end(), array.data(), array.data() + array.size() * width);
+                break;
+            }
+            case NbtType::List:
+                beginList(name, node.elementType(), static_cast<std::int32_t>(node.size()));
+                for (const NbtNode child : node)
+                    write(child);
+                endList();
+                break;
+            case NbtType::Compound:
+                beginCompound(name);
+                for (const NbtNode child : node)
+                    write(child);
+                endCompound();
+                break;
+            default:
+                throw std::logic_error("Cannot write an invalid NBT node");
+            }
+        }
+
+        std::vector<std::uint8_t> NbtWriter::finish(NbtCompression compression)
+        {
+            if (!_stack.empty() || !_rootWritten)
+                throw std::logic_error("Unfinished NBT document");
+
+            std::vector<std::uint8_t> result;
+            switch (compression)
+            {
+            case NbtCompression::GZip:
+                result.reserve(_out.size() / 2 + 32);
+                internal::deflateGzip(_out.data(), _out.size(), result);
+                break;
+            case NbtCompression::Zlib:
+                result.reserve(_out.size() / 2 + 32);
+                internal::deflateZlib(_out.data(), _out.size(), result);
+                break;
+            default:
+                result = _out;
+                break;
+            }
+            return result;
+        }
+
+        void NbtWriter::save(const fs::path &path, NbtCompression compression)
+        {
+            const std::vector<std::uint8_t> data = finish(compression);
+
+            // The game reads these files on start, never leave one half written
+            fs::path temporary = path;
+            temporary += ".tmp";
+            {
+                std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+                if (!file.is_open())
+                    throw std::runtime_error("Cannot write file: " + temporary.string());
+                file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+                file.close();
+                if (!file)
+                    throw std::runtime_error("Cannot write file: " + temporary.string());
+            }
+            std::error_code ec;
+            fs::rename(temporary, path, ec);
+            if (ec)
+            {
+                fs::remove(temporary, ec);
+                throw std::runtime_error("Cannot replace file: " + path.string());
+            }
+        }
+    } // namespace minecraft
+
+} // namespace cnt
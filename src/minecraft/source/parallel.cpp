@@ -0,0 +1,91 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/parallel.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/parallel.hpp>
+#include <minecraft/scheduler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            void parallelFor(std::size_t count, const std::function<void(std::size_t)> &fn, unsigned int threads)
+            {
+                if (count == 0)
+                    return;
+
+                Scheduler &scheduler = Scheduler::shared();
+                if (threads == 0)
+                    threads = scheduler.workers(TaskPool::Cpu) + 1;
+                threads = static_cast<unsigned int>(std::min<std::size_t>(threads, count));
+
+                std::atomic<std::size_t> next{0};
+                TaskGroup group(TaskPool::Cpu, scheduler);
+
+                auto runner = [&]()
+                {
+                    while (!group.cancelled())
+                    {
+                        std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+                        if (index >= count)
+                            return;
+                        fn(index);
+                    }
+                };
+
+                for (unsigned int i = 1; i < threads; i++)
+                    group.run(runner);
+
+                // The calling thread is one of the runners
+                std::exception_ptr error;
+                try
+                {
+                    runner();
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                    group.cancel();
+                }
+                try
+                {
+                    group.wait();
+                }
+                catch (...)
+                {
+                    if (!error)
+                        error = std::current_exception();
+                }
+
+                if (error)
+                    std::rethrow_exception(error);
+            }
+        }
+    } // namespace minecraft
+
+} // namespace cnt
@@ -0,0 +1,539 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/process.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <minecraft/process.hpp>
+#include <minecraft/lib/trace.hpp>
+
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <cerrno>
+
+extern char **environ;
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+#ifndef _WIN32
+        void AttachToCgroup(const fs::path &group, int pid)
+        {
+            int fd = ::open((group / "cgroup.procs").c_str(), O_WRONLY | O_CLOEXEC);
+            if (fd < 0)
+                throw std::runtime_error("Cannot open cgroup " + group.string() + ": " + std::strerror(errno));
+
+            String value = std::to_string(pid);
+            ssize_t n = ::write(fd, value.data(), value.size());
+            int error = errno;
+            ::close(fd);
+            if (n != static_cast<ssize_t>(value.size()))
+                throw std::runtime_error("Cannot move process " + value + " to cgroup " + group.string() + ": " + std::strerror(error));
+        }
+
+        GameProcess::GameProcess() : _exit(_promise.get_future().share()) {}
+
+        GameProcess::~GameProcess()
+        {
+            for (int fd : {_pidfd, _stdin, _stdout, _stderr})
+            {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        }
+
+        bool GameProcess::sendInput(std::string_view data)
+        {
+            std::lock_guard<std::mutex> lock(_inputMutex);
+            if (_stdin < 0)
+                return false;
+
+            // A child that closed its stdin raises SIGPIPE, which would kill the
+            // launcher: block it on this thread and swallow the one we caused
+            sigset_t pipeSignal, previous, pending;
+            sigemptyset(&pipeSignal);
+            sigaddset(&pipeSignal, SIGPIPE);
+            sigpending(&pending);
+            bool alreadyPending = sigismember(&pending, SIGPIPE) == 1;
+            pthread_sigmask(SIG_BLOCK, &pipeSignal, &previous);
+
+            bool ok = true;
+            while (!data.empty())
+            {
+                ssize_t n = ::write(_stdin, data.data(), data.size());
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    if (errno == EPIPE && !alreadyPending)
+                    {
+                        const timespec none{0, 0};
+                        while (::sigtimedwait(&pipeSignal, nullptr, &none) < 0 && errno == EINTR)
+                        {
+                        }
+                    }
+                    ok = false;
+                    break;
+                }
+                data.remove_prefix(static_cast<std::size_t>(n));
+            }
+
+            pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+            return ok;
+        }
+
+        // The child leads its own process group (see spawn), signal the whole group
+        // so wrapper scripts take their children down with them
+        void GameProcess::terminate()
+        {
+            if (running())
+                ::kill(-_pid, SIGTERM);
+        }
+
+        void GameProcess::kill()
+        {
+            if (running())
+                ::kill(-_pid, SIGKILL);
+        }
+
+        ProcessReactor::ProcessReactor()
+        {
+            _epoll = ::epoll_create1(EPOLL_CLOEXEC);
+            _wakeup = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (_epoll < 0 || _wakeup < 0)
+                throw std::runtime_error("Failed to create process reactor");
+
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = 0;
+            ::epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeup, &event);
+
+            _thread = std::thread([this]
+                                  { _run(); });
+        }
+
+        ProcessReactor::~ProcessReactor()
+        {
+            _stopping.store(true);
+            std::uint64_t one = 1;
+            if (::write(_wakeup, &one, sizeof(one)) < 0)
+            {
+                // The loop also wakes up on its polling timeout
+            }
+            if (_thread.joinable())
+                _thread.join();
+            ::close(_wakeup);
+            ::close(_epoll);
+        }
+
+        ProcessReactor &ProcessReactor::shared()
+        {
+            static ProcessReactor reactor;
+            return reactor;
+        }
+
+        std::size_t ProcessReactor::size() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _processes.size();
+        }
+
+        void ProcessReactor::_register(const std::shared_ptr<GameProcess> &process, int fd, int kind,
+                                       std::vector<std::pair<std::uint64_t, Registration>> &registrations)
+        {
+            std::uint64_t token;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                token = _nextToken++;
+            }
+
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = token;
+            if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) != 0)
+                throw std::runtime_error("Failed to watch process descriptor");
+            registrations.emplace_back(token, Registration{process, fd, kind});
+        }
+
+        std::shared_ptr<GameProcess> ProcessReactor::spawn(char *const *argv, const ProcessOptions &options)
+        {
+            if (argv == nullptr || argv[0] == nullptr)
+                throw std::runtime_error("Cannot spawn an empty command");
+
+            CNT_TRACE_SCOPE_DETAIL("launch", "ProcessReactor::spawn", argv[0]);
+
+            int in[2], out[2], err[2];
+            if (::pipe2(in, O_CLOEXEC) != 0)
+                throw std::runtime_error("Failed to create pipe");
+            if (::pipe2(out, O_CLOEXEC) != 0)
+            {
+                ::close(in[0]), ::close(in[1]);
+                throw std::runtime_error("Failed to create pipe");
+            }
+            if (::pipe2(err, O_CLOEXEC) != 0)
+            {
+                ::close(in[0]), ::close(in[1]), ::close(out[0]), ::close(out[1]);
+                throw std::runtime_error("Failed to create pipe");
+            }
+
+            // Environment: inherited entries not overridden by the options, then the overrides
+            std::vector<char *> envp;
+            if (!options.clearEnvironment)
+            {
+                for (char **entry = environ; entry != nullptr && *entry != nullptr; entry++)
+                {
+                    const char *equals = std::strchr(*entry, '=');
+                    std::size_t keyLength = equals ? static_cast<std::size_t>(equals - *entry) : std::strlen(*entry);
+                    bool overridden = std::any_of(options.environment.begin(), options.environment.end(), [&](const String &value)
+                                                  { return value.size() > keyLength && value[keyLength] == '=' &&
+                                                           value.compare(0, keyLength, *entry, keyLength) == 0; });
+                    if (!overridden)
+                        envp.push_back(*entry);
+                }
+            }
+            for (const auto &value : options.environment)
+                envp.push_back(const_cast<char *>(value.c_str()));
+            envp.push_back(nullptr);
+
+            posix_spawn_file_actions_t actions;
+            posix_spawn_file_actions_init(&actions);
+            posix_spawn_file_actions_adddup2(&actions, in[0], STDIN_FILENO);
+            posix_spawn_file_actions_adddup2(&actions, out[1], STDOUT_FILENO);
+            posix_spawn_file_actions_adddup2(&actions, err[1], STDERR_FILENO);
+            if (!options.workingDirectory.empty())
+            {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+                posix_spawn_file_actions_addchdir_np(&actions, options.workingDirectory.c_str());
+#else
+                posix_spawn_file_actions_destroy(&actions);
+                for (int fd : {in[0], in[1], out[0], out[1], err[0], err[1]})
+                    ::close(fd);
+                throw std::runtime_error("Working directory is not supported by posix_spawn on this platform");
+#endif
+            }
+
+            // Own process group, so a Ctrl+C in the launcher does not take every game down
+            posix_spawnattr_t attributes;
+            posix_spawnattr_init(&attributes);
+            sigset_t signals;
+            sigemptyset(&signals);
+            posix_spawnattr_setsigmask(&attributes, &signals);
+            sigaddset(&signals, SIGPIPE);
+            posix_spawnattr_setsigdefault(&attributes, &signals);
+            posix_spawnattr_setpgroup(&attributes, 0);
+            posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETPGROUP);
+
+            pid_t pid = -1;
+            int status = ::posix_spawnp(&pid, argv[0], &actions, &attributes, argv, envp.data());
+            posix_spawn_file_actions_destroy(&actions);
+            posix_spawnattr_destroy(&attributes);
+
+            ::close(in[0]);
+            ::close(out[1]);
+            ::close(err[1]);
+            if (status != 0)
+            {
+                ::close(in[1]), ::close(out[0]), ::close(err[0]);
+                throw std::runtime_error("Failed to spawn " + String(argv[0]) + ": " + std::strerror(status));
+            }
+
+            if (!options.cgroup.empty())
+            {
+                // posix_spawn cannot place the child before exec, so a few
+                // milliseconds of startup are accounted to our group
+                try
+                {
+                    AttachToCgroup(options.cgroup, pid);
+                }
+                catch (...)
+                {
+                    ::kill(pid, SIGKILL);
+                    ::waitpid(pid, nullptr, 0);
+                    ::close(in[1]), ::close(out[0]), ::close(err[0]);
+                    throw;
+                }
+            }
+
+            auto process = std::make_shared<GameProcess>();
+            process->_pid = pid;
+            process->_stdin = in[1];
+            process->_stdout = out[0];
+            process->_stderr = err[0];
+            process->_output = options.output;
+            process->_onExit = options.onExit;
+            ::fcntl(out[0], F_SETFL, ::fcntl(out[0], F_GETFL) | O_NONBLOCK);
+            ::fcntl(err[0], F_SETFL, ::fcntl(err[0], F_GETFL) | O_NONBLOCK);
+
+#ifdef SYS_pidfd_open
+            // A pidfd turns process exit into an epoll event (Linux 5.3+)
+            process->_pidfd = static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+#endif
+
+            // Watch every descriptor before the process is published; events for tokens
+            // that are not registered yet are skipped and come back on the next wait
+            std::vector<std::pair<std::uint64_t, Registration>> registrations;
+            try
+            {
+                _register(process, process->_stdout, 0, registrations);
+                _register(process, process->_stderr, 1, registrations);
+                if (process->_pidfd >= 0)
+                    _register(process, process->_pidfd, 2, registrations);
+            }
+            catch (...)
+            {
+                // Nothing else knows the child yet, so it is ours to reap
+                for (const auto &registration : registrations)
+                    ::epoll_ctl(_epoll, EPOLL_CTL_DEL, registration.second.fd, nullptr);
+                ::kill(pid, SIGKILL);
+                ::waitpid(pid, nullptr, 0);
+                throw;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (auto &registration : registrations)
+                    _registrations.emplace(registration.first, std::move(registration.second));
+                _processes.push_back(process);
+            }
+            return process;
+        }
+
+        bool ProcessReactor::_drain(GameProcess &process, int fd, ProcessStream stream, std::vector<char> &buffer, std::size_t limit)
+        {
+            std::size_t total = 0;
+            while (total < limit)
+            {
+                ssize_t n = ::read(fd, buffer.data(), std::min(buffer.size(), limit - total));
+                if (n > 0)
+                {
+                    total += static_cast<std::size_t>(n);
+                    if (process._output)
+                        process._output(stream, std::string_view(buffer.data(), static_cast<std::size_t>(n)));
+                    continue;
+                }
+                if (n < 0 && errno == EINTR)
+                    continue;
+                return true;
+            }
+            return false;
+        }
+
+        void ProcessReactor::_reap(const std::shared_ptr<GameProcess> &process, std::vector<char> &buffer)
+        {
+            int status = 0;
+            pid_t result = ::waitpid(process->_pid, &status, WNOHANG);
+            if (result == 0)
+                return;
+
+            // Deliver whatever is still buffered in the pipes before resolving the future
+            if (process->_stdout >= 0)
+                _drain(*process, process->_stdout, ProcessStream::Stdout, buffer, SIZE_MAX);
+            if (process->_stderr >= 0)
+                _drain(*process, process->_stderr, ProcessStream::Stderr, buffer, SIZE_MAX);
+            if (process->_output)
+            {
+                process->_output(ProcessStream::Stdout, std::string_view());
+                process->_output(ProcessStream::Stderr, std::string_view());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (auto it = _registrations.begin(); it != _registrations.end();)
+                {
+                    if (it->second.process == process)
+                    {
+                        ::epoll_ctl(_epoll, EPOLL_CTL_DEL, it->second.fd, nullptr);
+                        it = _registrations.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+                _processes.erase(std::remove(_processes.begin(), _processes.end(), process), _processes.end());
+            }
+
+            for (int *fd : {&process->_pidfd, &process->_stdout, &process->_stderr})
+            {
+                if (*fd >= 0)
+                {
+                    ::close(*fd);
+                    *fd = -1;
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(process->_inputMutex);
+                if (process->_stdin >= 0)
+                {
+                    ::close(process->_stdin);
+                    process->_stdin = -1;
+                }
+            }
+
+            int code = -1;
+            if (result > 0)
+            {
+                if (WIFEXITED(status))
+                    code = WEXITSTATUS(status);
+                else if (WIFSIGNALED(status))
+                    code = -WTERMSIG(status);
+            }
+            process->_running.store(false, std::memory_order_release);
+            if (process->_onExit)
+            {
+                // A failing handler must not take the reactor down with it
+                try
+                {
+                    process->_onExit(code);
+                }
+                catch (...)
+                {
+                }
+            }
+            process->_promise.set_value(code);
+        }
+
+        void ProcessReactor::_run()
+        {
+            std::vector<char> buffer(1 << 16);
+            epoll_event events[64];
+
+            while (!_stopping.load())
+            {
+                // Without pidfd support, exits are discovered by polling
+                bool polling = false;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    for (const auto &process : _processes)
+                    {
+                        if (process->_pidfd < 0)
+                        {
+                            polling = true;
+                            break;
+                        }
+                    }
+                }
+
+                int count = ::epoll_wait(_epoll, events, 64, polling ? 100 : -1);
+                if (count < 0 && errno != EINTR)
+                    break;
+
+                for (int i = 0; i < count; i++)
+                {
+                    std::uint64_t token = events[i].data.u64;
+                    if (token == 0)
+                    {
+                        std::uint64_t value;
+                        while (::read(_wakeup, &value, sizeof(value)) > 0)
+                        {
+                        }
+                        continue;
+                    }
+
+                    Registration registration;
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        auto it = _registrations.find(token);
+                        if (it == _registrations.end())
+                            continue;
+                        registration = it->second;
+                    }
+
+                    if (registration.kind == 2)
+                    {
+                        _reap(registration.process, buffer);
+                        continue;
+                    }
+
+                    // Level triggered: a pipe left with data comes back on the next
+                    // wait, after the other processes had their turn
+                    bool drained = _drain(*registration.process, registration.fd,
+                                          registration.kind == 0 ? ProcessStream::Stdout : ProcessStream::Stderr, buffer, DrainLimit);
+
+                    if (drained && (events[i].events & (EPOLLHUP | EPOLLERR)))
+                    {
+                        // Writer side is gone, stop watching but keep the fd until the process is reaped
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        ::epoll_ctl(_epoll, EPOLL_CTL_DEL, registration.fd, nullptr);
+                        _registrations.erase(token);
+                    }
+                }
+
+                if (polling)
+                {
+                    std::vector<std::shared_ptr<GameProcess>> candidates;
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        for (const auto &process : _processes)
+                        {
+                            if (process->_pidfd < 0)
+                                candidates.push_back(process);
+                        }
+                    }
+                    for (const auto &process : candidates)
+                        _reap(process, buffer);
+                }
+            }
+        }
+#else
+        void AttachToCgroup(const fs::path &, int)
+        {
+            throw std::runtime_error("cgroups are not supported on this platform");
+        }
+
+        GameProcess::GameProcess() : _exit(_promise.get_future().share()) {}
+        GameProcess::~GameProcess() = default;
+        bool GameProcess::sendInput(std::string_view) { return false; }
+        void GameProcess::terminate() {}
+        void GameProcess::kill() {}
+
+        ProcessReactor::ProcessReactor() {}
+        ProcessReactor::~ProcessReactor() {}
+
+        ProcessReactor &ProcessReactor::shared()
+        {
+            static ProcessReactor reactor;
+            return reactor;
+        }
+
+        std::size_t ProcessReactor::size() const { return 0; }
+
+        std::shared_ptr<GameProcess> ProcessReactor::spawn(char *const *, const ProcessOptions &)
+        {
+            throw std::runtime_error("Process spawning is not supported on this platform yet");
+        }
+#endif
+    } // namespace minecraft
+
+} // namespace cnt
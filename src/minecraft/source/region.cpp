@@ -0,0 +1,450 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/region.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/region.hpp>
+#include <minecraft/parallel.hpp>
+#include <minecraft/nbt.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            static std::uint32_t readRegionInt(const std::uint8_t *p)
+            {
+                return (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) | (std::uint32_t(p[2]) << 8) | std::uint32_t(p[3]);
+            }
+
+            static void writeRegionInt(std::uint8_t *p, std::uint32_t value)
+            {
+                p[0] = static_cast<std::uint8_t>(value >> 24);
+                p[1] = static_cast<std::uint8_t>(value >> 16);
+                p[2] = static_cast<std::uint8_t>(value >> 8);
+                p[3] = static_cast<std::uint8_t>(value);
+            }
+
+            std::vector<std::uint8_t> decompressChunk(std::uint8_t compression, const std::uint8_t *data, std::size_t size)
+            {
+                std::vector<std::uint8_t> out;
+                switch (static_cast<RegionCompression>(compression))
+                {
+                case RegionCompression::None:
+                    out.assign(data, data + size);
+                    return out;
+                case RegionCompression::Zlib:
+                    out.reserve(std::min(size * 4, MaxInflatedNbt));
+                    inflateZlib(data, size, out);
+                    return out;
+                case RegionCompression::GZip:
+                    out.reserve(std::min(size * 4, MaxInflatedNbt));
+                    inflateGzip(data, size, out);
+                    return out;
+                default:
+                    throw std::runtime_error("Unsupported chunk compression " + std::to_string(compression));
+                }
+            }
+
+            std::optional<std::int64_t> readInhabitedTime(const std::uint8_t *nbt, std::size_t size)
+            {
+                NbtReader reader(nbt, size);
+                if (reader.next() != NbtReader::Token::BeginCompound)
+                    return std::nullopt;
+
+                // Sections, heightmaps and entities are skipped by their lengths
+                bool inLevel = false;
+                for (;;)
+                {
+                    NbtReader::Token token = reader.next();
+                    if (token == NbtReader::Token::EndCompound)
+                    {
+                        if (!inLevel)
+                            return std::nullopt;
+                        inLevel = false;
+                        continue;
+                    }
+                    if (reader.type() == NbtType::Long && reader.name() == "InhabitedTime")
+                        return reader.integer();
+                    if (token == NbtReader::Token::BeginCompound && !inLevel && reader.name() == "Level")
+                    {
+                        inLevel = true;
+                        continue;
+                    }
+                    if (token == NbtReader::Token::BeginCompound || token == NbtReader::Token::BeginList)
+                        reader.skip();
+                }
+            }
+        }
+
+        RegionFile::RegionFile(const fs::path &path) : _path(path)
+        {
+            _map();
+            try
+            {
+                _parse();
+            }
+            catch (...)
+            {
+#ifndef _WIN32
+                if (_mapped)
+                    ::munmap(const_cast<std::uint8_t *>(_data), _size);
+#endif
+                throw;
+            }
+        }
+
+        RegionFile::~RegionFile()
+        {
+#ifndef _WIN32
+            if (_mapped)
+                ::munmap(const_cast<std::uint8_t *>(_data), _size);
+#endif
+        }
+
+        void RegionFile::_map()
+        {
+#ifndef _WIN32
+            int fd = ::open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                throw std::runtime_error("Cannot open file: " + _path.string());
+
+            struct stat st;
+            if (::fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                throw std::runtime_error("Cannot stat file: " + _path.string());
+            }
+            _size = static_cast<std::size_t>(st.st_size);
+            if (_size < 2 * SectorSize)
+            {
+                ::close(fd);
+                throw std::runtime_error("Not a region file: " + _path.string());
+            }
+
+            void *mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (mapping == MAP_FAILED)
+                throw std::runtime_error("Cannot map file: " + _path.string());
+
+            // Chunks are visited in header order, which is not file order
+            ::madvise(mapping, _size, MADV_RANDOM);
+            _data = static_cast<const std::uint8_t *>(mapping);
+            _mapped = true;
+#else
+            std::ifstream stream(_path, std::ios::binary);
+            if (!stream.is_open())
+                throw std::runtime_error("Cannot open file: " + _path.string());
+            _buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+            _data = _buffer.data();
+            _size = _buffer.size();
+            if (_size < 2 * SectorSize)
+                throw std::runtime_error("Not a region file: " + _path.string());
+#endif
+        }
+
+        void RegionFile::_parse()
+        {
+            _chunks.reserve(1024);
+            for (int index = 0; index < 1024; index++)
+            {
+                std::uint32_t location = internal::readRegionInt(_data + index * 4);
+                if (location == 0)
+                    continue;
+
+                RegionChunk chunk;
+                chunk.x = index & 31;
+                chunk.z = index >> 5;
+                chunk.sectorOffset = location >> 8;
+                chunk.sectorCount = location & 0xff;
+                chunk.timestamp = internal::readRegionInt(_data + SectorSize + index * 4);
+
+                // A partial last sector is still readable, the game does not pad either
+                if (chunk.sectorOffset < 2 || chunk.sectorCount == 0 || chunk.sectorOffset * SectorSize + 5 > _size)
+                {
+                    _invalid++;
+                    continue;
+                }
+
+                const std::uint8_t *start = _data + chunk.sectorOffset * SectorSize;
+                std::uint32_t length = internal::readRegionInt(start);
+                std::size_t available = std::min<std::size_t>(chunk.sectorCount * SectorSize, _size - chunk.sectorOffset * SectorSize);
+                if (length >= 1 && std::size_t(length) + 4 <= available)
+                    chunk.length = length;
+                chunk.compression = start[4] & 0x7f;
+                chunk.external = (start[4] & 0x80) != 0;
+                _chunks.push_back(chunk);
+            }
+        }
+
+        const RegionChunk *RegionFile::find(int x, int z) const
+        {
+            for (const auto &chunk : _chunks)
+            {
+                if (chunk.x == (x & 31) && chunk.z == (z & 31))
+                    return &chunk;
+            }
+            return nullptr;
+        }
+
+        std::string_view RegionFile::raw(const RegionChunk &chunk) const
+        {
+            if (chunk.external || chunk.length == 0)
+                return std::string_view();
+            return std::string_view(reinterpret_cast<const char *>(_data + chunk.sectorOffset * SectorSize + 5), chunk.length - 1);
+        }
+
+        std::string_view RegionFile::sectors(const RegionChunk &chunk) const
+        {
+            std::size_t offset = chunk.sectorOffset * SectorSize;
+            if (offset >= _size)
+                return std::string_view();
+            return std::string_view(reinterpret_cast<const char *>(_data + offset), std::min<std::size_t>(chunk.sectorCount * SectorSize, _size - offset));
+        }
+
+        fs::path RegionFile::externalPath(const RegionChunk &chunk) const
+        {
+            // r.<rx>.<rz>.mca -> c.<cx>.<cz>.mcc with absolute chunk coordinates
+            String name = _path.stem().string();
+            int regionX = 0, regionZ = 0;
+            std::size_t first = name.find('.'), second = name.find('.', first + 1);
+            if (first != String::npos && second != String::npos)
+            {
+                regionX = std::atoi(name.c_str() + first + 1);
+                regionZ = std::atoi(name.c_str() + second + 1);
+            }
+            return _path.parent_path() / ("c." + std::to_string(regionX * 32 + chunk.x) + '.' + std::to_string(regionZ * 32 + chunk.z) + ".mcc");
+        }
+
+        std::vector<std::uint8_t> RegionFile::read(const RegionChunk &chunk) const
+        {
+            if (chunk.external)
+            {
+                const fs::path external = externalPath(chunk);
+                std::ifstream stream(external, std::ios::binary);
+                if (!stream.is_open())
+                    throw std::runtime_error("Cannot open file: " + external.string());
+                std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+                return internal::decompressChunk(chunk.compression, data.data(), data.size());
+            }
+            if (chunk.length == 0)
+                throw std::runtime_error("Corrupt chunk " + std::to_string(chunk.x) + "," + std::to_string(chunk.z) + " in " + _path.string());
+            std::string_view payload = raw(chunk);
+            return internal::decompressChunk(chunk.compression, reinterpret_cast<const std::uint8_t *>(payload.data()), payload.size());
+        }
+
+        RegionCompactStats CompactRegionFile(const fs::path &file, const RegionCompactOptions &options)
+        {
+            RegionCompactStats stats;
+            stats.files = 1;
+
+            RegionFile region(file);
+            stats.bytesBefore = region.fileSize();
+
+            // A header pointing outside the file is damage, not something to tidy up
+            if (region.invalidChunks() != 0)
+                throw std::runtime_error(std::to_string(region.invalidChunks()) + " header entries point outside the file");
+
+            struct Kept
+            {
+                const RegionChunk *chunk;
+                std::string_view data; // length field, compression byte and payload
+                std::size_t sectors;
+            };
+            std::vector<Kept> kept;
+            std::vector<fs::path> orphans;
+
+            for (const auto &chunk : region.chunks())
+            {
+                if (options.minInhabitedTime >= 0)
+                {
+                    // Chunks that cannot be decoded are kept, pruning must never guess
+                    std::optional<std::int64_t> inhabited;
+                    try
+                    {
+                        std::vector<std::uint8_t> nbt = region.read(chunk);
+                        inhabited = internal::readInhabitedTime(nbt.data(), nbt.size());
+                    }
+                    catch (const std::exception &)
+                    {
+                    }
+                    if (inhabited && *inhabited < options.minInhabitedTime)
+                    {
+                        stats.prunedChunks++;
+                        if (chunk.external)
+                            orphans.push_back(region.externalPath(chunk));
+                        continue;
+                    }
+                }
+
+                // Only the used bytes move; a broken length keeps every sector it had
+                std::string_view data = region.sectors(chunk);
+                if (chunk.length != 0)
+                    data = data.substr(0, chunk.length + 4);
+                kept.push_back({&chunk, data, (data.size() + RegionFile::SectorSize - 1) / RegionFile::SectorSize});
+            }
+            stats.chunks = kept.size();
+
+            // Keep the file order, neighbours in the file are often read together
+            std::sort(kept.begin(), kept.end(), [](const Kept &a, const Kept &b)
+                      { return a.chunk->sectorOffset < b.chunk->sectorOffset; });
+
+            bool compact = stats.prunedChunks == 0;
+            std::size_t next = 2;
+            for (const auto &item : kept)
+            {
+                if (item.chunk->sectorOffset != next || item.chunk->sectorCount != item.sectors)
+                    compact = false;
+                next += item.sectors;
+            }
+            if (next > 0xffffff || std::any_of(kept.begin(), kept.end(), [](const Kept &item)
+                                                { return item.sectors > 0xff; }))
+                throw std::runtime_error("Region file does not fit the sector format: " + file.string());
+
+            stats.bytesAfter = next * RegionFile::SectorSize;
+            if (compact && region.fileSize() <= stats.bytesAfter)
+            {
+                stats.bytesAfter = region.fileSize();
+                return stats;
+            }
+            if (options.dryRun)
+                return stats;
+
+            // Build the new header, then stream the sectors straight from the mapping
+            std::vector<std::uint8_t> header(2 * RegionFile::SectorSize, 0);
+            next = 2;
+            for (const auto &item : kept)
+            {
+                int index = item.chunk->x + item.chunk->z * 32;
+                internal::writeRegionInt(header.data() + index * 4, static_cast<std::uint32_t>(next << 8 | item.sectors));
+                internal::writeRegionInt(header.data() + RegionFile::SectorSize + index * 4, item.chunk->timestamp);
+                next += item.sectors;
+            }
+
+            // Unique per process and per call, so concurrent compactions never share it
+            static std::atomic<unsigned long long> sequence{0};
+#ifdef _WIN32
+            const auto pid = ::_getpid();
+#else
+            const auto pid = ::getpid();
+#endif
+            const fs::path temporary = file.parent_path() / (file.filename().string() + ".tmp-" + std::to_string(pid) + '-' +
+                                                             std::to_string(sequence.fetch_add(1, std::memory_order_relaxed)));
+            {
+                std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+                if (!out.is_open())
+                    throw std::runtime_error("Cannot write file: " + temporary.string());
+                out.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+
+                static const char padding[RegionFile::SectorSize] = {};
+                for (const auto &item : kept)
+                {
+                    out.write(item.data.data(), static_cast<std::streamsize>(item.data.size()));
+                    out.write(padding, static_cast<std::streamsize>(item.sectors * RegionFile::SectorSize - item.data.size()));
+                }
+                out.close();
+                if (!out)
+                {
+                    std::error_code ec;
+                    fs::remove(temporary, ec);
+                    throw std::runtime_error("Cannot write file: " + temporary.string());
+                }
+            }
+
+            std::error_code ec;
+            fs::rename(temporary, file, ec);
+            if (ec)
+            {
+                fs::remove(temporary, ec);
+                throw std::runtime_error("Cannot replace region file: " + file.string());
+            }
+            for (const auto &orphan : orphans)
+                fs::remove(orphan, ec);
+            stats.rewrittenFiles = 1;
+            return stats;
+        }
+
+        RegionCompactStats CompactRegions(const fs::path &directory, const RegionCompactOptions &options)
+        {
+            // region/ of the overworld, DIM-1/DIM1 and dimensions/<ns>/<name>
+            std::vector<fs::path> files;
+            std::error_code ec;
+            for (fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, ec), end; !ec && it != end; it.increment(ec))
+            {
+                std::error_code typeError;
+                if (!it->is_directory(typeError) || it->path().filename() != "region")
+                    continue;
+                it.disable_recursion_pending();
+                for (fs::directory_iterator region(it->path(), ec), last; !ec && region != last; region.increment(ec))
+                {
+                    if (region->path().extension() == ".mca" && region->is_regular_file(typeError))
+                        files.push_back(region->path());
+                }
+                ec.clear();
+            }
+
+            RegionCompactStats total;
+            std::mutex mutex;
+            internal::parallelFor(files.size(), [&](std::size_t index)
+                                  {
+                RegionCompactStats stats;
+                try
+                {
+                    stats = CompactRegionFile(files[index], options);
+                }
+                catch (const std::exception &e)
+                {
+                    stats = RegionCompactStats();
+                    stats.files = 1;
+                    stats.errors.push_back(files[index].string() + ": " + e.what());
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                total.files += stats.files;
+                total.rewrittenFiles += stats.rewrittenFiles;
+                total.chunks += stats.chunks;
+                total.prunedChunks += stats.prunedChunks;
+                total.bytesBefore += stats.bytesBefore;
+                total.bytesAfter += stats.bytesAfter;
+                total.errors.insert(total.errors.end(), stats.errors.begin(), stats.errors.end()); },
+                                  options.threads);
+            return total;
+        }
+    } // namespace minecraft
+
+} // namespace cnt
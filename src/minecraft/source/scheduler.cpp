@@ -0,0 +1,277 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/scheduler.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/scheduler.hpp>
+#include <minecraft/host.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            // Pool and deque of the worker running on this thread
+            struct SchedulerWorker
+            {
+                const void *pool = nullptr;
+                std::size_t index = 0;
+            };
+
+            static thread_local SchedulerWorker currentWorker;
+        }
+
+        Scheduler::Scheduler(unsigned int cpuWorkers, unsigned int ioWorkers)
+        {
+            if (cpuWorkers == 0)
+                cpuWorkers = HostResources::detect().effectiveCpus();
+            if (ioWorkers == 0)
+                ioWorkers = std::max(4u, cpuWorkers * 2);
+            _pool(TaskPool::Cpu).size = cpuWorkers;
+            _pool(TaskPool::Io).size = ioWorkers;
+        }
+
+        Scheduler::~Scheduler()
+        {
+            for (auto &pool : _pools)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(pool.mutex);
+                    pool.stopping = true;
+                }
+                pool.wakeup.notify_all();
+                for (auto &thread : pool.threads)
+                    thread.join();
+            }
+        }
+
+        Scheduler &Scheduler::shared()
+        {
+            static Scheduler scheduler;
+            return scheduler;
+        }
+
+        void Scheduler::_start(Pool &pool)
+        {
+            pool.workers.reserve(pool.size);
+            for (unsigned int i = 0; i < pool.size; i++)
+                pool.workers.push_back(std::make_unique<Worker>());
+            pool.threads.reserve(pool.size);
+            for (unsigned int i = 0; i < pool.size; i++)
+                pool.threads.emplace_back(&Scheduler::_run, this, std::ref(pool), i);
+        }
+
+        bool Scheduler::_take(Pool &pool, std::size_t self, Task &task)
+        {
+            const std::size_t count = pool.workers.size();
+
+            // Own work newest first, it is the most likely to be in cache
+            if (self < count)
+            {
+                Worker &worker = *pool.workers[self];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                if (!worker.tasks.empty())
+                {
+                    task = std::move(worker.tasks.back());
+                    worker.tasks.pop_back();
+                    pool.pending.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(pool.mutex);
+                if (!pool.injected.empty())
+                {
+                    task = std::move(pool.injected.front());
+                    pool.injected.pop_front();
+                    pool.pending.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            // Steal the oldest task of another worker, usually the biggest piece of work
+            std::size_t start = self < count ? self + 1 : static_cast<std::size_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+            for (std::size_t i = 0; i < count; i++)
+            {
+                Worker &victim = *pool.workers[(start + i) % count];
+                std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+                if (!lock.owns_lock() || victim.tasks.empty())
+                    continue;
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                pool.pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+
+        void Scheduler::_run(Pool &pool, std::size_t index)
+        {
+            internal::currentWorker = {&pool, index};
+            Task task;
+            for (;;)
+            {
+                if (_take(pool, index, task))
+                {
+                    try
+                    {
+                        task();
+                    }
+                    catch (...)
+                    {
+                        // Bare tasks have nobody to report to, TaskGroup catches its own
+                    }
+                    task = nullptr;
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(pool.mutex);
+                pool.wakeup.wait(lock, [&pool]
+                                 { return pool.stopping || pool.pending.load(std::memory_order_relaxed) > 0; });
+                if (pool.stopping && pool.pending.load(std::memory_order_relaxed) == 0)
+                    return;
+            }
+        }
+
+        void Scheduler::submit(Task task, TaskPool kind)
+        {
+            Pool &pool = _pool(kind);
+            std::call_once(pool.started, [this, &pool]
+                           { _start(pool); });
+
+            const internal::SchedulerWorker &current = internal::currentWorker;
+            if (current.pool == &pool)
+            {
+                Worker &worker = *pool.workers[current.index];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                worker.tasks.push_back(std::move(task));
+                pool.pending.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                std::lock_guard<std::mutex> lock(pool.mutex);
+                pool.injected.push_back(std::move(task));
+                pool.pending.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            // Taking the lock orders this with a worker about to sleep
+            {
+                std::lock_guard<std::mutex> lock(pool.mutex);
+            }
+            pool.wakeup.notify_one();
+        }
+
+        bool Scheduler::runPending(TaskPool kind)
+        {
+            Pool &pool = _pool(kind);
+            if (pool.workers.empty() || pool.pending.load(std::memory_order_relaxed) == 0)
+                return false;
+
+            const internal::SchedulerWorker &current = internal::currentWorker;
+            std::size_t self = current.pool == &pool ? current.index : static_cast<std::size_t>(-1);
+            Task task;
+            if (!_take(pool, self, task))
+                return false;
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+            }
+            return true;
+        }
+
+        TaskGroup::TaskGroup(TaskPool pool, Scheduler &scheduler)
+            : _scheduler(scheduler), _pool(pool), _state(std::make_shared<State>()) {}
+
+        TaskGroup::~TaskGroup()
+        {
+            try
+            {
+                wait();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        void TaskGroup::run(std::function<void()> task)
+        {
+            auto state = _state;
+            state->pending.fetch_add(1, std::memory_order_relaxed);
+            _scheduler.submit([state, task = std::move(task)]()
+                              {
+                if (!state->cancelled.load(std::memory_order_relaxed))
+                {
+                    try
+                    {
+                        task();
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        if (!state->error)
+                            state->error = std::current_exception();
+                        state->cancelled.store(true, std::memory_order_relaxed);
+                    }
+                }
+                if (state->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->done.notify_all();
+                } },
+                              _pool);
+        }
+
+        void TaskGroup::wait()
+        {
+            while (_state->pending.load(std::memory_order_acquire) > 0)
+            {
+                // Helping instead of blocking keeps nested groups from starving the pool
+                if (_scheduler.runPending(_pool))
+                    continue;
+                std::unique_lock<std::mutex> lock(_state->mutex);
+                _state->done.wait_for(lock, std::chrono::milliseconds(2), [this]
+                                      { return _state->pending.load(std::memory_order_acquire) == 0; });
+            }
+
+            std::exception_ptr error;
+            {
+                std::lock_guard<std::mutex> lock(_state->mutex);
+                std::swap(error, _state->error);
+            }
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        void TaskGroup::cancel()
+        {
+            _state->cancelled.store(true, std::memory_order_relaxed);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
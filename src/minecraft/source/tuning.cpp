@@ -0,0 +1,220 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/tuning.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/tuning.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            bool javaHasShenandoah(const JavaInfo &java)
+            {
+                const int major = java.majorVersion();
+
+                String implementor;
+                const String release = readSmallFile(java.path / "release");
+                std::size_t pos = release.find("IMPLEMENTOR=");
+                if (pos != String::npos)
+                {
+                    std::size_t end = release.find('\n', pos);
+                    implementor = release.substr(pos + 12, end == String::npos ? String::npos : end - pos - 12);
+                }
+                else
+                {
+                    implementor = java.publisher;
+                }
+
+                if (implementor.find("Oracle") != String::npos)
+                    return false;
+                // Red Hat backported it to 8 and 11, everyone else ships it from 12 on
+                if (implementor.find("Red Hat") != String::npos)
+                    return major >= 8;
+                return major >= 12;
+            }
+
+            String formatJvmSize(std::uint64_t bytes)
+            {
+                constexpr std::uint64_t MiB = std::uint64_t(1) << 20;
+                constexpr std::uint64_t GiB = std::uint64_t(1) << 30;
+                if (bytes % GiB == 0)
+                    return std::to_string(bytes / GiB) + "G";
+                return std::to_string(bytes / MiB) + "M";
+            }
+
+            // Update number of a legacy "1.8.0_292" version, 0 if there is none
+            static int javaUpdateVersion(const String &version)
+            {
+                std::size_t underscore = version.find('_');
+                if (underscore == String::npos)
+                    return 0;
+                int update = 0;
+                for (std::size_t i = underscore + 1; i < version.size() && std::isdigit(static_cast<unsigned char>(version[i])); i++)
+                    update = update * 10 + (version[i] - '0');
+                return update;
+            }
+        }
+
+        JvmPlan PlanJvmOptions(const JavaInfo &java, const HostResources &host, const JvmPlanOptions &options)
+        {
+            constexpr std::uint64_t MiB = std::uint64_t(1) << 20;
+            constexpr std::uint64_t GiB = std::uint64_t(1) << 30;
+
+            const int major = java.majorVersion();
+            const unsigned int instances = std::max(1u, options.concurrentInstances);
+
+            // What the instance would like to have
+            std::uint64_t wanted;
+            if (options.server)
+                wanted = options.modded ? std::min<std::uint64_t>(6 * GiB + options.modCount * 16 * MiB, 16 * GiB) : 4 * GiB;
+            else
+                wanted = options.modded ? std::min<std::uint64_t>(4 * GiB + options.modCount * 16 * MiB, 10 * GiB) : 2 * GiB;
+
+            // What the host can give: memory minus a reserve, split between
+            // instances, minus the per-JVM overhead outside the heap (metaspace,
+            // code cache, thread stacks, GC structures), which grows with the heap
+            std::uint64_t memory = host.effectiveMemory();
+            if (memory == 0)
+                memory = 4 * GiB;
+            std::uint64_t reserved = options.reservedMemory;
+            if (reserved == 0)
+                reserved = options.server ? std::max(GiB, memory / 8) : std::max(2 * GiB, memory / 5);
+            if (reserved >= memory)
+                reserved = memory / 2;
+
+            const std::uint64_t budget = (memory - reserved) / instances;
+            const std::uint64_t baseOverhead = options.modded ? 512 * MiB : 384 * MiB;
+            const std::uint64_t affordable = budget > baseOverhead ? (budget - baseOverhead) * 4 / 5 : 0;
+
+            // The floor is part of what the instance wants, the budget and an
+            // explicit maxHeap still bound it: an instance that cannot get it
+            // is reported rather than allowed to overcommit the host
+            constexpr std::uint64_t minimum = 512 * MiB;
+            if (affordable < minimum && (options.maxHeap == 0 || options.maxHeap > affordable))
+                throw std::runtime_error("Not enough memory for " + std::to_string(instances) + " instance(s): " +
+                                         std::to_string(affordable / MiB) + " MiB of heap per instance, 512 MiB needed");
+
+            JvmPlan plan;
+            plan.heap = std::min(std::max(wanted, minimum), affordable);
+            if (options.maxHeap != 0)
+                plan.heap = std::min(plan.heap, options.maxHeap);
+            const std::uint64_t step = plan.heap >= GiB ? 256 * MiB : 64 * MiB;
+            if (plan.heap > step)
+                plan.heap -= plan.heap % step;
+
+            // Collector
+            const bool shenandoah = internal::javaHasShenandoah(java);
+            plan.collector = options.collector;
+            if (plan.collector == JvmCollector::Auto)
+            {
+                plan.collector = JvmCollector::G1;
+                if (options.lowLatency || plan.heap >= 16 * GiB)
+                {
+                    if (major >= 21)
+                        plan.collector = JvmCollector::Z;
+                    else if (shenandoah && major >= 11)
+                        plan.collector = JvmCollector::Shenandoah;
+                    else if (major >= 15)
+                        plan.collector = JvmCollector::Z;
+                }
+            }
+            if ((plan.collector == JvmCollector::Z && major < 15) ||
+                (plan.collector == JvmCollector::Shenandoah && !shenandoah))
+                plan.collector = JvmCollector::G1;
+
+            // Servers run for long, commit the whole heap up front so an
+            // overcommitted host fails at start instead of mid-game
+            plan.preTouch = options.server;
+            plan.initialHeap = options.server ? plan.heap : std::min(plan.heap, std::max(512 * MiB, plan.heap / 4));
+
+            // Large pages only pay off for bigger heaps
+            bool explicitHugePages = false;
+            if (plan.heap >= GiB)
+            {
+                explicitHugePages = host.hugePageSize != 0 && host.hugePagesFree * host.hugePageSize >= plan.heap;
+                plan.largePages = explicitHugePages || host.transparentHugePages;
+            }
+
+            // Share the CPUs between instances; the JVM only reads cgroup
+            // quotas by itself from 8u191 and 10 on
+            const bool containerAware = major >= 10 || (major == 8 && internal::javaUpdateVersion(java.version) >= 191);
+            unsigned int cpus = host.effectiveCpus();
+            unsigned int share = std::min(cpus, std::max(2u, static_cast<unsigned int>(std::ceil(double(cpus) / instances))));
+            if (containerAware && share < host.cpus)
+                plan.activeProcessors = share;
+
+            auto &args = plan.arguments;
+            args.push_back("-Xmx" + internal::formatJvmSize(plan.heap));
+            args.push_back("-Xms" + internal::formatJvmSize(plan.initialHeap));
+
+            switch (plan.collector)
+            {
+            case JvmCollector::Z:
+                args.push_back("-XX:+UseZGC");
+                // Generational mode is opt-in on 21 and 22, the only mode later
+                if (major == 21 || major == 22)
+                    args.push_back("-XX:+ZGenerational");
+                break;
+            case JvmCollector::Shenandoah:
+                args.push_back("-XX:+UseShenandoahGC");
+                break;
+            case JvmCollector::Parallel:
+                args.push_back("-XX:+UseParallelGC");
+                break;
+            default:
+                args.push_back("-XX:+UseG1GC");
+                if (options.server)
+                {
+                    args.push_back("-XX:MaxGCPauseMillis=200");
+                    args.push_back("-XX:+ParallelRefProcEnabled");
+                }
+                else
+                {
+                    // The official launcher's client defaults
+                    args.push_back("-XX:+UnlockExperimentalVMOptions");
+                    args.push_back("-XX:G1NewSizePercent=20");
+                    args.push_back("-XX:G1ReservePercent=20");
+                    args.push_back("-XX:MaxGCPauseMillis=50");
+                    args.push_back("-XX:G1HeapRegionSize=32M");
+                }
+                break;
+            }
+
+            if (plan.preTouch)
+                args.push_back("-XX:+AlwaysPreTouch");
+            if (plan.largePages)
+                args.push_back(explicitHugePages ? "-XX:+UseLargePages" : "-XX:+UseTransparentHugePages");
+            if (plan.activeProcessors != 0)
+                args.push_back("-XX:ActiveProcessorCount=" + std::to_string(plan.activeProcessors));
+
+            return plan;
+        }
+    } // namespace minecraft
+
+} // namespace cnt
@@ -23,44 +23,60 @@
 #include <minecraft/version.hpp>
 
 #include <sstream>
+#include <climits>
 #include <algorithm>
 
 namespace cnt
 {
     namespace minecraft
     {
-
-        void Version<VersionBefore26>::VersionData::parse(const String &versionStr)
+        namespace internal
         {
-            std::regex pattern(R"(^(\d+)\.(\d+)(?:\.(\d+))?$)");
-            std::smatch matches;
-
-            if (std::regex_match(versionStr, matches, pattern))
+            // Split "a.b" or "a.b.c" into numbers by hand, std::regex is slow to build
+            // and throws on its own. Returns the number of parts, 0 if malformed
+            static int scanVersionParts(const String &text, int (&parts)[3])
             {
-                int major = std::stoi(matches[1]);
-
-                // For VersionBefore26, major must be 1
-                if (major != 1)
+                int count = 0;
+                std::size_t pos = 0;
+                while (count < 3)
                 {
-                    throw std::runtime_error("VersionBefore26: Major version must be 1");
+                    if (pos >= text.size() || text[pos] < '0' || text[pos] > '9')
+                        return 0;
+                    long long number = 0;
+                    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9')
+                    {
+                        number = number * 10 + (text[pos++] - '0');
+                        if (number > INT_MAX)
+                            return 0;
+                    }
+                    parts[count++] = static_cast<int>(number);
+                    if (pos == text.size())
+                        break;
+                    if (text[pos++] != '.')
+                        return 0;
                 }
+                return (pos == text.size() && count >= 2) ? count : 0;
+            }
+        }
 
-                minor = std::stoi(matches[2]);
-
-                // Patch is optional, default to 0 if not provided
-                if (matches[3].matched)
-                {
-                    patch = std::stoi(matches[3]);
-                }
-                else
-                {
-                    patch = 0;
-                }
+        Result<void> Version<VersionBefore26>::VersionData::parse(const String &versionStr)
+        {
+            int parts[3] = {0, 0, 0};
+            if (!internal::scanVersionParts(versionStr, parts))
+            {
+                return Error(Errc::PARSE, "Invalid version format for VersionBefore26. Expected format: 1.minor.patch or minor.patch");
             }
-            else
+
+            // For VersionBefore26, major must be 1
+            if (parts[0] != 1)
             {
-                throw std::runtime_error("Invalid version format for VersionBefore26. Expected format: 1.minor.patch or minor.patch");
+                return Error(Errc::OUT_OF_RANGE, "VersionBefore26: Major version must be 1");
             }
+
+            // Patch is optional, default to 0 if not provided
+            minor = parts[1];
+            patch = parts[2];
+            return {};
         }
 
         String Version<VersionBefore26>::VersionData::toString() const
@@ -90,10 +106,21 @@ namespace cnt
         Version<VersionBefore26>::Version(const String &versionStr)
             : data_(std::make_unique<VersionData>())
         {
-            data_->parse(versionStr);
+            data_->parse(versionStr).value();
             validateComponents();
         }
 
+        Result<Version<VersionBefore26>> Version<VersionBefore26>::parse(const String &versionStr)
+        {
+            Version version;
+            Result<void> parsed = version.data_->parse(versionStr);
+            if (!parsed)
+            {
+                return parsed.error();
+            }
+            return version;
+        }
+
         Version<VersionBefore26>::~Version() = default;
 
         Version<VersionBefore26>::Version(const Version &other)
@@ -122,7 +149,10 @@ namespace cnt
 
         Version<VersionBefore26> &Version<VersionBefore26>::operator=(const String &versionStr)
         {
-            data_->parse(versionStr);
+            // Parsed aside so a bad string leaves this version untouched
+            VersionData parsed;
+            parsed.parse(versionStr).value();
+            *data_ = parsed;
             validateComponents();
             return *this;
         }
@@ -188,36 +218,25 @@ namespace cnt
         // Implementation for VersionAfter26 specialization
         // ============================================================================
 
-        void Version<VersionAfter26>::VersionData::parse(const String &versionStr)
+        Result<void> Version<VersionAfter26>::VersionData::parse(const String &versionStr)
         {
-            std::regex pattern(R"(^(\d+)\.(\d+)(?:\.(\d+))?$)");
-            std::smatch matches;
-
-            if (std::regex_match(versionStr, matches, pattern))
+            int parts[3] = {0, 0, 0};
+            if (!internal::scanVersionParts(versionStr, parts))
             {
-                major = std::stoi(matches[1]);
-                minor = std::stoi(matches[2]);
-
-                // Patch is optional, default to 0 if not provided
-                if (matches[3].matched)
-                {
-                    patch = std::stoi(matches[3]);
-                }
-                else
-                {
-                    patch = 0;
-                }
-
-                // For VersionAfter26, major must be >= 26
-                if (major < 26)
-                {
-                    throw std::runtime_error("VersionAfter26: Major version must be 26 or greater");
-                }
+                return Error(Errc::PARSE, "Invalid version format for VersionAfter26. Expected format: major.minor or major.minor.patch");
             }
-            else
+
+            // For VersionAfter26, major must be >= 26
+            if (parts[0] < 26)
             {
-                throw std::runtime_error("Invalid version format for VersionAfter26. Expected format: major.minor or major.minor.patch");
+                return Error(Errc::OUT_OF_RANGE, "VersionAfter26: Major version must be 26 or greater");
             }
+
+            // Patch is optional, default to 0 if not provided
+            major = parts[0];
+            minor = parts[1];
+            patch = parts[2];
+            return {};
         }
 
         String Version<VersionAfter26>::VersionData::toString() const
@@ -257,10 +276,21 @@ namespace cnt
         Version<VersionAfter26>::Version(const String &versionStr)
             : data_(std::make_unique<VersionData>())
         {
-            data_->parse(versionStr);
+            data_->parse(versionStr).value();
             validateComponents();
         }
 
+        Result<Version<VersionAfter26>> Version<VersionAfter26>::parse(const String &versionStr)
+        {
+            Version version;
+            Result<void> parsed = version.data_->parse(versionStr);
+            if (!parsed)
+            {
+                return parsed.error();
+            }
+            return version;
+        }
+
         Version<VersionAfter26>::~Version() = default;
 
         Version<VersionAfter26>::Version(const Version &other)
@@ -289,7 +319,10 @@ namespace cnt
 
         Version<VersionAfter26> &Version<VersionAfter26>::operator=(const String &versionStr)
         {
-            data_->parse(versionStr);
+            // Parsed aside so a bad string leaves this version untouched
+            VersionData parsed;
+            parsed.parse(versionStr).value();
+            *data_ = parsed;
             validateComponents();
             return *this;
         }
@@ -0,0 +1,377 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/source/zip.cpp
+ * @Description:
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <minecraft/zip.hpp>
+#include <minecraft/lib/inflate.hpp>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        namespace internal
+        {
+            std::uint32_t crc32(const void *data, std::size_t size, std::uint32_t crc)
+            {
+                static const std::array<std::uint32_t, 256> table = []
+                {
+                    std::array<std::uint32_t, 256> result{};
+                    for (std::uint32_t i = 0; i < 256; i++)
+                    {
+                        std::uint32_t c = i;
+                        for (int k = 0; k < 8; k++)
+                            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                        result[i] = c;
+                    }
+                    return result;
+                }();
+
+                const std::uint8_t *bytes = static_cast<const std::uint8_t *>(data);
+                crc = ~crc;
+                for (std::size_t i = 0; i < size; i++)
+                    crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+                return ~crc;
+            }
+
+            static std::uint16_t readLE16(const std::uint8_t *data)
+            {
+                return static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+            }
+
+            static std::uint32_t readLE32(const std::uint8_t *data)
+            {
+                return std::uint32_t(data[0]) | (std::uint32_t(data[1]) << 8) |
+                       (std::uint32_t(data[2]) << 16) | (std::uint32_t(data[3]) << 24);
+            }
+
+            static std::uint64_t readLE64(const std::uint8_t *data)
+            {
+                return std::uint64_t(readLE32(data)) | (std::uint64_t(readLE32(data + 4)) << 32);
+            }
+
+            // Output size to reserve for an entry, once its claimed size is checked
+            // against the bytes it occupies: DEFLATE expands at most 1032:1
+            static std::size_t expectedSize(const ZipEntry &entry, std::string_view data)
+            {
+                std::uint64_t limit = entry.method == 0 ? data.size() : std::uint64_t(data.size()) * 1032 + 1032;
+                if (entry.size > limit)
+                    throw std::runtime_error("Corrupt zip entry: " + String(entry.name));
+                return static_cast<std::size_t>(entry.size);
+            }
+        }
+
+        ZipArchive::ZipArchive(const fs::path &path) : _path(path)
+        {
+            _map();
+            try
+            {
+                _parse();
+            }
+            catch (...)
+            {
+#ifndef _WIN32
+                if (_mapped)
+                    ::munmap(const_cast<std::uint8_t *>(_data), _size);
+#endif
+                throw;
+            }
+        }
+
+        ZipArchive::ZipArchive(std::vector<std::uint8_t> data, const fs::path &path) : _path(path), _buffer(std::move(data))
+        {
+            _data = _buffer.data();
+            _size = _buffer.size();
+            _parse();
+        }
+
+        ZipArchive::~ZipArchive()
+        {
+#ifndef _WIN32
+            if (_mapped)
+                ::munmap(const_cast<std::uint8_t *>(_data), _size);
+#endif
+        }
+
+        void ZipArchive::_map()
+        {
+#ifndef _WIN32
+            int fd = ::open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                throw std::runtime_error("Cannot open file: " + _path.string());
+
+            struct stat st;
+            if (::fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                throw std::runtime_error("Cannot stat file: " + _path.string());
+            }
+            _size = static_cast<std::size_t>(st.st_size);
+            if (_size == 0)
+            {
+                ::close(fd);
+                throw std::runtime_error("Not a zip file: " + _path.string());
+            }
+
+            void *mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (mapping == MAP_FAILED)
+                throw std::runtime_error("Cannot map file: " + _path.string());
+
+            // Entries are read one at a time, readahead of the whole file is waste
+            ::madvise(mapping, _size, MADV_RANDOM);
+            _data = static_cast<const std::uint8_t *>(mapping);
+            _mapped = true;
+#else
+            std::ifstream stream(_path, std::ios::binary);
+            if (!stream.is_open())
+                throw std::runtime_error("Cannot open file: " + _path.string());
+            _buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+            _data = _buffer.data();
+            _size = _buffer.size();
+#endif
+        }
+
+        void ZipArchive::_parse()
+        {
+            using namespace internal;
+            auto corrupt = [this](const char *what)
+            {
+                return std::runtime_error(String(what) + ": " + _path.string());
+            };
+
+            // End of central directory, followed by at most a 64 KiB comment
+            if (_size < 22)
+                throw corrupt("Not a zip file");
+            std::size_t eocd = String::npos;
+            std::size_t lowest = _size > 22 + 65535 ? _size - 22 - 65535 : 0;
+            for (std::size_t pos = _size - 22 + 1; pos-- > lowest;)
+            {
+                if (_data[pos] == 0x50 && readLE32(_data + pos) == 0x06054b50)
+                {
+                    eocd = pos;
+                    break;
+                }
+            }
+            if (eocd == String::npos)
+                throw corrupt("Not a zip file");
+
+            std::uint64_t count = readLE16(_data + eocd + 10);
+            std::uint64_t directorySize = readLE32(_data + eocd + 12);
+            std::uint64_t directoryOffset = readLE32(_data + eocd + 16);
+
+            // Zip64 end of central directory locator sits right before the record
+            if (eocd >= 20 && readLE32(_data + eocd - 20) == 0x07064b50)
+            {
+                std::uint64_t record = readLE64(_data + eocd - 20 + 8);
+                if (record > _size || _size - record < 56 || readLE32(_data + record) != 0x06064b50)
+                    throw corrupt("Corrupt zip64 end of central directory");
+                count = readLE64(_data + record + 32);
+                directorySize = readLE64(_data + record + 40);
+                directoryOffset = readLE64(_data + record + 48);
+            }
+
+            // Subtraction form: the zip64 fields are attacker controlled and a sum may wrap
+            if (directoryOffset > _size || directorySize > _size - directoryOffset)
+                throw corrupt("Corrupt zip central directory");
+
+            // Every record takes at least 46 bytes, do not trust the count blindly
+            _entries.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(count, directorySize / 46)));
+            const std::uint8_t *pos = _data + directoryOffset;
+            const std::uint8_t *end = pos + directorySize;
+            for (std::uint64_t i = 0; i < count; i++)
+            {
+                if (end - pos < 46 || readLE32(pos) != 0x02014b50)
+                    throw corrupt("Corrupt zip central directory");
+
+                ZipEntry entry;
+                entry.method = readLE16(pos + 10);
+                entry.crc32 = readLE32(pos + 16);
+                entry.compressedSize = readLE32(pos + 20);
+                entry.size = readLE32(pos + 24);
+                std::size_t nameLength = readLE16(pos + 28);
+                std::size_t extraLength = readLE16(pos + 30);
+                std::size_t commentLength = readLE16(pos + 32);
+                entry.externalAttributes = readLE32(pos + 38);
+                entry.localHeaderOffset = readLE32(pos + 42);
+                if (static_cast<std::size_t>(end - pos) - 46 < nameLength + extraLength)
+                    throw corrupt("Corrupt zip central directory");
+                entry.name = std::string_view(reinterpret_cast<const char *>(pos + 46), nameLength);
+
+                // Zip64 extended information replaces the saturated fields, in order
+                const std::uint8_t *extra = pos + 46 + nameLength;
+                const std::uint8_t *extraEnd = extra + extraLength;
+                while (extraEnd - extra >= 4)
+                {
+                    std::uint16_t id = readLE16(extra);
+                    std::uint16_t length = readLE16(extra + 2);
+                    const std::uint8_t *field = extra + 4;
+                    const std::uint8_t *fieldEnd = field + std::min<std::size_t>(length, static_cast<std::size_t>(extraEnd - field));
+                    if (id == 0x0001)
+                    {
+                        auto next = [&](std::uint64_t &value)
+                        {
+                            if (value != 0xFFFFFFFFu)
+                                return;
+                            if (fieldEnd - field < 8)
+                                throw corrupt("Corrupt zip64 extra field");
+                            value = readLE64(field);
+                            field += 8;
+                        };
+                        next(entry.size);
+                        next(entry.compressedSize);
+                        next(entry.localHeaderOffset);
+                        break;
+                    }
+                    if (static_cast<std::size_t>(extraEnd - field) <= length)
+                        break;
+                    extra = field + length;
+                }
+
+                _entries.push_back(entry);
+                pos += 46 + nameLength + extraLength;
+                if (static_cast<std::size_t>(end - pos) < commentLength)
+                {
+                    if (i + 1 < count)
+                        throw corrupt("Corrupt zip central directory");
+                    break;
+                }
+                pos += commentLength;
+            }
+        }
+
+        const ZipEntry *ZipArchive::find(std::string_view name) const
+        {
+            std::call_once(_indexOnce, [this]
+                           {
+                _index.reserve(_entries.size());
+                // The first record wins for duplicated names, like the JDK
+                for (std::size_t i = 0; i < _entries.size(); i++)
+                    _index.emplace(_entries[i].name, i); });
+
+            auto it = _index.find(name);
+            return it == _index.end() ? nullptr : &_entries[it->second];
+        }
+
+        std::string_view ZipArchive::raw(const ZipEntry &entry) const
+        {
+            using internal::readLE16;
+            using internal::readLE32;
+
+            // The local header may carry a different extra field than the central one
+            std::uint64_t local = entry.localHeaderOffset;
+            if (local > _size || _size - local < 30 || readLE32(_data + local) != 0x04034b50)
+                throw std::runtime_error("Corrupt zip local header: " + String(entry.name));
+            std::uint64_t offset = local + 30 + readLE16(_data + local + 26) + readLE16(_data + local + 28);
+            if (offset > _size || entry.compressedSize > _size - offset)
+                throw std::runtime_error("Truncated zip entry: " + String(entry.name));
+            return std::string_view(reinterpret_cast<const char *>(_data + offset), static_cast<std::size_t>(entry.compressedSize));
+        }
+
+        std::string_view ZipArchive::view(const ZipEntry &entry) const
+        {
+            if (entry.method != 0)
+                throw std::runtime_error("Zip entry is compressed: " + String(entry.name));
+            return raw(entry);
+        }
+
+        std::vector<std::uint8_t> ZipArchive::read(const ZipEntry &entry) const
+        {
+            std::vector<std::uint8_t> result;
+            std::string_view data = raw(entry);
+            const std::size_t size = internal::expectedSize(entry, data);
+            result.reserve(size);
+
+            if (entry.method == 0)
+                result.assign(data.begin(), data.end());
+            else if (entry.method == 8)
+                cnt::Inflater::inflate(data.data(), data.size(), result, size);
+            else
+                throw std::runtime_error("Unsupported zip compression method in " + String(entry.name));
+
+            if (result.size() != entry.size || internal::crc32(result.data(), result.size()) != entry.crc32)
+                throw std::runtime_error("Corrupt zip entry: " + String(entry.name));
+            return result;
+        }
+
+        void ZipArchive::read(const ZipEntry &entry, const Sink &sink) const
+        {
+            std::string_view data = raw(entry);
+            const std::uint8_t *bytes = reinterpret_cast<const std::uint8_t *>(data.data());
+
+            // The sink never sees more than the entry claims, it may be writing to disk
+            const std::size_t size = internal::expectedSize(entry, data);
+            std::uint32_t crc = 0;
+            std::uint64_t total = 0;
+            if (entry.method == 0)
+            {
+                if (data.size() != size)
+                    throw std::runtime_error("Corrupt zip entry: " + String(entry.name));
+                crc = internal::crc32(bytes, data.size());
+                total = data.size();
+                sink(bytes, data.size());
+            }
+            else if (entry.method == 8)
+            {
+                cnt::Inflater::inflate(bytes, data.size(), [&](const std::uint8_t *chunk, std::size_t length)
+                                       {
+                    crc = internal::crc32(chunk, length, crc);
+                    total += length;
+                    sink(chunk, length); },
+                                       size);
+            }
+            else
+            {
+                throw std::runtime_error("Unsupported zip compression method in " + String(entry.name));
+            }
+
+            if (total != entry.size || crc != entry.crc32)
+                throw std::runtime_error("Corrupt zip entry: " + String(entry.name));
+        }
+
+        bool ZipArchive::readString(std::string_view name, String &out) const
+        {
+            const ZipEntry *entry = find(name);
+            if (!entry)
+                return false;
+
+            out.clear();
+            out.reserve(internal::expectedSize(*entry, raw(*entry)));
+            read(*entry, [&out](const std::uint8_t *chunk, std::size_t length)
+                 { out.append(reinterpret_cast<const char *>(chunk), length); });
+            return true;
+        }
+    } // namespace minecraft
+
+} // namespace cnt
@@ -0,0 +1,115 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/tuning.hpp
+ * @Description: Plans JVM heap, GC and runtime flags from host resources
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__TUNING_HPP__
+#define __MINECRAFT_ENGINE__TUNING_HPP__
+
+#include <minecraft/cntconfig.hpp>
+#include <minecraft/java.hpp>
+#include <minecraft/host.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        enum class JvmCollector
+        {
+            Auto,
+            G1,
+            Z,
+            Shenandoah,
+            Parallel
+        };
+
+        struct JvmPlanOptions
+        {
+            // Dedicated server instead of a client
+            bool server = false;
+
+            // Runs a mod loader, and how many mods it loads
+            bool modded = false;
+            std::size_t modCount = 0;
+
+            // Instances expected to run on this host at the same time, this one included
+            unsigned int concurrentInstances = 1;
+
+            // Collector to use, Auto picks one from the Java version and heap size
+            JvmCollector collector = JvmCollector::Auto;
+
+            // Prefer a concurrent collector (ZGC, Shenandoah) over throughput
+            bool lowLatency = false;
+
+            // Memory left to the OS and other programs, 0 picks a share of the host
+            std::uint64_t reservedMemory = 0;
+
+            // Upper bound for the heap, 0 for none
+            std::uint64_t maxHeap = 0;
+        };
+
+        struct JvmPlan
+        {
+            std::uint64_t heap = 0;        // -Xmx
+            std::uint64_t initialHeap = 0; // -Xms
+            JvmCollector collector = JvmCollector::G1;
+            unsigned int activeProcessors = 0; // 0 when the JVM default is right
+            bool preTouch = false;
+            bool largePages = false;
+
+            // Ready to pass as LaunchOptions::jvmArgs
+            std::vector<String> arguments;
+        };
+
+        /**
+         * Plan JVM options for one instance
+         * The heap is sized from what the instance needs and what the host
+         * (or its cgroup) can give, split across concurrently running instances
+         * so that their heaps plus JVM overhead never exceed the host memory.
+         * Throws when each instance cannot get a 512 MiB heap within that budget,
+         * unless a smaller maxHeap was asked for.
+         * @param java Runtime the instance runs on
+         * @param host Host resources, see HostResources::detect
+         * @param options Instance profile
+         */
+        JvmPlan PlanJvmOptions(const JavaInfo &java, const HostResources &host, const JvmPlanOptions &options);
+
+        namespace internal
+        {
+            // Whether a runtime ships Shenandoah (not in Oracle builds)
+            bool javaHasShenandoah(const JavaInfo &java);
+
+            // "-Xmx" style size: whole gigabytes as "G", otherwise "M"
+            String formatJvmSize(std::uint64_t bytes);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/tuning.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__TUNING_HPP__
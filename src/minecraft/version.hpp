@@ -25,9 +25,9 @@
 #define __MINECRAFT_ENGINE__VERSION_HPP__
 
 #include <minecraft/cntconfig.hpp>
+#include <minecraft/lib/result.hpp>
 
 #include <stdexcept>
-#include <regex>
 #include <memory>
 
 namespace cnt
@@ -103,7 +103,7 @@ namespace cnt
                 int patch = 0;
 
                 // Parse version string in format "1.minor.patch" or "minor.patch"
-                void parse(const String &versionStr);
+                Result<void> parse(const String &versionStr);
 
                 // Convert to string
                 String toString() const;
@@ -122,6 +122,9 @@ namespace cnt
             // Constructor with version string
             explicit Version(const String &versionStr);
 
+            // Non-throwing parse, the constructor and string assignment wrap it
+            static Result<Version> parse(const String &versionStr);
+
             // Destructor
             ~Version();
 
@@ -167,7 +170,7 @@ namespace cnt
                 int patch = 0;
 
                 // Parse version string in format "major.minor" or "major.minor.patch"
-                void parse(const String &versionStr);
+                Result<void> parse(const String &versionStr);
 
                 // Convert to string
                 String toString() const;
@@ -186,6 +189,9 @@ namespace cnt
             // Constructor with version string
             explicit Version(const String &versionStr);
 
+            // Non-throwing parse, the constructor and string assignment wrap it
+            static Result<Version> parse(const String &versionStr);
+
             // Destructor
             ~Version();
 
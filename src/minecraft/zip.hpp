@@ -0,0 +1,126 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: minecraft/zip.hpp
+ * @Description: Memory-mapped zip/jar reader
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__ZIP_HPP__
+#define __MINECRAFT_ENGINE__ZIP_HPP__
+
+#include <minecraft/cntconfig.hpp>
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+namespace cnt
+{
+    namespace minecraft
+    {
+        // One central directory record, name points into the mapping
+        struct ZipEntry
+        {
+            std::string_view name;
+            std::uint16_t method = 0; // 0 stored, 8 deflate
+            std::uint32_t crc32 = 0;
+            std::uint64_t compressedSize = 0;
+            std::uint64_t size = 0;
+            std::uint64_t localHeaderOffset = 0;
+            std::uint32_t externalAttributes = 0;
+
+            bool isDirectory() const { return !name.empty() && name.back() == '/'; }
+        };
+
+        /**
+         * Read-only view of a zip archive
+         * The file is mapped and only the end of central directory and the central
+         * directory are parsed on open; entry data is touched when it is read.
+         * Reading is thread safe.
+         */
+        class ZipArchive
+        {
+        public:
+            // Receives decompressed data in order
+            using Sink = std::function<void(const std::uint8_t *, std::size_t)>;
+
+        private:
+            fs::path _path;
+            const std::uint8_t *_data = nullptr;
+            std::size_t _size = 0;
+            bool _mapped = false;
+            std::vector<std::uint8_t> _buffer; // Used where mapping is unavailable
+            std::vector<ZipEntry> _entries;
+
+            mutable std::once_flag _indexOnce;
+            mutable std::unordered_map<std::string_view, std::size_t> _index;
+
+            void _map();
+            void _parse();
+
+        public:
+            explicit ZipArchive(const fs::path &path);
+            // Archive held in memory (e.g. a jar nested in another one), path only names it in errors
+            ZipArchive(std::vector<std::uint8_t> data, const fs::path &path);
+            ~ZipArchive();
+            ZipArchive(const ZipArchive &) = delete;
+            ZipArchive &operator=(const ZipArchive &) = delete;
+
+            const fs::path &path() const { return _path; }
+            const std::vector<ZipEntry> &entries() const { return _entries; }
+            std::size_t size() const { return _entries.size(); }
+
+            // Find an entry by name, the lookup table is built on first use
+            const ZipEntry *find(std::string_view name) const;
+
+            // Raw (possibly compressed) data of an entry inside the mapping
+            std::string_view raw(const ZipEntry &entry) const;
+
+            // Contents of a stored entry without copying, throws for compressed entries
+            std::string_view view(const ZipEntry &entry) const;
+
+            // Decompress an entry into memory, checking its CRC
+            std::vector<std::uint8_t> read(const ZipEntry &entry) const;
+
+            // Decompress an entry into a sink with bounded memory, checking its CRC
+            void read(const ZipEntry &entry, const Sink &sink) const;
+
+            // Contents of an entry by name, false if there is no such entry
+            bool readString(std::string_view name, String &out) const;
+        };
+
+        namespace internal
+        {
+            // CRC-32 (IEEE), pass the previous value to continue a running checksum
+            std::uint32_t crc32(const void *data, std::size_t size, std::uint32_t crc = 0);
+        }
+    } // namespace minecraft
+
+} // namespace cnt
+
+#ifdef MINECRAFT_ENGINE_IMPLEMENTATION
+#include <minecraft/source/zip.cpp>
+#endif // MINECRAFT_ENGINE_IMPLEMENTATION
+
+#endif // !__MINECRAFT_ENGINE__ZIP_HPP__
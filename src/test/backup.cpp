@@ -0,0 +1,159 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: test/backup.cpp
+ * @Description: Backup manifests, chunking and a backup and restore cycle
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <test/test.hpp>
+#include <minecraft/backup.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace cnt;
+using namespace cnt::minecraft;
+
+namespace
+{
+    void testManifest()
+    {
+        BackupFile plain;
+        plain.path = "saves/world/level.dat";
+        plain.size = 4096;
+        plain.mtime = 1700000000123456789LL;
+        plain.inode = 42;
+        plain.mode = 0644;
+        plain.chunks.resize(2);
+        plain.chunks[0].fill(0xab);
+        plain.chunks[1].fill(0x01);
+
+        BackupFile odd;
+        odd.path = "odd name\\with\nnewline";
+        odd.mtime = -5;
+
+        BackupFile empty;
+        empty.path = "empty";
+
+        const String text = internal::formatBackupManifest({plain, odd, empty});
+        std::vector<BackupFile> files = internal::parseBackupManifest(text);
+        CNT_CHECK(files.size() == 3);
+        if (files.size() == 3)
+        {
+            CNT_CHECK(files[0].path == plain.path && files[0].size == 4096 && files[0].mtime == plain.mtime);
+            CNT_CHECK(files[0].inode == 42 && files[0].mode == 0644);
+            CNT_CHECK(files[0].chunks == plain.chunks);
+            CNT_CHECK(files[1].path == odd.path && files[1].mtime == -5);
+            CNT_CHECK(files[2].path == "empty" && files[2].chunks.empty());
+        }
+
+        CNT_CHECK_THROWS(internal::parseBackupManifest(""));
+        CNT_CHECK_THROWS(internal::parseBackupManifest("cnt-backup 2\n"));
+        CNT_CHECK_THROWS(internal::parseBackupManifest("cnt-backup 1\n1 2 3\n"));
+        CNT_CHECK_THROWS(internal::parseBackupManifest("cnt-backup 1\n1 x 3 4 0 path\n"));
+        CNT_CHECK_THROWS(internal::parseBackupManifest("cnt-backup 1\n1 2 3 4 1 nothex path\n"));
+        CNT_CHECK_THROWS(internal::parseBackupManifest("cnt-backup 1\n1 2 3 4 999999999999 path\n"));
+    }
+
+    void testChunking()
+    {
+        std::vector<std::uint8_t> data(4 << 20);
+        std::mt19937 random(7);
+        for (auto &byte : data)
+            byte = static_cast<std::uint8_t>(random());
+
+        // Boundaries stay within the bounds and cover the input exactly
+        std::vector<std::size_t> cuts;
+        for (std::size_t offset = 0; offset < data.size();)
+        {
+            std::size_t length = internal::nextChunkBoundary(data.data() + offset, data.size() - offset);
+            CNT_CHECK(length > 0 && length <= 256 * 1024);
+            CNT_CHECK(length >= 16 * 1024 || offset + length == data.size());
+            offset += length;
+            cuts.push_back(offset);
+        }
+        CNT_CHECK(cuts.size() > 8);
+
+        // An insertion only moves the boundaries around it
+        std::vector<std::uint8_t> edited = data;
+        edited.insert(edited.begin() + 100, 10, 0x55);
+        std::size_t shared = 0;
+        for (std::size_t offset = 0; offset < edited.size();)
+        {
+            offset += internal::nextChunkBoundary(edited.data() + offset, edited.size() - offset);
+            for (std::size_t cut : cuts)
+                shared += cut + 10 == offset;
+        }
+        CNT_CHECK(shared + 2 >= cuts.size());
+    }
+
+    void testStore(const fs::path &root)
+    {
+        const fs::path source = root / "instance";
+        String large;
+        std::mt19937 random(11);
+        for (int i = 0; i < 300000; i++)
+            large += static_cast<char>('a' + random() % 26);
+        test::writeFile(source / "saves" / "world" / "level.dat", large);
+        test::writeFile(source / "options.txt", "fov:70\n");
+        test::writeFile(source / "logs" / "latest.log", "excluded");
+        fs::create_directories(source / "empty");
+
+        BackupStore store(root / "store");
+        CNT_CHECK_THROWS(store.backup(source, "../escape"));
+
+        BackupStats first = store.backup(source, "instance");
+        CNT_CHECK(first.files == 2);
+        CNT_CHECK(first.newChunks > 0);
+        CNT_CHECK(store.snapshots("instance").size() == 1);
+
+        // Unchanged files are taken from the previous snapshot without being read
+        test::writeFile(source / "options.txt", "fov:90\n");
+        BackupStats second = store.backup(source, "instance");
+        CNT_CHECK(second.unchangedFiles == 1);
+        CNT_CHECK(second.readBytes == 7);
+        CNT_CHECK(store.snapshots("instance").size() == 2);
+
+        const fs::path restored = root / "restored";
+        store.restore(first.snapshot, restored);
+        CNT_CHECK(test::readFile(restored / "saves" / "world" / "level.dat") == large);
+        CNT_CHECK(test::readFile(restored / "options.txt") == "fov:70\n");
+        CNT_CHECK(!fs::exists(restored / "logs" / "latest.log"));
+
+        store.restore(second.snapshot, restored);
+        CNT_CHECK(test::readFile(restored / "options.txt") == "fov:90\n");
+
+        // Pruning the old snapshot frees only the chunks nothing else uses
+        store.prune("instance", 1);
+        CNT_CHECK(store.snapshots("instance").size() == 1);
+        CNT_CHECK(store.collectGarbage() == 1);
+        store.restore(second.snapshot, root / "again");
+        CNT_CHECK(test::readFile(root / "again" / "saves" / "world" / "level.dat") == large);
+    }
+}
+
+int main()
+{
+    testManifest();
+    testChunking();
+
+    test::TemporaryDirectory root("backup");
+    testStore(root.path());
+    return test::finish("backup");
+}
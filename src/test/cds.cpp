@@ -0,0 +1,162 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: test/cds.cpp
+ * @Description: Class data sharing across launches, against a stub java
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <test/test.hpp>
+#include <minecraft/instance.hpp>
+
+#include <vector>
+
+using namespace cnt;
+using namespace cnt::minecraft;
+
+namespace
+{
+    // Records its arguments one per line and writes the archive it is asked to dump
+    const char *StubJava = R"(#!/bin/sh
+printf '%s\n' "$@" > "$(dirname "$0")/../argv"
+for arg in "$@"; do
+    case "$arg" in
+        -XX:ArchiveClassesAtExit=*) echo archive > "${arg#-XX:ArchiveClassesAtExit=}" ;;
+    esac
+done
+exit 0
+)";
+
+    struct Launch
+    {
+        std::vector<String> arguments;
+        int exitCode = -1;
+
+        bool has(std::string_view prefix) const
+        {
+            for (const auto &argument : arguments)
+            {
+                if (argument.compare(0, prefix.size(), prefix) == 0)
+                    return true;
+            }
+            return false;
+        }
+    };
+
+    Launch launch(const Instance &instance, const JavaInfo &java)
+    {
+        LaunchOptions options;
+        options.variables.set(LaunchSlot::NativesDirectory, (instance.getPath() / "natives").string());
+
+        Launch result;
+        result.exitCode = instance.launch(java, options)->wait();
+
+        std::ifstream file(java.path / "argv");
+        for (String line; std::getline(file, line);)
+            result.arguments.push_back(line);
+        return result;
+    }
+
+    std::size_t archives(const fs::path &directory)
+    {
+        std::size_t count = 0;
+        std::error_code ec;
+        for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec))
+            count += it->path().extension() == ".jsa";
+        return count;
+    }
+}
+
+int main()
+{
+    test::TemporaryDirectory root("cds");
+
+    const fs::path jdk = root.path() / "jdk";
+    test::writeFile(jdk / "bin" / "java", StubJava);
+    fs::permissions(jdk / "bin" / "java", fs::perms::owner_all | fs::perms::group_read | fs::perms::group_exec);
+    test::writeFile(jdk / "lib" / "modules", "modules");
+
+    Index index(root.path() / "index");
+    test::writeFile(index.getPath() / "versions" / "test" / "test.json", R"({
+    "id": "test",
+    "type": "release",
+    "mainClass": "net.minecraft.client.main.Main",
+    "arguments": {
+        "jvm": ["-cp", "${classpath}"],
+        "game": ["--version", "${version_name}"]
+    },
+    "libraries": [
+        {"name": "org.example:library:1.0", "downloads": {"artifact": {"path": "org/example/library/1.0/library-1.0.jar"}}}
+    ]
+})");
+    test::writeFile(index.getPath() / "versions" / "test" / "test.jar", "game");
+    const fs::path library = index.getPath() / "libraries" / "org" / "example" / "library" / "1.0" / "library-1.0.jar";
+    test::writeFile(library, "library");
+
+    Instance instance(index, "test");
+    const fs::path cache = index.getPath() / "cache" / "cds";
+    JavaInfo java("stub", "test", "JDK", jdk, "17.0.2");
+
+    // The first launch dumps an archive, the next one maps it
+    Launch first = launch(instance, java);
+    CNT_CHECK(first.exitCode == 0);
+    CNT_CHECK(first.has("-XX:ArchiveClassesAtExit="));
+    CNT_CHECK(!first.has("-XX:SharedArchiveFile="));
+    CNT_CHECK(archives(cache) == 1);
+
+    Launch second = launch(instance, java);
+    CNT_CHECK(second.has("-XX:SharedArchiveFile="));
+    CNT_CHECK(second.has("-Xshare:auto"));
+    CNT_CHECK(!second.has("-XX:ArchiveClassesAtExit="));
+    CNT_CHECK(archives(cache) == 1);
+
+    // A changed classpath jar starts a new archive
+    test::writeFile(library, "library, rebuilt");
+    Launch changedClasspath = launch(instance, java);
+    CNT_CHECK(changedClasspath.has("-XX:ArchiveClassesAtExit="));
+    CNT_CHECK(archives(cache) == 2);
+    CNT_CHECK(launch(instance, java).has("-XX:SharedArchiveFile="));
+
+    // So does another runtime version, or the runtime image updated in place
+    JavaInfo updated("stub", "test", "JDK", jdk, "17.0.3");
+    CNT_CHECK(launch(instance, updated).has("-XX:ArchiveClassesAtExit="));
+    CNT_CHECK(launch(instance, updated).has("-XX:SharedArchiveFile="));
+
+    test::writeFile(jdk / "lib" / "modules", "modules, updated");
+    CNT_CHECK(launch(instance, updated).has("-XX:ArchiveClassesAtExit="));
+    CNT_CHECK(archives(cache) == 4);
+
+    // Runtimes before 13 cannot dump dynamic archives
+    JavaInfo legacy("stub", "test", "JDK", jdk, "11.0.20");
+    Launch old = launch(instance, legacy);
+    CNT_CHECK(!old.has("-XX:ArchiveClassesAtExit="));
+    CNT_CHECK(!old.has("-XX:SharedArchiveFile="));
+
+    // Without class data sharing nothing is added
+    LaunchOptions options;
+    options.classDataSharing = false;
+    options.variables.set(LaunchSlot::NativesDirectory, (instance.getPath() / "natives").string());
+    LaunchCommand command;
+    instance.buildLaunchCommand(java, options, command);
+    bool sharing = false;
+    for (char *const *argument = command.argv(); *argument != nullptr; argument++)
+        sharing = sharing || std::string_view(*argument).find("Archive") != std::string_view::npos;
+    CNT_CHECK(!sharing);
+
+    return test::finish("cds");
+}
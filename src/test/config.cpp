@@ -0,0 +1,144 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: test/config.cpp
+ * @Description: Config parsing, escapes, limits and round trips
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <test/test.hpp>
+#include <minecraft/lib/config.hpp>
+#include <minecraft/index.hpp>
+
+using namespace cnt;
+
+namespace
+{
+    String parsedString(const String &literal)
+    {
+        Config config;
+        if (!config.try_parse("value: " + literal))
+            return "<error>";
+        return config.get("value").as_string().value_or("<not a string>");
+    }
+
+    void testEscapes()
+    {
+        CNT_CHECK(parsedString(R"("a\nb\tc\rd")") == "a\nb\tc\rd");
+        CNT_CHECK(parsedString(R"("back\bspace")") == "back\bspace");
+        CNT_CHECK(parsedString(R"("form\ffeed")") == "form\ffeed");
+        CNT_CHECK(parsedString(R"("quote \" backslash \\ slash \/")") == "quote \" backslash \\ slash /");
+        CNT_CHECK(parsedString(R"("\u00e9\u4e2d")") == "\xc3\xa9\xe4\xb8\xad");
+        CNT_CHECK(parsedString(R"("\ud83d\ude00")") == "\xf0\x9f\x98\x80");
+
+        // A short escape is an error, a lone surrogate becomes U+FFFD
+        CNT_CHECK(parsedString(R"("\u12")") == "<error>");
+        CNT_CHECK(parsedString(R"("\ud83d")") == "\xef\xbf\xbd");
+
+        Config characters;
+        CNT_CHECK(characters.try_parse(R"(a: '\b', b: '\f', c: 'x')"));
+        CNT_CHECK(characters.get("a").as_character() == std::optional<char>('\b'));
+        CNT_CHECK(characters.get("b").as_character() == std::optional<char>('\f'));
+        CNT_CHECK(characters.get("c").as_character() == std::optional<char>('x'));
+    }
+
+    void testValues()
+    {
+        Config config;
+        CNT_CHECK(config.try_parse(R"(
+// Line comment
+number: 42, /* block comment */
+negative: -7,
+flag: true,
+nothing: None,
+list: [1, 2, /* inside */ 3],
+object: {
+    inner: "value", // after a member
+    nested: { deep: false }
+}
+)"));
+        CNT_CHECK(config.get("number").as_number() == std::optional<long long>(42));
+        CNT_CHECK(config.get("negative").as_number() == std::optional<long long>(-7));
+        CNT_CHECK(config.get("flag").as_boolean() == std::optional<bool>(true));
+        CNT_CHECK(config.get("list").is_array() && config.get("list").size() == 3);
+        CNT_CHECK(config.get("object").at("inner").as_string() == std::optional<String>("value"));
+        CNT_CHECK(config.get("object").at("nested").at("deep").as_boolean() == std::optional<bool>(false));
+        CNT_CHECK(!config.get("missing").is_string());
+    }
+
+    void testLimits()
+    {
+        // Nesting past the limit fails without exhausting the stack
+        Config config;
+        config.set("kept", "yes");
+        CNT_CHECK(!config.try_parse("value: " + String(100000, '[') + String(100000, ']')));
+        CNT_CHECK(!config.try_parse("value: " + String(100000, '{')));
+        CNT_CHECK(config.get("kept").as_string() == std::optional<String>("yes"));
+
+        Config nested;
+        CNT_CHECK(nested.try_parse("value: " + String(100, '[') + String(100, ']')));
+
+        CNT_CHECK_THROWS(Config().parse("value: " + String(1000, '[')));
+        CNT_CHECK_THROWS(Config().open("/nonexistent/config.cco"));
+    }
+
+    void testRoundTrip(const fs::path &directory)
+    {
+        Config config;
+        config.set("text", "line\nbreak \"quoted\" back\\slash \b\f\t");
+        config.set("number", 12);
+        config.set("character", '\f');
+        config.save(directory / "round.cco");
+
+        Config loaded;
+        CNT_CHECK(loaded.try_open(directory / "round.cco"));
+        CNT_CHECK(loaded.get("text").as_string() == config.get("text").as_string());
+        CNT_CHECK(loaded.get("number").as_number() == std::optional<long long>(12));
+        CNT_CHECK(loaded.get("character").as_character() == std::optional<char>('\f'));
+    }
+
+    void testIndexConfig(const fs::path &directory)
+    {
+        // The meic.cco written by Index parses, and an old-format one is regenerated
+        const fs::path path = directory / "index \"quoted\"";
+        minecraft::Index index(path);
+        Config meic;
+        CNT_CHECK(meic.try_open(path / "meic.cco"));
+        CNT_CHECK(meic.get("name").as_string() == std::optional<String>("index \"quoted\""));
+        CNT_CHECK(meic.get("config").is_object());
+
+        test::writeFile(path / "meic.cco", "name: old\nlastVersion: None,\nconfig: {\n    VersionIsolation: 2, // comment\n}.\n");
+        minecraft::Index migrated(path);
+        Config regenerated;
+        CNT_CHECK(regenerated.try_open(path / "meic.cco"));
+        CNT_CHECK(regenerated.get("config").is_object());
+        CNT_CHECK(fs::exists(path / "meic.cco.old"));
+    }
+}
+
+int main()
+{
+    testEscapes();
+    testValues();
+    testLimits();
+
+    test::TemporaryDirectory root("config");
+    testRoundTrip(root.path());
+    testIndexConfig(root.path());
+    return test::finish("config");
+}
@@ -0,0 +1,165 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: test/nbt.cpp
+ * @Description: NBT writer, reader and document, compressed and malformed input
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <test/test.hpp>
+#include <minecraft/nbt.hpp>
+
+#include <vector>
+
+using namespace cnt;
+using namespace cnt::minecraft;
+
+namespace
+{
+    // A small level.dat
+    std::vector<std::uint8_t> level(NbtCompression compression)
+    {
+        const std::int32_t ints[] = {1, -2, 3};
+        const std::int64_t longs[] = {INT64_MIN, 0, INT64_MAX};
+
+        NbtWriter writer;
+        writer.beginCompound();
+        writer.beginCompound("Data");
+        writer.writeString("LevelName", "World");
+        writer.writeLong("Time", 123456789012LL);
+        writer.writeByte("hardcore", 1);
+        writer.writeShort("Short", -300);
+        writer.writeFloat("Float", 0.5f);
+        writer.writeDouble("Double", -2.25);
+        writer.beginCompound("Version");
+        writer.writeInt("Id", 3465);
+        writer.writeString("Name", "1.20.1");
+        writer.endCompound();
+        writer.beginList("Players", NbtType::String);
+        writer.writeString("", "alice");
+        writer.writeString("", "bob");
+        writer.endList();
+        writer.writeIntArray("Ints", ints, 3);
+        writer.writeLongArray("Longs", longs, 3);
+        writer.writeByteArray("Bytes", "abc", 3);
+        writer.endCompound();
+        writer.endCompound();
+        return writer.finish(compression);
+    }
+
+    void testDocument()
+    {
+        for (NbtCompression compression : {NbtCompression::None, NbtCompression::GZip, NbtCompression::Zlib})
+        {
+            std::vector<std::uint8_t> bytes = level(compression);
+            CNT_CHECK(internal::detectNbtCompression(bytes.data(), bytes.size()) == compression);
+
+            NbtDocument document = NbtDocument::parse(std::move(bytes));
+            CNT_CHECK(document.compression() == compression);
+
+            NbtNode data = document.root()["Data"];
+            CNT_CHECK(data.type() == NbtType::Compound);
+            CNT_CHECK(data["LevelName"].asString() == "World");
+            CNT_CHECK(data["Time"].asInteger() == 123456789012LL);
+            CNT_CHECK(data["hardcore"].asInteger() == 1);
+            CNT_CHECK(data["Short"].asInteger() == -300);
+            CNT_CHECK(data["Float"].asNumber() == 0.5);
+            CNT_CHECK(data["Double"].asNumber() == -2.25);
+            CNT_CHECK(document.root().find("Data.Version.Name").asString() == "1.20.1");
+            CNT_CHECK(document.root().find("Data.Version.Id").asInteger() == 3465);
+            CNT_CHECK(!document.root().find("Data.Missing.Name").valid());
+
+            NbtNode players = data["Players"];
+            CNT_CHECK(players.size() == 2 && players.elementType() == NbtType::String);
+            CNT_CHECK(players.at(0).asString() == "alice" && players.at(1).asString() == "bob");
+
+            NbtArrayView ints = data["Ints"].asArray();
+            CNT_CHECK(ints.size() == 3 && ints[0] == 1 && ints[1] == -2 && ints[2] == 3);
+            NbtArrayView longs = data["Longs"].asArray();
+            CNT_CHECK(longs.size() == 3 && longs[0] == INT64_MIN && longs[2] == INT64_MAX);
+            CNT_CHECK(data["Bytes"].asArray().size() == 3);
+
+            std::size_t children = 0;
+            for (NbtNode child : data)
+                children += child.valid();
+            CNT_CHECK(children == data.size());
+        }
+    }
+
+    void testReader()
+    {
+        std::vector<std::uint8_t> bytes = level(NbtCompression::None);
+
+        NbtReader reader(bytes.data(), bytes.size());
+        CNT_CHECK(reader.seek("Data.Version.Name"));
+        CNT_CHECK(reader.string() == "1.20.1");
+
+        NbtReader missing(bytes.data(), bytes.size());
+        CNT_CHECK(!missing.seek("Data.Nothing"));
+
+        // Skipping the root compound consumes the whole document
+        NbtReader skipping(bytes.data(), bytes.size());
+        CNT_CHECK(skipping.next() == NbtReader::Token::BeginCompound);
+        skipping.skip();
+        CNT_CHECK(skipping.position() == bytes.size());
+    }
+
+    void testMalformed()
+    {
+        std::vector<std::uint8_t> bytes = level(NbtCompression::None);
+
+        // Every truncation fails instead of reading past the end
+        for (std::size_t size = 1; size < bytes.size(); size += 7)
+            CNT_CHECK_THROWS(NbtDocument::parse(std::vector<std::uint8_t>(bytes.begin(), bytes.begin() + size)));
+
+        // A list claiming more elements than there are bytes
+        const std::uint8_t list[] = {10, 0, 0, 9, 0, 1, 'l', 3, 0x7f, 0xff, 0xff, 0xff, 0};
+        CNT_CHECK_THROWS(NbtDocument::parse(std::vector<std::uint8_t>(list, list + sizeof(list))));
+
+        // Nesting deeper than the reader's stack
+        std::vector<std::uint8_t> deep = {10, 0, 0};
+        for (std::size_t i = 0; i < NbtReader::MaxDepth + 8; i++)
+            deep.insert(deep.end(), {10, 0, 1, 'c'});
+        deep.insert(deep.end(), NbtReader::MaxDepth + 9, 0);
+        CNT_CHECK_THROWS(NbtDocument::parse(std::move(deep)));
+
+        // Compressed input that inflates past the limit
+        std::vector<std::uint8_t> zeros(1 << 20, 0), gzip, zlib, out;
+        internal::deflateGzip(zeros.data(), zeros.size(), gzip);
+        internal::deflateZlib(zeros.data(), zeros.size(), zlib);
+        CNT_CHECK_THROWS(internal::inflateGzip(gzip.data(), gzip.size(), out, 4096));
+        out.clear();
+        CNT_CHECK_THROWS(internal::inflateZlib(zlib.data(), zlib.size(), out, 4096));
+        out.clear();
+        internal::inflateGzip(gzip.data(), gzip.size(), out);
+        CNT_CHECK(out == zeros);
+
+        // A corrupt checksum
+        gzip[gzip.size() - 5] ^= 0xff;
+        out.clear();
+        CNT_CHECK_THROWS(internal::inflateGzip(gzip.data(), gzip.size(), out));
+    }
+}
+
+int main()
+{
+    testDocument();
+    testReader();
+    testMalformed();
+    return test::finish("nbt");
+}
@@ -0,0 +1,218 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: test/region.cpp
+ * @Description: Region file reading, damaged headers and compaction
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <test/test.hpp>
+#include <minecraft/region.hpp>
+#include <minecraft/nbt.hpp>
+
+#include <vector>
+
+using namespace cnt;
+using namespace cnt::minecraft;
+
+namespace
+{
+    constexpr std::size_t Sector = RegionFile::SectorSize;
+
+    struct TestChunk
+    {
+        int x;
+        int z;
+        std::int64_t inhabited;
+        std::uint32_t sector; // where the chunk starts
+    };
+
+    std::vector<std::uint8_t> chunkNbt(const TestChunk &chunk)
+    {
+        NbtWriter writer;
+        writer.beginCompound();
+        writer.writeInt("xPos", chunk.x);
+        writer.writeInt("zPos", chunk.z);
+        writer.writeLong("InhabitedTime", chunk.inhabited);
+        writer.writeString("Status", "minecraft:full");
+        writer.endCompound();
+        return writer.finish();
+    }
+
+    void putInt(std::vector<std::uint8_t> &out, std::size_t offset, std::uint32_t value)
+    {
+        for (int i = 0; i < 4; i++)
+            out[offset + i] = static_cast<std::uint8_t>(value >> (24 - 8 * i));
+    }
+
+    // A region file with zlib chunks at the given sectors, gaps left between them
+    std::vector<std::uint8_t> buildRegion(const std::vector<TestChunk> &chunks)
+    {
+        std::vector<std::uint8_t> out(2 * Sector, 0);
+        for (const auto &chunk : chunks)
+        {
+            std::vector<std::uint8_t> nbt = chunkNbt(chunk), payload;
+            internal::deflateZlib(nbt.data(), nbt.size(), payload);
+
+            const std::size_t start = chunk.sector * Sector;
+            const std::size_t sectors = (payload.size() + 5 + Sector - 1) / Sector;
+            if (out.size() < start + sectors * Sector)
+                out.resize(start + sectors * Sector, 0);
+            putInt(out, start, static_cast<std::uint32_t>(payload.size() + 1));
+            out[start + 4] = static_cast<std::uint8_t>(RegionCompression::Zlib);
+            std::copy(payload.begin(), payload.end(), out.begin() + start + 5);
+
+            const std::size_t index = static_cast<std::size_t>(chunk.x + chunk.z * 32);
+            putInt(out, index * 4, (chunk.sector << 8) | static_cast<std::uint32_t>(sectors));
+            putInt(out, Sector + index * 4, 1700000000);
+        }
+        return out;
+    }
+
+    void write(const fs::path &path, const std::vector<std::uint8_t> &bytes)
+    {
+        test::writeFile(path, std::string_view(reinterpret_cast<const char *>(bytes.data()), bytes.size()));
+    }
+
+    void testRead(const fs::path &directory)
+    {
+        const fs::path path = directory / "r.0.0.mca";
+        write(path, buildRegion({{0, 0, 100, 2}, {5, 7, 5000, 3}}));
+
+        RegionFile region(path);
+        CNT_CHECK(region.chunks().size() == 2);
+        CNT_CHECK(region.invalidChunks() == 0);
+        CNT_CHECK(region.find(1, 1) == nullptr);
+
+        const RegionChunk *chunk = region.find(5, 7);
+        CNT_CHECK(chunk != nullptr);
+        if (chunk)
+        {
+            CNT_CHECK(chunk->compression == static_cast<std::uint8_t>(RegionCompression::Zlib));
+            CNT_CHECK(chunk->timestamp == 1700000000);
+            std::vector<std::uint8_t> nbt = region.read(*chunk);
+            CNT_CHECK(internal::readInhabitedTime(nbt.data(), nbt.size()) == std::optional<std::int64_t>(5000));
+            NbtDocument document = NbtDocument::parse(std::move(nbt));
+            CNT_CHECK(document.root()["xPos"].asInteger() == 5);
+        }
+
+        CNT_CHECK(region.externalPath(*region.find(0, 0)).filename() == "c.0.0.mcc");
+    }
+
+    void testDamaged(const fs::path &directory)
+    {
+        // Too short to hold the header
+        const fs::path small = directory / "r.1.0.mca";
+        test::writeFile(small, String(100, '\0'));
+        CNT_CHECK_THROWS(RegionFile{small});
+
+        // A chunk length that does not fit its sectors, or wraps when 4 is added
+        std::vector<std::uint8_t> bytes = buildRegion({{0, 0, 100, 2}, {1, 0, 100, 3}});
+        putInt(bytes, 2 * Sector, 0xfffffffeu);
+        putInt(bytes, 3 * Sector, 0x00100000u);
+        const fs::path lengths = directory / "r.2.0.mca";
+        write(lengths, bytes);
+        {
+            RegionFile region(lengths);
+            CNT_CHECK(region.chunks().size() == 2);
+            for (const auto &chunk : region.chunks())
+            {
+                CNT_CHECK(chunk.length == 0);
+                CNT_CHECK(region.raw(chunk).empty());
+                CNT_CHECK_THROWS(region.read(chunk));
+            }
+        }
+
+        // Header entries pointing into the header or past the end
+        bytes = buildRegion({{0, 0, 100, 2}});
+        putInt(bytes, 4, (1u << 8) | 1);
+        putInt(bytes, 8, (4000u << 8) | 1);
+        const fs::path outside = directory / "r.3.0.mca";
+        write(outside, bytes);
+        {
+            RegionFile region(outside);
+            CNT_CHECK(region.chunks().size() == 1);
+            CNT_CHECK(region.invalidChunks() == 2);
+        }
+        CNT_CHECK_THROWS(CompactRegionFile(outside));
+
+        // Corrupt compressed data and unsupported compression
+        bytes = buildRegion({{0, 0, 100, 2}, {1, 0, 100, 3}});
+        bytes[2 * Sector + 10] ^= 0xff;
+        bytes[3 * Sector + 4] = static_cast<std::uint8_t>(RegionCompression::LZ4);
+        const fs::path corrupt = directory / "r.4.0.mca";
+        write(corrupt, bytes);
+        {
+            RegionFile region(corrupt);
+            CNT_CHECK_THROWS(region.read(*region.find(0, 0)));
+            CNT_CHECK_THROWS(region.read(*region.find(1, 0)));
+        }
+    }
+
+    void testCompact(const fs::path &directory)
+    {
+        const fs::path world = directory / "saves" / "world" / "region";
+        const fs::path path = world / "r.0.0.mca";
+        write(path, buildRegion({{0, 0, 100, 2}, {1, 0, 5000, 10}, {2, 0, 20, 40}}));
+        const std::uint64_t before = fs::file_size(path);
+
+        // A dry run reports without touching the file
+        RegionCompactOptions dry;
+        dry.dryRun = true;
+        RegionCompactStats planned = CompactRegionFile(path, dry);
+        CNT_CHECK(planned.chunks == 3);
+        CNT_CHECK(fs::file_size(path) == before);
+
+        RegionCompactStats stats = CompactRegions(directory);
+        CNT_CHECK(stats.files == 1 && stats.rewrittenFiles == 1);
+        CNT_CHECK(stats.errors.empty());
+        CNT_CHECK(fs::file_size(path) < before);
+        {
+            RegionFile region(path);
+            CNT_CHECK(region.chunks().size() == 3);
+            for (const auto &chunk : region.chunks())
+                CNT_CHECK(!region.read(chunk).empty());
+        }
+
+        // Pruning drops the chunks players barely visited
+        RegionCompactOptions prune;
+        prune.minInhabitedTime = 1200;
+        stats = CompactRegionFile(path, prune);
+        CNT_CHECK(stats.prunedChunks == 2);
+        {
+            RegionFile region(path);
+            CNT_CHECK(region.chunks().size() == 1);
+            CNT_CHECK(region.find(1, 0) != nullptr);
+        }
+
+        // Nothing but the region file is left behind
+        std::size_t files = 0;
+        for (const auto &entry : fs::directory_iterator(world))
+            files += entry.is_regular_file();
+        CNT_CHECK(files == 1);
+    }
+}
+
+int main()
+{
+    test::TemporaryDirectory root("region");
+    testRead(root.path());
+    testDamaged(root.path());
+    testCompact(root.path() / "instance");
+    return test::finish("region");
+}
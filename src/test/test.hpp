@@ -0,0 +1,137 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: test/test.hpp
+ * @Description: Checks and scratch directories shared by the test programs
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+#ifndef __MINECRAFT_ENGINE__TEST_HPP__
+#define __MINECRAFT_ENGINE__TEST_HPP__
+
+#include <minecraft/cntconfig.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace cnt
+{
+    namespace test
+    {
+        inline int &failures()
+        {
+            static int count = 0;
+            return count;
+        }
+
+        inline void check(bool ok, const char *expression, const char *file, int line)
+        {
+            if (ok)
+                return;
+            failures()++;
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+        }
+
+        // Exit status of the test program, prints a summary
+        inline int finish(const char *name)
+        {
+            if (failures() == 0)
+                std::printf("%s: ok\n", name);
+            else
+                std::printf("%s: %d check(s) failed\n", name, failures());
+            return failures() == 0 ? 0 : 1;
+        }
+
+        // Scratch directory below the system temp directory, removed with the object
+        class TemporaryDirectory
+        {
+        private:
+            fs::path _path;
+
+        public:
+            explicit TemporaryDirectory(const String &name)
+            {
+                static std::atomic<unsigned long long> sequence{0};
+#ifdef _WIN32
+                const String pid = "0";
+#else
+                const String pid = std::to_string(::getpid());
+#endif
+                _path = fs::temp_directory_path() / ("cnt-test-" + name + '-' + pid + '-' +
+                                                     std::to_string(sequence.fetch_add(1, std::memory_order_relaxed)));
+                fs::remove_all(_path);
+                fs::create_directories(_path);
+            }
+
+            ~TemporaryDirectory()
+            {
+                std::error_code ec;
+                fs::remove_all(_path, ec);
+            }
+
+            TemporaryDirectory(const TemporaryDirectory &) = delete;
+            TemporaryDirectory &operator=(const TemporaryDirectory &) = delete;
+
+            const fs::path &path() const { return _path; }
+        };
+
+        inline void writeFile(const fs::path &path, std::string_view content)
+        {
+            fs::create_directories(path.parent_path());
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(content.data(), static_cast<std::streamsize>(content.size()));
+            if (!file)
+                throw std::runtime_error("Failed to write file: " + path.string());
+        }
+
+        inline String readFile(const fs::path &path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            return String(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+    } // namespace test
+
+} // namespace cnt
+
+#define CNT_CHECK(expression) ::cnt::test::check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+// Passes when the expression throws anything derived from std::exception
+#define CNT_CHECK_THROWS(expression)                                        \
+    do                                                                      \
+    {                                                                       \
+        bool thrown = false;                                                \
+        try                                                                 \
+        {                                                                   \
+            (void)(expression);                                             \
+        }                                                                   \
+        catch (const std::exception &)                                      \
+        {                                                                   \
+            thrown = true;                                                  \
+        }                                                                   \
+        ::cnt::test::check(thrown, "throws: " #expression, __FILE__, __LINE__); \
+    } while (0)
+
+#endif // !__MINECRAFT_ENGINE__TEST_HPP__
@@ -0,0 +1,232 @@
+/*
+ * Minecraft Engine
+ * Copyright (C) 2026 TaimWay <taimway@gmail.com>
+ *
+ * @File: test/zip.cpp
+ * @Description: Inflate and zip archives, including hostile headers
+ * @Ownership: TaimWay <taimway@gmail.com> - 10/18/2026
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <test/test.hpp>
+#include <minecraft/zip.hpp>
+#include <minecraft/lib/deflate.hpp>
+#include <minecraft/lib/inflate.hpp>
+
+#include <vector>
+
+using namespace cnt;
+using namespace cnt::minecraft;
+
+namespace
+{
+    struct TestEntry
+    {
+        String name;
+        String content;
+        bool deflate = true;
+
+        // Overrides of the recorded header fields
+        std::int64_t size = -1;
+        std::int64_t crc = -1;
+    };
+
+    void put(std::vector<std::uint8_t> &out, std::uint64_t value, int bytes)
+    {
+        for (int i = 0; i < bytes; i++)
+            out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+
+    // A zip archive with local headers, a central directory and its end record
+    std::vector<std::uint8_t> buildZip(const std::vector<TestEntry> &entries)
+    {
+        std::vector<std::uint8_t> out, directory;
+        for (const auto &entry : entries)
+        {
+            std::vector<std::uint8_t> data;
+            if (entry.deflate)
+                Deflater::deflate(entry.content.data(), entry.content.size(), data);
+            else
+                data.assign(entry.content.begin(), entry.content.end());
+
+            const std::uint32_t crc = entry.crc >= 0 ? static_cast<std::uint32_t>(entry.crc)
+                                                     : internal::crc32(entry.content.data(), entry.content.size());
+            const std::uint64_t size = entry.size >= 0 ? static_cast<std::uint64_t>(entry.size) : entry.content.size();
+            const std::uint64_t offset = out.size();
+
+            put(out, 0x04034b50, 4);
+            put(out, 20, 2);
+            put(out, 0, 2);
+            put(out, entry.deflate ? 8 : 0, 2);
+            put(out, 0, 4);
+            put(out, crc, 4);
+            put(out, data.size(), 4);
+            put(out, size, 4);
+            put(out, entry.name.size(), 2);
+            put(out, 0, 2);
+            out.insert(out.end(), entry.name.begin(), entry.name.end());
+            out.insert(out.end(), data.begin(), data.end());
+
+            put(directory, 0x02014b50, 4);
+            put(directory, 20, 2);
+            put(directory, 20, 2);
+            put(directory, 0, 2);
+            put(directory, entry.deflate ? 8 : 0, 2);
+            put(directory, 0, 4);
+            put(directory, crc, 4);
+            put(directory, data.size(), 4);
+            put(directory, size, 4);
+            put(directory, entry.name.size(), 2);
+            put(directory, 0, 6);
+            put(directory, 0, 2);
+            put(directory, 0, 4);
+            put(directory, offset, 4);
+            directory.insert(directory.end(), entry.name.begin(), entry.name.end());
+        }
+
+        const std::uint64_t directoryOffset = out.size();
+        out.insert(out.end(), directory.begin(), directory.end());
+        put(out, 0x06054b50, 4);
+        put(out, 0, 4);
+        put(out, entries.size(), 2);
+        put(out, entries.size(), 2);
+        put(out, directory.size(), 4);
+        put(out, directoryOffset, 4);
+        put(out, 0, 2);
+        return out;
+    }
+
+    String text(const std::vector<std::uint8_t> &data)
+    {
+        return String(data.begin(), data.end());
+    }
+
+    void testInflate()
+    {
+        String input;
+        for (int i = 0; i < 100000; i++)
+            input += "block " + std::to_string(i % 97) + (i % 13 == 0 ? "\n" : " ");
+
+        std::vector<std::uint8_t> compressed;
+        Deflater::deflate(input.data(), input.size(), compressed);
+        CNT_CHECK(compressed.size() < input.size());
+
+        std::vector<std::uint8_t> out;
+        Inflater::inflate(compressed.data(), compressed.size(), out);
+        CNT_CHECK(text(out) == input);
+
+        // The sink sees the same bytes in order
+        String streamed;
+        Inflater::inflate(compressed.data(), compressed.size(), [&streamed](const std::uint8_t *data, std::size_t size)
+                          { streamed.append(reinterpret_cast<const char *>(data), size); });
+        CNT_CHECK(streamed == input);
+
+        // A limit below the real size stops decoding, before the sink sees the excess
+        out.clear();
+        CNT_CHECK_THROWS(Inflater::inflate(compressed.data(), compressed.size(), out, input.size() - 1));
+        std::size_t seen = 0;
+        CNT_CHECK_THROWS(Inflater::inflate(compressed.data(), compressed.size(), [&seen](const std::uint8_t *, std::size_t size)
+                                           { seen += size; }, 1000));
+        CNT_CHECK(seen <= 1000);
+
+        // Garbage and truncated streams are rejected
+        const std::uint8_t invalid[] = {0xff, 0xff, 0xff, 0xff};
+        out.clear();
+        CNT_CHECK_THROWS(Inflater::inflate(invalid, sizeof(invalid), out));
+        out.clear();
+        CNT_CHECK_THROWS(Inflater::inflate(compressed.data(), compressed.size() / 2, out));
+    }
+
+    void testArchive()
+    {
+        CNT_CHECK(internal::crc32("123456789", 9) == 0xCBF43926u);
+
+        String large(200000, 'x');
+        ZipArchive archive(buildZip({{"fabric.mod.json", R"({"id": "example"})", true},
+                                     {"META-INF/MANIFEST.MF", "Manifest-Version: 1.0\n", false},
+                                     {"assets/", "", false},
+                                     {"large.bin", large, true}}),
+                           "memory.jar");
+        CNT_CHECK(archive.size() == 4);
+        CNT_CHECK(archive.find("missing") == nullptr);
+        CNT_CHECK(archive.find("assets/") != nullptr && archive.find("assets/")->isDirectory());
+
+        String content;
+        CNT_CHECK(archive.readString("fabric.mod.json", content));
+        CNT_CHECK(content == R"({"id": "example"})");
+        CNT_CHECK(archive.readString("META-INF/MANIFEST.MF", content));
+        CNT_CHECK(content == "Manifest-Version: 1.0\n");
+        CNT_CHECK(archive.view(*archive.find("META-INF/MANIFEST.MF")) == "Manifest-Version: 1.0\n");
+        CNT_CHECK_THROWS(archive.view(*archive.find("fabric.mod.json")));
+        CNT_CHECK(text(archive.read(*archive.find("large.bin"))) == large);
+        CNT_CHECK(!archive.readString("missing", content));
+
+        // The same archive from a file
+        test::TemporaryDirectory root("zip");
+        const std::vector<std::uint8_t> bytes = buildZip({{"a.txt", "alpha", true}});
+        test::writeFile(root.path() / "a.zip", String(bytes.begin(), bytes.end()));
+        ZipArchive mapped(root.path() / "a.zip");
+        CNT_CHECK(mapped.readString("a.txt", content) && content == "alpha");
+    }
+
+    void testHostileArchives()
+    {
+        String content;
+
+        // Wrong checksum
+        {
+            ZipArchive archive(buildZip({{"a.txt", "alpha", true, -1, 0x12345678}}), "crc.zip");
+            CNT_CHECK_THROWS(archive.readString("a.txt", content));
+        }
+
+        // A deflate stream that decodes to more than the header admits
+        {
+            ZipArchive archive(buildZip({{"bomb.bin", String(1 << 20, '\0'), true, 1024}}), "bomb.zip");
+            const ZipEntry *entry = archive.find("bomb.bin");
+            CNT_CHECK_THROWS(archive.read(*entry));
+            std::size_t seen = 0;
+            CNT_CHECK_THROWS(archive.read(*entry, [&seen](const std::uint8_t *, std::size_t size)
+                                          { seen += size; }));
+            CNT_CHECK(seen <= 1024);
+        }
+
+        // A stored entry whose sizes disagree
+        {
+            ZipArchive archive(buildZip({{"a.txt", "alpha", false, 3}}), "stored.zip");
+            CNT_CHECK_THROWS(archive.readString("a.txt", content));
+        }
+
+        // Not a zip, truncated, central directory outside the file
+        CNT_CHECK_THROWS(ZipArchive(std::vector<std::uint8_t>(), "empty.zip"));
+        CNT_CHECK_THROWS(ZipArchive(std::vector<std::uint8_t>(100, 0x41), "text.zip"));
+
+        std::vector<std::uint8_t> bytes = buildZip({{"a.txt", "alpha", true}});
+        CNT_CHECK_THROWS(ZipArchive(std::vector<std::uint8_t>(bytes.begin() + 10, bytes.end()), "cut.zip"));
+
+        std::vector<std::uint8_t> moved = bytes;
+        const std::size_t eocd = moved.size() - 22;
+        moved[eocd + 16] = 0xff, moved[eocd + 17] = 0xff, moved[eocd + 18] = 0xff, moved[eocd + 19] = 0x7f;
+        CNT_CHECK_THROWS(ZipArchive(std::move(moved), "offset.zip"));
+    }
+}
+
+int main()
+{
+    testInflate();
+    testArchive();
+    testHostileArchives();
+    return test::finish("zip");
+}